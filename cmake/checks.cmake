@@ -31,6 +31,17 @@
 include(CheckCXXSourceCompiles)
 include(CheckIncludeFileCXX)
 
+check_include_file_cxx(charconv HAVE_CHARCONV_INCLUDE)
+if(HAVE_CHARCONV_INCLUDE)
+  check_cxx_source_compiles(
+    "#include <charconv>
+    #include <cstdint>
+    #include <tuple> // std::ignore
+    std::int32_t main() { char buffer[ 32 ] = \"0.5\"; double value = 0; std::ignore = std::from_chars( buffer, buffer + 3, value ); std::ignore = std::to_chars( buffer, buffer + sizeof( buffer ), value ); return 0; }"
+    HAVE_CHARCONV_FLOAT
+  )
+endif()
+
 check_include_file_cxx(format HAVE_FORMAT_INCLUDE)
 if(HAVE_FORMAT_INCLUDE)
   check_cxx_source_compiles(
@@ -34,6 +34,7 @@ option(CMAKE_VERBOSE_MAKEFILE "Show the complete build commands" OFF)
 # possibility to disable build steps
 option(CORE_BUILD_EXAMPLES "Build examples" ON)
 option(CORE_BUILD_TESTS "Build tests" ON)
+option(CORE_WITH_RE2 "Build re2 and link it for dependent projects" OFF)
 
 # General
 set(CMAKE_TLS_VERIFY TRUE)
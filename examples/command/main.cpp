@@ -41,15 +41,14 @@
 
 namespace {
 
-  void checkResult( std::int32_t _code,
-                    const std::string &_pipe ) {
+  void checkResult( const vx::exec::Result &_result ) {
 
     std::string result = "EXIT_SUCCESS";
-    if ( _code != EXIT_SUCCESS ) {
+    if ( _result.exitCode != EXIT_SUCCESS ) {
 
       result = "EXIT_FAILURE";
     }
-    std::cout << "'" << _pipe << "'" << std::endl;
+    std::cout << "'" << _result.output << "'" << std::endl;
     std::cout << "Result: " << result << std::endl;
   }
 }
@@ -57,20 +56,16 @@ namespace {
 std::int32_t main() {
 
   std::cout << "----- Result: EXIT_SUCCESS stdout" << std::endl;
-  std::string pipe = vx::exec::run( "../pipe/pipe 0 2>/dev/null" );
-  checkResult( vx::exec::resultCode(), pipe );
+  checkResult( vx::exec::run( "../pipe/pipe 0 2>/dev/null" ) );
 
   std::cout << "----- Result: EXIT_SUCCESS mixed stdout and stderr" << std::endl;
-  pipe = vx::exec::run( "../pipe/pipe 0 2>&1" );
-  checkResult( vx::exec::resultCode(), pipe );
+  checkResult( vx::exec::run( "../pipe/pipe 0 2>&1" ) );
 
   std::cout << "----- Result: EXIT_FAILURE stdout" << std::endl;
-  pipe = vx::exec::run( "../pipe/pipe 1 2>/dev/null" );
-  checkResult( vx::exec::resultCode(), pipe );
+  checkResult( vx::exec::run( "../pipe/pipe 1 2>/dev/null" ) );
 
   std::cout << "----- Result: EXIT_FAILURE mixed stdout and stderr" << std::endl;
-  pipe = vx::exec::run( "../pipe/pipe 1 2>&1" );
-  checkResult( vx::exec::resultCode(), pipe );
+  checkResult( vx::exec::run( "../pipe/pipe 1 2>&1" ) );
 
   return EXIT_SUCCESS;
 }
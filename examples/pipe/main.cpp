@@ -40,6 +40,9 @@
 #endif
 #include <string>
 
+/* modern.cpp.core */
+#include <StringUtils.h>
+
 std::int32_t main( std::int32_t argc,
                    char **argv ) {
 
@@ -64,8 +67,8 @@ std::int32_t main( std::int32_t argc,
   printf( "This is printf text.\n" );
 
 #ifdef HAVE_SPAN
-  return std::stoi( args[ 1 ] );
+  return vx::string_utils::parse<std::int32_t>( args[ 1 ] ).value_or( EXIT_FAILURE );
 #else
-  return std::stoi( argv[ 1 ] );
+  return vx::string_utils::parse<std::int32_t>( argv[ 1 ] ).value_or( EXIT_FAILURE );
 #endif
 }
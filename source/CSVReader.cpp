@@ -0,0 +1,272 @@
+/*
+ * Copyright (c) 2020 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* c header */
+#include <cstddef> // std::size_t
+
+/* system header */
+#ifndef _WIN32
+  #include <fcntl.h> // open
+  #include <sys/mman.h> // mmap, munmap, madvise
+  #include <sys/stat.h> // fstat
+  #include <unistd.h> // close
+#endif
+
+/* stl header */
+#include <algorithm>
+#include <array>
+#include <exception>
+#ifdef _WIN32
+  #include <fstream>
+  #include <ios>
+#endif
+#include <new> // std::bad_alloc
+
+/* local header */
+#include "CSVReader.h"
+#include "Logger.h"
+#include "StringUtils.h"
+
+namespace vx {
+
+  CSVReader::CSVReader( const std::string &_filename,
+                        char _delimiter ) noexcept
+    : m_delimiter( _delimiter ) {
+
+#ifdef _WIN32
+    try {
+
+      std::ifstream input( _filename, std::ios::in | std::ios::binary | std::ios::ate );
+      if ( !input.is_open() ) {
+
+        logError() << "Unable to open csv file:" << _filename;
+        return;
+      }
+      m_buffer.resize( static_cast<std::size_t>( input.tellg() ) );
+      input.seekg( 0, std::ios_base::beg );
+      input.read( m_buffer.data(), static_cast<std::streamsize>( m_buffer.size() ) );
+      m_data = { m_buffer.data(), m_buffer.size() };
+    }
+    catch ( const std::bad_alloc &_exception ) {
+
+      logFatal() << "bad_alloc:" << _exception.what();
+      return;
+    }
+    catch ( const std::exception &_exception ) { // NOSONAR fallback for every exeption.
+
+      logFatal() << _exception.what();
+      return;
+    }
+#else
+    const int descriptor = ::open( _filename.c_str(), O_RDONLY | O_CLOEXEC );
+    if ( descriptor == -1 ) {
+
+      logError() << "Unable to open csv file:" << _filename;
+      return;
+    }
+    struct stat status {};
+    if ( ::fstat( descriptor, &status ) == -1 ) {
+
+      logError() << "Unable to stat csv file:" << _filename;
+      ::close( descriptor );
+      return;
+    }
+    const auto size = static_cast<std::size_t>( status.st_size );
+    /* An empty file cannot be mapped, but it is a valid csv file without rows. */
+    if ( size > 0 ) {
+
+      void *mapping = ::mmap( nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0 );
+      if ( mapping == MAP_FAILED ) { // NOSONAR MAP_FAILED is defined as old-style cast by the system header.
+
+        logError() << "Unable to map csv file:" << _filename;
+        ::close( descriptor );
+        return;
+      }
+      ::madvise( mapping, size, MADV_SEQUENTIAL );
+      m_mapping = mapping;
+      m_data = { static_cast<const char *>( mapping ), size };
+    }
+    /* The mapping stays valid after the descriptor is closed. */
+    ::close( descriptor );
+#endif
+    m_cursor = m_data;
+    m_isOpen = true;
+  }
+
+  CSVReader::~CSVReader() noexcept {
+
+    close();
+  }
+
+  bool CSVReader::readRow( std::vector<std::string_view> &_fields ) noexcept {
+
+    return parseRow( m_cursor, _fields, m_delimiter );
+  }
+
+  std::vector<std::string_view> CSVReader::chunks( std::size_t _count ) const {
+
+    std::vector<std::string_view> result {};
+    if ( m_data.empty() || _count == 0 ) {
+
+      return result;
+    }
+    result.reserve( _count );
+    const std::size_t size = m_data.size();
+    const std::size_t target = std::max( size / _count, std::size_t { 1 } );
+    std::size_t start = 0;
+    std::size_t scanned = 0;
+    bool quoted = false;
+    while ( start < size ) {
+
+      std::size_t end = result.size() + 1 >= _count ? size : std::min( start + target, size );
+      while ( end < size ) {
+
+        /* The quote parity tells, if a line break is part of a quoted field. */
+        for ( std::size_t quote = m_data.find( '"', scanned ); quote < end; quote = m_data.find( '"', quote + 1 ) ) {
+
+          quoted = !quoted;
+        }
+        scanned = end;
+        if ( !quoted && m_data[ end - 1 ] == '\n' ) {
+
+          break;
+        }
+        end = string_utils::findFirstOf( m_data, "\"\n", end );
+        end = end == std::string_view::npos ? size : end + 1;
+      }
+      result.emplace_back( m_data.substr( start, end - start ) );
+      start = end;
+    }
+    return result;
+  }
+
+  void CSVReader::close() noexcept {
+
+#ifdef _WIN32
+    m_buffer.clear();
+    m_buffer.shrink_to_fit();
+#else
+    if ( m_mapping ) {
+
+      ::munmap( m_mapping, m_data.size() );
+      m_mapping = nullptr;
+    }
+#endif
+    m_data = {};
+    m_cursor = {};
+    m_isOpen = false;
+  }
+
+  bool CSVReader::parseRow( std::string_view &_input,
+                            std::vector<std::string_view> &_fields,
+                            char _delimiter ) noexcept {
+
+    _fields.clear();
+    if ( _input.empty() ) {
+
+      return false;
+    }
+    const std::array stops { _delimiter, '\n' };
+    const std::string_view stopChars( stops.data(), stops.size() );
+    const std::size_t size = _input.size();
+    std::size_t pos = 0;
+    try {
+
+      while ( true ) {
+
+        std::string_view field {};
+        if ( pos < size && _input[ pos ] == '"' ) {
+
+          std::size_t quote = _input.find( '"', pos + 1 );
+          while ( quote != std::string_view::npos && quote + 1 < size && _input[ quote + 1 ] == '"' ) {
+
+            quote = _input.find( '"', quote + 2 );
+          }
+          if ( quote == std::string_view::npos ) {
+
+            field = _input.substr( pos + 1 );
+            pos = size;
+          }
+          else {
+
+            field = _input.substr( pos + 1, quote - pos - 1 );
+            /* Skip everything up to the next stop, e.g. the carriage return of the line ending. */
+            pos = std::min( string_utils::findFirstOf( _input, stopChars, quote + 1 ), size );
+          }
+        }
+        else {
+
+          const std::size_t end = std::min( string_utils::findFirstOf( _input, stopChars, pos ), size );
+          field = _input.substr( pos, end - pos );
+          if ( !field.empty() && field.back() == '\r' && ( end == size || _input[ end ] == '\n' ) ) {
+
+            field.remove_suffix( 1 );
+          }
+          pos = end;
+        }
+        _fields.emplace_back( field );
+        if ( pos == size ) {
+
+          break;
+        }
+        const bool lineEnd = _input[ pos ] == '\n';
+        ++pos;
+        if ( lineEnd ) {
+
+          break;
+        }
+      }
+    }
+    catch ( const std::bad_alloc &_exception ) {
+
+      logFatal() << "bad_alloc:" << _exception.what();
+    }
+    catch ( const std::exception &_exception ) { // NOSONAR fallback for every exeption.
+
+      logFatal() << _exception.what();
+    }
+    _input.remove_prefix( pos );
+    return true;
+  }
+
+  std::string CSVReader::unescape( std::string_view _field ) {
+
+    std::string result {};
+    result.reserve( _field.size() );
+    std::size_t start = 0;
+    for ( std::size_t quote = _field.find( "\"\"" ); quote != std::string_view::npos; quote = _field.find( "\"\"", start ) ) {
+
+      result.append( _field.substr( start, quote - start + 1 ) );
+      start = quote + 2;
+    }
+    result.append( _field.substr( start ) );
+    return result;
+  }
+}
@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2020 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+/* c header */
+#include <cstddef> // std::size_t
+
+/* stl header */
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief vx (VX APPS) namespace.
+ */
+namespace vx {
+
+  /**
+   * @brief Read comma-separated values from a memory mapped file.
+   * The fields of a row are views into the mapped file, nothing is copied while parsing.
+   * Quoted fields are returned without the enclosing quotes, escaped quotes inside stay doubled - use unescape() to resolve them.
+   * @author Florian Becker <fb\@vxapps.com> (VX APPS)
+   */
+  class CSVReader {
+
+  public:
+    /**
+     * @brief Default constructor for CSVReader.
+     * @param _filename   CSV filename.
+     * @param _delimiter   Delimiter between the fields.
+     */
+    explicit CSVReader( const std::string &_filename,
+                        char _delimiter = ',' ) noexcept;
+
+    /**
+     * @brief Delete copy assign.
+     */
+    CSVReader( const CSVReader & ) = delete;
+
+    /**
+     * @brief Delete move assign.
+     */
+    CSVReader( CSVReader && ) = delete;
+
+    /**
+     * @brief Delete copy assign.
+     * @return Nothing.
+     */
+    CSVReader &operator=( const CSVReader & ) = delete;
+
+    /**
+     * @brief Delete move assign.
+     * @return Nothing.
+     */
+    CSVReader &operator=( CSVReader && ) = delete;
+
+    /**
+     * @brief Default destructor for CSVReader.
+     */
+    virtual ~CSVReader() noexcept;
+
+    /**
+     * @brief Is the csv file open?
+     * @return True, if open - otherwise false.
+     */
+    [[nodiscard]] inline bool isOpen() const noexcept { return m_isOpen; }
+
+    /**
+     * @brief Return the whole content of the file.
+     * @return View of the mapped file.
+     */
+    [[nodiscard]] inline std::string_view data() const noexcept { return m_data; }
+
+    /**
+     * @brief Read the next row.
+     * @param _fields   Fields of the row - the vector is reused and only grows for wider rows.
+     * @return True, if a row was read - otherwise false at the end of the file.
+     */
+    [[nodiscard]] bool readRow( std::vector<std::string_view> &_fields ) noexcept;
+
+    /**
+     * @brief Start reading at the first row again.
+     */
+    inline void rewind() noexcept { m_cursor = m_data; }
+
+    /**
+     * @brief Split the file into chunks, each ends after a complete row.
+     * Line breaks inside of quoted fields are not used as chunk boundary.
+     * Every chunk can be parsed independently by parseRow() - e.g. by a thread per chunk.
+     * @param _count   Maximal number of chunks.
+     * @return Chunks of the file.
+     * @note This function may throw an exception by std::vector.
+     */
+    [[nodiscard]] std::vector<std::string_view> chunks( std::size_t _count ) const;
+
+    /**
+     * @brief Close the csv file.
+     * All views returned before are invalid afterwards.
+     */
+    void close() noexcept;
+
+    /**
+     * @brief Parse the first row of the input and remove it from the input.
+     * @param _input   Input to parse.
+     * @param _fields   Fields of the row - the vector is reused and only grows for wider rows.
+     * @param _delimiter   Delimiter between the fields.
+     * @return True, if a row was parsed - otherwise false for an empty input.
+     */
+    [[nodiscard]] static bool parseRow( std::string_view &_input,
+                                        std::vector<std::string_view> &_fields,
+                                        char _delimiter = ',' ) noexcept;
+
+    /**
+     * @brief Resolve the doubled quotes of a quoted field.
+     * @param _field   Field to unescape.
+     * @return Unescaped field.
+     * @note This function may throw an exception by the constructor of std::string.
+     */
+    [[nodiscard]] static std::string unescape( std::string_view _field );
+
+  private:
+    /**
+     * @brief Member if file is open.
+     */
+    bool m_isOpen = false;
+
+    /**
+     * @brief Member for the delimiter.
+     */
+    char m_delimiter = ',';
+
+    /**
+     * @brief Member for the content of the file.
+     */
+    std::string_view m_data {};
+
+    /**
+     * @brief Member for the rows not read so far.
+     */
+    std::string_view m_cursor {};
+
+#ifdef _WIN32
+    /**
+     * @brief Member for the content of the file - the file is read instead of mapped.
+     */
+    std::vector<char> m_buffer {};
+#else
+    /**
+     * @brief Member for the mapped memory.
+     */
+    void *m_mapping = nullptr;
+#endif
+  };
+}
@@ -0,0 +1,351 @@
+/*
+ * Copyright (c) 2020 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* c header */
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint8_t, std::uint32_t, std::int8_t, std::int16_t, std::int32_t, std::int64_t
+#include <cstring> // std::memcpy
+
+/* stl header */
+#include <algorithm>
+#include <array>
+#include <exception>
+#include <fstream>
+#include <ios>
+#include <new> // std::bad_alloc
+
+/* local header */
+#include "ColumnarReader.h"
+#include "CSVWriter.h"
+#include "Logger.h"
+#include "StringUtils.h"
+
+namespace vx {
+
+  namespace {
+
+    /**
+     * @brief Return the size of a stored value.
+     * @param _type   Column type.
+     * @return The size of a stored value in bytes.
+     */
+    std::size_t valueSize( columnar::Type _type ) noexcept {
+
+      switch ( _type ) {
+
+        case columnar::Type::Bool:
+        case columnar::Type::Int8:
+        case columnar::Type::UInt8:
+          return sizeof( std::uint8_t );
+        case columnar::Type::Int16:
+        case columnar::Type::UInt16:
+          return sizeof( std::uint16_t );
+        case columnar::Type::Int32:
+        case columnar::Type::UInt32:
+        case columnar::Type::Text:
+          return sizeof( std::uint32_t );
+        case columnar::Type::Float:
+          return sizeof( float );
+        case columnar::Type::Int64:
+        case columnar::Type::UInt64:
+          return sizeof( std::uint64_t );
+        case columnar::Type::Double:
+          return sizeof( double );
+      }
+      return 0;
+    }
+
+    /**
+     * @brief Replace the field by a number.
+     * @tparam T   Type.
+     * @param _field   Field.
+     * @param _data   Stored number.
+     */
+    template <typename T>
+    void assign( std::string &_field,
+                 const char *_data ) {
+
+      T value {};
+      std::memcpy( &value, _data, sizeof( T ) );
+      std::array<char, string_utils::formatSize<T>> buffer {};
+      _field.assign( string_utils::format( buffer, value ) );
+    }
+  }
+
+  ColumnarReader::ColumnarReader( const std::string &_filename ) noexcept {
+
+    try {
+
+      std::ifstream input( _filename, std::ios::in | std::ios::binary | std::ios::ate );
+      if ( !input.is_open() ) {
+
+        logError() << "Unable to open columnar file:" << _filename;
+        return;
+      }
+      m_data.resize( static_cast<std::size_t>( input.tellg() ) );
+      input.seekg( 0, std::ios_base::beg );
+      input.read( m_data.data(), static_cast<std::streamsize>( m_data.size() ) );
+      m_isOpen = parse();
+    }
+    catch ( const std::bad_alloc &_exception ) {
+
+      logFatal() << "bad_alloc:" << _exception.what();
+    }
+    catch ( const std::exception &_exception ) { // NOSONAR fallback for every exeption.
+
+      logFatal() << _exception.what();
+    }
+    if ( !m_isOpen ) {
+
+      logError() << "Invalid columnar file:" << _filename;
+      m_columns.clear();
+      m_blocks.clear();
+      m_rows = 0;
+    }
+  }
+
+  bool ColumnarReader::toCSV( std::string_view _filename,
+                              std::string_view _delimiter ) const noexcept {
+
+    if ( !m_isOpen ) {
+
+      return false;
+    }
+    CSVWriter writer( _filename, _delimiter );
+    std::vector<std::string> fields {};
+    try {
+
+      fields.resize( m_columns.size() );
+      if ( std::any_of( std::cbegin( m_columns ), std::cend( m_columns ), []( const Column &_column ) { return !_column.name.empty(); } ) ) {
+
+        std::transform( std::cbegin( m_columns ), std::cend( m_columns ), std::begin( fields ), []( const Column &_column ) { return std::string( _column.name ); } );
+        writer.addRowData( std::cbegin( fields ), std::cend( fields ) );
+      }
+      for ( std::size_t block = 0; block < m_blocks.size(); ++block ) {
+
+        for ( std::size_t row = 0; row < m_blocks[ block ].rows; ++row ) {
+
+          for ( std::size_t column = 0; column < m_columns.size(); ++column ) {
+
+            if ( !format( fields[ column ], block, column, row ) ) {
+
+              logError() << "Invalid text index in block:" << block << "column:" << column;
+              return false;
+            }
+          }
+          writer.addRowData( std::cbegin( fields ), std::cend( fields ) );
+        }
+      }
+    }
+    catch ( const std::bad_alloc &_exception ) {
+
+      logFatal() << "bad_alloc:" << _exception.what();
+      return false;
+    }
+    catch ( const std::exception &_exception ) { // NOSONAR fallback for every exeption.
+
+      logFatal() << _exception.what();
+      return false;
+    }
+    return writer.isOpen();
+  }
+
+  bool ColumnarReader::parse() {
+
+    const std::size_t size = m_data.size();
+    std::size_t pos = 0;
+    const auto available = [ &pos, size ]( std::size_t _bytes ) { return _bytes <= size - pos; };
+    if ( !available( columnar::magic.size() ) || !std::equal( std::cbegin( columnar::magic ), std::cend( columnar::magic ), std::cbegin( m_data ) ) ) {
+
+      return false;
+    }
+    pos += columnar::magic.size();
+    if ( !available( sizeof( std::uint8_t ) + sizeof( std::uint32_t ) ) ) {
+
+      return false;
+    }
+    m_statistics = ( read<std::uint8_t>( pos ) & columnar::statisticsFlag ) != 0;
+    pos += sizeof( std::uint8_t );
+    const auto columnCount = read<std::uint32_t>( pos );
+    pos += sizeof( std::uint32_t );
+
+    /* Every column needs at least its type and name length. */
+    if ( !available( columnCount * ( sizeof( std::uint8_t ) + sizeof( std::uint32_t ) ) ) ) {
+
+      return false;
+    }
+    m_columns.resize( columnCount );
+    for ( Column &column : m_columns ) {
+
+      const auto type = read<std::uint8_t>( pos );
+      if ( type > static_cast<std::uint8_t>( columnar::Type::Text ) ) {
+
+        return false;
+      }
+      column.type = static_cast<columnar::Type>( type );
+      pos += sizeof( std::uint8_t );
+      const auto length = read<std::uint32_t>( pos );
+      pos += sizeof( std::uint32_t );
+      if ( !available( length ) ) {
+
+        return false;
+      }
+      column.name = { m_data.data() + pos, length };
+      pos += length;
+    }
+
+    while ( pos < size ) {
+
+      if ( !available( sizeof( std::uint32_t ) ) ) {
+
+        return false;
+      }
+      Block block {};
+      block.rows = read<std::uint32_t>( pos );
+      pos += sizeof( std::uint32_t );
+      block.columns.resize( columnCount );
+      for ( std::size_t index = 0; index < columnCount; ++index ) {
+
+        const columnar::Type type = m_columns[ index ].type;
+        BlockColumn &column = block.columns[ index ];
+        if ( type == columnar::Type::Text ) {
+
+          if ( !available( sizeof( std::uint32_t ) ) ) {
+
+            return false;
+          }
+          const auto entries = read<std::uint32_t>( pos );
+          pos += sizeof( std::uint32_t );
+          if ( !available( entries * sizeof( std::uint32_t ) ) ) {
+
+            return false;
+          }
+          column.dictionary.reserve( entries );
+          for ( std::uint32_t entry = 0; entry < entries; ++entry ) {
+
+            if ( !available( sizeof( std::uint32_t ) ) ) {
+
+              return false;
+            }
+            const auto length = read<std::uint32_t>( pos );
+            pos += sizeof( std::uint32_t );
+            if ( !available( length ) ) {
+
+              return false;
+            }
+            column.dictionary.emplace_back( m_data.data() + pos, length );
+            pos += length;
+          }
+        }
+        else if ( m_statistics ) {
+
+          if ( !available( 2 * valueSize( type ) ) ) {
+
+            return false;
+          }
+          column.statistics = pos;
+          pos += 2 * valueSize( type );
+        }
+        if ( !available( block.rows * valueSize( type ) ) ) {
+
+          return false;
+        }
+        column.values = pos;
+        pos += block.rows * valueSize( type );
+      }
+      m_rows += block.rows;
+      m_blocks.emplace_back( std::move( block ) );
+    }
+    return true;
+  }
+
+  bool ColumnarReader::isValid( std::size_t _block,
+                                std::size_t _column,
+                                columnar::Type _type ) const noexcept {
+
+    return m_isOpen && _block < m_blocks.size() && _column < m_columns.size() && m_columns[ _column ].type == _type;
+  }
+
+  bool ColumnarReader::format( std::string &_field,
+                               std::size_t _block,
+                               std::size_t _column,
+                               std::size_t _row ) const {
+
+    const BlockColumn &column = m_blocks[ _block ].columns[ _column ];
+    const columnar::Type type = m_columns[ _column ].type;
+    const char *data = m_data.data() + column.values + _row * valueSize( type );
+    switch ( type ) {
+
+      case columnar::Type::Bool:
+        _field.assign( *data != 0 ? "true" : "false" );
+        break;
+      case columnar::Type::Int8:
+        assign<std::int8_t>( _field, data );
+        break;
+      case columnar::Type::UInt8:
+        assign<std::uint8_t>( _field, data );
+        break;
+      case columnar::Type::Int16:
+        assign<std::int16_t>( _field, data );
+        break;
+      case columnar::Type::UInt16:
+        assign<std::uint16_t>( _field, data );
+        break;
+      case columnar::Type::Int32:
+        assign<std::int32_t>( _field, data );
+        break;
+      case columnar::Type::UInt32:
+        assign<std::uint32_t>( _field, data );
+        break;
+      case columnar::Type::Int64:
+        assign<std::int64_t>( _field, data );
+        break;
+      case columnar::Type::UInt64:
+        assign<std::uint64_t>( _field, data );
+        break;
+      case columnar::Type::Float:
+        assign<float>( _field, data );
+        break;
+      case columnar::Type::Double:
+        assign<double>( _field, data );
+        break;
+      case columnar::Type::Text: {
+        const auto index = read<std::uint32_t>( column.values + _row * sizeof( std::uint32_t ) );
+        if ( index >= column.dictionary.size() ) {
+
+          return false;
+        }
+        _field.assign( column.dictionary[ index ] );
+        break;
+      }
+    }
+    return true;
+  }
+}
@@ -0,0 +1,355 @@
+/*
+ * Copyright (c) 2020 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+/* c header */
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint8_t
+#include <cstring> // std::memcpy
+
+/* stl header */
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+/* local header */
+#include "Columnar.h"
+
+/**
+ * @brief vx (VX APPS) namespace.
+ */
+namespace vx {
+
+  /**
+   * @brief Read a columnar file written by ColumnarWriter.
+   * The file is read at once and indexed by blocks, columns are read as a whole per block.
+   * Text values are views into the read file.
+   * @author Florian Becker <fb\@vxapps.com> (VX APPS)
+   */
+  class ColumnarReader {
+
+  public:
+    /**
+     * @brief Default constructor for ColumnarReader.
+     * @param _filename   Columnar filename.
+     */
+    explicit ColumnarReader( const std::string &_filename ) noexcept;
+
+    /**
+     * @brief Delete copy assign.
+     */
+    ColumnarReader( const ColumnarReader & ) = delete;
+
+    /**
+     * @brief Delete move assign.
+     */
+    ColumnarReader( ColumnarReader && ) = delete;
+
+    /**
+     * @brief Delete copy assign.
+     * @return Nothing.
+     */
+    ColumnarReader &operator=( const ColumnarReader & ) = delete;
+
+    /**
+     * @brief Delete move assign.
+     * @return Nothing.
+     */
+    ColumnarReader &operator=( ColumnarReader && ) = delete;
+
+    /**
+     * @brief Default destructor for ColumnarReader.
+     */
+    virtual ~ColumnarReader() = default;
+
+    /**
+     * @brief Is the columnar file read and valid?
+     * @return True, if valid - otherwise false.
+     */
+    [[nodiscard]] inline bool isOpen() const noexcept { return m_isOpen; }
+
+    /**
+     * @brief Return the number of columns.
+     * @return The number of columns.
+     */
+    [[nodiscard]] inline std::size_t columnCount() const noexcept { return m_columns.size(); }
+
+    /**
+     * @brief Return the type of a column.
+     * @param _column   Column index.
+     * @return The column type - std::nullopt, if the column does not exist.
+     */
+    [[nodiscard]] inline std::optional<columnar::Type> columnType( std::size_t _column ) const noexcept {
+
+      if ( _column >= m_columns.size() ) {
+
+        return std::nullopt;
+      }
+      return m_columns[ _column ].type;
+    }
+
+    /**
+     * @brief Return the name of a column.
+     * @param _column   Column index.
+     * @return The column name - empty, if the column does not exist.
+     */
+    [[nodiscard]] inline std::string_view columnName( std::size_t _column ) const noexcept { return _column < m_columns.size() ? std::string_view { m_columns[ _column ].name } : std::string_view {}; }
+
+    /**
+     * @brief Are minimum and maximum of the number columns stored per block?
+     * @return True, if the statistics are stored - otherwise false.
+     */
+    [[nodiscard]] inline bool hasStatistics() const noexcept { return m_statistics; }
+
+    /**
+     * @brief Return the number of blocks.
+     * @return The number of blocks.
+     */
+    [[nodiscard]] inline std::size_t blockCount() const noexcept { return m_blocks.size(); }
+
+    /**
+     * @brief Return the number of rows in a block.
+     * @param _block   Block index.
+     * @return The number of rows in the block - 0, if the block does not exist.
+     */
+    [[nodiscard]] inline std::size_t blockRows( std::size_t _block ) const noexcept { return _block < m_blocks.size() ? m_blocks[ _block ].rows : 0; }
+
+    /**
+     * @brief Return the number of rows of all blocks.
+     * @return The number of rows.
+     */
+    [[nodiscard]] inline std::size_t rowCount() const noexcept { return m_rows; }
+
+    /**
+     * @brief Read the values of a column in a block.
+     * @tparam T   Column type - text columns are read as std::string_view.
+     * @param _block   Block index.
+     * @param _column   Column index.
+     * @param _values   Values of the column - the vector is reused.
+     * @return True, if the column has the type and the indexes are valid - otherwise false.
+     * @note This function may throw an exception by std::vector.
+     */
+    template <typename T>
+    [[nodiscard]] bool column( std::size_t _block,
+                               std::size_t _column,
+                               std::vector<T> &_values ) const {
+
+      _values.clear();
+      if ( !isValid( _block, _column, columnar::typeOf<T>() ) ) {
+
+        return false;
+      }
+      const Block &block = m_blocks[ _block ];
+      const BlockColumn &column = block.columns[ _column ];
+      _values.resize( block.rows );
+      if constexpr ( columnar::isText<T> ) {
+
+        for ( std::size_t row = 0; row < block.rows; ++row ) {
+
+          const auto index = read<std::uint32_t>( column.values + row * sizeof( std::uint32_t ) );
+          if ( index >= column.dictionary.size() ) {
+
+            _values.clear();
+            return false;
+          }
+          _values[ row ] = column.dictionary[ index ];
+        }
+      }
+      else if constexpr ( std::is_same_v<T, bool> ) {
+
+        for ( std::size_t row = 0; row < block.rows; ++row ) {
+
+          _values[ row ] = m_data[ column.values + row ] != 0;
+        }
+      }
+      else {
+
+        std::memcpy( _values.data(), m_data.data() + column.values, block.rows * sizeof( T ) );
+      }
+      return true;
+    }
+
+    /**
+     * @brief Read minimum and maximum of a number column in a block, e.g. to skip blocks without matching values.
+     * @tparam T   Column type.
+     * @param _block   Block index.
+     * @param _column   Column index.
+     * @param _min   Minimum of the block.
+     * @param _max   Maximum of the block.
+     * @return True, if the statistics are stored and the column has the type - otherwise false.
+     */
+    template <typename T>
+    [[nodiscard]] bool minMax( std::size_t _block,
+                               std::size_t _column,
+                               T &_min,
+                               T &_max ) const noexcept {
+
+      static_assert( !columnar::isText<T>, "Text columns have no statistics." );
+      if ( !m_statistics || !isValid( _block, _column, columnar::typeOf<T>() ) ) {
+
+        return false;
+      }
+      using Value = std::conditional_t<std::is_same_v<T, bool>, std::uint8_t, T>;
+      const std::size_t statistics = m_blocks[ _block ].columns[ _column ].statistics;
+      _min = static_cast<T>( read<Value>( statistics ) );
+      _max = static_cast<T>( read<Value>( statistics + sizeof( Value ) ) );
+      return true;
+    }
+
+    /**
+     * @brief Convert the columnar file into a csv file, the column names are written as first row.
+     * The rows are appended, if the csv file exists.
+     * @param _filename   Filename for the csv file.
+     * @param _delimiter   Delimiter of values.
+     * @return True, if the conversion is successful - otherwise false.
+     */
+    [[nodiscard]] bool toCSV( std::string_view _filename,
+                              std::string_view _delimiter = "," ) const noexcept;
+
+  private:
+    /**
+     * @brief Type and name of a column.
+     */
+    struct Column {
+
+      /** @brief Column type. */
+      columnar::Type type = columnar::Type::Bool;
+
+      /** @brief Column name. */
+      std::string_view name {};
+    };
+
+    /**
+     * @brief Position of one column in a block.
+     */
+    struct BlockColumn {
+
+      /** @brief Offset of minimum and maximum. */
+      std::size_t statistics = 0;
+
+      /** @brief Offset of the values. */
+      std::size_t values = 0;
+
+      /** @brief Dictionary of a text column. */
+      std::vector<std::string_view> dictionary {};
+    };
+
+    /**
+     * @brief Rows and columns of a block.
+     */
+    struct Block {
+
+      /** @brief Number of rows. */
+      std::size_t rows = 0;
+
+      /** @brief Columns. */
+      std::vector<BlockColumn> columns {};
+    };
+
+    /**
+     * @brief Member if file is read and valid.
+     */
+    bool m_isOpen = false;
+
+    /**
+     * @brief Member if the statistics are stored.
+     */
+    bool m_statistics = false;
+
+    /**
+     * @brief Member for the number of rows.
+     */
+    std::size_t m_rows = 0;
+
+    /**
+     * @brief Member for the content of the file.
+     */
+    std::vector<char> m_data {};
+
+    /**
+     * @brief Member for the columns.
+     */
+    std::vector<Column> m_columns {};
+
+    /**
+     * @brief Member for the blocks.
+     */
+    std::vector<Block> m_blocks {};
+
+    /**
+     * @brief Index header and blocks of the content.
+     * @return True, if the content is a valid columnar file - otherwise false.
+     * @note This function may throw an exception by std::vector.
+     */
+    [[nodiscard]] bool parse();
+
+    /**
+     * @brief Check the indexes and the column type.
+     * @param _block   Block index.
+     * @param _column   Column index.
+     * @param _type   Expected column type.
+     * @return True, if valid - otherwise false.
+     */
+    [[nodiscard]] bool isValid( std::size_t _block,
+                                std::size_t _column,
+                                columnar::Type _type ) const noexcept;
+
+    /**
+     * @brief Format one value as text.
+     * @param _field   Field, which is replaced by the value.
+     * @param _block   Block index.
+     * @param _column   Column index.
+     * @param _row   Row index in the block.
+     * @return True, if the value is valid - otherwise false.
+     * @note This function may throw an exception by std::string.
+     */
+    [[nodiscard]] bool format( std::string &_field,
+                               std::size_t _block,
+                               std::size_t _column,
+                               std::size_t _row ) const;
+
+    /**
+     * @brief Read a number in native byte order.
+     * @tparam T   Type.
+     * @param _offset   Offset in the content.
+     * @return The number.
+     */
+    template <typename T>
+    [[nodiscard]] T read( std::size_t _offset ) const noexcept {
+
+      T value {};
+      std::memcpy( &value, m_data.data() + _offset, sizeof( T ) );
+      return value;
+    }
+  };
+}
@@ -29,6 +29,7 @@
  */
 
 /* c header */
+#include <cstddef> // std::size_t
 #include <cstdint> // std::int32_t
 #include <cstdlib> // std::free
 #ifndef _WIN32
@@ -36,16 +37,22 @@
 #endif
 
 /* stl header */
+#include <array>
 #include <exception>
+#include <iterator>
+#include <limits>
 #include <memory>
+#include <mutex>
 #include <new> // std::bad_alloc
+#include <shared_mutex>
 #include <string>
 #include <string_view>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
+#include <utility> // std::move, std::pair
 #include <vector>
 
-/* re2 header */
-#include <re2/re2.h>
-
 /* local header */
 #include "Demangle.h"
 #include "Logger.h"
@@ -81,38 +88,232 @@ namespace vx::demangle {
     return result;
   }
 
-  std::string simple( const std::string &_name ) {
+  namespace {
+
+    /**
+     * @brief Literal replacement.
+     */
+    struct Replacement {
+
+      /**
+       * @brief Pattern to search for.
+       */
+      std::string_view pattern {};
+
+      /**
+       * @brief Replacement for the pattern.
+       */
+      std::string_view replacement {};
+    };
+
+    /**
+     * @brief Single pass rewriter over a table of literal replacements.
+     * Every character is appended to the output and if the output ends with a pattern, the longest one is replaced.
+     * So a replacement, which forms a new pattern with the preceding output, is handled within the same pass.
+     */
+    class Rewriter {
+
+    public:
+      /**
+       * @brief Constructor for Rewriter.
+       * @tparam N   Size of the table.
+       * @param _table   Replacement table.
+       */
+      template <std::size_t N>
+      explicit Rewriter( const std::array<Replacement, N> &_table )
+        : m_table( std::cbegin( _table ), std::cend( _table ) ) {
+
+        /* Trie over the reversed patterns, so the suffix of the output can be matched */
+        for ( std::size_t index = 0; index < m_table.size(); ++index ) {
+
+          const std::string_view pattern = m_table[ index ].pattern;
+          m_last[ static_cast<unsigned char>( pattern.back() ) ] = true;
+          std::size_t node = 0;
+          for ( auto chr = std::crbegin( pattern ); chr != std::crend( pattern ); ++chr ) {
+
+            std::size_t child = find( node, *chr );
+            if ( child == 0 ) {
+
+              child = m_nodes.size();
+              m_nodes[ node ].children.emplace_back( *chr, child );
+              m_nodes.emplace_back();
+            }
+            node = child;
+          }
+          m_nodes[ node ].replacement = index;
+        }
+      }
+
+      /**
+       * @brief Rewrite the input.
+       * @param _input   Input to rewrite.
+       * @return The rewritten input.
+       */
+      [[nodiscard]] std::string rewrite( std::string_view _input ) const {
+
+        std::string result {};
+        result.reserve( _input.size() );
+        for ( const auto chr : _input ) {
+
+          result.push_back( chr );
+          while ( replaceSuffix( result ) ) {
+
+            /* Check again, the replacement may end with another pattern */
+          }
+        }
+        return result;
+      }
+
+    private:
+      /**
+       * @brief Trie node.
+       */
+      struct Node {
+
+        /**
+         * @brief Children by character.
+         */
+        std::vector<std::pair<char, std::size_t>> children {};
+
+        /**
+         * @brief Index of the replacement ending at this node - or npos.
+         */
+        std::size_t replacement = std::string_view::npos;
+      };
+
+      /**
+       * @brief Member for replacement table.
+       */
+      std::vector<Replacement> m_table {};
+
+      /**
+       * @brief Member for reversed trie nodes, node 0 is the root.
+       */
+      std::vector<Node> m_nodes { Node {} };
+
+      /**
+       * @brief Member for characters, which end a pattern.
+       */
+      std::array<bool, std::numeric_limits<unsigned char>::max() + 1> m_last {};
+
+      /**
+       * @brief Find child of node.
+       * @param _node   Parent node.
+       * @param _chr   Character of child.
+       * @return The child node - otherwise 0.
+       */
+      [[nodiscard]] std::size_t find( std::size_t _node,
+                                      char _chr ) const noexcept {
+
+        for ( const auto &[ chr, child ] : m_nodes[ _node ].children ) {
+
+          if ( chr == _chr ) {
+
+            return child;
+          }
+        }
+        return 0;
+      }
+
+      /**
+       * @brief Replace the longest pattern at the end of the output.
+       * @param _output   Output to check.
+       * @return True, if a pattern was replaced by a non empty replacement - otherwise false.
+       */
+      bool replaceSuffix( std::string &_output ) const {
+
+        if ( !m_last[ static_cast<unsigned char>( _output.back() ) ] ) {
+
+          return false;
+        }
+
+        std::size_t longest = std::string_view::npos;
+        std::size_t node = 0;
+        for ( auto chr = std::crbegin( _output ); chr != std::crend( _output ); ++chr ) {
 
-    std::string result = abi( _name );
+          node = find( node, *chr );
+          if ( node == 0 ) {
 
-    // WINDOWS
-    RE2::GlobalReplace( &result, "class", "" );
-    RE2::GlobalReplace( &result, "struct", "" );
-    RE2::GlobalReplace( &result, "__ptr64", "" );
+            break;
+          }
+          if ( m_nodes[ node ].replacement != std::string_view::npos ) {
 
-    RE2::GlobalReplace( &result, "enum `private: virtual void __cdecl ", "" );
-    RE2::GlobalReplace( &result, " '::`2'", "" );
-    RE2::GlobalReplace( &result, "(void)", "" );
+            longest = m_nodes[ node ].replacement;
+          }
+        }
+        if ( longest == std::string_view::npos ) {
 
-    // LINUX clang and gcc
-    RE2::GlobalReplace( &result, "__cxx11::", "" );
+          return false;
+        }
+
+        const auto &[ pattern, replacement ] = m_table[ longest ];
+        _output.resize( _output.size() - pattern.size() );
+        _output.append( replacement );
+        return !replacement.empty();
+      }
+    };
 
-    // MAC AppleClang
-    RE2::GlobalReplace( &result, "__1::", "" );
+    /** @brief Cleanup for demangled names of all compilers. */
+    constexpr std::array simpleTable {
 
-    // All, after general cleanup
-    RE2::GlobalReplace( &result, "std::basic_string<char, std::char_traits<char>, std::allocator<char> >", "std::string" );
-    RE2::GlobalReplace( &result, "std::basic_string<char, std::char_traits<char>, std::allocator<char>>", "std::string" );
-    RE2::GlobalReplace( &result, "std::basic_string_view<char, std::char_traits<char> >", "std::string_view" );
-    RE2::GlobalReplace( &result, "std::basic_string_view<char, std::char_traits<char>>", "std::string_view" );
+      // WINDOWS
+      Replacement { "class", "" },
+      Replacement { "struct", "" },
+      Replacement { "__ptr64", "" },
+      Replacement { "enum `private: virtual void __cdecl ", "" },
+      Replacement { " '::`2'", "" },
+      Replacement { "(void)", "()" },
 
-    /* Remove space after opening bracket - overall valid */
-    RE2::GlobalReplace( &result, "< ", "<" );
+      // LINUX clang and gcc
+      Replacement { "__cxx11::", "" },
 
-    // Remove space before closing bracket - overall valid
-    RE2::GlobalReplace( &result, ", >", ">" );
-    RE2::GlobalReplace( &result, ",>", ">" );
-    RE2::GlobalReplace( &result, " >", ">" );
+      // MAC AppleClang
+      Replacement { "__1::", "" },
+
+      // All, after general cleanup
+      Replacement { "std::basic_string<char, std::char_traits<char>, std::allocator<char> >", "std::string" },
+      Replacement { "std::basic_string<char, std::char_traits<char>, std::allocator<char>>", "std::string" },
+      Replacement { "std::basic_string_view<char, std::char_traits<char> >", "std::string_view" },
+      Replacement { "std::basic_string_view<char, std::char_traits<char>>", "std::string_view" },
+
+      /* Remove space after opening bracket - overall valid */
+      Replacement { "< ", "<" },
+
+      /* Remove space before closing bracket - overall valid */
+      Replacement { ", >", ">" },
+      Replacement { ",>", ">" },
+      Replacement { " >", ">" }
+    };
+
+    /** @brief Cleanup for extreme() after simple() and cut out. */
+    constexpr std::array extremeTable {
+
+      /* reorder for const type pointer/reference */
+      Replacement { "int const", "const int " },
+      Replacement { "double const", "const double " },
+      Replacement { "char const", "const char " },
+
+      /* Remove space after opening bracket - overall valid */
+      Replacement { "< ", "<" },
+
+      /* Remove space before closing bracket - overall valid */
+      Replacement { ", >", ">" },
+      Replacement { ",>", ">" },
+      Replacement { " >", ">" }
+    };
+
+    /** @brief Remove spaces before commas. */
+    constexpr std::array commaTable { Replacement { " ,", "," } };
+
+    /** @brief Add spaces after commas. */
+    constexpr std::array commaSpaceTable { Replacement { ",", ", " } };
+  }
+
+  std::string simple( const std::string &_name ) {
+
+    static const Rewriter rewriter( simpleTable );
+
+    std::string result = rewriter.rewrite( abi( _name ) );
     result = string_utils::simplified( result );
 
     return result;
@@ -122,6 +323,10 @@ namespace vx::demangle {
 
     using namespace std::literals;
 
+    static const Rewriter rewriter( extremeTable );
+    static const Rewriter commaRewriter( commaTable );
+    static const Rewriter commaSpaceRewriter( commaSpaceTable );
+
     std::string result = simple( _name );
 
     try {
@@ -145,27 +350,37 @@ namespace vx::demangle {
       logFatal() << _exception.what();
     }
 
-    /* reorder for const type pointer/reference */
-    RE2::GlobalReplace( &result, "int const", "const int " );
-    RE2::GlobalReplace( &result, "double const", "const double " );
-    RE2::GlobalReplace( &result, "char const", "const char " );
-
-    /* Remove space after opening bracket - overall valid */
-    RE2::GlobalReplace( &result, "< ", "<" );
-
-    /* Remove space before closing bracket - overall valid */
-    RE2::GlobalReplace( &result, ", >", ">" );
-    RE2::GlobalReplace( &result, ",>", ">" );
-    RE2::GlobalReplace( &result, " >", ">" );
+    result = rewriter.rewrite( result );
     result = string_utils::simplified( result );
 
     /* Try to fix no spaces and comma issues */
-    RE2::GlobalReplace( &result, " ,", "," );
+    result = commaRewriter.rewrite( result );
     if ( result.find( ", " ) == std::string::npos ) {
 
-      RE2::GlobalReplace( &result, ",", ", " );
+      result = commaSpaceRewriter.rewrite( result );
     }
 
     return result;
   }
+
+  std::string_view cached( const std::type_info &_type ) {
+
+    /* Node based container, so the strings are not moved by a rehash */
+    static std::unordered_map<std::type_index, std::string> cache {};
+    static std::shared_mutex mutex {};
+
+    const std::type_index index( _type );
+    {
+      const std::shared_lock<std::shared_mutex> lock( mutex ); // NOSONAR template argument deduction.
+      if ( const auto found = cache.find( index ); found != std::cend( cache ) ) {
+
+        return found->second;
+      }
+    }
+
+    /* Demangle outside of the lock, if two threads race the first one wins */
+    std::string name = extreme( _type.name() );
+    const std::unique_lock<std::shared_mutex> lock( mutex ); // NOSONAR template argument deduction.
+    return cache.try_emplace( index, std::move( name ) ).first->second;
+  }
 }
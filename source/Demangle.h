@@ -30,8 +30,13 @@
 
 #pragma once
 
+/* c header */
+#include <cstddef> // std::size_t
+
 /* stl header */
 #include <string>
+#include <string_view>
+#include <typeinfo>
 
 /**
  * @brief vx (VX APPS) demangle namespace.
@@ -58,4 +63,57 @@ namespace vx::demangle {
    * @return The demangled type information.
    */
   [[nodiscard]] std::string extreme( const std::string &_name );
+
+  /**
+   * @brief Demangle with extreme() once per type and cache the result thread-safe.
+   * @param _type   Type information.
+   * @return The demangled type information, which is valid until the end of the program.
+   * @note This function may throw an exception by the constructor of std::string.
+   */
+  [[nodiscard]] std::string_view cached( const std::type_info &_type );
+
+  /**
+   * @brief Demangle with extreme() once per type and cache the result thread-safe.
+   * After the first call only a static is read, there is no lookup and no lock.
+   * @tparam T   Type.
+   * @return The demangled type information, which is valid until the end of the program.
+   * @note This function may throw an exception by the constructor of std::string.
+   */
+  template <typename T>
+  [[nodiscard]] std::string_view cached() {
+
+    static const std::string_view name = cached( typeid( T ) );
+    return name;
+  }
+
+  /**
+   * @brief Type name at compile time, without any runtime demangling.
+   * @tparam T   Type.
+   * @return The type name as spelled by the compiler - no cleanup like simple() or extreme().
+   * @note The spelling depends on the compiler, e.g. std::string is std::__cxx11::basic_string<char> for gcc.
+   */
+  template <typename T>
+  [[nodiscard]] constexpr std::string_view typeName() noexcept {
+
+#if defined __clang__ || defined __GNUC__
+    constexpr std::string_view function = __PRETTY_FUNCTION__;
+    constexpr std::string_view prefix = "T = ";
+    const std::size_t start = function.find( prefix ) + prefix.size();
+    std::size_t end = function.find( ';', start );
+    if ( end == std::string_view::npos ) {
+
+      end = function.rfind( ']' );
+    }
+#elif defined _MSC_VER
+    constexpr std::string_view function = __FUNCSIG__;
+    constexpr std::string_view prefix = "typeName<";
+    const std::size_t start = function.find( prefix ) + prefix.size();
+    const std::size_t end = function.rfind( ">(void)" );
+#else
+    constexpr std::string_view function {};
+    constexpr std::size_t start = 0;
+    constexpr std::size_t end = 0;
+#endif
+    return function.substr( start, end - start );
+  }
 }
@@ -29,69 +29,1013 @@
  */
 
 /* c header */
+#include <cerrno>
+#include <cstddef> // std::size_t
 #include <cstdint> // std::int32_t
-#include <cstdio> // std::gets, std::FILE, pclose, popen
+#include <cstdio> // std::fgets, std::FILE, _pclose, _popen
 
 /* system header */
 #ifndef _MSC_VER
-  #include <sys/wait.h>
+  #include <fcntl.h> // fcntl, O_CLOEXEC, splice, tee
+  #include <poll.h>
+  #include <signal.h> // pthread_sigmask, sigset_t, sigtimedwait, SIGPIPE
+  #include <spawn.h>
+  #include <sys/resource.h> // rusage
+  #include <sys/wait.h> // wait4
+  #include <unistd.h> // close, pipe, read
 #endif
 
 /* stl header */
+#include <algorithm>
 #include <array>
-#include <iostream>
+#include <chrono>
+#include <limits>
 #include <memory>
 #include <string>
+#include <system_error>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 /* local header */
 #include "Exec.h"
+#include "Logger.h"
+
+#ifndef _MSC_VER
+/** @brief Environment of the current process for posix_spawn. */
+extern char **environ; // NOSONAR declared by POSIX without a header.
+#endif
 
 namespace vx::exec {
 
+#ifdef _MSC_VER
+  /** @brief Buffer size to read stdout. */
+  constexpr std::int32_t bufferSize = 128;
+#else
+  /** @brief Buffer size to read the pipes - the default pipe capacity of Linux. */
+  constexpr std::size_t pipeBufferSize = 65536;
+
+  /** @brief Exit code offset of a child terminated by a signal, like the shell reports it. */
+  constexpr std::int32_t signalOffset = 128;
+
+  /** @brief Interval in milliseconds to check a command again, which closed its pipes, but still runs. */
+  constexpr int reapInterval = 10;
+
   namespace {
 
-    /** @brief Global result of executable. */
-    std::int32_t m_resultCode = 0; // NOSONAR const is not possible here.
+    /**
+     * @brief Are both pipes of a process closed?
+     * @param _process   Process.
+     * @return True, if both pipes are closed - otherwise false.
+     */
+    bool pipesClosed( const Process &_process ) noexcept {
+
+      return _process.descriptor( Stream::Output ) < 0 && _process.descriptor( Stream::Error ) < 0;
+    }
+
+    /**
+     * @brief Log the error of a failed function.
+     * @param _function   Failed function.
+     * @param _program   Program of the child.
+     * @param _error   Error number.
+     */
+    void logFailure( const std::string &_function,
+                     const std::string &_program,
+                     int _error ) {
+
+      logError() << _function << "failed for" << _program << "Error:" << std::error_code( _error, std::generic_category() ).message();
+    }
+
+    /**
+     * @brief Create a pipe, which is not inherited by children.
+     * Without O_CLOEXEC at creation, a child spawned by another thread could inherit the write end and delay the end of file.
+     * @param _pipe   Read and write end.
+     * @return True, if the pipe is created - otherwise false.
+     */
+    bool createPipe( std::array<int, 2> &_pipe ) noexcept {
+
+  #ifdef __linux__
+      return ::pipe2( _pipe.data(), O_CLOEXEC ) == 0;
+  #else
+      if ( ::pipe( _pipe.data() ) != 0 ) {
+
+        return false;
+      }
+      ::fcntl( _pipe[ 0 ], F_SETFD, FD_CLOEXEC );
+      ::fcntl( _pipe[ 1 ], F_SETFD, FD_CLOEXEC );
+      return true;
+  #endif
+    }
+
+    /**
+     * @brief Close a descriptor, if it is valid.
+     * @param _descriptor   Descriptor to close - set to -1.
+     */
+    void closeDescriptor( int &_descriptor ) noexcept {
+
+      if ( _descriptor >= 0 ) {
+
+        ::close( _descriptor );
+        _descriptor = -1;
+      }
+    }
+
+    /**
+     * @brief Wait for the events of descriptors.
+     * @param _descriptors   Descriptors to wait for - negative descriptors are ignored.
+     * @param _timeout   Timeout in milliseconds - negative to wait without timeout.
+     * @return True, if poll() returned or was interrupted - false on failure.
+     */
+    bool waitEvents( std::vector<pollfd> &_descriptors,
+                       int _timeout ) noexcept {
+
+      for ( pollfd &descriptor : _descriptors ) {
+
+        descriptor.revents = 0;
+      }
+      return ::poll( _descriptors.data(), _descriptors.size(), _timeout ) >= 0 || errno == EINTR;
+    }
+
+  #ifdef __linux__
+    /**
+     * @brief Observed connection from stdout of a stage through the current process.
+     */
+    struct Tap {
+
+      /** @brief Read end of the pipe from stdout of the stage. */
+      int source = -1;
+
+      /** @brief Stdin of the next stage or the output of the pipeline. */
+      int target = -1;
+
+      /** @brief Is the target closed at the end? */
+      bool ownsTarget = true;
+
+      /** @brief Pipe for the duplicated data. */
+      std::array<int, 2> copy { -1, -1 };
+
+      /** @brief Bytes duplicated, but not moved to the target yet. */
+      std::size_t pending = 0;
+    };
+
+    /**
+     * @brief Set a descriptor to non-blocking.
+     * @param _descriptor   Descriptor.
+     */
+    void setNonBlocking( int _descriptor ) noexcept { ::fcntl( _descriptor, F_SETFL, ::fcntl( _descriptor, F_GETFL ) | O_NONBLOCK ); }
+
+    /**
+     * @brief Block SIGPIPE of the current thread, while the taps write to stages, which might be gone.
+     */
+    class SigPipeBlocker {
+
+    public:
+      /**
+       * @brief Block SIGPIPE, if there is a tap.
+       * @param _active   Is there a tap?
+       */
+      explicit SigPipeBlocker( bool _active ) noexcept
+        : m_active( _active ) {
+
+        if ( !m_active ) {
+
+          return;
+        }
+        sigset_t pipe {};
+        ::sigemptyset( &pipe );
+        ::sigaddset( &pipe, SIGPIPE );
+        sigset_t pending {};
+        ::sigpending( &pending );
+        m_pending = ::sigismember( &pending, SIGPIPE ) == 1;
+        ::pthread_sigmask( SIG_BLOCK, &pipe, &m_previous );
+      }
+
+      /**
+       * @brief Delete copy constructor.
+       */
+      SigPipeBlocker( const SigPipeBlocker & ) = delete;
+
+      /**
+       * @brief Delete copy assign.
+       * @return Nothing.
+       */
+      SigPipeBlocker &operator=( const SigPipeBlocker & ) = delete;
+
+      /**
+       * @brief Consume SIGPIPE raised by the taps and restore the signal mask.
+       */
+      ~SigPipeBlocker() noexcept {
+
+        if ( !m_active ) {
+
+          return;
+        }
+        if ( !m_pending ) {
+
+          sigset_t pipe {};
+          ::sigemptyset( &pipe );
+          ::sigaddset( &pipe, SIGPIPE );
+          const timespec immediately {};
+          while ( ::sigtimedwait( &pipe, nullptr, &immediately ) == -1 && errno == EINTR ) {}
+        }
+        ::pthread_sigmask( SIG_SETMASK, &m_previous, nullptr );
+      }
+
+    private:
+      /** @brief Member for the state. */
+      bool m_active = false;
+
+      /** @brief Member for SIGPIPE pending before. */
+      bool m_pending = false;
+
+      /** @brief Member for the previous signal mask. */
+      sigset_t m_previous {};
+    };
+
+    /**
+     * @brief Close the descriptors of a tap.
+     * @param _tap   Tap to close.
+     */
+    void closeTap( Tap &_tap ) noexcept {
+
+      closeDescriptor( _tap.source );
+      if ( _tap.ownsTarget ) {
+
+        closeDescriptor( _tap.target );
+      }
+      _tap.target = -1;
+      closeDescriptor( _tap.copy[ 0 ] );
+      closeDescriptor( _tap.copy[ 1 ] );
+      _tap.pending = 0;
+    }
+
+    /**
+     * @brief Duplicate the available data of a tap with tee() for the tap function and move it to the target with splice().
+     * @param _tap   Tap.
+     * @param _buffer   Read buffer for the duplicated data.
+     * @param _function   Tap function.
+     * @note This function may throw an exception by the tap function.
+     */
+    void transfer( Tap &_tap,
+                   std::vector<char> &_buffer,
+                   const Pipeline::TapFunction &_function ) {
+
+      if ( _tap.pending == 0 ) {
+
+        const ssize_t size = ::tee( _tap.source, _tap.copy[ 1 ], _buffer.size(), SPLICE_F_NONBLOCK );
+        if ( size == 0 ) {
+
+          /* End of file, the target gets it too. */
+          closeTap( _tap );
+          return;
+        }
+        if ( size < 0 ) {
+
+          if ( errno != EAGAIN && errno != EINTR ) {
+
+            logFailure( "tee()", "Pipeline", errno );
+            closeTap( _tap );
+          }
+          return;
+        }
+        _tap.pending = static_cast<std::size_t>( size );
+        std::size_t copied = 0;
+        while ( copied < _tap.pending ) {
+
+          const ssize_t read = ::read( _tap.copy[ 0 ], _buffer.data(), std::min( _buffer.size(), _tap.pending - copied ) );
+          if ( read <= 0 ) {
+
+            if ( read < 0 && errno == EINTR ) {
+
+              continue;
+            }
+            break;
+          }
+          copied += static_cast<std::size_t>( read );
+          _function( std::string_view( _buffer.data(), static_cast<std::size_t>( read ) ) );
+        }
+      }
+      const ssize_t moved = ::splice( _tap.source, nullptr, _tap.target, nullptr, _tap.pending, SPLICE_F_MOVE | SPLICE_F_NONBLOCK );
+      if ( moved > 0 ) {
+
+        _tap.pending -= static_cast<std::size_t>( moved );
+      }
+      else if ( moved < 0 && errno != EAGAIN && errno != EINTR ) {
+
+        /* The next stage is gone, the stage gets SIGPIPE like in a direct connection. */
+        closeTap( _tap );
+      }
+    }
+  #endif
+
+    /**
+     * @brief Convert a time of the resource usage.
+     * @param _time   Time of the resource usage.
+     * @return The time in microseconds.
+     */
+    std::chrono::microseconds toMicroseconds( const timeval &_time ) noexcept { return std::chrono::seconds( _time.tv_sec ) + std::chrono::microseconds( _time.tv_usec ); }
+
+    /**
+     * @brief Run a process.
+     * @param _process   Process to run.
+     * @return The result of the process - the exit code is -1, if the process is not started.
+     * @note This function may throw an exception by std::vector or std::string.
+     */
+    Result runProcess( Process &_process ) {
+
+      if ( !_process.start() ) {
+
+        return {};
+      }
+      std::ignore = _process.wait();
+      return _process.takeResult();
+    }
   }
 
-  /** @brief Buffer size to read stdout. */
-  constexpr std::int32_t bufferSize = 128;
+  Process::Process( std::vector<std::string> _arguments ) noexcept
+    : m_arguments( std::move( _arguments ) ) {}
 
-  void close( std::FILE *_file ) noexcept {
+  Process::~Process() noexcept {
 
-#ifdef _MSC_VER
-    m_resultCode = _pclose( _file );
-#else
-    m_resultCode = pclose( _file );
-#endif
-#ifndef _MSC_VER
-    if ( WIFEXITED( m_resultCode ) ) {
+    /* A child blocked by a full pipe gets SIGPIPE and ends. */
+    closePipes();
+    std::ignore = reap( 0 );
+  }
 
-      m_resultCode = WEXITSTATUS( m_resultCode );
+  bool Process::start() {
+
+    if ( m_id != -1 || m_arguments.empty() ) {
+
+      return false;
     }
-#endif
+    std::vector<char *> arguments {};
+    arguments.reserve( m_arguments.size() + 1 );
+    for ( std::string &argument : m_arguments ) {
+
+      arguments.push_back( argument.data() );
+    }
+    arguments.push_back( nullptr );
+
+    m_result = {};
+    m_start = std::chrono::steady_clock::now();
+    std::array<int, 2> output { -1, -1 };
+    std::array<int, 2> error { -1, -1 };
+    if ( ( m_outputTarget < 0 && !createPipe( output ) ) || ( m_captureError && !createPipe( error ) ) ) {
+
+      logFailure( "pipe()", m_arguments.front(), errno );
+      closeDescriptor( output[ 0 ] );
+      closeDescriptor( output[ 1 ] );
+      return false;
+    }
+
+    posix_spawn_file_actions_t actions {};
+    ::posix_spawn_file_actions_init( &actions );
+    if ( m_input >= 0 ) {
+
+      ::posix_spawn_file_actions_adddup2( &actions, m_input, STDIN_FILENO );
+    }
+    ::posix_spawn_file_actions_adddup2( &actions, m_outputTarget >= 0 ? m_outputTarget : output[ 1 ], STDOUT_FILENO );
+    if ( m_captureError ) {
+
+      ::posix_spawn_file_actions_adddup2( &actions, error[ 1 ], STDERR_FILENO );
+    }
+
+    /* The child starts with no blocked signals and the default action of SIGPIPE, even if the current process changed them. */
+    posix_spawnattr_t attributes {};
+    ::posix_spawnattr_init( &attributes );
+    sigset_t signals {};
+    sigemptyset( &signals );
+    ::posix_spawnattr_setsigmask( &attributes, &signals );
+    sigaddset( &signals, SIGPIPE );
+    ::posix_spawnattr_setsigdefault( &attributes, &signals );
+    int flags = POSIX_SPAWN_SETSIGMASK | POSIX_SPAWN_SETSIGDEF;
+    if ( m_processGroup ) {
+
+      ::posix_spawnattr_setpgroup( &attributes, 0 );
+      flags |= POSIX_SPAWN_SETPGROUP;
+    }
+    ::posix_spawnattr_setflags( &attributes, static_cast<short>( flags ) );
+
+    const int result = ::posix_spawnp( &m_id, arguments.front(), &actions, &attributes, arguments.data(), environ );
+    ::posix_spawnattr_destroy( &attributes );
+    ::posix_spawn_file_actions_destroy( &actions );
+    closeDescriptor( output[ 1 ] );
+    closeDescriptor( error[ 1 ] );
+    m_outputDescriptor = output[ 0 ];
+    m_errorDescriptor = error[ 0 ];
+    if ( result != 0 ) {
+
+      m_id = -1;
+      closePipes();
+      logFailure( "posix_spawnp()", m_arguments.front(), result );
+      return false;
+    }
+    return true;
   }
 
-  std::string run( const std::string &_command ) {
+  std::int32_t Process::wait() {
 
-    std::array<char, bufferSize> buffer {};
-    std::string result {};
-#ifdef _MSC_VER
-    const std::unique_ptr<FILE, decltype( &close )> pipe( _popen( _command.c_str(), "r" ), &close );
-#else
-    const std::unique_ptr<std::FILE, decltype( &close )> pipe( popen( _command.c_str(), "r" ), &close );
+    if ( m_id == -1 ) {
+
+      return -1;
+    }
+    std::vector<char> buffer( pipeBufferSize );
+    std::vector<pollfd> descriptors { { m_outputDescriptor, POLLIN, 0 }, { m_errorDescriptor, POLLIN, 0 } };
+    constexpr std::array<Stream, 2> streams { Stream::Output, Stream::Error };
+
+    /* Both pipes are read, so the child never blocks on one of them. */
+    while ( descriptors[ 0 ].fd >= 0 || descriptors[ 1 ].fd >= 0 ) {
+
+      if ( !waitEvents( descriptors, -1 ) ) {
+
+        logFailure( "poll()", m_arguments.front(), errno );
+        break;
+      }
+      for ( std::size_t index = 0; index < descriptors.size(); ++index ) {
+
+        if ( descriptors[ index ].fd >= 0 && descriptors[ index ].revents != 0 && read( streams[ index ], buffer ).empty() ) {
+
+          descriptors[ index ].fd = -1;
+        }
+      }
+    }
+    return finish();
+  }
+
+  std::string_view Process::read( Stream _stream,
+                                  std::vector<char> &_buffer ) {
+
+    int &descriptor = _stream == Stream::Output ? m_outputDescriptor : m_errorDescriptor;
+    if ( descriptor < 0 ) {
+
+      return {};
+    }
+    ssize_t size = 0;
+    do {
+
+      size = ::read( descriptor, _buffer.data(), _buffer.size() );
+    } while ( size < 0 && errno == EINTR );
+    if ( size <= 0 ) {
+
+      closeDescriptor( descriptor );
+      return {};
+    }
+    const std::string_view data( _buffer.data(), static_cast<std::size_t>( size ) );
+    if ( m_keepOutput ) {
+
+      std::string &output = _stream == Stream::Output ? m_result.output : m_result.error;
+
+      /* Reserve ahead, so large outputs are not copied for every chunk. */
+      if ( output.capacity() - output.size() < data.size() ) {
+
+        output.reserve( std::max( output.capacity() * 2, output.size() + pipeBufferSize ) );
+      }
+      output.append( data );
+    }
+    return data;
+  }
+
+  bool Process::kill( int _signal ) const noexcept {
+
+    if ( m_id == -1 ) {
+
+      return false;
+    }
+    return ::kill( m_processGroup ? -m_id : m_id, _signal ) == 0;
+  }
+
+  std::int32_t Process::finish() noexcept {
+
+    closePipes();
+    return reap( 0 ).value_or( -1 );
+  }
+
+  bool Process::tryFinish() noexcept {
+
+    closePipes();
+    return reap( WNOHANG ).has_value();
+  }
+
+  void Process::closePipes() noexcept {
+
+    closeDescriptor( m_outputDescriptor );
+    closeDescriptor( m_errorDescriptor );
+  }
+
+  std::optional<std::int32_t> Process::reap( int _options ) noexcept {
+
+    if ( m_id == -1 ) {
+
+      return -1;
+    }
+    int status = 0;
+    rusage usage {};
+    pid_t result = 0;
+    do {
+
+      result = ::wait4( m_id, &status, _options, &usage );
+    } while ( result < 0 && errno == EINTR );
+    if ( result == 0 ) {
+
+      return {};
+    }
+    m_id = -1;
+    if ( result < 0 ) {
+
+      return -1;
+    }
+    m_result.duration = std::chrono::steady_clock::now() - m_start;
+    m_result.userTime = toMicroseconds( usage.ru_utime );
+    m_result.systemTime = toMicroseconds( usage.ru_stime );
+  #ifdef __APPLE__
+    m_result.maxResidentSize = usage.ru_maxrss;
+  #else
+    /* Linux reports kilobytes. */
+    m_result.maxResidentSize = static_cast<std::int64_t>( usage.ru_maxrss ) * 1024;
+  #endif
+    if ( WIFEXITED( status ) ) {
+
+      m_result.exitCode = WEXITSTATUS( status );
+    }
+    else if ( WIFSIGNALED( status ) ) {
+
+      m_result.signal = WTERMSIG( status );
+      m_result.exitCode = signalOffset + m_result.signal;
+    }
+    return m_result.exitCode;
+  }
+
+  Pool::Pool( std::size_t _parallel ) noexcept
+    : m_parallel( std::max<std::size_t>( _parallel, 1 ) ) {
+
+    if ( !createPipe( m_wake ) ) {
+
+      logFailure( "pipe()", "Pool", errno );
+    }
+    for ( const int descriptor : m_wake ) {
+
+      if ( descriptor >= 0 ) {
+
+        ::fcntl( descriptor, F_SETFL, ::fcntl( descriptor, F_GETFL ) | O_NONBLOCK );
+      }
+    }
+  }
+
+  Pool::~Pool() noexcept {
+
+    for ( int &descriptor : m_wake ) {
+
+      closeDescriptor( descriptor );
+    }
+  }
+
+  std::size_t Pool::add( std::vector<std::string> _arguments,
+                         std::chrono::milliseconds _timeout ) {
+
+    m_commands.push_back( { std::move( _arguments ), _timeout, false } );
+    return m_commands.size() - 1;
+  }
+
+  void Pool::cancel( std::size_t _index ) noexcept {
+
+    try {
+
+      const std::lock_guard<std::mutex> lock( m_mutex );
+      m_cancelled.push_back( _index );
+    }
+    catch ( const std::exception &_exception ) { // NOSONAR fallback for every exeption.
+
+      logFatal() << _exception.what();
+    }
+    std::ignore = ::write( m_wake[ 1 ], "c", 1 );
+  }
+
+  void Pool::cancel() noexcept {
+
+    {
+      const std::lock_guard<std::mutex> lock( m_mutex );
+      m_cancelAll = true;
+    }
+    std::ignore = ::write( m_wake[ 1 ], "c", 1 );
+  }
+
+  std::vector<Result> Pool::run() {
+
+    try {
+
+      return runCommands();
+    }
+    catch ( ... ) {
+
+      /* Otherwise the destructors of the processes wait for running children and the next run() repeats every command. */
+      reset();
+      throw;
+    }
+  }
+
+  std::vector<Result> Pool::runCommands() {
+
+    std::vector<char> buffer( pipeBufferSize );
+    std::vector<pollfd> descriptors {};
+    std::size_t next = 0;
+    constexpr std::array<Stream, 2> streams { Stream::Output, Stream::Error };
+    while ( true ) {
+
+      applyCancel();
+      for ( Running &running : m_running ) {
+
+        if ( m_commands[ running.index ].cancelled ) {
+
+          finish( running, false );
+        }
+      }
+      removeFinished();
+
+      /* Start waiting commands, cancelled commands are finished without a start. */
+      while ( m_running.size() < m_parallel && next < m_commands.size() ) {
+
+        const std::size_t index = next++;
+        if ( m_commands[ index ].cancelled ) {
+
+          store( index, {} );
+          continue;
+        }
+        auto process = std::make_unique<Process>( m_commands[ index ].arguments );
+        process->setKeepOutput( m_keepOutput );
+        process->setProcessGroup( true );
+        if ( !process->start() ) {
+
+          store( index, {} );
+          continue;
+        }
+        const auto timeout = m_commands[ index ].timeout;
+        m_running.push_back( { index, std::move( process ), timeout > std::chrono::milliseconds::zero() ? std::chrono::steady_clock::now() + timeout : std::chrono::steady_clock::time_point::max() } );
+      }
+      if ( m_running.empty() && next == m_commands.size() ) {
+
+        break;
+      }
+
+      /* The first descriptor wakes for cancel requests, then two descriptors follow for every running command. */
+      descriptors.assign( 1, { m_wake[ 0 ], POLLIN, 0 } );
+      auto deadline = std::chrono::steady_clock::time_point::max();
+      for ( const Running &running : m_running ) {
+
+        descriptors.push_back( { running.process->descriptor( Stream::Output ), POLLIN, 0 } );
+        descriptors.push_back( { running.process->descriptor( Stream::Error ), POLLIN, 0 } );
+        deadline = std::min( deadline, running.deadline );
+      }
+      int timeout = -1;
+      if ( deadline != std::chrono::steady_clock::time_point::max() ) {
+
+        const auto remaining = std::chrono::ceil<std::chrono::milliseconds>( deadline - std::chrono::steady_clock::now() ).count();
+        timeout = static_cast<int>( std::clamp<std::chrono::milliseconds::rep>( remaining, 0, std::numeric_limits<int>::max() ) );
+      }
+
+      /* A command, which closed its pipes, but still runs, is checked again after an interval. */
+      if ( std::any_of( std::begin( m_running ), std::end( m_running ), []( const Running &_running ) { return pipesClosed( *_running.process ); } ) ) {
+
+        timeout = timeout < 0 ? reapInterval : std::min( timeout, reapInterval );
+      }
+      if ( !waitEvents( descriptors, timeout ) ) {
+
+        logFailure( "poll()", "Pool", errno );
+        break;
+      }
+      if ( descriptors[ 0 ].revents != 0 ) {
+
+        std::array<char, 64> drain {};
+        while ( ::read( m_wake[ 0 ], drain.data(), drain.size() ) > 0 ) {}
+      }
+
+      const auto now = std::chrono::steady_clock::now();
+      for ( std::size_t index = 0; index < m_running.size(); ++index ) {
+
+        Running &running = m_running[ index ];
+        for ( std::size_t stream = 0; stream < streams.size(); ++stream ) {
+
+          if ( descriptors[ 1 + index * 2 + stream ].revents == 0 ) {
+
+            continue;
+          }
+          const std::string_view data = running.process->read( streams[ stream ], buffer );
+          if ( !data.empty() && m_outputFunction ) {
+
+            m_outputFunction( running.index, streams[ stream ], data );
+          }
+        }
+        /* A command, which closed its pipes, is finished without waiting, it may still run until its deadline. */
+        if ( pipesClosed( *running.process ) && running.process->tryFinish() ) {
+
+          finish( running, false );
+        }
+        else if ( now >= running.deadline ) {
+
+          finish( running, true );
+        }
+      }
+      removeFinished();
+    }
+    m_commands.clear();
+    return std::move( m_results );
+  }
+
+  void Pool::reset() noexcept {
+
+    for ( Running &running : m_running ) {
+
+      if ( running.process ) {
+
+        running.process->kill();
+        std::ignore = running.process->finish();
+      }
+    }
+    m_running.clear();
+    m_commands.clear();
+    m_results.clear();
+    const std::lock_guard<std::mutex> lock( m_mutex );
+    m_cancelled.clear();
+    m_cancelAll = false;
+  }
+
+  void Pool::removeFinished() noexcept {
+
+    m_running.erase( std::remove_if( std::begin( m_running ), std::end( m_running ), []( const Running &_running ) { return !_running.process; } ), std::end( m_running ) );
+  }
+
+  void Pool::applyCancel() noexcept {
+
+    const std::lock_guard<std::mutex> lock( m_mutex );
+    for ( const std::size_t index : m_cancelled ) {
+
+      if ( index < m_commands.size() ) {
+
+        m_commands[ index ].cancelled = true;
+      }
+    }
+    m_cancelled.clear();
+    if ( m_cancelAll ) {
+
+      for ( Command &command : m_commands ) {
+
+        command.cancelled = true;
+      }
+      m_cancelAll = false;
+    }
+  }
+
+  void Pool::finish( Running &_running,
+                     bool _timedOut ) {
+
+    /* A killed command is not read to its end, children of it could keep the pipes open. */
+    if ( _timedOut || m_commands[ _running.index ].cancelled ) {
+
+      _running.process->kill();
+    }
+    std::ignore = _running.process->finish();
+    Result result = _running.process->takeResult();
+    result.timedOut = _timedOut;
+    _running.process.reset();
+    store( _running.index, std::move( result ) );
+  }
+
+  void Pool::store( std::size_t _index,
+                    Result &&_result ) {
+
+    if ( m_results.size() < m_commands.size() ) {
+
+      m_results.resize( m_commands.size() );
+    }
+    m_results[ _index ] = std::move( _result );
+    if ( m_finishFunction ) {
+
+      m_finishFunction( _index, m_results[ _index ] );
+    }
+  }
+
+  std::size_t Pipeline::add( std::vector<std::string> _arguments ) {
+
+    m_stages.push_back( std::move( _arguments ) );
+    return m_stages.size() - 1;
+  }
+
+  #ifdef __linux__
+  void Pipeline::setTap( std::size_t _stage,
+                         TapFunction _function ) {
+
+    if ( m_taps.size() <= _stage ) {
+
+      m_taps.resize( _stage + 1 );
+    }
+    m_taps[ _stage ] = std::move( _function );
+  }
+  #endif
+
+  std::vector<Result> Pipeline::run() {
+
+    const std::size_t count = m_stages.size();
+    std::vector<Result> results( count );
+    if ( count == 0 ) {
+
+      return results;
+    }
+    m_taps.resize( count );
+
+    /* Descriptors of stdin and stdout of every stage, the ends of the children are closed after every start. */
+    std::vector<int> inputs( count, -1 );
+    std::vector<int> outputs( count, -1 );
+    std::vector<int> childEnds {};
+    inputs.front() = m_input;
+    outputs.back() = m_output;
+  #ifdef __linux__
+    std::vector<Tap> taps( count );
+  #endif
+    bool connected = true;
+    for ( std::size_t stage = 0; stage < count && connected; ++stage ) {
+
+      const bool last = stage + 1 == count;
+  #ifdef __linux__
+      if ( m_taps[ stage ] && ( !last || m_output >= 0 ) ) {
+
+        Tap &tap = taps[ stage ];
+        std::array<int, 2> source { -1, -1 };
+        std::array<int, 2> target { -1, -1 };
+        if ( !createPipe( source ) || !createPipe( tap.copy ) || ( !last && !createPipe( target ) ) ) {
+
+          closeDescriptor( source[ 0 ] );
+          closeDescriptor( source[ 1 ] );
+          connected = false;
+          break;
+        }
+        outputs[ stage ] = source[ 1 ];
+        childEnds.push_back( source[ 1 ] );
+        tap.source = source[ 0 ];
+        if ( last ) {
+
+          tap.target = m_output;
+          tap.ownsTarget = false;
+        }
+        else {
+
+          inputs[ stage + 1 ] = target[ 0 ];
+          childEnds.push_back( target[ 0 ] );
+          tap.target = target[ 1 ];
+          setNonBlocking( tap.target );
+        }
+        setNonBlocking( tap.source );
+        setNonBlocking( tap.copy[ 0 ] );
+        setNonBlocking( tap.copy[ 1 ] );
+        continue;
+      }
+  #endif
+      if ( !last ) {
+
+        std::array<int, 2> direct { -1, -1 };
+        if ( !createPipe( direct ) ) {
+
+          connected = false;
+          break;
+        }
+        outputs[ stage ] = direct[ 1 ];
+        inputs[ stage + 1 ] = direct[ 0 ];
+        childEnds.push_back( direct[ 0 ] );
+        childEnds.push_back( direct[ 1 ] );
+      }
+    }
+
+    std::vector<std::unique_ptr<Process>> processes {};
+    if ( connected ) {
+
+      for ( std::size_t stage = 0; stage < count; ++stage ) {
+
+        processes.push_back( std::make_unique<Process>( m_stages[ stage ] ) );
+        processes.back()->setInput( inputs[ stage ] );
+        processes.back()->setOutput( outputs[ stage ] );
+        std::ignore = processes.back()->start();
+      }
+    }
+    else {
+
+      logFailure( "pipe()", "Pipeline", errno );
+    }
+    for ( int &descriptor : childEnds ) {
+
+      closeDescriptor( descriptor );
+    }
+
+    /* Stderr of every stage, stdout of the last stage and the taps are multiplexed until everything is closed. */
+  #ifdef __linux__
+    const SigPipeBlocker blocker( std::any_of( taps.cbegin(), taps.cend(), []( const Tap &_tap ) { return _tap.source >= 0; } ) );
+  #endif
+    std::vector<char> buffer( pipeBufferSize );
+    std::vector<pollfd> descriptors {};
+    std::vector<std::pair<std::size_t, Stream>> streams {};
+    while ( true ) {
+
+      descriptors.clear();
+      streams.clear();
+      for ( std::size_t stage = 0; stage < processes.size(); ++stage ) {
+
+        for ( const Stream stream : { Stream::Output, Stream::Error } ) {
+
+          if ( processes[ stage ]->descriptor( stream ) >= 0 ) {
+
+            descriptors.push_back( { processes[ stage ]->descriptor( stream ), POLLIN, 0 } );
+            streams.emplace_back( stage, stream );
+          }
+        }
+      }
+  #ifdef __linux__
+      const std::size_t firstTap = descriptors.size();
+      std::vector<std::size_t> tapStages {};
+      for ( std::size_t stage = 0; stage < count; ++stage ) {
+
+        if ( taps[ stage ].source >= 0 ) {
+
+          descriptors.push_back( taps[ stage ].pending == 0 ? pollfd { taps[ stage ].source, POLLIN, 0 } : pollfd { taps[ stage ].target, POLLOUT, 0 } );
+          tapStages.push_back( stage );
+        }
+      }
+  #endif
+      if ( descriptors.empty() ) {
+
+        break;
+      }
+      if ( !waitEvents( descriptors, -1 ) ) {
+
+        logFailure( "poll()", "Pipeline", errno );
+        break;
+      }
+      for ( std::size_t index = 0; index < streams.size(); ++index ) {
+
+        if ( descriptors[ index ].revents == 0 ) {
+
+          continue;
+        }
+        const auto [ stage, stream ] = streams[ index ];
+        const std::string_view data = processes[ stage ]->read( stream, buffer );
+        if ( !data.empty() && stream == Stream::Output && m_taps[ stage ] ) {
+
+          m_taps[ stage ]( data );
+        }
+      }
+  #ifdef __linux__
+      for ( std::size_t index = 0; index < tapStages.size(); ++index ) {
+
+        if ( descriptors[ firstTap + index ].revents != 0 ) {
+
+          transfer( taps[ tapStages[ index ] ], buffer, m_taps[ tapStages[ index ] ] );
+        }
+      }
+  #endif
+    }
+
+    for ( std::size_t stage = 0; stage < processes.size(); ++stage ) {
+
+      std::ignore = processes[ stage ]->finish();
+      results[ stage ] = processes[ stage ]->takeResult();
+    }
+  #ifdef __linux__
+    for ( Tap &tap : taps ) {
+
+      closeTap( tap );
+    }
+  #endif
+    return results;
+  }
 #endif
+
+  Result run( const std::string &_command ) {
+
+#ifdef _MSC_VER
+    const auto start = std::chrono::steady_clock::now();
+    std::array<char, bufferSize> buffer {};
+    Result result {};
+    FILE *pipe = _popen( _command.c_str(), "r" );
     if ( !pipe ) {
 
-      std::cout << "popen() failed for " << _command << std::endl;
-      return {};
+      logError() << "_popen() failed for" << _command;
+      return result;
     }
-    while ( std::fgets( buffer.data(), static_cast<int>( buffer.size() ), pipe.get() ) != nullptr ) {
+    while ( std::fgets( buffer.data(), static_cast<int>( buffer.size() ), pipe ) != nullptr ) {
 
-      result += buffer.data();
+      result.output += buffer.data();
     }
+    result.exitCode = _pclose( pipe );
+    result.duration = std::chrono::steady_clock::now() - start;
     return result;
+#else
+    /* The shell is kept for redirections in the command. */
+    Process process( { "/bin/sh", "-c", _command } );
+    return runProcess( process );
+#endif
   }
 
-  std::int32_t resultCode() noexcept { return m_resultCode; }
+#ifndef _MSC_VER
+  Result run( const std::vector<std::string> &_arguments ) {
+
+    Process process( _arguments );
+    return runProcess( process );
+  }
+#endif
 }
@@ -31,11 +31,26 @@
 #pragma once
 
 /* c header */
-#include <cstdint> // std::int32_t
-#include <cstdio> // std::FILE
+#include <csignal> // SIGKILL
+#include <cstddef> // std::size_t
+#include <cstdint> // std::int32_t, std::int64_t
+
+/* system header */
+#ifndef _MSC_VER
+  #include <sys/types.h> // pid_t
+#endif
 
 /* stl header */
+#include <array>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <utility> // std::move
+#include <vector>
 
 /**
  * @brief vx (VX APPS) exec namespace.
@@ -43,21 +58,590 @@
 namespace vx::exec {
 
   /**
-   * @brief Overload for close.
-   * @param _file   File handle to close.
+   * @brief Result of one command.
+   */
+  struct Result {
+
+    /** @brief Exit code of the command, 128 plus the signal number, if it is terminated by a signal - -1 if it is not started. */
+    std::int32_t exitCode = -1;
+
+    /** @brief Signal, which terminated the command - 0 if it exited. */
+    std::int32_t signal = 0;
+
+    /** @brief Stdout output of the command. */
+    std::string output {};
+
+    /** @brief Stderr output of the command - empty, if stderr is not captured. */
+    std::string error {};
+
+    /** @brief Wall time from the start until the command is reaped. */
+    std::chrono::nanoseconds duration {};
+
+    /** @brief CPU time in user mode. */
+    std::chrono::microseconds userTime {};
+
+    /** @brief CPU time in kernel mode. */
+    std::chrono::microseconds systemTime {};
+
+    /** @brief Maximum resident set size in bytes. */
+    std::int64_t maxResidentSize = 0;
+
+    /** @brief Is the command killed, because it ran longer than its timeout? */
+    bool timedOut = false;
+  };
+
+  /**
+   * @brief Output stream of a command.
+   */
+  enum class Stream {
+
+    Output, /**< Stdout. */
+    Error   /**< Stderr. */
+  };
+
+#ifndef _MSC_VER
+  /**
+   * @brief Child process started by posix_spawn without a shell.
+   * Stdout and stderr are read through separate pipes with large buffers. Stdin is inherited.
+   * @author Florian Becker <fb\@vxapps.com> (VX APPS)
    */
-  void close( std::FILE *_file ) noexcept;
+  class Process {
+
+  public:
+    /**
+     * @brief Constructor for Process.
+     * @param _arguments   Program and its arguments - the program is searched in PATH, if it contains no slash.
+     */
+    explicit Process( std::vector<std::string> _arguments ) noexcept;
+
+    /**
+     * @brief Delete copy constructor.
+     */
+    Process( const Process & ) = delete;
+
+    /**
+     * @brief Delete move constructor.
+     */
+    Process( Process && ) = delete;
+
+    /**
+     * @brief Delete copy assign.
+     * @return Nothing.
+     */
+    Process &operator=( const Process & ) = delete;
+
+    /**
+     * @brief Delete move assign.
+     * @return Nothing.
+     */
+    Process &operator=( Process && ) = delete;
+
+    /**
+     * @brief Destructor for Process - closes the pipes and waits for a started child.
+     */
+    ~Process() noexcept;
+
+    /**
+     * @brief Capture stderr or inherit it from the current process.
+     * @param _capture   Capture stderr - default true.
+     */
+    inline void setCaptureError( bool _capture ) noexcept { m_captureError = _capture; }
+
+    /**
+     * @brief Keep the read output in the result.
+     * @param _keep   Keep the output - default true.
+     */
+    inline void setKeepOutput( bool _keep ) noexcept { m_keepOutput = _keep; }
+
+    /**
+     * @brief Connect stdin of the child to a descriptor.
+     * @param _descriptor   Descriptor, which stays owned by the caller - -1 to inherit stdin.
+     */
+    inline void setInput( int _descriptor ) noexcept { m_input = _descriptor; }
+
+    /**
+     * @brief Connect stdout of the child to a descriptor instead of a pipe.
+     * @param _descriptor   Descriptor, which stays owned by the caller - -1 to capture stdout.
+     */
+    inline void setOutput( int _descriptor ) noexcept { m_outputTarget = _descriptor; }
+
+    /**
+     * @brief Start the child in its own process group, so kill() reaches its children too.
+     * @param _group   Own process group - default false.
+     */
+    inline void setProcessGroup( bool _group ) noexcept { m_processGroup = _group; }
+
+    /**
+     * @brief Start the child process.
+     * @return True, if the child is started - otherwise false.
+     * @note This function may throw an exception by std::vector.
+     */
+    [[nodiscard]] bool start();
+
+    /**
+     * @brief Read stdout and stderr until both are closed and wait for the child.
+     * @return The exit code of the child, 128 plus the signal number, if it is terminated by a signal - -1 if it is not started.
+     * @note This function may throw an exception by std::string.
+     */
+    std::int32_t wait();
+
+    /**
+     * @brief Read once from stdout or stderr - blocks, if no data is available.
+     * The pipe is closed at the end of file.
+     * @param _stream   Stream to read.
+     * @param _buffer   Read buffer.
+     * @return The read data, valid until the buffer changes - empty at the end of file.
+     * @note This function may throw an exception by std::string.
+     */
+    [[nodiscard]] std::string_view read( Stream _stream,
+                                         std::vector<char> &_buffer );
+
+    /**
+     * @brief Send a signal to the child - to its process group, if it has its own.
+     * @param _signal   Signal to send.
+     * @return True, if the signal is sent - otherwise false.
+     */
+    bool kill( int _signal = SIGKILL ) const noexcept;
+
+    /**
+     * @brief Close the pipes without reading them and wait for the child.
+     * @return The exit code of the child, 128 plus the signal number, if it is terminated by a signal - -1 if it is not started.
+     */
+    std::int32_t finish() noexcept;
+
+    /**
+     * @brief Close the pipes without reading them and reap the child, if it has ended - without waiting for it.
+     * @return True, if the child is reaped and the result is complete - false, if it is still running.
+     */
+    [[nodiscard]] bool tryFinish() noexcept;
+
+    /**
+     * @brief Return the read end of a pipe.
+     * @param _stream   Stream of the pipe.
+     * @return The descriptor - -1, if the pipe is closed.
+     */
+    [[nodiscard]] inline int descriptor( Stream _stream ) const noexcept { return _stream == Stream::Output ? m_outputDescriptor : m_errorDescriptor; }
+
+    /**
+     * @brief Return the process id of the child.
+     * @return The process id - -1 if the child is not running.
+     */
+    [[nodiscard]] inline pid_t id() const noexcept { return m_id; }
+
+    /**
+     * @brief Return the stdout output.
+     * @return The stdout output read by wait().
+     */
+    [[nodiscard]] inline const std::string &output() const noexcept { return m_result.output; }
+
+    /**
+     * @brief Return the stderr output.
+     * @return The stderr output read by wait() - empty, if stderr is not captured.
+     */
+    [[nodiscard]] inline const std::string &error() const noexcept { return m_result.error; }
+
+    /**
+     * @brief Return the result.
+     * @return The result, complete after wait().
+     */
+    [[nodiscard]] inline const Result &result() const noexcept { return m_result; }
+
+    /**
+     * @brief Move the result out of the process.
+     * @return The result, complete after wait().
+     */
+    [[nodiscard]] inline Result takeResult() noexcept { return std::move( m_result ); }
+
+  private:
+    /**
+     * @brief Member for the program and its arguments.
+     */
+    std::vector<std::string> m_arguments {};
+
+    /**
+     * @brief Member for the process id of the child.
+     */
+    pid_t m_id = -1;
+
+    /**
+     * @brief Member for the read end of the stdout pipe.
+     */
+    int m_outputDescriptor = -1;
+
+    /**
+     * @brief Member for the read end of the stderr pipe.
+     */
+    int m_errorDescriptor = -1;
+
+    /**
+     * @brief Member for the descriptor connected to stdin - -1 to inherit stdin.
+     */
+    int m_input = -1;
+
+    /**
+     * @brief Member for the descriptor connected to stdout - -1 to capture stdout.
+     */
+    int m_outputTarget = -1;
+
+    /**
+     * @brief Member for capturing stderr.
+     */
+    bool m_captureError = true;
+
+    /**
+     * @brief Member for keeping the output in the result.
+     */
+    bool m_keepOutput = true;
+
+    /**
+     * @brief Member for starting the child in its own process group.
+     */
+    bool m_processGroup = false;
+
+    /**
+     * @brief Member for the start time.
+     */
+    std::chrono::steady_clock::time_point m_start {};
+
+    /**
+     * @brief Member for the result.
+     */
+    Result m_result {};
+
+    /**
+     * @brief Close both pipes.
+     */
+    void closePipes() noexcept;
+
+    /**
+     * @brief Wait for the child without reading the pipes and complete the result.
+     * @param _options   Options of wait4() - WNOHANG returns at once, if the child is still running.
+     * @return The exit code of the child, 128 plus the signal number, if it is terminated by a signal - -1 on failure,
+     * empty if the child is still running.
+     */
+    std::optional<std::int32_t> reap( int _options ) noexcept;
+  };
+
+  /**
+   * @brief Run many commands in parallel and multiplex their pipes on the calling thread.
+   * The output is delivered in chunks as soon as it is read, every command can have a timeout and can be cancelled by any thread.
+   * Every command runs in its own process group, so killing a command kills its children too.
+   * @author Florian Becker <fb\@vxapps.com> (VX APPS)
+   */
+  class Pool {
+
+  public:
+    /**
+     * @brief Function for a read chunk - gets the index of the command, the stream and the data.
+     */
+    using OutputFunction = std::function<void( std::size_t, Stream, std::string_view )>;
+
+    /**
+     * @brief Function for a finished command - gets the index of the command and its result.
+     */
+    using FinishFunction = std::function<void( std::size_t, const Result & )>;
+
+    /**
+     * @brief Constructor for Pool.
+     * @param _parallel   Maximum number of commands running at once - at least one.
+     */
+    explicit Pool( std::size_t _parallel ) noexcept;
+
+    /**
+     * @brief Delete copy constructor.
+     */
+    Pool( const Pool & ) = delete;
+
+    /**
+     * @brief Delete move constructor.
+     */
+    Pool( Pool && ) = delete;
+
+    /**
+     * @brief Delete copy assign.
+     * @return Nothing.
+     */
+    Pool &operator=( const Pool & ) = delete;
+
+    /**
+     * @brief Delete move assign.
+     * @return Nothing.
+     */
+    Pool &operator=( Pool && ) = delete;
+
+    /**
+     * @brief Destructor for Pool.
+     */
+    ~Pool() noexcept;
+
+    /**
+     * @brief Add a command - before run() or from a callback.
+     * @param _arguments   Program and its arguments.
+     * @param _timeout   Time after the start, when the command is killed - zero for no timeout.
+     * @return The index of the command.
+     * @note This function may throw an exception by std::vector.
+     */
+    std::size_t add( std::vector<std::string> _arguments,
+                     std::chrono::milliseconds _timeout = std::chrono::milliseconds::zero() );
+
+    /**
+     * @brief Set the function for read chunks.
+     * @param _function   Function called on the thread of run().
+     */
+    inline void setOutputFunction( OutputFunction _function ) noexcept { m_outputFunction = std::move( _function ); }
+
+    /**
+     * @brief Set the function for finished commands.
+     * @param _function   Function called on the thread of run().
+     */
+    inline void setFinishFunction( FinishFunction _function ) noexcept { m_finishFunction = std::move( _function ); }
+
+    /**
+     * @brief Keep the output in the results.
+     * @param _keep   Keep the output - default true.
+     */
+    inline void setKeepOutput( bool _keep ) noexcept { m_keepOutput = _keep; }
+
+    /**
+     * @brief Cancel a command - a running command is killed, a waiting command is not started. Thread-safe.
+     * @param _index   Index of the command.
+     */
+    void cancel( std::size_t _index ) noexcept;
+
+    /**
+     * @brief Cancel every command. Thread-safe.
+     */
+    void cancel() noexcept;
+
+    /**
+     * @brief Run every command and return when the last one is finished.
+     * The commands are removed afterwards, so the indexes of new commands start at zero again. If a callback throws, the
+     * running commands are killed and every command is removed, before the exception is passed on.
+     * @return The result of every command by its index - the exit code is -1 for commands, which are not started.
+     * @note This function may throw an exception by std::vector, std::string or the callbacks.
+     */
+    [[nodiscard]] std::vector<Result> run();
+
+  private:
+    /**
+     * @brief Command to run.
+     */
+    struct Command {
+
+      /** @brief Program and its arguments. */
+      std::vector<std::string> arguments {};
+
+      /** @brief Timeout after the start - zero for no timeout. */
+      std::chrono::milliseconds timeout {};
+
+      /** @brief Is the command cancelled? */
+      bool cancelled = false;
+    };
+
+    /**
+     * @brief Running command.
+     */
+    struct Running {
+
+      /** @brief Index of the command. */
+      std::size_t index = 0;
+
+      /** @brief Child process. */
+      std::unique_ptr<Process> process {};
+
+      /** @brief Time, when the command is killed. */
+      std::chrono::steady_clock::time_point deadline {};
+    };
+
+    /**
+     * @brief Member for the maximum number of commands running at once.
+     */
+    std::size_t m_parallel = 1;
+
+    /**
+     * @brief Member for the commands.
+     */
+    std::vector<Command> m_commands {};
+
+    /**
+     * @brief Member for the running commands.
+     */
+    std::vector<Running> m_running {};
+
+    /**
+     * @brief Member for the results.
+     */
+    std::vector<Result> m_results {};
+
+    /**
+     * @brief Member for the function for read chunks.
+     */
+    OutputFunction m_outputFunction {};
+
+    /**
+     * @brief Member for the function for finished commands.
+     */
+    FinishFunction m_finishFunction {};
+
+    /**
+     * @brief Member for keeping the output in the results.
+     */
+    bool m_keepOutput = true;
+
+    /**
+     * @brief Member for the mutex of the cancel requests.
+     */
+    std::mutex m_mutex {};
+
+    /**
+     * @brief Member for the indexes of cancelled commands, not handled by run() yet.
+     */
+    std::vector<std::size_t> m_cancelled {};
+
+    /**
+     * @brief Member for cancelling every command, not handled by run() yet.
+     */
+    bool m_cancelAll = false;
+
+    /**
+     * @brief Member for the pipe, which wakes run() for cancel requests.
+     */
+    std::array<int, 2> m_wake { -1, -1 };
+
+    /**
+     * @brief Run every command - run() without the cleanup after an exception.
+     * @return The result of every command by its index.
+     * @note This function may throw an exception by std::vector, std::string or the callbacks.
+     */
+    std::vector<Result> runCommands();
+
+    /**
+     * @brief Kill and wait for the running commands and drop every command, result and cancel request.
+     */
+    void reset() noexcept;
+
+    /**
+     * @brief Apply the cancel requests of other threads.
+     */
+    void applyCancel() noexcept;
+
+    /**
+     * @brief Remove the finished commands from the running commands.
+     */
+    void removeFinished() noexcept;
+
+    /**
+     * @brief Finish a running command.
+     * @param _running   Running command.
+     * @param _timedOut   Is the command killed by its timeout?
+     * @note This function may throw an exception by the finish function.
+     */
+    void finish( Running &_running,
+                 bool _timedOut );
+
+    /**
+     * @brief Store the result and call the finish function.
+     * @param _index   Index of the command.
+     * @param _result   Result of the command.
+     * @note This function may throw an exception by the finish function.
+     */
+    void store( std::size_t _index,
+                Result &&_result );
+  };
+
+  /**
+   * @brief Commands connected by pipes, where stdout of every stage is stdin of the next stage.
+   * The stages are connected by kernel pipes directly, so the data between them is not copied through the current process.
+   * Stderr of every stage and stdout of the last stage are captured, unless the last stage writes to a descriptor.
+   * @author Florian Becker <fb\@vxapps.com> (VX APPS)
+   */
+  class Pipeline {
+
+  public:
+    /**
+     * @brief Function for observed data - gets the data.
+     */
+    using TapFunction = std::function<void( std::string_view )>;
+
+    /**
+     * @brief Add a stage.
+     * @param _arguments   Program and its arguments.
+     * @return The index of the stage.
+     * @note This function may throw an exception by std::vector.
+     */
+    std::size_t add( std::vector<std::string> _arguments );
+
+    /**
+     * @brief Connect stdin of the first stage to a descriptor.
+     * @param _descriptor   Descriptor, which stays owned by the caller - -1 to inherit stdin.
+     */
+    inline void setInput( int _descriptor ) noexcept { m_input = _descriptor; }
+
+    /**
+     * @brief Connect stdout of the last stage to a descriptor instead of capturing it.
+     * @param _descriptor   Descriptor, which stays owned by the caller - -1 to capture stdout.
+     */
+    inline void setOutput( int _descriptor ) noexcept { m_output = _descriptor; }
+
+  #ifdef __linux__
+    /**
+     * @brief Observe stdout of a stage.
+     * The data is duplicated by tee() and moved to the next stage by splice(), so it stays in the kernel on its way.
+     * @param _stage   Index of the stage.
+     * @param _function   Function called with every chunk on the thread of run().
+     * @note This function may throw an exception by std::vector.
+     */
+    void setTap( std::size_t _stage,
+                 TapFunction _function );
+  #endif
+
+    /**
+     * @brief Run every stage and return when the last one is finished.
+     * @return The result of every stage by its index - stdout is only captured for the last stage.
+     * @note This function may throw an exception by std::vector, std::string or the tap functions.
+     */
+    [[nodiscard]] std::vector<Result> run();
+
+  private:
+    /**
+     * @brief Member for the stages.
+     */
+    std::vector<std::vector<std::string>> m_stages {};
+
+    /**
+     * @brief Member for the tap functions by stage.
+     */
+    std::vector<TapFunction> m_taps {};
+
+    /**
+     * @brief Member for the descriptor connected to stdin of the first stage.
+     */
+    int m_input = -1;
+
+    /**
+     * @brief Member for the descriptor connected to stdout of the last stage.
+     */
+    int m_output = -1;
+  };
+#endif
 
   /**
-   * @brief Execute the external application and return the stdout output.
+   * @brief Execute the external application by the shell.
+   * Every call has its own result, so commands can be run by several threads at once.
    * @param _command   Command to run.
-   * @return Return the stdout output.
+   * @return The result with the stdout and stderr output.
+   * @note This function may throw an exception by std::vector or std::string.
    */
-  std::string run( const std::string &_command );
+  [[nodiscard]] Result run( const std::string &_command );
 
+#ifndef _MSC_VER
   /**
-   * @brief Result   Exit code of the command.
-   * @return The result code.
+   * @brief Execute the external application without a shell.
+   * Every call has its own result, so commands can be run by several threads at once.
+   * @param _arguments   Program and its arguments.
+   * @return The result with the stdout and stderr output.
+   * @note This function may throw an exception by std::vector or std::string.
    */
-  [[nodiscard]] std::int32_t resultCode() noexcept;
+  [[nodiscard]] Result run( const std::vector<std::string> &_arguments );
+#endif
 }
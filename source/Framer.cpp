@@ -0,0 +1,571 @@
+/*
+ * Copyright (c) 2020 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* c header */
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint8_t, std::uint16_t, std::uint32_t
+
+/* stl header */
+#include <algorithm>
+#include <array>
+#include <optional>
+#include <string>
+#include <string_view>
+
+/* local header */
+#include "Framer.h"
+
+namespace vx::framer {
+
+  namespace {
+
+    /** @brief SLIP end of frame. */
+    constexpr char slipEnd = '\xC0';
+
+    /** @brief SLIP escape. */
+    constexpr char slipEscape = '\xDB';
+
+    /** @brief SLIP escaped end of frame. */
+    constexpr char slipEscapedEnd = '\xDC';
+
+    /** @brief SLIP escaped escape. */
+    constexpr char slipEscapedEscape = '\xDD';
+
+    /** @brief Maximum block of COBS. */
+    constexpr std::uint8_t cobsBlock = 0xFF;
+
+    /** @brief Bits per byte. */
+    constexpr std::uint32_t byteBits = 8;
+
+    /** @brief Mask of a byte. */
+    constexpr std::uint32_t byteMask = 0xFF;
+
+    /** @brief Number of table entries, one per byte. */
+    constexpr std::size_t tableSize = 256;
+
+    /**
+     * @brief Create the table of the CRC-16/CCITT-FALSE.
+     * @return The table.
+     */
+    consteval std::array<std::uint16_t, tableSize> crc16Table() noexcept {
+
+      constexpr std::uint16_t polynomial = 0x1021;
+      constexpr std::uint16_t highBit = 0x8000;
+      std::array<std::uint16_t, tableSize> table {};
+      for ( std::size_t index = 0; index < tableSize; ++index ) {
+
+        auto crc = static_cast<std::uint16_t>( index << ( byteBits * 2 - byteBits ) );
+        for ( std::uint32_t bit = 0; bit < byteBits; ++bit ) {
+
+          crc = static_cast<std::uint16_t>( ( crc & highBit ) != 0 ? ( crc << 1 ) ^ polynomial : crc << 1 );
+        }
+        table[ index ] = crc;
+      }
+      return table;
+    }
+
+    /**
+     * @brief Create the table of the reflected CRC-32.
+     * @return The table.
+     */
+    consteval std::array<std::uint32_t, tableSize> crc32Table() noexcept {
+
+      constexpr std::uint32_t polynomial = 0xEDB88320;
+      std::array<std::uint32_t, tableSize> table {};
+      for ( std::size_t index = 0; index < tableSize; ++index ) {
+
+        auto crc = static_cast<std::uint32_t>( index );
+        for ( std::uint32_t bit = 0; bit < byteBits; ++bit ) {
+
+          crc = ( crc & 1 ) != 0 ? ( crc >> 1 ) ^ polynomial : crc >> 1;
+        }
+        table[ index ] = crc;
+      }
+      return table;
+    }
+
+    /**
+     * @brief Return the size of a checksum.
+     * @param _checksum   Checksum.
+     * @return The size of the checksum.
+     */
+    constexpr std::size_t checksumSize( Checksum _checksum ) noexcept {
+
+      switch ( _checksum ) {
+
+        case Checksum::Crc16:
+          return sizeof( std::uint16_t );
+        case Checksum::Crc32:
+          return sizeof( std::uint32_t );
+        case Checksum::None:
+          break;
+      }
+      return 0;
+    }
+
+    /**
+     * @brief Calculate the checksum.
+     * @param _checksum   Checksum.
+     * @param _data   Data.
+     * @return The checksum.
+     */
+    std::uint32_t calculate( Checksum _checksum,
+                             std::string_view _data ) noexcept {
+
+      return _checksum == Checksum::Crc16 ? crc16( _data ) : crc32( _data );
+    }
+
+    /**
+     * @brief Read a big-endian number.
+     * @param _data   Data with at least _size bytes.
+     * @param _size   Size of the number.
+     * @return The number.
+     */
+    std::uint32_t readBigEndian( std::string_view _data,
+                                 std::size_t _size ) noexcept {
+
+      std::uint32_t value = 0;
+      for ( std::size_t index = 0; index < _size; ++index ) {
+
+        value = ( value << byteBits ) | static_cast<std::uint8_t>( _data[ index ] );
+      }
+      return value;
+    }
+
+    /**
+     * @brief Append a big-endian number.
+     * @param _value   Number.
+     * @param _size   Size of the number.
+     * @param _data   Data to append to.
+     */
+    void appendBigEndian( std::uint32_t _value,
+                          std::size_t _size,
+                          std::string &_data ) {
+
+      for ( std::size_t index = _size; index > 0; --index ) {
+
+        _data.push_back( static_cast<char>( ( _value >> ( ( index - 1 ) * byteBits ) ) & byteMask ) );
+      }
+    }
+
+    /**
+     * @brief Find a delimiter from the unchecked data on.
+     * @param _pending   Pending data.
+     * @param _checked   Number of checked bytes.
+     * @param _delimiter   Delimiter.
+     * @return The position of the delimiter - std::string_view::npos if there is none.
+     */
+    std::size_t find( std::string_view _pending,
+                      std::size_t _checked,
+                      std::string_view _delimiter ) noexcept {
+
+      /* A delimiter might have started in the checked bytes. */
+      const std::size_t overlap = _delimiter.size() - 1;
+      return _pending.find( _delimiter, _checked > overlap ? _checked - overlap : 0 );
+    }
+  }
+
+  std::uint16_t crc16( std::string_view _data ) noexcept {
+
+    static constexpr std::array<std::uint16_t, tableSize> table = crc16Table();
+    std::uint16_t crc = 0xFFFF;
+    for ( const char byte : _data ) {
+
+      crc = static_cast<std::uint16_t>( ( crc << byteBits ) ^ table[ ( ( crc >> byteBits ) ^ static_cast<std::uint8_t>( byte ) ) & byteMask ] );
+    }
+    return crc;
+  }
+
+  std::uint32_t crc32( std::string_view _data ) noexcept {
+
+    static constexpr std::array<std::uint32_t, tableSize> table = crc32Table();
+    std::uint32_t crc = 0xFFFFFFFF;
+    for ( const char byte : _data ) {
+
+      crc = ( crc >> byteBits ) ^ table[ ( crc ^ static_cast<std::uint8_t>( byte ) ) & byteMask ];
+    }
+    return ~crc;
+  }
+
+  void Framer::push( std::string_view _data ) {
+
+    if ( _data.empty() ) {
+
+      return;
+    }
+    if ( m_input.empty() && m_begin == m_buffer.size() ) {
+
+      /* Nothing pending, the data is scanned in place. */
+      m_buffer.clear();
+      m_begin = 0;
+      m_input = _data;
+      return;
+    }
+    keep();
+    m_buffer.erase( 0, m_begin );
+    m_begin = 0;
+    m_buffer.append( _data );
+  }
+
+  std::optional<std::string_view> Framer::next() {
+
+    const std::size_t trailer = checksumSize( m_checksum );
+    while ( true ) {
+
+      std::string_view data = pending();
+      if ( m_resync ) {
+
+        const std::optional<std::size_t> begin = resync( data );
+        consume( begin.value_or( data.size() ) );
+        m_resync = !begin;
+        data = pending();
+      }
+      if ( data.empty() ) {
+
+        return std::nullopt;
+      }
+      const Scan result = scan( data, m_checked );
+      switch ( result.status ) {
+
+        case Status::Incomplete:
+          if ( data.size() > m_maxFrameSize ) {
+
+            ++m_errors;
+            consume( data.size() );
+            m_resync = true;
+            continue;
+          }
+          m_checked = result.consumed;
+          keep();
+          return std::nullopt;
+        case Status::Skip:
+          consume( result.consumed );
+          continue;
+        case Status::Invalid:
+          ++m_errors;
+          consume( result.consumed );
+          continue;
+        case Status::Frame:
+          break;
+      }
+      consume( result.consumed );
+      if ( result.consumed > m_maxFrameSize || result.frame.size() < trailer ) {
+
+        ++m_errors;
+        continue;
+      }
+      const std::string_view payload = result.frame.substr( 0, result.frame.size() - trailer );
+      if ( trailer > 0 && calculate( m_checksum, payload ) != readBigEndian( result.frame.substr( payload.size() ), trailer ) ) {
+
+        ++m_errors;
+        continue;
+      }
+      return payload;
+    }
+  }
+
+  std::size_t Framer::drain( const FrameFunction &_function ) {
+
+    std::size_t count = 0;
+    for ( std::optional<std::string_view> frame = next(); frame; frame = next() ) {
+
+      _function( *frame );
+      ++count;
+    }
+    return count;
+  }
+
+  bool Framer::encode( std::string_view _payload,
+                       std::string &_frame ) const {
+
+    const std::size_t trailer = checksumSize( m_checksum );
+    if ( trailer == 0 ) {
+
+      return wrap( _payload, _frame );
+    }
+    std::string body {};
+    body.reserve( _payload.size() + trailer );
+    body.append( _payload );
+    appendBigEndian( calculate( m_checksum, _payload ), trailer, body );
+    return wrap( body, _frame );
+  }
+
+  std::size_t Framer::buffered() const noexcept {
+
+    return pending().size();
+  }
+
+  void Framer::reset() noexcept {
+
+    m_buffer.clear();
+    m_begin = 0;
+    m_input = {};
+    m_checked = 0;
+    m_resync = false;
+    m_errors = 0;
+  }
+
+  std::optional<std::size_t> Framer::resync( std::string_view ) const noexcept {
+
+    return 0;
+  }
+
+  std::string_view Framer::pending() const noexcept {
+
+    return m_input.empty() ? std::string_view( m_buffer ).substr( m_begin ) : m_input;
+  }
+
+  void Framer::consume( std::size_t _size ) noexcept {
+
+    if ( m_input.empty() ) {
+
+      m_begin += _size;
+    }
+    else {
+
+      m_input.remove_prefix( _size );
+    }
+    m_checked = 0;
+  }
+
+  void Framer::keep() {
+
+    if ( m_input.empty() ) {
+
+      return;
+    }
+    m_buffer.erase( 0, m_begin );
+    m_begin = 0;
+    m_buffer.append( m_input );
+    m_input = {};
+  }
+
+  Framer::Scan Delimiter::scan( std::string_view _pending,
+                                std::size_t _checked ) {
+
+    const std::size_t end = find( _pending, _checked, m_delimiter );
+    if ( end == std::string_view::npos ) {
+
+      return { Status::Incomplete, _pending.size(), {} };
+    }
+    return { Status::Frame, end + m_delimiter.size(), _pending.substr( 0, end ) };
+  }
+
+  std::optional<std::size_t> Delimiter::resync( std::string_view _pending ) const noexcept {
+
+    const std::size_t end = _pending.find( m_delimiter );
+    if ( end == std::string_view::npos ) {
+
+      return std::nullopt;
+    }
+    return end + m_delimiter.size();
+  }
+
+  bool Delimiter::wrap( std::string_view _body,
+                        std::string &_frame ) const {
+
+    if ( _body.find( m_delimiter ) != std::string_view::npos ) {
+
+      return false;
+    }
+    _frame.append( _body );
+    _frame.append( m_delimiter );
+    return true;
+  }
+
+  Framer::Scan LengthPrefix::scan( std::string_view _pending,
+                                   std::size_t ) {
+
+    if ( _pending.size() < m_prefixSize ) {
+
+      return { Status::Incomplete, 0, {} };
+    }
+    const std::size_t length = readBigEndian( _pending, m_prefixSize );
+    if ( m_prefixSize + length > maxFrameSize() ) {
+
+      /* Without a delimiter the stream is only resynchronized behind the length. */
+      return { Status::Invalid, m_prefixSize, {} };
+    }
+    if ( _pending.size() < m_prefixSize + length ) {
+
+      return { Status::Incomplete, 0, {} };
+    }
+    return { Status::Frame, m_prefixSize + length, _pending.substr( m_prefixSize, length ) };
+  }
+
+  bool LengthPrefix::wrap( std::string_view _body,
+                           std::string &_frame ) const {
+
+    if ( m_prefixSize < sizeof( std::uint32_t ) && _body.size() >> ( m_prefixSize * byteBits ) != 0 ) {
+
+      return false;
+    }
+    appendBigEndian( static_cast<std::uint32_t>( _body.size() ), m_prefixSize, _frame );
+    _frame.append( _body );
+    return true;
+  }
+
+  Framer::Scan Slip::scan( std::string_view _pending,
+                           std::size_t _checked ) {
+
+    const std::size_t end = _pending.find( slipEnd, _checked );
+    if ( end == std::string_view::npos ) {
+
+      return { Status::Incomplete, _pending.size(), {} };
+    }
+    if ( end == 0 ) {
+
+      return { Status::Skip, 1, {} };
+    }
+    const std::string_view raw = _pending.substr( 0, end );
+    std::size_t escape = raw.find( slipEscape );
+    if ( escape == std::string_view::npos ) {
+
+      /* Nothing escaped, the frame is a view into the data. */
+      return { Status::Frame, end + 1, raw };
+    }
+    m_decoded.assign( raw.substr( 0, escape ) );
+    while ( escape != std::string_view::npos ) {
+
+      if ( escape + 1 == end || ( raw[ escape + 1 ] != slipEscapedEnd && raw[ escape + 1 ] != slipEscapedEscape ) ) {
+
+        return { Status::Invalid, end + 1, {} };
+      }
+      m_decoded.push_back( raw[ escape + 1 ] == slipEscapedEnd ? slipEnd : slipEscape );
+      const std::size_t next = raw.find( slipEscape, escape + 2 );
+      m_decoded.append( raw.substr( escape + 2, next == std::string_view::npos ? std::string_view::npos : next - escape - 2 ) );
+      escape = next;
+    }
+    return { Status::Frame, end + 1, m_decoded };
+  }
+
+  std::optional<std::size_t> Slip::resync( std::string_view _pending ) const noexcept {
+
+    const std::size_t end = _pending.find( slipEnd );
+    if ( end == std::string_view::npos ) {
+
+      return std::nullopt;
+    }
+    return end + 1;
+  }
+
+  bool Slip::wrap( std::string_view _body,
+                   std::string &_frame ) const {
+
+    /* The leading end flushes noise of the line. */
+    _frame.push_back( slipEnd );
+    for ( const char byte : _body ) {
+
+      if ( byte == slipEnd ) {
+
+        _frame.push_back( slipEscape );
+        _frame.push_back( slipEscapedEnd );
+      }
+      else if ( byte == slipEscape ) {
+
+        _frame.push_back( slipEscape );
+        _frame.push_back( slipEscapedEscape );
+      }
+      else {
+
+        _frame.push_back( byte );
+      }
+    }
+    _frame.push_back( slipEnd );
+    return true;
+  }
+
+  Framer::Scan Cobs::scan( std::string_view _pending,
+                           std::size_t _checked ) {
+
+    const std::size_t end = _pending.find( '\0', _checked );
+    if ( end == std::string_view::npos ) {
+
+      return { Status::Incomplete, _pending.size(), {} };
+    }
+    if ( end == 0 ) {
+
+      return { Status::Skip, 1, {} };
+    }
+    m_decoded.clear();
+    std::size_t index = 0;
+    while ( index < end ) {
+
+      const auto code = static_cast<std::uint8_t>( _pending[ index ] );
+      if ( index + code > end ) {
+
+        return { Status::Invalid, end + 1, {} };
+      }
+      m_decoded.append( _pending.substr( index + 1, code - 1U ) );
+      index += code;
+      if ( code != cobsBlock && index < end ) {
+
+        m_decoded.push_back( '\0' );
+      }
+    }
+    return { Status::Frame, end + 1, m_decoded };
+  }
+
+  std::optional<std::size_t> Cobs::resync( std::string_view _pending ) const noexcept {
+
+    const std::size_t end = _pending.find( '\0' );
+    if ( end == std::string_view::npos ) {
+
+      return std::nullopt;
+    }
+    return end + 1;
+  }
+
+  bool Cobs::wrap( std::string_view _body,
+                   std::string &_frame ) const {
+
+    /* Every block is the code with the distance to the next zero and up to 254 non-zero bytes. */
+    std::size_t code = _frame.size();
+    _frame.push_back( '\x01' );
+    for ( const char byte : _body ) {
+
+      if ( byte == '\0' ) {
+
+        code = _frame.size();
+        _frame.push_back( '\x01' );
+        continue;
+      }
+      _frame.push_back( byte );
+      ++_frame[ code ];
+      if ( static_cast<std::uint8_t>( _frame[ code ] ) == cobsBlock ) {
+
+        code = _frame.size();
+        _frame.push_back( '\x01' );
+      }
+    }
+    _frame.push_back( '\0' );
+    return true;
+  }
+}
@@ -0,0 +1,440 @@
+/*
+ * Copyright (c) 2020 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+/* c header */
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint16_t, std::uint32_t
+
+/* stl header */
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief vx (VX APPS) framer namespace.
+ */
+namespace vx::framer {
+
+  /**
+   * @brief Checksum at the end of every frame, in network byte order.
+   */
+  enum class Checksum {
+
+    None,  /**< No checksum. */
+    Crc16, /**< CRC-16/CCITT-FALSE - 2 bytes. */
+    Crc32  /**< CRC-32 (IEEE 802.3) - 4 bytes. */
+  };
+
+  /**
+   * @brief Calculate the CRC-16/CCITT-FALSE.
+   * @param _data   Data.
+   * @return The CRC-16.
+   */
+  [[nodiscard]] std::uint16_t crc16( std::string_view _data ) noexcept;
+
+  /**
+   * @brief Calculate the CRC-32 (IEEE 802.3).
+   * @param _data   Data.
+   * @return The CRC-32.
+   */
+  [[nodiscard]] std::uint32_t crc32( std::string_view _data ) noexcept;
+
+  /**
+   * @brief Reassemble frames from a byte stream, e.g. of vx::Serial.
+   * Received data is scanned in place, only an incomplete rest is kept for the next push(). Frames are views into the
+   * data, unless SLIP or COBS have to decode them into a reused buffer.
+   * @author Florian Becker <fb\@vxapps.com> (VX APPS)
+   */
+  class Framer {
+
+  public:
+    /**
+     * @brief Function for a frame - gets the payload without checksum.
+     */
+    using FrameFunction = std::function<void( std::string_view )>;
+
+    /**
+     * @brief Default constructor for Framer.
+     */
+    Framer() = default;
+
+    /**
+     * @brief Default copy constructor for Framer.
+     */
+    Framer( const Framer & ) = default;
+
+    /**
+     * @brief Default move constructor for Framer.
+     */
+    Framer( Framer && ) = default;
+
+    /**
+     * @brief Default copy assign.
+     * @return The framer.
+     */
+    Framer &operator=( const Framer & ) = default;
+
+    /**
+     * @brief Default move assign.
+     * @return The framer.
+     */
+    Framer &operator=( Framer && ) = default;
+
+    /**
+     * @brief Default destructor for Framer.
+     */
+    virtual ~Framer() = default;
+
+    /**
+     * @brief Set the checksum of every frame.
+     * @param _checksum   Checksum.
+     */
+    inline void setChecksum( Checksum _checksum ) noexcept { m_checksum = _checksum; }
+
+    /**
+     * @brief Return the checksum of every frame.
+     * @return The checksum.
+     */
+    [[nodiscard]] inline Checksum checksum() const noexcept { return m_checksum; }
+
+    /**
+     * @brief Set the maximum size of an encoded frame - larger frames are dropped.
+     * @param _size   Maximum size.
+     */
+    inline void setMaxFrameSize( std::size_t _size ) noexcept { m_maxFrameSize = _size; }
+
+    /**
+     * @brief Return the maximum size of an encoded frame.
+     * @return The maximum size.
+     */
+    [[nodiscard]] inline std::size_t maxFrameSize() const noexcept { return m_maxFrameSize; }
+
+    /**
+     * @brief Add received data.
+     * @param _data   Data, which must stay valid until next() returns no frame - not a temporary.
+     * @note This function may throw an exception by std::string.
+     */
+    void push( std::string_view _data );
+
+    /**
+     * @brief Return the next complete frame.
+     * @return The payload without checksum, valid until the next call of next() or push() - std::nullopt if no frame is complete.
+     * @note This function may throw an exception by std::string.
+     */
+    [[nodiscard]] std::optional<std::string_view> next();
+
+    /**
+     * @brief Call a function for every complete frame.
+     * @param _function   Function for a frame.
+     * @return Number of frames.
+     * @note This function may throw an exception by std::string or the function.
+     */
+    std::size_t drain( const FrameFunction &_function );
+
+    /**
+     * @brief Encode a payload and append it with checksum to a frame for writing.
+     * @param _payload   Payload.
+     * @param _frame   Encoded frame.
+     * @return True, if the payload is encodable - otherwise false.
+     * @note This function may throw an exception by std::string.
+     */
+    [[nodiscard]] bool encode( std::string_view _payload,
+                               std::string &_frame ) const;
+
+    /**
+     * @brief Return the number of dropped frames by checksum, encoding or size.
+     * @return The number of dropped frames.
+     */
+    [[nodiscard]] inline std::size_t errors() const noexcept { return m_errors; }
+
+    /**
+     * @brief Return the number of received bytes, which are not complete frames yet.
+     * @return The number of incomplete bytes.
+     */
+    [[nodiscard]] std::size_t buffered() const noexcept;
+
+    /**
+     * @brief Drop incomplete data and the error count.
+     */
+    void reset() noexcept;
+
+  protected:
+    /**
+     * @brief Result of a scan.
+     */
+    enum class Status {
+
+      Incomplete, /**< No complete frame - consumed is the number of bytes checked. */
+      Frame,      /**< Frame complete - frame is the decoded frame with checksum. */
+      Skip,       /**< Bytes without a frame, e.g. an empty frame. */
+      Invalid     /**< Invalid frame. */
+    };
+
+    /**
+     * @brief Scan of pending data.
+     */
+    struct Scan {
+
+      /** @brief Result. */
+      Status status = Status::Incomplete;
+
+      /** @brief Number of bytes consumed. */
+      std::size_t consumed = 0;
+
+      /** @brief Decoded frame with checksum. */
+      std::string_view frame {};
+    };
+
+    /**
+     * @brief Scan pending data for the next frame.
+     * @param _pending   Pending data.
+     * @param _checked   Number of bytes at the begin, which were checked by the last incomplete scan.
+     * @return The scan.
+     * @note This function may throw an exception by std::string.
+     */
+    [[nodiscard]] virtual Scan scan( std::string_view _pending,
+                                     std::size_t _checked ) = 0;
+
+    /**
+     * @brief Find the begin of the next frame after dropped data.
+     * @param _pending   Pending data.
+     * @return Number of bytes up to the next frame - std::nullopt, if the data has no begin of a frame.
+     */
+    [[nodiscard]] virtual std::optional<std::size_t> resync( std::string_view _pending ) const noexcept;
+
+    /**
+     * @brief Encode a payload with checksum.
+     * @param _body   Payload with checksum.
+     * @param _frame   Encoded frame to append to.
+     * @return True, if the body is encodable - otherwise false.
+     * @note This function may throw an exception by std::string.
+     */
+    [[nodiscard]] virtual bool wrap( std::string_view _body,
+                                     std::string &_frame ) const = 0;
+
+  private:
+    /**
+     * @brief Return the pending data.
+     * @return The pending data.
+     */
+    [[nodiscard]] std::string_view pending() const noexcept;
+
+    /**
+     * @brief Consume pending data.
+     * @param _size   Number of bytes.
+     */
+    void consume( std::size_t _size ) noexcept;
+
+    /**
+     * @brief Copy pending data of the caller into the buffer.
+     * @note This function may throw an exception by std::string.
+     */
+    void keep();
+
+    /**
+     * @brief Member for the checksum.
+     */
+    Checksum m_checksum = Checksum::None;
+
+    /**
+     * @brief Member for the maximum size of an encoded frame.
+     */
+    std::size_t m_maxFrameSize = 65536;
+
+    /**
+     * @brief Member for the incomplete data.
+     */
+    std::string m_buffer {};
+
+    /**
+     * @brief Member for the begin of the pending data in the buffer.
+     */
+    std::size_t m_begin = 0;
+
+    /**
+     * @brief Member for pending data of the caller.
+     */
+    std::string_view m_input {};
+
+    /**
+     * @brief Member for the checked bytes of the pending data.
+     */
+    std::size_t m_checked = 0;
+
+    /**
+     * @brief Member for dropping data until the next frame.
+     */
+    bool m_resync = false;
+
+    /**
+     * @brief Member for the number of dropped frames.
+     */
+    std::size_t m_errors = 0;
+  };
+
+  /**
+   * @brief Frames terminated by a delimiter, e.g. lines.
+   * @author Florian Becker <fb\@vxapps.com> (VX APPS)
+   */
+  class Delimiter : public Framer {
+
+  public:
+    /**
+     * @brief Default constructor for Delimiter.
+     * @param _delimiter   Delimiter, which must not be empty.
+     * @note This function may throw an exception by std::string.
+     */
+    explicit Delimiter( std::string_view _delimiter = "\n" )
+      : m_delimiter( _delimiter ) {}
+
+  protected:
+    /**
+     * @copydoc Framer::scan
+     */
+    [[nodiscard]] Scan scan( std::string_view _pending,
+                             std::size_t _checked ) override;
+
+    /**
+     * @copydoc Framer::resync
+     */
+    [[nodiscard]] std::optional<std::size_t> resync( std::string_view _pending ) const noexcept override;
+
+    /**
+     * @copydoc Framer::wrap
+     */
+    [[nodiscard]] bool wrap( std::string_view _body,
+                             std::string &_frame ) const override;
+
+  private:
+    /**
+     * @brief Member for the delimiter.
+     */
+    std::string m_delimiter {};
+  };
+
+  /**
+   * @brief Frames with a big-endian length of the payload with checksum in front.
+   * @author Florian Becker <fb\@vxapps.com> (VX APPS)
+   */
+  class LengthPrefix : public Framer {
+
+  public:
+    /**
+     * @brief Default constructor for LengthPrefix.
+     * @param _prefixSize   Size of the length - 1, 2 or 4 bytes.
+     */
+    explicit LengthPrefix( std::size_t _prefixSize = 2 ) noexcept
+      : m_prefixSize( _prefixSize == 1 || _prefixSize == 4 ? _prefixSize : 2 ) {}
+
+  protected:
+    /**
+     * @copydoc Framer::scan
+     */
+    [[nodiscard]] Scan scan( std::string_view _pending,
+                             std::size_t _checked ) override;
+
+    /**
+     * @copydoc Framer::wrap
+     */
+    [[nodiscard]] bool wrap( std::string_view _body,
+                             std::string &_frame ) const override;
+
+  private:
+    /**
+     * @brief Member for the size of the length.
+     */
+    std::size_t m_prefixSize = 2;
+  };
+
+  /**
+   * @brief SLIP (RFC 1055) frames.
+   * @author Florian Becker <fb\@vxapps.com> (VX APPS)
+   */
+  class Slip : public Framer {
+
+  protected:
+    /**
+     * @copydoc Framer::scan
+     */
+    [[nodiscard]] Scan scan( std::string_view _pending,
+                             std::size_t _checked ) override;
+
+    /**
+     * @copydoc Framer::resync
+     */
+    [[nodiscard]] std::optional<std::size_t> resync( std::string_view _pending ) const noexcept override;
+
+    /**
+     * @copydoc Framer::wrap
+     */
+    [[nodiscard]] bool wrap( std::string_view _body,
+                             std::string &_frame ) const override;
+
+  private:
+    /**
+     * @brief Member for the decoded frame.
+     */
+    std::string m_decoded {};
+  };
+
+  /**
+   * @brief COBS (Consistent Overhead Byte Stuffing) frames terminated by a zero byte.
+   * @author Florian Becker <fb\@vxapps.com> (VX APPS)
+   */
+  class Cobs : public Framer {
+
+  protected:
+    /**
+     * @copydoc Framer::scan
+     */
+    [[nodiscard]] Scan scan( std::string_view _pending,
+                             std::size_t _checked ) override;
+
+    /**
+     * @copydoc Framer::resync
+     */
+    [[nodiscard]] std::optional<std::size_t> resync( std::string_view _pending ) const noexcept override;
+
+    /**
+     * @copydoc Framer::wrap
+     */
+    [[nodiscard]] bool wrap( std::string_view _body,
+                             std::string &_frame ) const override;
+
+  private:
+    /**
+     * @brief Member for the decoded frame.
+     */
+    std::string m_decoded {};
+  };
+}
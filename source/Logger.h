@@ -36,9 +36,9 @@
 #include <ctime>
 
 /* stl header */
+#include <array>
 #include <chrono>
 #include <ios>
-#include <limits>
 #include <optional>
 #include <ostream>
 #include <ratio>
@@ -51,6 +51,7 @@
 
 /* local header */
 #include "Singleton.h"
+#include "StringUtils.h"
 
 /**
  * @brief vx (VX APPS) logger namespace.
@@ -228,6 +229,20 @@ namespace vx::logger {
      */
     void printString( std::string_view _input );
 
+    /**
+     * @brief Print number without locale and stream formatting.
+     * Floating point values are printed in the shortest form, which is read back to the same value.
+     * @tparam T   Type.
+     * @param _input   Number.
+     */
+    template <typename T>
+    inline void printNumber( T _input ) noexcept {
+
+      std::array<char, string_utils::formatSize<T>> buffer {};
+      const std::string_view number = string_utils::format( buffer, _input );
+      m_stream.write( number.data(), static_cast<std::streamsize>( number.size() ) );
+    }
+
     /**
      * @brief Is auto space enabled?
      * @return True, if auto space is enabled - otherwise false.
@@ -323,7 +338,7 @@ namespace vx::logger {
      */
     inline Logger &operator<<( std::int32_t _input ) noexcept {
 
-      m_stream << _input;
+      printNumber( _input );
       return maybeSpace();
     }
 
@@ -335,7 +350,7 @@ namespace vx::logger {
      */
     inline Logger &operator<<( std::uint32_t _input ) noexcept {
 
-      m_stream << _input;
+      printNumber( _input );
       return maybeSpace();
     }
 #endif
@@ -350,7 +365,7 @@ namespace vx::logger {
      */
     inline Logger &operator<<( std::size_t _input ) noexcept {
 
-      m_stream << _input;
+      printNumber( _input );
       return maybeSpace();
     }
 #endif
@@ -363,7 +378,7 @@ namespace vx::logger {
      */
     inline Logger &operator<<( std::int64_t _input ) noexcept {
 
-      m_stream << _input;
+      printNumber( _input );
       return maybeSpace();
     }
 
@@ -374,7 +389,7 @@ namespace vx::logger {
      */
     inline Logger &operator<<( std::uint64_t _input ) noexcept {
 
-      m_stream << _input;
+      printNumber( _input );
       return maybeSpace();
     }
 #endif
@@ -386,10 +401,7 @@ namespace vx::logger {
      */
     inline Logger &operator<<( float _input ) noexcept {
 
-      const std::streamsize saveState = m_stream.precision();
-      m_stream.precision( std::numeric_limits<float>::max_digits10 );
-      m_stream << _input;
-      m_stream.precision( saveState );
+      printNumber( _input );
       return maybeSpace();
     }
 
@@ -400,10 +412,7 @@ namespace vx::logger {
      */
     inline Logger &operator<<( double _input ) noexcept {
 
-      const std::streamsize saveState = m_stream.precision();
-      m_stream.precision( std::numeric_limits<double>::max_digits10 );
-      m_stream << _input;
-      m_stream.precision( saveState );
+      printNumber( _input );
       return maybeSpace();
     }
 
@@ -460,7 +469,8 @@ namespace vx::logger {
       else if constexpr ( ratio.num == std::micro::num && ratio.den == std::micro::den ) { literal = "us"; }
       else if constexpr ( ratio.num == std::nano::num && ratio.den == std::nano::den ) { literal = "ns"; }
 
-      m_stream << _input.count() << ' ';
+      printNumber( _input.count() );
+      m_stream << ' ';
 
       if ( literal.empty() ) { m_stream << "unsupported " << '(' << ratio.num << '/' << ratio.den << ')'; }
       else { m_stream << literal; }
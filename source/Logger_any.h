@@ -142,7 +142,7 @@ namespace vx::logger {
     }
     else {
 
-      _logger.stream() << "unregistered: " << demangle::extreme( _any.type().name() );
+      _logger.stream() << "unregistered: " << demangle::cached( _any.type() );
     }
   }
 
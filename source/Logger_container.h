@@ -65,7 +65,7 @@ namespace vx::logger {
   Logger &operator<<( Logger &_logger,
                       const std::optional<T> &_optional ) noexcept {
 
-    _logger.stream() << demangle::extreme( typeid( _optional ).name() ) << ' ';
+    _logger.stream() << demangle::cached<std::optional<T>>() << ' ';
     if ( _optional ) {
 
       const bool saveState = _logger.autoSpace();
@@ -115,7 +115,7 @@ namespace vx::logger {
     const func noPrint = [ &checkComma, &printComma ]() noexcept { checkComma = printComma; };
     checkComma = noPrint;
 
-    _logger.stream() << demangle::extreme( typeid( _list ).name() ) << ' ' << '{';
+    _logger.stream() << demangle::cached<List>() << ' ' << '{';
     for ( const auto &value : _list ) {
 
       try {
@@ -203,7 +203,7 @@ namespace vx::logger {
     const func noPrint = [ &checkComma, &printComma ]() noexcept { checkComma = printComma; };
     checkComma = noPrint;
 
-    _logger.stream() << demangle::extreme( typeid( _map ).name() ) << ' ' << '{';
+    _logger.stream() << demangle::cached<T>() << ' ' << '{';
     for ( const auto &[ key, value ] : _map ) {
 
       try {
@@ -282,7 +282,7 @@ namespace vx::logger {
     const func noPrint = [ &checkComma, &printComma ]() noexcept { checkComma = printComma; };
     checkComma = noPrint;
 
-    _logger.stream() << demangle::extreme( typeid( _tuple ).name() ) << ' ' << '{';
+    _logger.stream() << demangle::cached<T>() << ' ' << '{';
     std::size_t tupleSize = std::tuple_size_v<T>;
     for ( std::size_t pos = 0; pos < tupleSize; pos++ ) {
 
@@ -324,7 +324,7 @@ namespace vx::logger {
   Logger &printVariant( Logger &_logger,
                         const T &_variant ) noexcept {
 
-    _logger.stream() << demangle::extreme( typeid( _variant ).name() ) << ' ';
+    _logger.stream() << demangle::cached<T>() << ' ';
     std::size_t variantSize = std::variant_size_v<T>;
     for ( std::size_t pos = 0; pos < variantSize; pos++ ) {
 
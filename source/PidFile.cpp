@@ -0,0 +1,263 @@
+/*
+ * Copyright (c) 2020 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* c header */
+#include <cerrno>
+#include <cstddef> // std::size_t
+#include <cstdint> // std::int32_t
+#include <cstdlib> // mkostemp
+
+/* system header */
+#include <fcntl.h> // open, O_CLOEXEC
+#include <signal.h> // kill
+#include <sys/file.h> // flock
+#include <sys/stat.h> // fstat, stat, fchmod
+#include <unistd.h>
+
+/* stl header */
+#include <array>
+#include <charconv>
+#include <exception>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+/* local header */
+#include "Logger.h"
+#include "PidFile.h"
+
+namespace vx::service {
+
+  /** @brief Maximum attempts, if other instances replace the PID file at the same time. */
+  constexpr std::int32_t maxAttempts = 16;
+
+  namespace {
+
+    /**
+     * @brief Log a failed system call with errno.
+     * @param _function   Failed system call.
+     */
+    void logFailure( std::string_view _function ) noexcept {
+
+      const std::int32_t error = errno;
+      try {
+
+        logError() << "PidFile" << _function << "failed. Error:" << std::error_code( error, std::generic_category() ).message();
+      }
+      catch ( const std::exception &_exception ) { // NOSONAR fallback for every exeption.
+
+        logFatal() << _exception.what();
+      }
+    }
+
+    /**
+     * @brief Read the PID of a PID file.
+     * @param _descriptor   Descriptor of the PID file.
+     * @return PID - zero, if there is none.
+     */
+    pid_t readPid( std::int32_t _descriptor ) noexcept {
+
+      std::array<char, 32> buffer {};
+      const ssize_t size = ::pread( _descriptor, buffer.data(), buffer.size(), 0 );
+      if ( size <= 0 ) {
+
+        return 0;
+      }
+      pid_t pid = 0;
+      const auto [ end, error ] = std::from_chars( buffer.data(), buffer.data() + size, pid );
+      return error == std::errc {} && pid > 0 ? pid : 0;
+    }
+
+    /**
+     * @brief Is a process running?
+     * @param _pid   PID of the process.
+     * @return True, if the process exists, even of another user - otherwise false.
+     */
+    bool isRunning( pid_t _pid ) noexcept {
+
+      return ::kill( _pid, 0 ) == 0 || errno == EPERM;
+    }
+
+    /**
+     * @brief Is a descriptor still the file at a path?
+     * @param _descriptor   Descriptor.
+     * @param _path   Path.
+     * @return True, if both are the same file - otherwise false.
+     */
+    bool isCurrent( std::int32_t _descriptor,
+                    const std::string &_path ) noexcept {
+
+      struct stat opened {};
+      struct stat current {};
+      return ::fstat( _descriptor, &opened ) == 0 && ::stat( _path.c_str(), &current ) == 0 && opened.st_dev == current.st_dev && opened.st_ino == current.st_ino;
+    }
+
+    /**
+     * @brief Write a string completely.
+     * @param _descriptor   Descriptor.
+     * @param _data   String to write.
+     * @return True, if the string is written - otherwise false.
+     */
+    bool writeAll( std::int32_t _descriptor,
+                   std::string_view _data ) noexcept {
+
+      while ( !_data.empty() ) {
+
+        const ssize_t size = ::write( _descriptor, _data.data(), _data.size() );
+        if ( size < 0 && errno == EINTR ) {
+
+          continue;
+        }
+        if ( size <= 0 ) {
+
+          return false;
+        }
+        _data.remove_prefix( static_cast<std::size_t>( size ) );
+      }
+      return true;
+    }
+  }
+
+  PidFile::PidFile( const std::string &_path )
+    : m_path( _path ) {
+
+    acquire();
+  }
+
+  PidFile::~PidFile() noexcept {
+
+    if ( m_descriptor >= 0 ) {
+
+      /* Nobody else replaces a locked PID file, but check it anyway. */
+      if ( isCurrent( m_descriptor, m_path ) ) {
+
+        ::unlink( m_path.c_str() );
+      }
+      ::close( m_descriptor );
+    }
+  }
+
+  bool PidFile::acquire() {
+
+    std::string temporary = m_path + ".XXXXXX";
+    const std::int32_t descriptor = ::mkostemp( temporary.data(), O_CLOEXEC );
+    if ( descriptor < 0 ) {
+
+      logFailure( "mkostemp()" );
+      return false;
+    }
+
+    /* The new file is locked before anyone can see it. */
+    const std::string pid = std::to_string( ::getpid() ) + '\n';
+    const bool written = ::fchmod( descriptor, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH ) == 0 && ::flock( descriptor, LOCK_EX | LOCK_NB ) == 0 && writeAll( descriptor, pid );
+    if ( !written ) {
+
+      logFailure( "write()" );
+    }
+    if ( !written || !replace( temporary ) ) {
+
+      ::unlink( temporary.c_str() );
+      ::close( descriptor );
+      return false;
+    }
+    m_descriptor = descriptor;
+    return true;
+  }
+
+  bool PidFile::replace( const std::string &_temporary ) noexcept {
+
+    for ( std::int32_t attempt = 0; attempt < maxAttempts; ++attempt ) {
+
+      const std::int32_t current = ::open( m_path.c_str(), O_RDONLY | O_CLOEXEC | O_NOFOLLOW );
+      if ( current < 0 ) {
+
+        if ( errno != ENOENT ) {
+
+          logFailure( "open()" );
+          return false;
+        }
+
+        /* No PID file yet - link() fails, if another instance was faster. */
+        if ( ::link( _temporary.c_str(), m_path.c_str() ) == 0 ) {
+
+          ::unlink( _temporary.c_str() );
+          return true;
+        }
+        if ( errno != EEXIST ) {
+
+          logFailure( "link()" );
+          return false;
+        }
+        continue;
+      }
+
+      /* The lock of the PID file is held by the running instance. */
+      if ( ::flock( current, LOCK_EX | LOCK_NB ) != 0 ) {
+
+        if ( errno == EWOULDBLOCK ) {
+
+          m_owner = readPid( current );
+        }
+        else {
+
+          logFailure( "flock()" );
+        }
+        ::close( current );
+        return false;
+      }
+
+      /* Replaced or removed by another instance between open() and flock() */
+      if ( !isCurrent( current, m_path ) ) {
+
+        ::close( current );
+        continue;
+      }
+
+      /* Unlocked PID file of a running process, which does not lock its PID file */
+      if ( const pid_t pid = readPid( current ); pid > 0 && pid != ::getpid() && isRunning( pid ) ) {
+
+        m_owner = pid;
+        ::close( current );
+        return false;
+      }
+
+      /* Stale or empty PID file, replaced while its lock is held. */
+      const bool renamed = ::rename( _temporary.c_str(), m_path.c_str() ) == 0;
+      if ( !renamed ) {
+
+        logFailure( "rename()" );
+      }
+      ::close( current );
+      return renamed;
+    }
+    logError() << "PidFile" << m_path << "is replaced too often.";
+    return false;
+  }
+}
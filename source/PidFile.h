@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2020 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+/* c header */
+#include <cstdint> // std::int32_t
+
+/* system header */
+#include <sys/types.h> // pid_t
+
+/* stl header */
+#include <string>
+
+/**
+ * @brief vx (VX APPS) service namespace.
+ */
+namespace vx::service {
+
+  /**
+   * @brief PID file, which guarantees a single running instance.
+   * The file is locked by flock() for the lifetime of the object, so the lock vanishes with the process, even after a
+   * crash. The PID is written to a temporary file first, which replaces the PID file by link() or rename() - readers never
+   * see a partial PID. A PID file without lock, e.g. of an older version, is stale, if its process is not running anymore.
+   * Create the PID file after daemonize(), the lock belongs to the open file description.
+   * @author Florian Becker <fb\@vxapps.com> (VX APPS)
+   */
+  class PidFile {
+
+  public:
+    /**
+     * @brief Constructor for PidFile - locks and writes the PID file.
+     * @param _path   Path of the PID file, e.g. /run/name.pid.
+     */
+    explicit PidFile( const std::string &_path );
+
+    /**
+     * @brief Delete copy constructor.
+     */
+    PidFile( const PidFile & ) = delete;
+
+    /**
+     * @brief Delete move constructor.
+     */
+    PidFile( PidFile && ) = delete;
+
+    /**
+     * @brief Delete copy assign.
+     * @return Nothing.
+     */
+    PidFile &operator=( const PidFile & ) = delete;
+
+    /**
+     * @brief Delete move assign.
+     * @return Nothing.
+     */
+    PidFile &operator=( PidFile && ) = delete;
+
+    /**
+     * @brief Default destructor for PidFile - removes the PID file and releases the lock.
+     */
+    virtual ~PidFile() noexcept;
+
+    /**
+     * @brief Is this process the only running instance?
+     * @return True, if the PID file is locked - otherwise false.
+     */
+    [[nodiscard]] inline bool isLocked() const noexcept { return m_descriptor >= 0; }
+
+    /**
+     * @brief Return the PID of the running instance, if the PID file is not locked.
+     * @return PID of the other instance - zero, if there is none or it is unknown.
+     */
+    [[nodiscard]] inline pid_t owner() const noexcept { return m_owner; }
+
+  private:
+    /**
+     * @brief Lock and write the PID file.
+     * @return True, if the PID file is locked - otherwise false.
+     * @note This function may throw an exception by std::string.
+     */
+    bool acquire();
+
+    /**
+     * @brief Replace the PID file by the locked temporary file.
+     * @param _temporary   Path of the temporary file.
+     * @return True, if the PID file is replaced - otherwise false.
+     */
+    bool replace( const std::string &_temporary ) noexcept;
+
+    /**
+     * @brief Member for the path of the PID file.
+     */
+    std::string m_path {};
+
+    /**
+     * @brief Member for the locked descriptor of the PID file.
+     */
+    std::int32_t m_descriptor = -1;
+
+    /**
+     * @brief Member for the PID of the running instance.
+     */
+    pid_t m_owner = 0;
+  };
+}
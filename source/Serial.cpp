@@ -33,18 +33,33 @@
 #include <cstddef> // std::size_t
 #include <cstdint> // std::int32_t
 #include <cstdio>
-#include <cstring> // strerror_r
 
 /* system header */
+#include <poll.h>
 #include <sys/fcntl.h> // open
+#ifdef __linux__
+  #include <sys/epoll.h>
+#endif
+#ifdef __APPLE__
+  #include <IOKit/serial/ioss.h> // IOSSIOSPEED
+  #include <sys/ioctl.h>
+#endif
+#include <sys/uio.h> // iovec, readv, writev
 #include <termios.h>
 #include <unistd.h> // write, read, close
 
 /* stl header */
+#include <algorithm>
+#include <array>
 #include <chrono>
 #include <exception>
+#include <limits>
+#include <memory>
 #include <new> // std::bad_alloc
+#include <optional>
 #include <string>
+#include <string_view>
+#include <system_error>
 #include <tuple>
 #include <utility>
 #include <vector>
@@ -53,20 +68,88 @@
 #include "Cpp23.h"
 #include "Logger.h"
 #include "Serial.h"
+#ifdef __linux__
+  #include "Serial_linux.h"
+#endif
 
 namespace vx {
 
-  /** @brief Flush duration in milliseconds. */
-  constexpr std::int32_t flushDurationMs = 150;
-
   /** @brief Buffer size to read std out. */
   constexpr std::int32_t bufferSize = 1024;
 
-  /** @brief Buffer size for errno. */
-  constexpr std::int32_t errnoBufferSize = 128;
+  /** @brief Buffer size of the poller - one read per readable device. */
+  constexpr std::size_t pollerBufferSize = 4096;
+
+  /** @brief Number of buffers of one writev(). */
+  constexpr std::size_t maxWriteBuffers = 16;
+
+  /** @brief Maximum events of one epoll_wait(). */
+  constexpr std::int32_t maxEvents = 64;
+
+  namespace {
+
+    /** @brief Baud rates with a speed constant of termios. */
+    constexpr std::array standardSpeeds {
+      std::pair<std::uint32_t, speed_t> { 9600, B9600 },
+      std::pair<std::uint32_t, speed_t> { 19200, B19200 },
+      std::pair<std::uint32_t, speed_t> { 38400, B38400 },
+      std::pair<std::uint32_t, speed_t> { 57600, B57600 },
+      std::pair<std::uint32_t, speed_t> { 115200, B115200 },
+      std::pair<std::uint32_t, speed_t> { 230400, B230400 },
+#ifdef B4000000
+      std::pair<std::uint32_t, speed_t> { 460800, B460800 },
+      std::pair<std::uint32_t, speed_t> { 500000, B500000 },
+      std::pair<std::uint32_t, speed_t> { 576000, B576000 },
+      std::pair<std::uint32_t, speed_t> { 921600, B921600 },
+      std::pair<std::uint32_t, speed_t> { 1000000, B1000000 },
+      std::pair<std::uint32_t, speed_t> { 1152000, B1152000 },
+      std::pair<std::uint32_t, speed_t> { 1500000, B1500000 },
+      std::pair<std::uint32_t, speed_t> { 2000000, B2000000 },
+      std::pair<std::uint32_t, speed_t> { 2500000, B2500000 },
+      std::pair<std::uint32_t, speed_t> { 3000000, B3000000 },
+      std::pair<std::uint32_t, speed_t> { 3500000, B3500000 },
+      std::pair<std::uint32_t, speed_t> { 4000000, B4000000 }
+#endif
+    };
+
+    /**
+     * @brief Return the speed constant of a baud rate.
+     * @param _baudrate   Baud rate.
+     * @return The speed constant - std::nullopt if the rate has none.
+     */
+    std::optional<speed_t> standardSpeed( std::uint32_t _baudrate ) noexcept {
+
+      const auto *standard = std::find_if( standardSpeeds.cbegin(), standardSpeeds.cend(), [ _baudrate ]( const std::pair<std::uint32_t, speed_t> &_standard ) { return _standard.first == _baudrate; } );
+      if ( standard == standardSpeeds.cend() ) {
+
+        return std::nullopt;
+      }
+      return standard->second;
+    }
+
+    /**
+     * @brief Set a baud rate without speed constant.
+     * @param _descriptor   Descriptor.
+     * @param _baudrate   Baud rate.
+     * @return True, if the baud rate is set - otherwise false.
+     */
+    bool setOtherSpeed( [[maybe_unused]] std::int32_t _descriptor,
+                        [[maybe_unused]] std::uint32_t _baudrate ) noexcept {
+
+#ifdef __linux__
+      return serial::setCustomBaudrate( _descriptor, _baudrate );
+#elif defined __APPLE__
+      speed_t speed = _baudrate;
+      return ::ioctl( _descriptor, IOSSIOSPEED, &speed ) == 0;
+#else
+      return false;
+#endif
+    }
+  }
 
   Serial::Serial( const std::string &_path,
-                  Baudrate _baudrate ) noexcept
+                  Baudrate _baudrate,
+                  [[maybe_unused]] Latency _latency ) noexcept
     : m_descriptor( ::open( _path.c_str(), ( O_RDWR | O_NOCTTY | O_NONBLOCK ) ) ) {
 
     /* Open port, checking for errors */
@@ -76,38 +159,28 @@ namespace vx {
       return;
     }
 
-    /* Configure i/o baud rate settings */
+    /* Configure i/o baud rate settings, other rates follow after the settings. */
     struct termios options = {};
     tcgetattr( m_descriptor, &options );
-    switch ( _baudrate ) {
+    const auto rate = static_cast<std::uint32_t>( std::to_underlying( _baudrate ) );
+    const std::optional<speed_t> speed = standardSpeed( rate );
+    if ( speed ) {
 
-      case Baudrate::Speed9600:
-        cfsetispeed( &options, B9600 );
-        cfsetospeed( &options, B9600 );
-        break;
-      case Baudrate::Speed19200:
-        cfsetispeed( &options, B19200 );
-        cfsetospeed( &options, B19200 );
-        break;
-      case Baudrate::Speed38400:
-        cfsetispeed( &options, B38400 );
-        cfsetospeed( &options, B38400 );
-        break;
-      case Baudrate::Speed57600:
-        cfsetispeed( &options, B57600 );
-        cfsetospeed( &options, B57600 );
-        break;
+      cfsetispeed( &options, *speed );
+      cfsetospeed( &options, *speed );
     }
 
     /* Configure other settings */
     /* Settings from: */
     /* https://github.com/Marzac/rs232/blob/master/rs232-linux.c */
-    options.c_iflag &= static_cast<std::uint64_t>( ~( INLCR | ICRNL ) );
+    /* Binary frames need a transparent line - no software flow control, no stripping, no translation. */
+    options.c_iflag &= static_cast<std::uint64_t>( ~( INLCR | ICRNL | IGNCR | IXON | IXOFF | IXANY | ISTRIP | PARMRK ) );
     options.c_iflag |= IGNPAR | IGNBRK;
     options.c_oflag &= static_cast<std::uint64_t>( ~( OPOST | ONLCR | OCRNL ) );
     options.c_cflag &= static_cast<std::uint64_t>( ~( PARENB | PARODD | CSTOPB | CSIZE | CRTSCTS ) );
     options.c_cflag |= CLOCAL | CREAD | CS8;
-    options.c_lflag &= static_cast<std::uint64_t>( ~( ICANON | ISIG | ECHO ) );
+    options.c_lflag &= static_cast<std::uint64_t>( ~( ICANON | ISIG | ECHO | ECHONL | IEXTEN ) );
+    /* Without effect for the non-blocking descriptor, reads wait by poll() with their timeouts. */
     options.c_cc[ VTIME ] = 1;
     options.c_cc[ VMIN ] = 0;
 
@@ -119,91 +192,236 @@ namespace vx {
       close();
       return;
     }
+    if ( !speed && !setOtherSpeed( m_descriptor, rate ) ) {
+
+      logFatal() << "Unsupported baud rate:" << rate << "for serial port:" << _path;
+      close();
+      return;
+    }
+#ifdef __linux__
+    if ( _latency == Latency::Low && !serial::setLowLatency( m_descriptor ) ) {
+
+      logWarning() << "Low latency is not supported by serial port:" << _path;
+    }
+#endif
     m_isOpen = true;
   }
 
-  Serial::~Serial() noexcept {
+  std::uint32_t Serial::baudrate() const noexcept {
 
-    if ( m_isOpen ) {
+#ifdef __linux__
+    return serial::customBaudrate( m_descriptor );
+#else
+    struct termios options = {};
+    if ( tcgetattr( m_descriptor, &options ) < 0 ) {
 
-      close();
+      return 0;
     }
+    const speed_t speed = cfgetospeed( &options );
+    const auto *standard = std::find_if( standardSpeeds.cbegin(), standardSpeeds.cend(), [ speed ]( const std::pair<std::uint32_t, speed_t> &_standard ) { return _standard.second == speed; } );
+    return standard == standardSpeeds.cend() ? static_cast<std::uint32_t>( speed ) : standard->first;
+#endif
+  }
+
+  Serial::~Serial() noexcept {
+
+    close();
   }
 
   namespace {
 
     /**
-     * @brief Return timestamp in milliseconds.
-     * @return Timestamp in milliseconds.
+     * @brief Log a failed system call with errno.
+     * @param _function   Failed system call.
      */
-    inline std::chrono::milliseconds timestampMs() noexcept {
+    void logFailure( std::string_view _function ) noexcept {
+
+      const std::int32_t error = errno;
+      try {
+
+        logError() << "Serial port" << _function << "failed. Error:" << std::error_code( error, std::generic_category() ).message();
+      }
+      catch ( const std::exception &_exception ) { // NOSONAR fallback for every exeption.
 
-      return std::chrono::duration_cast<std::chrono::milliseconds>( std::chrono::steady_clock::now().time_since_epoch() );
+        logFatal() << _exception.what();
+      }
     }
-  }
 
-  bool Serial::flush() const {
+    /**
+     * @brief Read available data without blocking.
+     * @param _descriptor   Descriptor.
+     * @param _data   Buffer.
+     * @param _size   Size of the buffer.
+     * @return Number of bytes read, 0 if nothing is available - -1 for an error or hang up.
+     */
+    ssize_t readAvailable( std::int32_t _descriptor,
+                           char *_data,
+                           std::size_t _size ) noexcept {
 
-    const std::chrono::milliseconds startTimestampMs = timestampMs();
-    while ( timestampMs().count() - startTimestampMs.count() < flushDurationMs ) {
+      while ( true ) {
 
-      const std::string result = read();
-      if ( result.empty() ) {
+        const ssize_t size = ::read( _descriptor, _data, _size );
+        if ( size > 0 ) {
 
-        std::vector<char> errnoBuffer {};
-        try {
+          return size;
+        }
+        if ( size < 0 && errno == EINTR ) {
 
-          errnoBuffer.resize( errnoBufferSize );
+          continue;
         }
-        catch ( const std::bad_alloc &_exception ) {
+        if ( size < 0 && ( errno == EAGAIN || errno == EWOULDBLOCK ) ) {
 
-          logFatal() << "bad_alloc:" << _exception.what();
+          return 0;
         }
-        catch ( const std::exception &_exception ) { // NOSONAR fallback for every exeption.
+        if ( size < 0 ) {
 
-          logFatal() << _exception.what();
+          logFailure( "read()" );
         }
-        std::ignore = strerror_r( errno, errnoBuffer.data(), errnoBuffer.size() );
-        logError() << "Serial port read() failed. Error:" << std::string( std::cbegin( errnoBuffer ), std::cend( errnoBuffer ) );
-        return false;
+        return -1;
       }
     }
+
+    /**
+     * @brief Wait for the events of descriptors.
+     * @param _descriptors   Descriptors to wait for.
+     * @param _timeout   Timeout in milliseconds - negative waits forever.
+     * @return Number of descriptors with events, 0 for a timeout - -1 for an error.
+     */
+    std::int32_t waitEvents( pollfd *_descriptors,
+                             std::size_t _count,
+                             std::int32_t _timeout ) noexcept {
+
+      std::int32_t result = -1;
+      do {
+
+        result = ::poll( _descriptors, _count, _timeout );
+      } while ( result < 0 && errno == EINTR );
+      if ( result < 0 ) {
+
+        logFailure( "poll()" );
+      }
+      return result;
+    }
+
+    /**
+     * @brief Write buffers completely - a partial write continues with the rest, when the device is writable again.
+     * @param _descriptor   Descriptor.
+     * @param _buffers   Buffers, which are advanced by the written bytes.
+     * @param _count   Number of buffers.
+     * @return True, if everything is written - otherwise false.
+     */
+    bool writeVector( std::int32_t _descriptor,
+                      iovec *_buffers,
+                      std::size_t _count ) noexcept {
+
+      while ( _count > 0 && _buffers->iov_len == 0 ) {
+
+        ++_buffers;
+        --_count;
+      }
+      while ( _count > 0 ) {
+
+        const ssize_t written = ::writev( _descriptor, _buffers, static_cast<std::int32_t>( _count ) );
+        if ( written < 0 ) {
+
+          if ( errno == EINTR ) {
+
+            continue;
+          }
+          if ( errno != EAGAIN && errno != EWOULDBLOCK ) {
+
+            logFailure( "writev()" );
+            return false;
+          }
+          pollfd descriptor { _descriptor, POLLOUT, 0 };
+          if ( waitEvents( &descriptor, 1, -1 ) < 0 ) {
+
+            return false;
+          }
+          continue;
+        }
+        auto rest = static_cast<std::size_t>( written );
+        while ( _count > 0 && rest >= _buffers->iov_len ) {
+
+          rest -= _buffers->iov_len;
+          ++_buffers;
+          --_count;
+        }
+        if ( _count > 0 ) {
+
+          _buffers->iov_base = static_cast<char *>( _buffers->iov_base ) + rest;
+          _buffers->iov_len -= rest;
+        }
+      }
+      return true;
+    }
+
+    /**
+     * @brief Convert a duration to a poll() timeout.
+     * @param _timeout   Duration - negative waits forever.
+     * @return Timeout in milliseconds.
+     */
+    std::int32_t toTimeout( std::chrono::milliseconds _timeout ) noexcept {
+
+      if ( _timeout.count() < 0 ) {
+
+        return -1;
+      }
+      return static_cast<std::int32_t>( std::min<std::chrono::milliseconds::rep>( _timeout.count(), std::numeric_limits<std::int32_t>::max() ) );
+    }
+  }
+
+  bool Serial::flush() const noexcept {
+
+    if ( ::tcflush( m_descriptor, TCIFLUSH ) < 0 ) {
+
+      logFailure( "tcflush()" );
+      return false;
+    }
     return true;
   }
 
   bool Serial::write( const std::string &_data ) const noexcept {
 
-    if ( ::write( m_descriptor, _data.c_str(), _data.size() ) < 0 ) {
+    return write( reinterpret_cast<const std::byte *>( _data.data() ), _data.size() );
+  }
 
-      std::vector<char> errnoBuffer {};
-      try {
+  bool Serial::write( const std::byte *_data,
+                      std::size_t _size ) const noexcept {
 
-        errnoBuffer.resize( errnoBufferSize );
-      }
-      catch ( const std::bad_alloc &_exception ) {
+    iovec buffer { const_cast<std::byte *>( _data ), _size };
+    return writeVector( m_descriptor, &buffer, 1 );
+  }
+
+#ifdef HAVE_SPAN
+  bool Serial::write( std::span<const std::span<const std::byte>> _buffers ) const noexcept {
 
-        logFatal() << "bad_alloc:" << _exception.what();
+    /* The buffers are written in chunks on the stack. */
+    std::array<iovec, maxWriteBuffers> buffers {};
+    while ( !_buffers.empty() ) {
+
+      const std::size_t count = std::min( _buffers.size(), buffers.size() );
+      for ( std::size_t index = 0; index < count; ++index ) {
+
+        buffers[ index ] = { const_cast<std::byte *>( _buffers[ index ].data() ), _buffers[ index ].size() };
       }
-      catch ( const std::exception &_exception ) { // NOSONAR fallback for every exeption.
+      if ( !writeVector( m_descriptor, buffers.data(), count ) ) {
 
-        logFatal() << _exception.what();
+        return false;
       }
-      std::ignore = strerror_r( errno, errnoBuffer.data(), errnoBuffer.size() );
-      logError() << "Serial port write() failed. Error:" << std::string( std::cbegin( errnoBuffer ), std::cend( errnoBuffer ) );
-      return false;
+      _buffers = _buffers.subspan( count );
     }
     return true;
   }
+#endif
 
   std::string Serial::read() const {
 
-    std::vector<char> buffer {};
-    ssize_t numBytesRead {};
+    std::string result {};
     try {
 
-      buffer.resize( bufferSize );
-      numBytesRead = ::read( m_descriptor, buffer.data(), buffer.size() );
-      buffer.resize( static_cast<std::size_t>( numBytesRead ) );
+      result.resize( bufferSize );
+      result.resize( read( reinterpret_cast<std::byte *>( result.data() ), result.size() ) );
     }
     catch ( const std::bad_alloc &_exception ) {
 
@@ -213,34 +431,291 @@ namespace vx {
 
       logFatal() << _exception.what();
     }
-    if ( numBytesRead < 0 ) {
+    return result;
+  }
 
-      std::vector<char> errnoBuffer {};
-      try {
+  std::size_t Serial::read( std::byte *_data,
+                            std::size_t _size ) const noexcept {
+
+    return static_cast<std::size_t>( std::max<ssize_t>( readAvailable( m_descriptor, reinterpret_cast<char *>( _data ), _size ), 0 ) );
+  }
+
+  void Serial::setReceiveBuffer( std::size_t _capacity ) {
+
+    m_receiveBuffer = std::make_unique<RingBuffer>( _capacity );
+  }
 
-        errnoBuffer.resize( errnoBufferSize );
+  std::size_t Serial::receive() noexcept {
+
+    if ( !m_receiveBuffer ) {
+
+      return 0;
+    }
+    const std::array<RingBuffer::Region, 2> regions = m_receiveBuffer->writeRegions();
+    std::array<iovec, 2> buffers { { { regions[ 0 ].data, regions[ 0 ].size }, { regions[ 1 ].data, regions[ 1 ].size } } };
+    const std::int32_t count = regions[ 1 ].size > 0 ? 2 : 1;
+    if ( regions[ 0 ].size == 0 ) {
+
+      return 0;
+    }
+    ssize_t size = -1;
+    do {
+
+      size = ::readv( m_descriptor, buffers.data(), count );
+    } while ( size < 0 && errno == EINTR );
+    if ( size < 0 ) {
+
+      if ( errno != EAGAIN && errno != EWOULDBLOCK ) {
+
+        logFailure( "readv()" );
+      }
+      return 0;
+    }
+    m_receiveBuffer->commit( static_cast<std::size_t>( size ) );
+    return static_cast<std::size_t>( size );
+  }
+
+  bool Serial::waitReadable( std::chrono::milliseconds _timeout ) const noexcept {
+
+    pollfd descriptor { m_descriptor, POLLIN, 0 };
+    return waitEvents( &descriptor, 1, toTimeout( _timeout ) ) > 0 && ( descriptor.revents & POLLIN ) != 0;
+  }
+
+  std::string Serial::readExactly( std::size_t _size,
+                                   std::chrono::milliseconds _timeout ) const {
+
+    std::string result( _size, '\0' );
+    std::size_t received = 0;
+    const auto deadline = std::chrono::steady_clock::now() + _timeout;
+    while ( received < _size ) {
+
+      const ssize_t size = readAvailable( m_descriptor, result.data() + received, _size - received );
+      if ( size < 0 ) {
+
+        break;
       }
-      catch ( const std::bad_alloc &_exception ) {
+      received += static_cast<std::size_t>( size );
+      if ( size > 0 ) {
 
-        logFatal() << "bad_alloc:" << _exception.what();
+        continue;
       }
-      catch ( const std::exception &_exception ) { // NOSONAR fallback for every exeption.
+      auto wait = std::chrono::duration_cast<std::chrono::milliseconds>( deadline - std::chrono::steady_clock::now() );
+      if ( received > 0 && m_interByteTimeout.count() > 0 ) {
 
-        logFatal() << _exception.what();
+        wait = std::min( wait, m_interByteTimeout );
+      }
+      if ( wait.count() <= 0 || !waitReadable( wait ) ) {
+
+        break;
       }
-      std::ignore = strerror_r( errno, errnoBuffer.data(), errnoBuffer.size() );
-      logError() << "Serial port read() failed. Error:" << std::string( std::cbegin( errnoBuffer ), std::cend( errnoBuffer ) );
-      return {};
     }
-    return { std::cbegin( buffer ), std::cend( buffer ) };
+    result.resize( received );
+    return result;
   }
 
   void Serial::close() noexcept {
 
-    if ( m_isOpen ) {
+    /* Also called by the constructor for a descriptor, which is opened, but not configured. */
+    if ( m_descriptor >= 0 ) {
 
       ::close( m_descriptor );
       m_descriptor = -1;
     }
+    m_isOpen = false;
+  }
+
+  SerialPoller::SerialPoller() noexcept {
+
+  #ifdef __linux__
+    if ( ::pipe2( m_wake.data(), O_CLOEXEC | O_NONBLOCK ) < 0 ) {
+
+      logFailure( "pipe2()" );
+      return;
+    }
+    m_epoll = ::epoll_create1( EPOLL_CLOEXEC );
+    if ( m_epoll < 0 ) {
+
+      logFailure( "epoll_create1()" );
+      return;
+    }
+    epoll_event event {};
+    event.events = EPOLLIN;
+    event.data.fd = m_wake[ 0 ];
+    ::epoll_ctl( m_epoll, EPOLL_CTL_ADD, m_wake[ 0 ], &event );
+  #else
+    if ( ::pipe( m_wake.data() ) < 0 ) {
+
+      logFailure( "pipe()" );
+      return;
+    }
+    for ( const std::int32_t descriptor : m_wake ) {
+
+      ::fcntl( descriptor, F_SETFD, FD_CLOEXEC );
+      ::fcntl( descriptor, F_SETFL, ::fcntl( descriptor, F_GETFL ) | O_NONBLOCK );
+    }
+  #endif
+  }
+
+  SerialPoller::~SerialPoller() noexcept {
+
+  #ifdef __linux__
+    if ( m_epoll >= 0 ) {
+
+      ::close( m_epoll );
+    }
+  #endif
+    for ( const std::int32_t descriptor : m_wake ) {
+
+      if ( descriptor >= 0 ) {
+
+        ::close( descriptor );
+      }
+    }
+  }
+
+  bool SerialPoller::add( Serial &_serial,
+                          ReadFunction _function ) {
+
+    if ( !_serial.isOpen() || m_wake[ 0 ] < 0 ) {
+
+      return false;
+    }
+  #ifdef __linux__
+    epoll_event event {};
+    event.events = EPOLLIN;
+    event.data.fd = _serial.descriptor();
+    if ( ::epoll_ctl( m_epoll, EPOLL_CTL_ADD, _serial.descriptor(), &event ) < 0 ) {
+
+      logFailure( "epoll_ctl()" );
+      return false;
+    }
+  #endif
+    m_ports.push_back( std::make_unique<Port>( Port { &_serial, std::move( _function ) } ) );
+    return true;
+  }
+
+  void SerialPoller::remove( const Serial &_serial ) noexcept {
+
+    const auto port = std::find_if( m_ports.begin(), m_ports.end(), [ &_serial ]( const std::unique_ptr<Port> &_port ) { return _port->serial == &_serial; } );
+    if ( port == m_ports.end() ) {
+
+      return;
+    }
+  #ifdef __linux__
+    ::epoll_ctl( m_epoll, EPOLL_CTL_DEL, _serial.descriptor(), nullptr );
+  #endif
+    /* A running read function is erased after poll(). */
+    ( *port )->serial = nullptr;
+    if ( !m_dispatching ) {
+
+      m_ports.erase( port );
+    }
+  }
+
+  std::size_t SerialPoller::size() const noexcept {
+
+    return static_cast<std::size_t>( std::count_if( m_ports.cbegin(), m_ports.cend(), []( const std::unique_ptr<Port> &_port ) { return _port->serial != nullptr; } ) );
+  }
+
+  std::size_t SerialPoller::poll( std::chrono::milliseconds _timeout ) {
+
+    if ( m_buffer.empty() ) {
+
+      m_buffer.resize( pollerBufferSize );
+    }
+    std::size_t handled = 0;
+    m_dispatching = true;
+  #ifdef __linux__
+    std::array<epoll_event, maxEvents> events {};
+    std::int32_t count = -1;
+    do {
+
+      count = ::epoll_wait( m_epoll, events.data(), maxEvents, toTimeout( _timeout ) );
+    } while ( count < 0 && errno == EINTR );
+    if ( count < 0 ) {
+
+      logFailure( "epoll_wait()" );
+      m_dispatching = false;
+      return 0;
+    }
+    for ( std::int32_t index = 0; index < count; ++index ) {
+
+      const epoll_event &event = events[ static_cast<std::size_t>( index ) ];
+      if ( event.data.fd == m_wake[ 0 ] ) {
+
+        while ( ::read( m_wake[ 0 ], m_buffer.data(), m_buffer.size() ) > 0 ) {}
+        continue;
+      }
+      dispatch( event.data.fd, ( event.events & ( EPOLLHUP | EPOLLERR ) ) != 0 && ( event.events & EPOLLIN ) == 0 );
+      ++handled;
+    }
+  #else
+    std::vector<pollfd> descriptors {};
+    descriptors.reserve( m_ports.size() + 1 );
+    descriptors.push_back( { m_wake[ 0 ], POLLIN, 0 } );
+    for ( const std::unique_ptr<Port> &port : m_ports ) {
+
+      descriptors.push_back( { port->serial->descriptor(), POLLIN, 0 } );
+    }
+    if ( waitEvents( descriptors.data(), descriptors.size(), toTimeout( _timeout ) ) <= 0 ) {
+
+      m_dispatching = false;
+      return 0;
+    }
+    if ( descriptors.front().revents != 0 ) {
+
+      while ( ::read( m_wake[ 0 ], m_buffer.data(), m_buffer.size() ) > 0 ) {}
+    }
+    for ( std::size_t index = 1; index < descriptors.size(); ++index ) {
+
+      if ( descriptors[ index ].revents != 0 ) {
+
+        dispatch( descriptors[ index ].fd, ( descriptors[ index ].revents & ( POLLHUP | POLLERR | POLLNVAL ) ) != 0 && ( descriptors[ index ].revents & POLLIN ) == 0 );
+        ++handled;
+      }
+    }
+  #endif
+    m_dispatching = false;
+    m_ports.erase( std::remove_if( m_ports.begin(), m_ports.end(), []( const std::unique_ptr<Port> &_port ) { return _port->serial == nullptr; } ), m_ports.end() );
+    return handled;
+  }
+
+  void SerialPoller::dispatch( std::int32_t _descriptor,
+                               bool _hangup ) {
+
+    /* A previous read function might have removed the device. */
+    const auto port = std::find_if( m_ports.cbegin(), m_ports.cend(), [ _descriptor ]( const std::unique_ptr<Port> &_port ) { return _port->serial != nullptr && _port->serial->descriptor() == _descriptor; } );
+    if ( port == m_ports.cend() ) {
+
+      return;
+    }
+    /* The port stays valid, even if the function adds or removes devices. */
+    Port &current = **port;
+    Serial &serial = *current.serial;
+    const ssize_t size = _hangup ? -1 : readAvailable( _descriptor, m_buffer.data(), m_buffer.size() );
+    if ( size > 0 ) {
+
+      current.function( serial, std::string_view( m_buffer.data(), static_cast<std::size_t>( size ) ) );
+    }
+    else if ( size < 0 ) {
+
+      remove( serial );
+      current.function( serial, {} );
+    }
+  }
+
+  void SerialPoller::run() {
+
+    while ( !m_stopped && size() > 0 ) {
+
+      std::ignore = poll( std::chrono::milliseconds( -1 ) );
+    }
+    m_stopped = false;
+  }
+
+  void SerialPoller::stop() noexcept {
+
+    m_stopped = true;
+    std::ignore = ::write( m_wake[ 1 ], "s", 1 );
   }
 }
@@ -31,10 +31,24 @@
 #pragma once
 
 /* c header */
-#include <cstdint> // std::int32_t
+#include <cstddef> // std::size_t
+#include <cstdint> // std::int32_t, std::uint32_t
 
 /* stl header */
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#ifdef HAVE_SPAN
+  #include <span>
+#endif
 #include <string>
+#include <string_view>
+#include <vector>
+
+/* local header */
+#include "RingBuffer.h"
 
 /**
  * @brief vx (VX APPS) namespace.
@@ -43,13 +57,38 @@ namespace vx {
 
   /**
    * @brief The Baudrate speed enum.
+   * The value is the rate, so any other rate is possible by static_cast<Baudrate>( rate ) - on Linux by termios2 and
+   * BOTHER, on macOS by IOSSIOSPEED.
    */
   enum class Baudrate {
 
-    Speed9600 = 9000,   /**< Baudrate of 9600. */
-    Speed19200 = 19200, /**< Baudrate of 19200. */
-    Speed38400 = 38400, /**< Baudrate of 38400. */
-    Speed57600 = 57600  /**< Baudrate of 57600. */
+    Speed9600 = 9600,       /**< Baudrate of 9600. */
+    Speed19200 = 19200,     /**< Baudrate of 19200. */
+    Speed38400 = 38400,     /**< Baudrate of 38400. */
+    Speed57600 = 57600,     /**< Baudrate of 57600. */
+    Speed115200 = 115200,   /**< Baudrate of 115200. */
+    Speed230400 = 230400,   /**< Baudrate of 230400. */
+    Speed460800 = 460800,   /**< Baudrate of 460800. */
+    Speed500000 = 500000,   /**< Baudrate of 500000. */
+    Speed576000 = 576000,   /**< Baudrate of 576000. */
+    Speed921600 = 921600,   /**< Baudrate of 921600. */
+    Speed1000000 = 1000000, /**< Baudrate of 1000000. */
+    Speed1152000 = 1152000, /**< Baudrate of 1152000. */
+    Speed1500000 = 1500000, /**< Baudrate of 1500000. */
+    Speed2000000 = 2000000, /**< Baudrate of 2000000. */
+    Speed2500000 = 2500000, /**< Baudrate of 2500000. */
+    Speed3000000 = 3000000, /**< Baudrate of 3000000. */
+    Speed3500000 = 3500000, /**< Baudrate of 3500000. */
+    Speed4000000 = 4000000  /**< Baudrate of 4000000. */
+  };
+
+  /**
+   * @brief The latency enum.
+   */
+  enum class Latency {
+
+    Default, /**< Driver defaults. */
+    Low      /**< ASYNC_LOW_LATENCY on Linux, the driver passes received data on without delay - no effect on other systems. */
   };
 
   /**
@@ -63,9 +102,11 @@ namespace vx {
      * @brief Default constructor for Serial.
      * @param _path   Device path.
      * @param _baudrate   Baudrate.
+     * @param _latency   Latency - a driver without low latency support only logs a warning.
      */
     explicit Serial( const std::string &_path,
-                     Baudrate _baudrate = Baudrate::Speed9600 ) noexcept;
+                     Baudrate _baudrate = Baudrate::Speed9600,
+                     Latency _latency = Latency::Default ) noexcept;
 
     /**
      * @brief Delete copy assign.
@@ -101,11 +142,16 @@ namespace vx {
     [[nodiscard]] inline bool isOpen() const noexcept { return m_isOpen; }
 
     /**
-     * @brief Flush the serial port.
+     * @brief Return the output baud rate of the device.
+     * @return The baud rate - 0 if unknown.
+     */
+    [[nodiscard]] std::uint32_t baudrate() const noexcept;
+
+    /**
+     * @brief Flush the serial port - discard received data, which was not read yet.
      * @return True, if flushing is successful - otherwise false.
-     * @note This function may throw an exception by the constructor of std::string.
      */
-    [[nodiscard]] bool flush() const;
+    [[nodiscard]] bool flush() const noexcept;
 
     /**
      * @brief Write data to the serial device.
@@ -114,6 +160,31 @@ namespace vx {
      */
     [[nodiscard]] bool write( const std::string &_data ) const noexcept;
 
+    /**
+     * @brief Write data completely to the serial device - a partial write continues, when the device is writable again.
+     * @param _data   Data written to the device.
+     * @param _size   Size of the data.
+     * @return True, if the data writing was successful - otherwise false.
+     */
+    [[nodiscard]] bool write( const std::byte *_data,
+                              std::size_t _size ) const noexcept;
+
+#ifdef HAVE_SPAN
+    /**
+     * @brief Write data completely to the serial device - a partial write continues, when the device is writable again.
+     * @param _data   Data written to the device.
+     * @return True, if the data writing was successful - otherwise false.
+     */
+    [[nodiscard]] inline bool write( std::span<const std::byte> _data ) const noexcept { return write( _data.data(), _data.size() ); }
+
+    /**
+     * @brief Write buffers completely by writev() without joining them, e.g. header and payload.
+     * @param _buffers   Buffers written to the device in order.
+     * @return True, if the data writing was successful - otherwise false.
+     */
+    [[nodiscard]] bool write( std::span<const std::span<const std::byte>> _buffers ) const noexcept;
+#endif
+
     /**
      * @brief Read data from the serial device.
      * @return Data read from the serial device.
@@ -121,6 +192,72 @@ namespace vx {
      */
     [[nodiscard]] std::string read() const;
 
+    /**
+     * @brief Read available data into a buffer of the caller without blocking.
+     * @param _data   Buffer.
+     * @param _size   Size of the buffer.
+     * @return Number of bytes read - 0 if nothing is available or on error.
+     */
+    [[nodiscard]] std::size_t read( std::byte *_data,
+                                    std::size_t _size ) const noexcept;
+
+#ifdef HAVE_SPAN
+    /**
+     * @brief Read available data into a buffer of the caller without blocking.
+     * @param _buffer   Buffer.
+     * @return Number of bytes read - 0 if nothing is available or on error.
+     */
+    [[nodiscard]] inline std::size_t read( std::span<std::byte> _buffer ) const noexcept { return read( _buffer.data(), _buffer.size() ); }
+#endif
+
+    /**
+     * @brief Wait until data is available without spinning.
+     * @param _timeout   Timeout - negative waits forever.
+     * @return True, if data is available - otherwise false.
+     */
+    [[nodiscard]] bool waitReadable( std::chrono::milliseconds _timeout ) const noexcept;
+
+    /**
+     * @brief Read an exact number of bytes and block until they are received.
+     * @param _size   Number of bytes.
+     * @param _timeout   Timeout for the whole read.
+     * @return Data read from the serial device - less than _size, if the timeout, the inter-byte timeout or an error occurs.
+     * @note This function may throw an exception by std::string.
+     */
+    [[nodiscard]] std::string readExactly( std::size_t _size,
+                                           std::chrono::milliseconds _timeout ) const;
+
+    /**
+     * @brief Set the maximum gap between two bytes of one readExactly().
+     * @param _timeout   Inter-byte timeout - zero disables it.
+     */
+    inline void setInterByteTimeout( std::chrono::milliseconds _timeout ) noexcept { m_interByteTimeout = _timeout; }
+
+    /**
+     * @brief Return the maximum gap between two bytes of one readExactly().
+     * @return The inter-byte timeout - zero is disabled.
+     */
+    [[nodiscard]] inline std::chrono::milliseconds interByteTimeout() const noexcept { return m_interByteTimeout; }
+
+    /**
+     * @brief Create the receive buffer, which decouples a reading thread from a consuming thread.
+     * @param _capacity   Capacity, rounded up to a power of two.
+     * @note This function may throw an exception by new.
+     */
+    void setReceiveBuffer( std::size_t _capacity );
+
+    /**
+     * @brief Read available data directly into the free space of the receive buffer - only from the producer thread.
+     * @return Number of bytes received - 0 if nothing is available, the buffer is full or missing.
+     */
+    [[nodiscard]] std::size_t receive() noexcept;
+
+    /**
+     * @brief Return the receive buffer - the consumer thread reads it.
+     * @return The receive buffer - nullptr without setReceiveBuffer().
+     */
+    [[nodiscard]] inline RingBuffer *receiveBuffer() noexcept { return m_receiveBuffer.get(); }
+
     /**
      * @brief Descriptor of the current device.
      * @return The descriptor of the serial device - -1 is not a valid descriptor.
@@ -142,5 +279,156 @@ namespace vx {
      * @brief Member for descriptor.
      */
     std::int32_t m_descriptor = -1;
+
+    /**
+     * @brief Member for the inter-byte timeout.
+     */
+    std::chrono::milliseconds m_interByteTimeout { 0 };
+
+    /**
+     * @brief Member for the receive buffer.
+     */
+    std::unique_ptr<RingBuffer> m_receiveBuffer {};
+  };
+
+  /**
+   * @brief Event loop for many serial devices in one thread.
+   * The devices are watched by epoll on Linux and by poll otherwise, a callback gets the data of a readable device.
+   * @author Florian Becker <fb\@vxapps.com> (VX APPS)
+   */
+  class SerialPoller {
+
+  public:
+    /**
+     * @brief Function for received data - gets the device and the data, which is only valid during the call.
+     * Empty data means the device hung up and was removed.
+     */
+    using ReadFunction = std::function<void( Serial &, std::string_view )>;
+
+    /**
+     * @brief Default constructor for SerialPoller.
+     */
+    SerialPoller() noexcept;
+
+    /**
+     * @brief Delete copy constructor.
+     */
+    SerialPoller( const SerialPoller & ) = delete;
+
+    /**
+     * @brief Delete move constructor.
+     */
+    SerialPoller( SerialPoller && ) = delete;
+
+    /**
+     * @brief Delete copy assign.
+     * @return Nothing.
+     */
+    SerialPoller &operator=( const SerialPoller & ) = delete;
+
+    /**
+     * @brief Delete move assign.
+     * @return Nothing.
+     */
+    SerialPoller &operator=( SerialPoller && ) = delete;
+
+    /**
+     * @brief Default destructor for SerialPoller.
+     */
+    virtual ~SerialPoller() noexcept;
+
+    /**
+     * @brief Watch a device.
+     * @param _serial   Open device, which must outlive the watching.
+     * @param _function   Function for received data.
+     * @return True, if the device is watched - otherwise false.
+     * @note This function may throw an exception by std::vector.
+     */
+    [[nodiscard]] bool add( Serial &_serial,
+                            ReadFunction _function );
+
+    /**
+     * @brief Stop watching a device - allowed inside a read function.
+     * @param _serial   Device.
+     */
+    void remove( const Serial &_serial ) noexcept;
+
+    /**
+     * @brief Number of watched devices.
+     * @return The number of watched devices.
+     */
+    [[nodiscard]] std::size_t size() const noexcept;
+
+    /**
+     * @brief Wait once for readable devices and call their read functions.
+     * @param _timeout   Timeout - negative waits forever.
+     * @return Number of handled events.
+     * @note This function may throw an exception by the read functions.
+     */
+    std::size_t poll( std::chrono::milliseconds _timeout );
+
+    /**
+     * @brief Call poll() until stop() is called or no device is left.
+     * @note This function may throw an exception by the read functions.
+     */
+    void run();
+
+    /**
+     * @brief Stop run() - allowed from another thread.
+     */
+    void stop() noexcept;
+
+  private:
+    /**
+     * @brief Watched device.
+     */
+    struct Port {
+
+      /** @brief Device. */
+      Serial *serial = nullptr;
+
+      /** @brief Function for received data. */
+      ReadFunction function {};
+    };
+
+    /**
+     * @brief Read a readable device and call its function.
+     * @param _descriptor   Descriptor of the device.
+     * @param _hangup   Did the device report a hang up or an error?
+     */
+    void dispatch( std::int32_t _descriptor,
+                   bool _hangup );
+
+    /**
+     * @brief Member for the watched devices.
+     */
+    std::vector<std::unique_ptr<Port>> m_ports {};
+
+    /**
+     * @brief Member for the read buffer.
+     */
+    std::vector<char> m_buffer {};
+
+  #ifdef __linux__
+    /**
+     * @brief Member for the epoll descriptor.
+     */
+    std::int32_t m_epoll = -1;
+  #endif
+
+    /**
+     * @brief Member for the pipe, which wakes up poll() - read and write end.
+     */
+    std::array<std::int32_t, 2> m_wake { -1, -1 };
+
+    /**
+     * @brief Member for a running poll().
+     */
+    bool m_dispatching = false;
+
+    /**
+     * @brief Member for the stop state.
+     */
+    std::atomic_bool m_stopped { false };
   };
 }
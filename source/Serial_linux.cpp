@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2020 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* c header */
+#include <cstdint> // std::int32_t, std::uint32_t
+
+/* system header */
+#include <asm/termbits.h> // termios2, BOTHER, TCGETS2, TCSETS2
+#include <linux/serial.h> // serial_struct, ASYNC_LOW_LATENCY
+#include <sys/ioctl.h>
+
+/* local header */
+#include "Serial_linux.h"
+
+namespace vx::serial {
+
+  bool setCustomBaudrate( std::int32_t _descriptor,
+                          std::uint32_t _baudrate ) noexcept {
+
+    termios2 options {};
+    if ( ::ioctl( _descriptor, TCGETS2, &options ) < 0 ) {
+
+      return false;
+    }
+    options.c_cflag &= ~static_cast<tcflag_t>( CBAUD | ( CBAUD << IBSHIFT ) );
+    options.c_cflag |= BOTHER | ( BOTHER << IBSHIFT );
+    options.c_ispeed = _baudrate;
+    options.c_ospeed = _baudrate;
+    return ::ioctl( _descriptor, TCSETS2, &options ) == 0;
+  }
+
+  std::uint32_t customBaudrate( std::int32_t _descriptor ) noexcept {
+
+    termios2 options {};
+    if ( ::ioctl( _descriptor, TCGETS2, &options ) < 0 ) {
+
+      return 0;
+    }
+    return options.c_ospeed;
+  }
+
+  bool setLowLatency( std::int32_t _descriptor ) noexcept {
+
+    serial_struct serial {};
+    if ( ::ioctl( _descriptor, TIOCGSERIAL, &serial ) < 0 ) {
+
+      return false;
+    }
+    serial.flags |= ASYNC_LOW_LATENCY;
+    return ::ioctl( _descriptor, TIOCSSERIAL, &serial ) == 0;
+  }
+}
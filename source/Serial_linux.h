@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2020 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+/* c header */
+#include <cstdint> // std::int32_t, std::uint32_t
+
+/**
+ * @brief vx (VX APPS) serial namespace.
+ */
+namespace vx::serial {
+
+  /**
+   * @brief Set any baud rate by termios2 and BOTHER.
+   * Kept in an own translation unit, because the kernel termios of termios2 conflicts with the termios of the libc.
+   * @param _descriptor   Descriptor of the serial device.
+   * @param _baudrate   Baud rate for input and output.
+   * @return True, if the baud rate is set - otherwise false.
+   */
+  [[nodiscard]] bool setCustomBaudrate( std::int32_t _descriptor,
+                                        std::uint32_t _baudrate ) noexcept;
+
+  /**
+   * @brief Return the output baud rate by termios2.
+   * @param _descriptor   Descriptor of the serial device.
+   * @return The baud rate - 0 if unknown.
+   */
+  [[nodiscard]] std::uint32_t customBaudrate( std::int32_t _descriptor ) noexcept;
+
+  /**
+   * @brief Set ASYNC_LOW_LATENCY, so the driver hands over received data immediately, e.g. the USB latency timer of FTDI.
+   * @param _descriptor   Descriptor of the serial device.
+   * @return True, if the driver supports low latency - otherwise false.
+   */
+  [[nodiscard]] bool setLowLatency( std::int32_t _descriptor ) noexcept;
+}
@@ -0,0 +1,459 @@
+/*
+ * Copyright (c) 2020 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* c header */
+#include <cerrno>
+#include <cstddef> // offsetof, std::size_t
+#include <cstdint> // std::int32_t, std::uint32_t, std::uint64_t
+#include <cstdlib> // std::getenv, EXIT_SUCCESS, EXIT_FAILURE
+#include <cstring> // std::memcpy, std::strlen
+
+/* system header */
+#include <dirent.h> // opendir, readdir
+#include <fcntl.h> // open
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/signalfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h> // umask
+#include <sys/syscall.h> // SYS_close_range
+#include <sys/timerfd.h>
+#include <sys/un.h> // sockaddr_un
+#include <unistd.h>
+
+/* stl header */
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+/* local header */
+#include "Logger.h"
+#include "Service.h"
+
+namespace vx::service {
+
+  /** @brief Maximum events of one epoll_wait(). */
+  constexpr std::int32_t maxEvents = 16;
+
+  /** @brief Microseconds per second. */
+  constexpr std::int64_t microsecondsPerSecond = 1000000;
+
+  /** @brief Nanoseconds per microsecond. */
+  constexpr std::int64_t nanosecondsPerMicrosecond = 1000;
+
+  namespace {
+
+    /**
+     * @brief Log a failed system call with errno.
+     * @param _function   Failed system call.
+     */
+    void logFailure( std::string_view _function ) noexcept {
+
+      const std::int32_t error = errno;
+      try {
+
+        logError() << "Service" << _function << "failed. Error:" << std::error_code( error, std::generic_category() ).message();
+      }
+      catch ( const std::exception &_exception ) { // NOSONAR fallback for every exeption.
+
+        logFatal() << _exception.what();
+      }
+    }
+
+    /**
+     * @brief Close a descriptor and mark it as closed.
+     * @param _descriptor   Descriptor.
+     */
+    void closeDescriptor( std::int32_t &_descriptor ) noexcept {
+
+      if ( _descriptor >= 0 ) {
+
+        ::close( _descriptor );
+        _descriptor = -1;
+      }
+    }
+
+    /**
+     * @brief Fork and exit the parent process.
+     * @return True in the child process - false on error.
+     */
+    bool forkChild() noexcept {
+
+      const pid_t pid = ::fork();
+      if ( pid > 0 ) {
+
+        ::_exit( EXIT_SUCCESS );
+      }
+      return pid == 0;
+    }
+
+    /**
+     * @brief Read everything of a non-blocking descriptor.
+     * @param _descriptor   Descriptor.
+     */
+    void drain( std::int32_t _descriptor ) noexcept {
+
+      std::uint64_t value = 0;
+      while ( ::read( _descriptor, &value, sizeof( value ) ) > 0 ) {}
+    }
+  }
+
+  bool daemonize() noexcept {
+
+    if ( !forkChild() ) {
+
+      logFailure( "fork()" );
+      return false;
+    }
+    if ( ::setsid() < 0 ) {
+
+      logFailure( "setsid()" );
+      return false;
+    }
+
+    /* The second fork is no session leader, so it never acquires a terminal again. */
+    if ( !forkChild() ) {
+
+      logFailure( "fork()" );
+      return false;
+    }
+    ::umask( S_IRWXO );
+    if ( ::chdir( "/" ) < 0 ) {
+
+      logFailure( "chdir()" );
+      return false;
+    }
+    closeDescriptors();
+
+    /* A daemon cannot use the terminal, but writes to the standard descriptors must not hit other files. */
+    const std::int32_t null = ::open( "/dev/null", O_RDWR | O_CLOEXEC );
+    if ( null < 0 ) {
+
+      return false;
+    }
+    for ( const std::int32_t descriptor : { STDIN_FILENO, STDOUT_FILENO, STDERR_FILENO } ) {
+
+      ::dup2( null, descriptor );
+    }
+    if ( null > STDERR_FILENO ) {
+
+      ::close( null );
+    }
+    return true;
+  }
+
+  bool closeDescriptors( std::int32_t _from ) noexcept {
+
+#ifdef SYS_close_range
+    if ( ::syscall( SYS_close_range, static_cast<std::uint32_t>( _from ), ~0U, 0U ) == 0 ) {
+
+      return true;
+    }
+#endif
+    /* Kernel before 5.9 - only open descriptors instead of every possible one. */
+    if ( DIR *directory = ::opendir( "/proc/self/fd" ) ) {
+
+      const std::int32_t own = ::dirfd( directory );
+      while ( const dirent *entry = ::readdir( directory ) ) {
+
+        const std::string_view name( entry->d_name );
+        std::int32_t descriptor = -1;
+        if ( std::from_chars( name.data(), name.data() + name.size(), descriptor ).ec == std::errc {} && descriptor >= _from && descriptor != own ) {
+
+          ::close( descriptor );
+        }
+      }
+      ::closedir( directory );
+      return true;
+    }
+    for ( auto descriptor = static_cast<std::int32_t>( ::sysconf( _SC_OPEN_MAX ) ); descriptor >= _from; --descriptor ) {
+
+      ::close( descriptor );
+    }
+    return true;
+  }
+
+  bool notify( std::string_view _state ) noexcept {
+
+    const char *path = std::getenv( "NOTIFY_SOCKET" );
+    if ( path == nullptr || ( path[ 0 ] != '/' && path[ 0 ] != '@' ) ) {
+
+      return false;
+    }
+    sockaddr_un address {};
+    address.sun_family = AF_UNIX;
+    const std::size_t length = std::strlen( path );
+    if ( length >= sizeof( address.sun_path ) ) {
+
+      return false;
+    }
+    std::memcpy( address.sun_path, path, length );
+    if ( path[ 0 ] == '@' ) {
+
+      /* Abstract namespace */
+      address.sun_path[ 0 ] = '\0';
+    }
+    const std::int32_t descriptor = ::socket( AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0 );
+    if ( descriptor < 0 ) {
+
+      logFailure( "socket()" );
+      return false;
+    }
+    const auto size = static_cast<socklen_t>( offsetof( sockaddr_un, sun_path ) + length );
+    /* A busy service manager must not block the service. */
+    const bool sent = ::sendto( descriptor, _state.data(), _state.size(), MSG_NOSIGNAL | MSG_DONTWAIT, reinterpret_cast<const sockaddr *>( &address ), size ) == static_cast<ssize_t>( _state.size() );
+    if ( !sent ) {
+
+      logFailure( "sendto()" );
+    }
+    ::close( descriptor );
+    return sent;
+  }
+
+  std::chrono::microseconds watchdogInterval() noexcept {
+
+    const auto number = []( const char *_name ) {
+      std::int64_t value = 0;
+      const char *text = std::getenv( _name );
+      if ( text == nullptr || std::from_chars( text, text + std::strlen( text ), value ).ec != std::errc {} ) {
+
+        return std::int64_t { -1 };
+      }
+      return value;
+    };
+    const std::int64_t pid = number( "WATCHDOG_PID" );
+    if ( std::getenv( "WATCHDOG_PID" ) != nullptr && pid != ::getpid() ) {
+
+      /* The watchdog is meant for another process, e.g. the parent. */
+      return std::chrono::microseconds( 0 );
+    }
+    return std::chrono::microseconds( std::max<std::int64_t>( number( "WATCHDOG_USEC" ), 0 ) );
+  }
+
+  Runtime::Runtime() noexcept {
+
+    sigset_t signals {};
+    ::sigemptyset( &signals );
+    ::sigaddset( &signals, SIGTERM );
+    ::sigaddset( &signals, SIGINT );
+    ::sigaddset( &signals, SIGHUP );
+    ::pthread_sigmask( SIG_BLOCK, &signals, &m_previousMask );
+
+    m_signal = ::signalfd( -1, &signals, SFD_CLOEXEC | SFD_NONBLOCK );
+    m_epoll = ::epoll_create1( EPOLL_CLOEXEC );
+    m_wake = ::eventfd( 0, EFD_CLOEXEC | EFD_NONBLOCK );
+    if ( !isValid() ) {
+
+      logFailure( "signalfd(), epoll_create1() or eventfd()" );
+      return;
+    }
+    const std::chrono::microseconds interval = watchdogInterval();
+    if ( interval.count() > 0 ) {
+
+      /* Half of the interval like sd_watchdog_enabled() recommends. */
+      const std::int64_t half = interval.count() / 2;
+      itimerspec timer {};
+      timer.it_interval.tv_sec = half / microsecondsPerSecond;
+      timer.it_interval.tv_nsec = ( half % microsecondsPerSecond ) * nanosecondsPerMicrosecond;
+      timer.it_value = timer.it_interval;
+      m_watchdog = ::timerfd_create( CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK );
+      if ( m_watchdog < 0 || ::timerfd_settime( m_watchdog, 0, &timer, nullptr ) < 0 ) {
+
+        logFailure( "timerfd_create()" );
+        closeDescriptor( m_watchdog );
+      }
+    }
+    for ( const std::int32_t descriptor : { m_signal, m_wake, m_watchdog } ) {
+
+      if ( descriptor >= 0 ) {
+
+        epoll_event event {};
+        event.events = EPOLLIN;
+        event.data.fd = descriptor;
+        ::epoll_ctl( m_epoll, EPOLL_CTL_ADD, descriptor, &event );
+      }
+    }
+  }
+
+  Runtime::~Runtime() noexcept {
+
+    /* Signals received after run() are dropped instead of their default action with the restored mask. */
+    if ( m_signal >= 0 ) {
+
+      signalfd_siginfo info {};
+      while ( ::read( m_signal, &info, sizeof( info ) ) > 0 ) {}
+    }
+    closeDescriptor( m_watchdog );
+    closeDescriptor( m_wake );
+    closeDescriptor( m_signal );
+    closeDescriptor( m_epoll );
+    ::pthread_sigmask( SIG_SETMASK, &m_previousMask, nullptr );
+  }
+
+  bool Runtime::add( std::int32_t _descriptor,
+                     std::uint32_t _events,
+                     DescriptorFunction _function ) {
+
+    if ( !isValid() ) {
+
+      return false;
+    }
+    epoll_event event {};
+    event.events = _events;
+    event.data.fd = _descriptor;
+    if ( ::epoll_ctl( m_epoll, EPOLL_CTL_ADD, _descriptor, &event ) < 0 ) {
+
+      logFailure( "epoll_ctl()" );
+      return false;
+    }
+    m_watches.push_back( std::make_unique<Watch>( Watch { _descriptor, std::move( _function ) } ) );
+    return true;
+  }
+
+  void Runtime::remove( std::int32_t _descriptor ) noexcept {
+
+    for ( const std::unique_ptr<Watch> &watch : m_watches ) {
+
+      if ( watch->descriptor == _descriptor ) {
+
+        ::epoll_ctl( m_epoll, EPOLL_CTL_DEL, _descriptor, nullptr );
+
+        /* A running function is erased after it returns. */
+        watch->descriptor = -1;
+      }
+    }
+  }
+
+  std::int32_t Runtime::run() {
+
+    if ( !isValid() ) {
+
+      return EXIT_FAILURE;
+    }
+    std::ignore = notify( "READY=1" );
+    std::int32_t result = EXIT_SUCCESS;
+    std::array<epoll_event, maxEvents> events {};
+    bool running = true;
+    while ( running ) {
+
+      const std::int32_t count = ::epoll_wait( m_epoll, events.data(), maxEvents, -1 );
+      if ( count < 0 ) {
+
+        if ( errno == EINTR ) {
+
+          continue;
+        }
+        logFailure( "epoll_wait()" );
+        result = EXIT_FAILURE;
+        break;
+      }
+      for ( std::int32_t index = 0; index < count; ++index ) {
+
+        const epoll_event &event = events[ static_cast<std::size_t>( index ) ];
+        if ( event.data.fd == m_signal ) {
+
+          running = !handleSignals() && running;
+        }
+        else if ( event.data.fd == m_wake ) {
+
+          drain( m_wake );
+          running = false;
+        }
+        else if ( event.data.fd == m_watchdog ) {
+
+          drain( m_watchdog );
+          std::ignore = notify( "WATCHDOG=1" );
+        }
+        else {
+
+          const auto watch = std::find_if( m_watches.cbegin(), m_watches.cend(), [ &event ]( const std::unique_ptr<Watch> &_watch ) { return _watch->descriptor == event.data.fd; } );
+          if ( watch != m_watches.cend() ) {
+
+            /* The watch stays valid, even if the function adds or removes watches. */
+            const Watch &current = **watch;
+            current.function( event.events );
+          }
+        }
+      }
+      m_watches.erase( std::remove_if( m_watches.begin(), m_watches.end(), []( const std::unique_ptr<Watch> &_watch ) { return _watch->descriptor < 0; } ), m_watches.end() );
+    }
+    std::ignore = notify( "STOPPING=1" );
+    if ( m_shutdown ) {
+
+      m_shutdown();
+    }
+    return result;
+  }
+
+  void Runtime::stop() noexcept {
+
+    const std::uint64_t value = 1;
+    std::ignore = ::write( m_wake, &value, sizeof( value ) );
+  }
+
+  bool Runtime::handleSignals() {
+
+    bool stop = false;
+    signalfd_siginfo info {};
+    while ( ::read( m_signal, &info, sizeof( info ) ) == static_cast<ssize_t>( sizeof( info ) ) ) {
+
+      if ( info.ssi_signo == SIGHUP ) {
+
+        reload();
+      }
+      else {
+
+        stop = true;
+      }
+    }
+    return stop;
+  }
+
+  void Runtime::reload() {
+
+    timespec now {};
+    ::clock_gettime( CLOCK_MONOTONIC, &now );
+    const std::int64_t monotonic = static_cast<std::int64_t>( now.tv_sec ) * microsecondsPerSecond + now.tv_nsec / nanosecondsPerMicrosecond;
+    std::ignore = notify( "RELOADING=1\nMONOTONIC_USEC=" + std::to_string( monotonic ) );
+    if ( m_reload ) {
+
+      m_reload();
+    }
+    std::ignore = notify( "READY=1" );
+  }
+}
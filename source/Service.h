@@ -0,0 +1,243 @@
+/*
+ * Copyright (c) 2020 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+/* c header */
+#include <cstdint> // std::int32_t, std::uint32_t
+
+/* system header */
+#include <signal.h> // sigset_t
+
+/* stl header */
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief vx (VX APPS) service namespace.
+ */
+namespace vx::service {
+
+  /**
+   * @brief Run in the background - fork, new session, chdir to /, umask, close inherited descriptors and connect the
+   * standard descriptors to /dev/null.
+   * The parent process exits, only the daemon returns.
+   * @return True, if the daemon is running - otherwise false.
+   */
+  [[nodiscard]] bool daemonize() noexcept;
+
+  /**
+   * @brief Close every descriptor from a descriptor on by close_range() - /proc/self/fd or every possible descriptor otherwise.
+   * @param _from   First descriptor to close.
+   * @return True, if the descriptors are closed - otherwise false.
+   */
+  bool closeDescriptors( std::int32_t _from = 3 ) noexcept;
+
+  /**
+   * @brief Send a state to the service manager like sd_notify() - the socket is taken from NOTIFY_SOCKET.
+   * @param _state   State lines, e.g. "READY=1".
+   * @return True, if the state is sent - false without NOTIFY_SOCKET or on error.
+   */
+  bool notify( std::string_view _state ) noexcept;
+
+  /**
+   * @brief Return the interval, in which the service manager expects WATCHDOG=1 - from WATCHDOG_USEC and WATCHDOG_PID.
+   * @return The interval - zero without watchdog.
+   */
+  [[nodiscard]] std::chrono::microseconds watchdogInterval() noexcept;
+
+  /**
+   * @brief Event loop of a service with signal handling by signalfd and epoll.
+   * SIGTERM and SIGINT stop the loop gracefully, SIGHUP calls the reload function. The service manager is notified
+   * about readiness, reloading and stopping and gets watchdog messages in half of its interval.
+   * @author Florian Becker <fb\@vxapps.com> (VX APPS)
+   */
+  class Runtime {
+
+  public:
+    /**
+     * @brief Function for reload and shutdown.
+     */
+    using Function = std::function<void()>;
+
+    /**
+     * @brief Function for a ready descriptor - gets the epoll events.
+     */
+    using DescriptorFunction = std::function<void( std::uint32_t )>;
+
+    /**
+     * @brief Default constructor for Runtime.
+     * Blocks the handled signals of the calling thread, so it has to be created before other threads.
+     */
+    Runtime() noexcept;
+
+    /**
+     * @brief Delete copy constructor.
+     */
+    Runtime( const Runtime & ) = delete;
+
+    /**
+     * @brief Delete move constructor.
+     */
+    Runtime( Runtime && ) = delete;
+
+    /**
+     * @brief Delete copy assign.
+     * @return Nothing.
+     */
+    Runtime &operator=( const Runtime & ) = delete;
+
+    /**
+     * @brief Delete move assign.
+     * @return Nothing.
+     */
+    Runtime &operator=( Runtime && ) = delete;
+
+    /**
+     * @brief Default destructor for Runtime - restores the signal mask.
+     */
+    virtual ~Runtime() noexcept;
+
+    /**
+     * @brief Is the runtime ready to run?
+     * @return True, if the runtime is valid - otherwise false.
+     */
+    [[nodiscard]] inline bool isValid() const noexcept { return m_epoll >= 0 && m_signal >= 0 && m_wake >= 0; }
+
+    /**
+     * @brief Set the function for SIGHUP.
+     * @param _function   Function, which reloads the configuration.
+     */
+    inline void setReloadFunction( Function _function ) noexcept { m_reload = std::move( _function ); }
+
+    /**
+     * @brief Set the function for SIGTERM and SIGINT, called before run() returns.
+     * @param _function   Function, which releases the resources.
+     */
+    inline void setShutdownFunction( Function _function ) noexcept { m_shutdown = std::move( _function ); }
+
+    /**
+     * @brief Watch a descriptor.
+     * @param _descriptor   Descriptor, which stays owned by the caller.
+     * @param _events   Epoll events, e.g. EPOLLIN.
+     * @param _function   Function for a ready descriptor.
+     * @return True, if the descriptor is watched - otherwise false.
+     * @note This function may throw an exception by std::vector.
+     */
+    [[nodiscard]] bool add( std::int32_t _descriptor,
+                            std::uint32_t _events,
+                            DescriptorFunction _function );
+
+    /**
+     * @brief Stop watching a descriptor - allowed inside a descriptor function.
+     * @param _descriptor   Descriptor.
+     */
+    void remove( std::int32_t _descriptor ) noexcept;
+
+    /**
+     * @brief Notify readiness and run until SIGTERM, SIGINT or stop().
+     * @return EXIT_SUCCESS, if the loop stopped gracefully - EXIT_FAILURE otherwise.
+     * @note This function may throw an exception by the functions.
+     */
+    [[nodiscard]] std::int32_t run();
+
+    /**
+     * @brief Stop run() like SIGTERM - allowed from other threads.
+     */
+    void stop() noexcept;
+
+  private:
+    /**
+     * @brief Watched descriptor.
+     */
+    struct Watch {
+
+      /** @brief Descriptor. */
+      std::int32_t descriptor = -1;
+
+      /** @brief Function for a ready descriptor. */
+      DescriptorFunction function {};
+    };
+
+    /**
+     * @brief Handle pending signals.
+     * @return True, if the runtime has to stop - otherwise false.
+     */
+    bool handleSignals();
+
+    /**
+     * @brief Reload by the reload function.
+     */
+    void reload();
+
+    /**
+     * @brief Member for the epoll descriptor.
+     */
+    std::int32_t m_epoll = -1;
+
+    /**
+     * @brief Member for the signalfd descriptor.
+     */
+    std::int32_t m_signal = -1;
+
+    /**
+     * @brief Member for the eventfd descriptor, which wakes up run() for stop().
+     */
+    std::int32_t m_wake = -1;
+
+    /**
+     * @brief Member for the timerfd descriptor of the watchdog.
+     */
+    std::int32_t m_watchdog = -1;
+
+    /**
+     * @brief Member for the signal mask before the runtime.
+     */
+    sigset_t m_previousMask {};
+
+    /**
+     * @brief Member for the reload function.
+     */
+    Function m_reload {};
+
+    /**
+     * @brief Member for the shutdown function.
+     */
+    Function m_shutdown {};
+
+    /**
+     * @brief Member for the watched descriptors - stable during their functions.
+     */
+    std::vector<std::unique_ptr<Watch>> m_watches {};
+  };
+}
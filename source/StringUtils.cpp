@@ -30,19 +30,36 @@
 
 /* c header */
 #include <cctype> // std::isspace
-#include <cstring>
+#include <cerrno>
+#include <cmath> // std::fpclassify, std::isfinite, std::isinf
+#include <cstdint> // std::uint8_t, std::uint32_t, std::uint64_t
+#include <cstdio> // std::snprintf
+#include <cstdlib> // std::strtod, std::strtof, std::strtold
+#include <cstring> // std::memcmp
+
+/* system header */
+#ifndef _WIN32
+  #include <locale.h> // newlocale, uselocale
+  #ifdef __APPLE__
+    #include <xlocale.h>
+  #endif
+#endif
 
 /* stl header */
 #include <algorithm>
+#include <bit>
 #include <exception>
 #include <functional>
 #include <ios>
 #include <iterator>
+#include <limits>
 #include <optional>
+#include <queue>
 #include <ranges>
 #include <sstream>
 #include <string>
 #include <string_view>
+#include <type_traits>
 #include <vector>
 
 /* local header */
@@ -66,6 +83,175 @@ namespace std { // NOSONAR for std integration.
 
 namespace vx::string_utils {
 
+  namespace {
+
+#ifndef _WIN32
+    /**
+     * @brief Switch the calling thread to the "C" locale, as long as the object exists.
+     * @author Florian Becker <fb\@vxapps.com> (VX APPS)
+     */
+    class ClassicLocale {
+
+    public:
+      /**
+       * @brief Default constructor for ClassicLocale.
+       */
+      ClassicLocale() noexcept
+        : m_previous( ::uselocale( classic() ) ) {}
+
+      /**
+       * @brief Delete copy constructor.
+       */
+      ClassicLocale( const ClassicLocale & ) = delete;
+
+      /**
+       * @brief Delete copy assign.
+       * @return Nothing.
+       */
+      ClassicLocale &operator=( const ClassicLocale & ) = delete;
+
+      /**
+       * @brief Default destructor for ClassicLocale - restores the previous locale.
+       */
+      ~ClassicLocale() noexcept { ::uselocale( m_previous ); }
+
+    private:
+      /**
+       * @brief Return the "C" locale - a null locale on error, which keeps the current one.
+       * @return The "C" locale.
+       */
+      static locale_t classic() noexcept {
+
+        static const locale_t locale = ::newlocale( LC_ALL_MASK, "C", nullptr );
+        return locale;
+      }
+
+      /**
+       * @brief Member for the previous locale of the thread.
+       */
+      locale_t m_previous = nullptr;
+    };
+#else
+    /**
+     * @brief Keep the locale - MSVC has floating point std::from_chars and std::to_chars.
+     */
+    struct ClassicLocale {};
+#endif
+
+    /**
+     * @brief Convert a null terminated string by std::strtof, std::strtod or std::strtold.
+     * @tparam T   Type.
+     * @param _string   String to convert.
+     * @param _end   End of the converted number.
+     * @return The converted number.
+     */
+    template <typename T>
+    T stringTo( const char *_string,
+                char **_end ) noexcept {
+
+      if constexpr ( std::is_same_v<T, float> ) {
+
+        return std::strtof( _string, _end );
+      }
+      else if constexpr ( std::is_same_v<T, double> ) {
+
+        return std::strtod( _string, _end );
+      }
+      else {
+
+        return std::strtold( _string, _end );
+      }
+    }
+
+    /**
+     * @brief Print a number by std::snprintf with a precision.
+     * @tparam T   Type.
+     * @param _buffer   Buffer to write into.
+     * @param _size   Size of the buffer.
+     * @param _precision   Significant digits.
+     * @param _value   Value to print.
+     * @return Size of the printed number, like std::snprintf.
+     */
+    template <typename T>
+    std::int32_t printTo( char *_buffer,
+                          std::size_t _size,
+                          std::int32_t _precision,
+                          T _value ) noexcept {
+
+      if constexpr ( std::is_same_v<T, long double> ) {
+
+        return std::snprintf( _buffer, _size, "%.*Lg", _precision, _value );
+      }
+      else {
+
+        return std::snprintf( _buffer, _size, "%.*g", _precision, static_cast<double>( _value ) );
+      }
+    }
+  }
+
+  template <typename T>
+  std::optional<T> parseFloatingPoint( std::string_view _string ) noexcept {
+
+    /* Like std::from_chars - no leading spaces, plus sign or hexadecimal prefix, which std::strtod accepts. */
+    const std::string_view number = _string.starts_with( '-' ) ? _string.substr( 1 ) : _string;
+    if ( number.empty() || number.starts_with( "0x" ) || number.starts_with( "0X" ) || std::isspace( static_cast<unsigned char>( number.front() ) ) || number.front() == '+' || number.front() == '-' ) {
+
+      return {};
+    }
+    try {
+
+      const std::string string( _string );
+      [[maybe_unused]] const ClassicLocale locale {};
+      char *end = nullptr;
+      errno = 0;
+      const T value = stringTo<T>( string.c_str(), &end );
+
+      /* Subnormal numbers set ERANGE as well, but std::from_chars returns them. */
+      if ( end != string.c_str() + string.size() || ( errno == ERANGE && ( std::fpclassify( value ) == FP_ZERO || std::isinf( value ) ) ) ) { // NOSONAR pointer arithmetic is needed for the end of std::strtod.
+
+        return {};
+      }
+      return value;
+    }
+    catch ( const std::exception &_exception ) {
+
+      logFatal() << _exception.what();
+    }
+    return {};
+  }
+
+  template std::optional<float> parseFloatingPoint<float>( std::string_view _string ) noexcept;
+  template std::optional<double> parseFloatingPoint<double>( std::string_view _string ) noexcept;
+  template std::optional<long double> parseFloatingPoint<long double>( std::string_view _string ) noexcept;
+
+  template <typename T>
+  std::string_view formatFloatingPoint( char *_buffer,
+                                        std::size_t _size,
+                                        T _value ) noexcept {
+
+    [[maybe_unused]] const ClassicLocale locale {};
+
+    /* The shortest precision, which is read back to the same value, like std::to_chars. */
+    const std::int32_t maxPrecision = std::isfinite( _value ) ? std::numeric_limits<T>::max_digits10 : 1;
+    for ( std::int32_t precision = 1; precision <= maxPrecision; ++precision ) {
+
+      const std::int32_t size = printTo( _buffer, _size, precision, _value );
+      if ( size < 0 || static_cast<std::size_t>( size ) >= _size ) {
+
+        return {};
+      }
+      if ( precision == maxPrecision || stringTo<T>( _buffer, nullptr ) == _value ) {
+
+        return { _buffer, static_cast<std::size_t>( size ) };
+      }
+    }
+    return {};
+  }
+
+  template std::string_view formatFloatingPoint<float>( char *_buffer, std::size_t _size, float _value ) noexcept;
+  template std::string_view formatFloatingPoint<double>( char *_buffer, std::size_t _size, double _value ) noexcept;
+  template std::string_view formatFloatingPoint<long double>( char *_buffer, std::size_t _size, long double _value ) noexcept;
+
   std::string &trimRight( std::string &_string,
                           std::string_view _trim ) noexcept {
 
@@ -123,7 +309,11 @@ namespace vx::string_utils {
   bool startsWith( std::string_view _string,
                    std::string_view _start ) noexcept {
 
-    return _string.rfind( _start, 0 ) == 0;
+    if ( _string.length() >= _start.length() ) {
+
+      return _string.compare( 0, _start.length(), _start ) == 0;
+    }
+    return false;
   }
 
   bool endsWith( std::string_view _string,
@@ -195,6 +385,53 @@ namespace vx::string_utils {
     return result;
   }
 
+  std::size_t findFirstOf( std::string_view _string,
+                           std::string_view _chars,
+                           std::size_t _pos ) noexcept {
+
+    constexpr std::uint64_t lows = 0x0101010101010101;
+    constexpr std::uint64_t highs = 0x8080808080808080;
+    constexpr std::size_t wordSize = sizeof( std::uint64_t );
+
+    std::size_t pos = _pos;
+    if ( _chars.empty() || pos >= _string.size() ) {
+
+      return std::string_view::npos;
+    }
+
+    /* Every byte of a word is compared at once, the high bit is set for every matching byte */
+    while ( pos + wordSize <= _string.size() ) {
+
+      std::uint64_t word = 0;
+      std::memcpy( &word, _string.data() + pos, wordSize ); // NOSONAR pointer arithmetic is needed for the unaligned load.
+      std::uint64_t mask = 0;
+      for ( const auto chr : _chars ) {
+
+        const std::uint64_t diff = word ^ ( lows * static_cast<unsigned char>( chr ) );
+        mask |= ( diff - lows ) & ~diff & highs;
+      }
+      if ( mask != 0 ) {
+
+        /* Only the lowest byte is exact, bytes after it may be false positive */
+        if constexpr ( std::endian::native == std::endian::little ) {
+
+          return pos + static_cast<std::size_t>( std::countr_zero( mask ) ) / wordSize;
+        }
+        break;
+      }
+      pos += wordSize;
+    }
+
+    for ( ; pos < _string.size(); ++pos ) {
+
+      if ( _chars.find( _string[ pos ] ) != std::string_view::npos ) {
+
+        return pos;
+      }
+    }
+    return std::string_view::npos;
+  }
+
   std::string toHex( std::string_view _string ) noexcept {
 
     std::ostringstream stream {};
@@ -262,4 +499,190 @@ namespace vx::string_utils {
     }
     return std::make_optional<std::string>( _uchr, _uchr + size ); // NOSONAR do not use pointer arithmetic.
   }
+
+  Searcher::Searcher( std::string_view _pattern )
+    : m_pattern( _pattern ) {
+
+    m_shift.fill( m_pattern.size() );
+    for ( std::size_t pos = 0; pos + 1 < m_pattern.size(); ++pos ) {
+
+      m_shift[ static_cast<unsigned char>( m_pattern[ pos ] ) ] = m_pattern.size() - 1 - pos;
+    }
+  }
+
+  std::size_t Searcher::find( std::string_view _string,
+                              std::size_t _pos ) const noexcept {
+
+    const std::size_t length = m_pattern.size();
+    if ( _pos > _string.size() || _string.size() - _pos < length ) {
+
+      return std::string_view::npos;
+    }
+    if ( length == 0 ) {
+
+      return _pos;
+    }
+
+    const char last = m_pattern.back();
+    const std::size_t end = _string.size() - length;
+    std::size_t pos = _pos;
+    while ( pos <= end ) {
+
+      const char chr = _string[ pos + length - 1 ];
+      if ( chr == last && std::memcmp( _string.data() + pos, m_pattern.data(), length - 1 ) == 0 ) { // NOSONAR pointer arithmetic is the fastest option here.
+
+        return pos;
+      }
+      pos += m_shift[ static_cast<unsigned char>( chr ) ];
+    }
+    return std::string_view::npos;
+  }
+
+  std::vector<std::size_t> Searcher::findAll( std::string_view _string ) const {
+
+    std::vector<std::size_t> result {};
+    std::size_t pos = find( _string );
+    while ( pos != std::string_view::npos ) {
+
+      result.push_back( pos );
+      if ( pos == _string.size() ) {
+
+        break;
+      }
+      pos = find( _string, pos + 1 );
+    }
+    return result;
+  }
+
+  MultiSearcher::MultiSearcher( const std::vector<std::string_view> &_patterns ) {
+
+    constexpr std::size_t alphabetSize = std::numeric_limits<unsigned char>::max() + 1;
+    constexpr std::uint32_t root = 0;
+
+    /* Reduce the alphabet to the bytes used by the patterns, this keeps the transition table small */
+    std::array<bool, alphabetSize> used {};
+    for ( const auto &pattern : _patterns ) {
+
+      for ( const auto chr : pattern ) {
+
+        used[ static_cast<unsigned char>( chr ) ] = true;
+      }
+    }
+    const auto usedCount = static_cast<std::size_t>( std::ranges::count( used, true ) );
+    const std::size_t offset = usedCount == alphabetSize ? 0 : 1;
+    m_classes = usedCount + offset;
+    std::size_t current = offset;
+    for ( std::size_t chr = 0; chr < alphabetSize; ++chr ) {
+
+      if ( used[ chr ] ) {
+
+        m_alphabet[ chr ] = static_cast<std::uint8_t>( current++ );
+      }
+    }
+
+    /* Build the trie, transition 0 means no child while building */
+    m_transitions.resize( m_classes, root );
+    m_match.push_back( std::string_view::npos );
+    for ( const auto &pattern : _patterns ) {
+
+      const std::size_t index = m_lengths.size();
+      m_lengths.push_back( pattern.size() );
+      if ( pattern.empty() ) {
+
+        continue;
+      }
+      std::uint32_t state = root;
+      for ( const auto chr : pattern ) {
+
+        const std::size_t transition = state * m_classes + m_alphabet[ static_cast<unsigned char>( chr ) ];
+        if ( m_transitions[ transition ] == root ) {
+
+          m_transitions[ transition ] = static_cast<std::uint32_t>( m_match.size() );
+          m_transitions.resize( m_transitions.size() + m_classes, root );
+          m_match.push_back( std::string_view::npos );
+        }
+        state = m_transitions[ transition ];
+      }
+      if ( m_match[ state ] == std::string_view::npos ) {
+
+        m_match[ state ] = index;
+      }
+    }
+
+    /* Resolve failure links breadth first into a complete automaton */
+    std::vector<std::uint32_t> failure( m_match.size(), root );
+    m_dictionary.resize( m_match.size(), root );
+    std::queue<std::uint32_t> queue {};
+    for ( std::size_t chrClass = 0; chrClass < m_classes; ++chrClass ) {
+
+      if ( const std::uint32_t child = m_transitions[ chrClass ]; child != root ) {
+
+        queue.push( child );
+      }
+    }
+    while ( !queue.empty() ) {
+
+      const std::uint32_t state = queue.front();
+      queue.pop();
+      for ( std::size_t chrClass = 0; chrClass < m_classes; ++chrClass ) {
+
+        const std::size_t transition = state * m_classes + chrClass;
+        const std::uint32_t fallback = m_transitions[ failure[ state ] * m_classes + chrClass ];
+        if ( const std::uint32_t child = m_transitions[ transition ]; child != root ) {
+
+          failure[ child ] = fallback;
+          m_dictionary[ child ] = m_match[ fallback ] != std::string_view::npos ? fallback : m_dictionary[ fallback ];
+          queue.push( child );
+        }
+        else {
+
+          m_transitions[ transition ] = fallback;
+        }
+      }
+    }
+  }
+
+  bool MultiSearcher::containsAny( std::string_view _string ) const noexcept {
+
+    std::uint32_t state = 0;
+    for ( const auto chr : _string ) {
+
+      state = next( state, chr );
+      if ( m_match[ state ] != std::string_view::npos || m_dictionary[ state ] != 0 ) {
+
+        return true;
+      }
+    }
+    return false;
+  }
+
+  std::vector<Match> MultiSearcher::findAll( std::string_view _string ) const {
+
+    std::vector<Match> result {};
+    std::uint32_t state = 0;
+    for ( std::size_t pos = 0; pos < _string.size(); ++pos ) {
+
+      state = next( state, _string[ pos ] );
+      std::uint32_t output = m_match[ state ] != std::string_view::npos ? state : m_dictionary[ state ];
+      while ( output != 0 ) {
+
+        const std::size_t pattern = m_match[ output ];
+        result.push_back( { pos + 1 - m_lengths[ pattern ], pattern } );
+        output = m_dictionary[ output ];
+      }
+    }
+    return result;
+  }
+
+  bool containsAny( std::string_view _string,
+                    const std::vector<std::string_view> &_needles ) {
+
+    return MultiSearcher( _needles ).containsAny( _string );
+  }
+
+  std::vector<Match> findAll( std::string_view _string,
+                              const std::vector<std::string_view> &_needles ) {
+
+    return MultiSearcher( _needles ).findAll( _string );
+  }
 }
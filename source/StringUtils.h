@@ -28,13 +28,21 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#pragma once
+
 /* c header */
 #include <cstddef> // std::size_t
+#include <cstdint> // std::uint8_t, std::uint32_t
 
 /* stl header */
+#include <array>
+#include <charconv>
+#include <limits>
 #include <optional>
 #include <string>
 #include <string_view>
+#include <system_error>
+#include <type_traits>
 #include <vector>
 
 /**
@@ -133,6 +141,18 @@ namespace vx::string_utils {
                                           std::string_view _separator,
                                           Split _split = Split::SkipEmpty );
 
+  /**
+   * @brief Find the first character, which is one of the characters.
+   * The string is scanned eight bytes at once, this is fast for a small set of characters like delimiters.
+   * @param _string   String to search in.
+   * @param _chars   Characters to search for.
+   * @param _pos   Position to start the search at.
+   * @return Position of the first found character - otherwise std::string_view::npos.
+   */
+  [[nodiscard]] std::size_t findFirstOf( std::string_view _string,
+                                         std::string_view _chars,
+                                         std::size_t _pos = 0 ) noexcept;
+
   /**
    * @brief Returns hex from string.
    * @param _string   Input string.
@@ -158,4 +178,324 @@ namespace vx::string_utils {
    */
   [[nodiscard]] std::optional<std::string> MAYBE_BAD_fromUnsignedChar( const unsigned char *_uchr,
                                                                        std::size_t _size ) noexcept;
+
+  /**
+   * @brief Does std::from_chars and std::to_chars support floating point? Apple libc++ does not, or not before macOS 13.3.
+   */
+#ifdef HAVE_CHARCONV_FLOAT
+  constexpr bool floatingPointCharconv = true;
+#else
+  constexpr bool floatingPointCharconv = false;
+#endif
+
+  /**
+   * @brief Parse a floating point number like std::from_chars, but by std::strtod in the "C" locale.
+   * Used by parse(), if std::from_chars does not support floating point.
+   * @tparam T   Type - float, double or long double.
+   * @param _string   String to parse - the whole string must be a valid number, without leading spaces or plus sign.
+   * @return The parsed number - otherwise empty, if the string is invalid or out of range.
+   */
+  template <typename T>
+  [[nodiscard]] std::optional<T> parseFloatingPoint( std::string_view _string ) noexcept;
+
+  /**
+   * @brief Format a floating point number like std::to_chars in the shortest form, but by std::snprintf in the "C" locale.
+   * Used by format(), if std::to_chars does not support floating point.
+   * @tparam T   Type - float, double or long double.
+   * @param _buffer   Buffer to write into.
+   * @param _size   Size of the buffer - including the terminating null character of std::snprintf.
+   * @param _value   Value to format.
+   * @return View of the formatted number inside the buffer - otherwise empty, if the buffer is too small.
+   */
+  template <typename T>
+  [[nodiscard]] std::string_view formatFloatingPoint( char *_buffer,
+                                                      std::size_t _size,
+                                                      T _value ) noexcept;
+
+  /**
+   * @brief Parse a number from a string without allocation and locale.
+   * @tparam T   Type.
+   * @param _string   String to parse - the whole string must be a valid number, without leading spaces or plus sign.
+   * @return The parsed number - otherwise empty, if the string is invalid or out of range.
+   */
+  template <typename T>
+#if __cplusplus >= 202002L
+  requires std::is_arithmetic_v<T> && ( !std::is_same_v<T, bool> )
+#endif
+  [[nodiscard]] std::optional<T> parse( std::string_view _string ) noexcept {
+
+    if constexpr ( std::is_floating_point_v<T> && !floatingPointCharconv ) {
+
+      return parseFloatingPoint<T>( _string );
+    }
+    else {
+
+      T value {};
+      const char *last = _string.data() + _string.size(); // NOSONAR pointer arithmetic is needed for std::from_chars.
+      if ( const auto [ ptr, errorCode ] = std::from_chars( _string.data(), last, value ); errorCode != std::errc {} || ptr != last ) {
+
+        return {};
+      }
+      return value;
+    }
+  }
+
+  /**
+   * @brief Parse a list of numbers, all fields are validated.
+   * @tparam T   Type.
+   * @param _fields   Fields to parse, e.g. from tokenize().
+   * @return The parsed numbers - otherwise empty, if any field is invalid.
+   * @note This function may throw an exception by reserve of std::vector.
+   */
+  template <typename T>
+#if __cplusplus >= 202002L
+  requires std::is_arithmetic_v<T> && ( !std::is_same_v<T, bool> )
+#endif
+  [[nodiscard]] std::optional<std::vector<T>> parseAll( const std::vector<std::string_view> &_fields ) {
+
+    std::vector<T> result {};
+    result.reserve( _fields.size() );
+    for ( const auto &field : _fields ) {
+
+      const std::optional<T> value = parse<T>( field );
+      if ( !value ) {
+
+        return {};
+      }
+      result.push_back( *value );
+    }
+    return result;
+  }
+
+  /**
+   * @brief Buffer size, which is big enough to format every value of type T - including a null character for formatFloatingPoint().
+   * @tparam T   Type.
+   */
+  template <typename T>
+  constexpr std::size_t formatSize = std::is_floating_point_v<T> ? std::numeric_limits<T>::max_digits10 + 9 : std::numeric_limits<T>::digits10 + 3;
+
+  /**
+   * @brief Format a number into a buffer without allocation and locale.
+   * Floating point values are written in the shortest form, which is read back to the same value.
+   * @tparam T   Type.
+   * @param _buffer   Buffer to write into.
+   * @param _size   Size of the buffer.
+   * @param _value   Value to format.
+   * @return View of the formatted number inside the buffer - otherwise empty, if the buffer is too small.
+   */
+  template <typename T>
+#if __cplusplus >= 202002L
+  requires std::is_arithmetic_v<T> && ( !std::is_same_v<T, bool> )
+#endif
+  [[nodiscard]] std::string_view format( char *_buffer,
+                                         std::size_t _size,
+                                         T _value ) noexcept {
+
+    if constexpr ( std::is_floating_point_v<T> && !floatingPointCharconv ) {
+
+      return formatFloatingPoint( _buffer, _size, _value );
+    }
+    else {
+
+      if ( const auto [ ptr, errorCode ] = std::to_chars( _buffer, _buffer + _size, _value ); errorCode == std::errc {} ) { // NOSONAR pointer arithmetic is needed for std::to_chars.
+
+        return { _buffer, static_cast<std::size_t>( ptr - _buffer ) };
+      }
+      return {};
+    }
+  }
+
+  /**
+   * @brief Format a number into an array without allocation and locale.
+   * @tparam T   Type.
+   * @tparam N   Size of the array, use formatSize<T> to fit every value.
+   * @param _buffer   Buffer to write into.
+   * @param _value   Value to format.
+   * @return View of the formatted number inside the buffer - otherwise empty, if the buffer is too small.
+   */
+  template <typename T, std::size_t N>
+#if __cplusplus >= 202002L
+  requires std::is_arithmetic_v<T> && ( !std::is_same_v<T, bool> )
+#endif
+  [[nodiscard]] std::string_view format( std::array<char, N> &_buffer,
+                                         T _value ) noexcept {
+
+    return format( _buffer.data(), _buffer.size(), _value );
+  }
+
+  /**
+   * @brief Precompiled single pattern searcher (Boyer-Moore-Horspool).
+   * @author Florian Becker <fb\@vxapps.com> (VX APPS)
+   */
+  class Searcher {
+
+  public:
+    /**
+     * @brief Constructor for Searcher.
+     * @param _pattern   Pattern to search for.
+     * @note This function may throw an exception by the constructor of std::string.
+     */
+    explicit Searcher( std::string_view _pattern );
+
+    /**
+     * @brief Return the pattern.
+     * @return The pattern.
+     */
+    [[nodiscard]] inline std::string_view pattern() const noexcept { return m_pattern; }
+
+    /**
+     * @brief Find the first occurrence of the pattern.
+     * @param _string   String to search in.
+     * @param _pos   Position to start the search at.
+     * @return Position of the first occurrence - otherwise std::string_view::npos.
+     */
+    [[nodiscard]] std::size_t find( std::string_view _string,
+                                    std::size_t _pos = 0 ) const noexcept;
+
+    /**
+     * @brief Check if the string contains the pattern.
+     * @param _string   String to search in.
+     * @return True, if the string contains the pattern - otherwise false.
+     */
+    [[nodiscard]] inline bool contains( std::string_view _string ) const noexcept { return find( _string ) != std::string_view::npos; }
+
+    /**
+     * @brief Find all, also overlapping, occurrences of the pattern.
+     * @param _string   String to search in.
+     * @return Positions of all occurrences.
+     * @note This function may throw an exception by push_back of std::vector.
+     */
+    [[nodiscard]] std::vector<std::size_t> findAll( std::string_view _string ) const;
+
+  private:
+    /**
+     * @brief Member for pattern.
+     */
+    std::string m_pattern {};
+
+    /**
+     * @brief Member for bad character shift table.
+     */
+    std::array<std::size_t, std::numeric_limits<unsigned char>::max() + 1> m_shift {};
+  };
+
+  /**
+   * @brief Match of a multi pattern search.
+   */
+  struct Match {
+
+    /**
+     * @brief Position of the match in the searched string.
+     */
+    std::size_t position = 0;
+
+    /**
+     * @brief Index of the matched pattern.
+     */
+    std::size_t pattern = 0;
+
+    /**
+     * @brief Equal operator.
+     * @param _match   Match to compare with.
+     * @return True, if the compared match is equal current match - otherwise false.
+     */
+    [[nodiscard]] constexpr bool operator==( const Match &_match ) const noexcept { return position == _match.position && pattern == _match.pattern; }
+  };
+
+  /**
+   * @brief Precompiled multi pattern searcher (Aho-Corasick).
+   * Every string is scanned once in linear time, independent of the number of patterns.
+   * @author Florian Becker <fb\@vxapps.com> (VX APPS)
+   */
+  class MultiSearcher {
+
+  public:
+    /**
+     * @brief Constructor for MultiSearcher.
+     * @param _patterns   Patterns to search for. Empty patterns are ignored.
+     * @note This function may throw an exception by the constructor of std::vector.
+     */
+    explicit MultiSearcher( const std::vector<std::string_view> &_patterns );
+
+    /**
+     * @brief Number of patterns.
+     * @return The number of patterns.
+     */
+    [[nodiscard]] inline std::size_t size() const noexcept { return m_lengths.size(); }
+
+    /**
+     * @brief Check if the string contains any of the patterns.
+     * @param _string   String to search in.
+     * @return True, if the string contains any pattern - otherwise false.
+     */
+    [[nodiscard]] bool containsAny( std::string_view _string ) const noexcept;
+
+    /**
+     * @brief Find all, also overlapping, occurrences of all patterns.
+     * @param _string   String to search in.
+     * @return Matches ordered by their end position. A pattern, which is added more than once, is reported by its first index.
+     * @note This function may throw an exception by push_back of std::vector.
+     */
+    [[nodiscard]] std::vector<Match> findAll( std::string_view _string ) const;
+
+  private:
+    /**
+     * @brief Member for character class of each byte. Bytes not used by any pattern share class 0.
+     */
+    std::array<std::uint8_t, std::numeric_limits<unsigned char>::max() + 1> m_alphabet {};
+
+    /**
+     * @brief Member for number of character classes.
+     */
+    std::size_t m_classes = 1;
+
+    /**
+     * @brief Member for the complete transition table - state * m_classes + class.
+     */
+    std::vector<std::uint32_t> m_transitions {};
+
+    /**
+     * @brief Member for pattern index ending at state - or npos.
+     */
+    std::vector<std::size_t> m_match {};
+
+    /**
+     * @brief Member for next state on the suffix chain, which ends a pattern - or 0.
+     */
+    std::vector<std::uint32_t> m_dictionary {};
+
+    /**
+     * @brief Member for pattern lengths.
+     */
+    std::vector<std::size_t> m_lengths {};
+
+    /**
+     * @brief Transition to the next state.
+     * @param _state   Current state.
+     * @param _chr   Next character.
+     * @return The next state.
+     */
+    [[nodiscard]] inline std::uint32_t next( std::uint32_t _state,
+                                             char _chr ) const noexcept { return m_transitions[ _state * m_classes + m_alphabet[ static_cast<unsigned char>( _chr ) ] ]; }
+  };
+
+  /**
+   * @brief Check if string contains any of the needles.
+   * @param _string   String to search in.
+   * @param _needles   Needles to search for.
+   * @return True, if the string contains any needle - otherwise false.
+   * @note This function may throw an exception by the constructor of MultiSearcher. Reuse a MultiSearcher for repeated searches.
+   */
+  [[nodiscard]] bool containsAny( std::string_view _string,
+                                  const std::vector<std::string_view> &_needles );
+
+  /**
+   * @brief Find all occurrences of all needles by scanning the string once.
+   * @param _string   String to search in.
+   * @param _needles   Needles to search for.
+   * @return Matches ordered by their end position.
+   * @note This function may throw an exception by the constructor of MultiSearcher. Reuse a MultiSearcher for repeated searches.
+   */
+  [[nodiscard]] std::vector<Match> findAll( std::string_view _string,
+                                            const std::vector<std::string_view> &_needles );
 }
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2011 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+/* c header */
+#include <cstddef> // std::size_t
+
+/* stl header */
+#include <limits>
+#include <new> // std::align_val_t, std::bad_array_new_length
+
+/**
+ * @brief vx (VX APPS) namespace.
+ */
+namespace vx {
+
+  /** @brief Default alignment in bytes, the size of a cache line and wide enough for every SIMD register. */
+  constexpr std::size_t defaultAlignment = 64;
+
+  /**
+   * @brief Allocator for aligned memory, e.g. for std::vector of values processed by SIMD.
+   * @author Florian Becker <fb\@vxapps.com> (VX APPS)
+   * @tparam T   Type.
+   * @tparam Alignment   Alignment in bytes.
+   */
+  template <typename T, std::size_t Alignment = defaultAlignment>
+  class AlignedAllocator {
+
+    static_assert( Alignment >= alignof( T ) && ( Alignment & ( Alignment - 1 ) ) == 0, "Alignment needs to be a power of two." );
+
+  public:
+    /** @brief Allocated type. */
+    using value_type = T;
+
+    /**
+     * @brief Rebind to another type.
+     * @tparam U   Other type.
+     */
+    template <typename U>
+    struct rebind {
+
+      /** @brief Allocator of the other type. */
+      using other = AlignedAllocator<U, Alignment>;
+    };
+
+    /**
+     * @brief Default constructor for AlignedAllocator.
+     */
+    constexpr AlignedAllocator() noexcept = default;
+
+    /**
+     * @brief Constructor for AlignedAllocator from another type.
+     * @tparam U   Other type.
+     */
+    template <typename U>
+    constexpr AlignedAllocator( const AlignedAllocator<U, Alignment> & ) noexcept {} // NOSONAR allocators need to be convertible implicitly.
+
+    /**
+     * @brief Allocate aligned memory.
+     * @param _count   Number of values.
+     * @return The aligned memory.
+     * @note This function may throw an exception by operator new.
+     */
+    [[nodiscard]] T *allocate( std::size_t _count ) {
+
+      if ( _count > std::numeric_limits<std::size_t>::max() / sizeof( T ) ) {
+
+        throw std::bad_array_new_length();
+      }
+      return static_cast<T *>( ::operator new( _count * sizeof( T ), std::align_val_t { Alignment } ) );
+    }
+
+    /**
+     * @brief Release aligned memory.
+     * @param _memory   Memory to release.
+     */
+    void deallocate( T *_memory,
+                     std::size_t ) noexcept {
+
+      ::operator delete( _memory, std::align_val_t { Alignment } );
+    }
+
+    /**
+     * @brief Equal operator.
+     * @tparam U   Other type.
+     * @return Always true, every allocator can release the memory of another.
+     */
+    template <typename U>
+    [[nodiscard]] constexpr bool operator==( const AlignedAllocator<U, Alignment> & ) const noexcept { return true; }
+  };
+}
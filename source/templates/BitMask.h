@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 2011 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+/* c header */
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint64_t
+
+/* stl header */
+#include <algorithm>
+#include <bit>
+#include <vector>
+
+/* local header */
+#include "AlignedAllocator.h"
+
+/**
+ * @brief vx (VX APPS) namespace.
+ */
+namespace vx {
+
+  /**
+   * @brief Packed result of batch tests, one bit per element.
+   * @author Florian Becker <fb\@vxapps.com> (VX APPS)
+   */
+  class BitMask {
+
+  public:
+    /** @brief Number of bits per word. */
+    static constexpr std::size_t wordBits = 64;
+
+    /**
+     * @brief Default constructor for BitMask.
+     */
+    BitMask() = default;
+
+    /**
+     * @brief Constructor for BitMask with every bit cleared.
+     * @param _size   Number of bits.
+     * @note This function may throw an exception by std::vector.
+     */
+    explicit BitMask( std::size_t _size )
+      : m_size( _size ),
+        m_words( wordCount( _size ) ) {}
+
+    /**
+     * @brief Return the number of bits.
+     * @return The number of bits.
+     */
+    [[nodiscard]] inline std::size_t size() const noexcept { return m_size; }
+
+    /**
+     * @brief Resize and clear every bit.
+     * @param _size   Number of bits.
+     * @note This function may throw an exception by std::vector.
+     */
+    inline void reset( std::size_t _size ) {
+
+      m_size = _size;
+      m_words.assign( wordCount( _size ), 0 );
+    }
+
+    /**
+     * @brief Return a bit.
+     * @param _index   Index of the bit.
+     * @return True, if the bit is set - otherwise false.
+     */
+    [[nodiscard]] inline bool test( std::size_t _index ) const noexcept { return ( m_words[ _index / wordBits ] >> ( _index % wordBits ) & 1 ) != 0; }
+
+    /**
+     * @brief Set or clear a bit.
+     * @param _index   Index of the bit.
+     * @param _value   True, to set the bit.
+     */
+    inline void set( std::size_t _index,
+                     bool _value = true ) noexcept {
+
+      const std::uint64_t bit = std::uint64_t { 1 } << ( _index % wordBits );
+      std::uint64_t &word = m_words[ _index / wordBits ];
+      word = _value ? word | bit : word & ~bit;
+    }
+
+    /**
+     * @brief Return the number of set bits.
+     * @return The number of set bits.
+     */
+    [[nodiscard]] inline std::size_t count() const noexcept {
+
+      std::size_t result = 0;
+      for ( const std::uint64_t word : m_words ) {
+
+        result += static_cast<std::size_t>( std::popcount( word ) );
+      }
+      return result;
+    }
+
+    /**
+     * @brief Call the function with the index of every set bit.
+     * @tparam Function   Function definition.
+     * @param _function   Function, which gets the index.
+     */
+    template <typename Function>
+    void forEach( Function _function ) const {
+
+      for ( std::size_t index = 0; index < m_words.size(); ++index ) {
+
+        for ( std::uint64_t word = m_words[ index ]; word != 0; word &= word - 1 ) {
+
+          _function( index * wordBits + static_cast<std::size_t>( std::countr_zero( word ) ) );
+        }
+      }
+    }
+
+    /**
+     * @brief Return the words of the bits, bit i is stored in word i / 64 at position i % 64.
+     * @return The words.
+     */
+    [[nodiscard]] inline std::uint64_t *words() noexcept { return m_words.data(); }
+
+    /**
+     * @brief Return the words of the bits, bit i is stored in word i / 64 at position i % 64.
+     * @return The words.
+     */
+    [[nodiscard]] inline const std::uint64_t *words() const noexcept { return m_words.data(); }
+
+    /**
+     * @brief Set every bit by a predicate, the predicate is evaluated branchless for a word at once.
+     * @tparam Function   Function definition.
+     * @param _size   Number of bits.
+     * @param _predicate   Predicate, which gets the index and returns the bit.
+     * @note This function may throw an exception by std::vector.
+     */
+    template <typename Function>
+    void assign( std::size_t _size,
+                 Function _predicate ) {
+
+      reset( _size );
+      for ( std::size_t index = 0; index < m_words.size(); ++index ) {
+
+        const std::size_t first = index * wordBits;
+        const std::size_t bits = std::min( wordBits, _size - first );
+        std::uint64_t word = 0;
+        for ( std::size_t bit = 0; bit < bits; ++bit ) {
+
+          word |= static_cast<std::uint64_t>( _predicate( first + bit ) ) << bit;
+        }
+        m_words[ index ] = word;
+      }
+    }
+
+    /**
+     * @brief Equal operator.
+     * @param _other   Mask to compare with.
+     * @return True, if both masks have the same bits - otherwise false.
+     */
+    [[nodiscard]] inline bool operator==( const BitMask &_other ) const noexcept { return m_size == _other.m_size && m_words == _other.m_words; }
+
+  private:
+    /**
+     * @brief Member for the number of bits.
+     */
+    std::size_t m_size = 0;
+
+    /**
+     * @brief Member for the words of the bits.
+     */
+    std::vector<std::uint64_t, AlignedAllocator<std::uint64_t>> m_words {};
+
+    /**
+     * @brief Return the number of words for bits.
+     * @param _size   Number of bits.
+     * @return The number of words.
+     */
+    [[nodiscard]] static constexpr std::size_t wordCount( std::size_t _size ) noexcept { return ( _size + wordBits - 1 ) / wordBits; }
+  };
+}
@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) 2020 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+/* c header */
+#include <cstddef> // std::size_t
+
+/* stl header */
+#include <array>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+/* local header */
+#include "StringUtils.h"
+
+/**
+ * @brief vx (VX APPS) namespace.
+ */
+namespace vx {
+
+  /**
+   * @brief A class to format rows of comma-separated values.
+   * Numbers are written by std::to_chars, text is quoted and escaped by RFC 4180, if it contains the delimiter, a quote or a line break.
+   * @author Florian Becker <fb\@vxapps.com> (VX APPS)
+   */
+  class CSVFormatter {
+
+  public:
+    /**
+     * @brief Default constructor for CSVFormatter.
+     * @param _delimiter   Delimiter of values.
+     * @param _linePrefix   Prefix for every line.
+     * @param _lineSuffix   Suffix for every line.
+     */
+    explicit CSVFormatter( std::string_view _delimiter = ",",
+                           std::string_view _linePrefix = {},
+                           std::string_view _lineSuffix = {} )
+      : m_delimiter( _delimiter ),
+        m_linePrefix( _linePrefix ),
+        m_lineSuffix( _lineSuffix ) {}
+
+    /**
+     * @brief Append the values as one line.
+     * @tparam Ts   Types.
+     * @param _row   Row to append to.
+     * @param _values   Values.
+     * @note This function may throw an exception by std::string.
+     */
+    template <typename... Ts>
+    void appendRow( std::string &_row,
+                    const Ts &..._values ) {
+
+      _row.append( m_linePrefix );
+      bool first = true;
+      ( ( appendDelimiter( _row, first ), appendField( _row, _values ) ), ... );
+      _row.append( m_lineSuffix );
+      _row.push_back( '\n' );
+    }
+
+    /**
+     * @brief Append the values of a range as one line.
+     * @tparam T   Type.
+     * @param _row   Row to append to.
+     * @param _first   First value.
+     * @param _last   Last value.
+     * @note This function may throw an exception by std::string.
+     */
+    template <typename T>
+    void appendRange( std::string &_row,
+                      T _first,
+                      T _last ) {
+
+      _row.append( m_linePrefix );
+      bool first = true;
+      /* Iterate over the range and add each element separated by delimiter. */
+      for ( ; _first != _last; ++_first ) {
+
+        appendDelimiter( _row, first );
+        appendField( _row, *_first );
+      }
+      _row.append( m_lineSuffix );
+      _row.push_back( '\n' );
+    }
+
+  private:
+    /**
+     * @brief Delimiter for values.
+     */
+    std::string_view m_delimiter {};
+
+    /**
+     * @brief Prefix for every line.
+     */
+    std::string_view m_linePrefix {};
+
+    /**
+     * @brief Suffix for every line.
+     */
+    std::string_view m_lineSuffix {};
+
+    /**
+     * @brief Member for formatting of types without a fast path.
+     */
+    std::ostringstream m_format {};
+
+    /**
+     * @brief Append the delimiter, if this is not the first field.
+     * @param _row   Row to append to.
+     * @param _first   True, for the first field - will be set to false.
+     */
+    inline void appendDelimiter( std::string &_row,
+                                 bool &_first ) const {
+
+      if ( !_first ) {
+
+        _row.append( m_delimiter );
+      }
+      _first = false;
+    }
+
+    /**
+     * @brief Append one field.
+     * @tparam T   Type.
+     * @param _row   Row to append to.
+     * @param _value   Value.
+     */
+    template <typename T>
+    void appendField( std::string &_row,
+                      const T &_value ) {
+
+      if constexpr ( std::is_same_v<T, bool> ) {
+
+        _row.append( _value ? "true" : "false" );
+      }
+      else if constexpr ( std::is_same_v<T, char> ) {
+
+        appendText( _row, std::string_view( &_value, 1 ) );
+      }
+      else if constexpr ( std::is_arithmetic_v<T> ) {
+
+        std::array<char, string_utils::formatSize<T>> buffer {};
+        _row.append( string_utils::format( buffer, _value ) );
+      }
+      else if constexpr ( std::is_convertible_v<const T &, std::string_view> ) {
+
+        appendText( _row, _value );
+      }
+      else {
+
+        m_format.str( {} );
+        m_format << _value;
+        appendText( _row, m_format.str() );
+      }
+    }
+
+    /**
+     * @brief Append text, quoted and escaped if needed.
+     * @param _row   Row to append to.
+     * @param _text   Text.
+     */
+    void appendText( std::string &_row,
+                     std::string_view _text ) const {
+
+      const std::array special { '"', '\r', '\n', m_delimiter.empty() ? '"' : m_delimiter.front() };
+      if ( string_utils::findFirstOf( _text, { special.data(), special.size() } ) == std::string_view::npos ) {
+
+        _row.append( _text );
+        return;
+      }
+
+      /* Quote the field and double every quote */
+      _row.push_back( '"' );
+      std::size_t quote = _text.find( '"' );
+      while ( quote != std::string_view::npos ) {
+
+        _row.append( _text.substr( 0, quote + 1 ) );
+        _row.push_back( '"' );
+        _text.remove_prefix( quote + 1 );
+        quote = _text.find( '"' );
+      }
+      _row.append( _text );
+      _row.push_back( '"' );
+    }
+  };
+}
@@ -30,15 +30,27 @@
 
 #pragma once
 
+/* c header */
+#include <cstddef> // std::size_t
+
 /* stl header */
+#include <chrono>
+#include <exception>
 #include <fstream>
 #include <ios>
 #if __cplusplus >= 202002L
   #include <iterator>
 #endif
+#include <new> // std::bad_alloc
 #include <ostream>
 #include <string>
 #include <string_view>
+#include <tuple>
+#include <vector>
+
+/* local header */
+#include "CSVFormatter.h"
+#include "Logger.h"
 
 /**
  * @brief vx (VX APPS) namespace.
@@ -47,11 +59,17 @@ namespace vx {
 
   /**
    * @brief A class to create and write data in a csv file.
+   * The file is opened with the first row and kept open, rows are written through a buffer.
+   * The buffer is written out when it is full, when the flush interval is elapsed, by flush() and on destruction.
+   * The rows are formatted by CSVFormatter.
    * @author Florian Becker <fb\@vxapps.com> (VX APPS)
    */
   class CSVWriter {
 
   public:
+    /** @brief Default buffer size in bytes. */
+    static constexpr std::size_t defaultBufferSize = 1024 * 1024;
+
     /**
      * @brief Default constructor for CsvWriter.
      * @param _filename   Filename for the csv file.
@@ -64,9 +82,64 @@ namespace vx {
                         std::string_view _linePrefix = {},
                         std::string_view _lineSuffix = {} )
       : m_filename( _filename ),
-        m_delimiter( _delimiter ),
-        m_linePrefix( _linePrefix ),
-        m_lineSuffix( _lineSuffix ) {}
+        m_formatter( _delimiter, _linePrefix, _lineSuffix ) {}
+
+    /**
+     * @brief Delete copy constructor.
+     */
+    CSVWriter( const CSVWriter & ) = delete;
+
+    /**
+     * @brief Default move constructor.
+     */
+    CSVWriter( CSVWriter && ) noexcept = default;
+
+    /**
+     * @brief Delete copy assign.
+     * @return Nothing.
+     */
+    CSVWriter &operator=( const CSVWriter & ) = delete;
+
+    /**
+     * @brief Delete move assign.
+     * @return Nothing.
+     */
+    CSVWriter &operator=( CSVWriter && ) = delete;
+
+    /**
+     * @brief Default destructor for CSVWriter, which writes out the buffer and closes the file.
+     */
+    ~CSVWriter() noexcept { close(); }
+
+    /**
+     * @brief Is the csv file open?
+     * @return True, if open - otherwise false.
+     */
+    [[nodiscard]] inline bool isOpen() const noexcept { return m_file.is_open(); }
+
+    /**
+     * @brief Return the buffer size.
+     * @return The buffer size in bytes.
+     */
+    [[nodiscard]] inline std::size_t bufferSize() const noexcept { return m_bufferSize; }
+
+    /**
+     * @brief Set the buffer size, only used if set before the first row.
+     * @param _bufferSize   The buffer size in bytes - 0 writes every row unbuffered.
+     */
+    inline void setBufferSize( std::size_t _bufferSize ) noexcept { m_bufferSize = _bufferSize; }
+
+    /**
+     * @brief Return the flush interval.
+     * @return The flush interval - 0 is disabled.
+     */
+    [[nodiscard]] inline std::chrono::milliseconds flushInterval() const noexcept { return m_flushInterval; }
+
+    /**
+     * @brief Set the flush interval, the buffer is written out with the next row after the interval is elapsed.
+     * @param _flushInterval   The flush interval - 0 disables flushing by time.
+     */
+    inline void setFlushInterval( std::chrono::milliseconds _flushInterval ) noexcept { m_flushInterval = _flushInterval; }
 
     /**
      * @brief Write out the values.
@@ -84,26 +157,81 @@ namespace vx {
     template <typename T>
 #endif
     void addRowData( T _first,
-                     T _last ) const noexcept {
+                     T _last ) noexcept {
+
+      writeRange( _first, _last );
+      maybeFlush();
+    }
+
+    /**
+     * @brief Write out the values as one row.
+     * @tparam Ts   Types.
+     * @param _values   Values.
+     */
+    template <typename... Ts>
+    void writeRow( const Ts &..._values ) noexcept {
+
+      writeLine( [ this, &_values... ]() { m_formatter.appendRow( m_row, _values... ); } );
+      maybeFlush();
+    }
 
-      std::ofstream file {};
-      file.open( m_filename, std::ios::app );
+    /**
+     * @brief Write out the tuple as one row.
+     * @tparam Ts   Types.
+     * @param _values   Tuple of values.
+     */
+    template <typename... Ts>
+    void writeRow( const std::tuple<Ts...> &_values ) noexcept {
+
+      std::apply( [ this ]( const auto &..._value ) { writeRow( _value... ); }, _values );
+    }
 
-      file << m_linePrefix;
-      /* Iterate over the range and add each element to file separated by delimiter. */
-      while ( _first != _last ) {
+    /**
+     * @brief Write out a batch of rows and check the flush interval once.
+     * @tparam T   Type.
+     * @param _first   First row, every row is a range of values.
+     * @param _last   Last row.
+     */
+#if __cplusplus >= 202002L
+  #if defined __clang__ && __clang_major__ > 12
+    template <std::forward_iterator T>
+  #else
+    template <typename T>
+  #endif
+#else
+    template <typename T>
+#endif
+    void addRows( T _first,
+                  T _last ) noexcept {
+
+      for ( ; _first != _last; ++_first ) {
+
+        writeRange( std::cbegin( *_first ), std::cend( *_first ) );
+      }
+      maybeFlush();
+    }
+
+    /**
+     * @brief Write out the buffer.
+     */
+    inline void flush() noexcept {
 
-        file << *_first;
-        if ( ++_first != _last ) {
+      if ( m_file.is_open() ) {
 
-          file << m_delimiter;
-        }
+        m_file.flush();
       }
-      file << m_lineSuffix;
-      file << std::endl;
+      m_lastFlush = std::chrono::steady_clock::now();
+    }
+
+    /**
+     * @brief Write out the buffer and close the csv file. The next row will open it again.
+     */
+    inline void close() noexcept {
 
-      /* Close the file. */
-      file.close();
+      if ( m_file.is_open() ) {
+
+        m_file.close();
+      }
     }
 
   private:
@@ -113,18 +241,127 @@ namespace vx {
     std::string m_filename {};
 
     /**
-     * @brief Delimiter for values.
+     * @brief Member for formatting of the rows.
+     */
+    CSVFormatter m_formatter;
+
+    /**
+     * @brief Member for buffer size.
+     */
+    std::size_t m_bufferSize = defaultBufferSize;
+
+    /**
+     * @brief Member for flush interval.
+     */
+    std::chrono::milliseconds m_flushInterval { 0 };
+
+    /**
+     * @brief Member for timestamp of the last flush.
+     */
+    std::chrono::steady_clock::time_point m_lastFlush {};
+
+    /**
+     * @brief Member for buffer, which is used by the file stream.
+     */
+    std::vector<char> m_buffer {};
+
+    /**
+     * @brief Member for the csv file.
      */
-    std::string_view m_delimiter {};
+    std::ofstream m_file {};
 
     /**
-     * @brief Prefix for every line.
+     * @brief Member for the current row, which is reused for every row.
      */
-    std::string_view m_linePrefix {};
+    std::string m_row {};
 
     /**
-     * @brief Suffix for every line.
+     * @brief Open the csv file for appending, if it is not open.
+     * @return True, if the file is open - otherwise false.
      */
-    std::string_view m_lineSuffix {};
+    bool open() noexcept {
+
+      if ( m_file.is_open() ) {
+
+        return true;
+      }
+
+      /* The buffer needs to be set before the file is opened. */
+      try {
+
+        m_buffer.resize( m_bufferSize );
+        m_file.rdbuf()->pubsetbuf( m_buffer.data(), static_cast<std::streamsize>( m_buffer.size() ) );
+      }
+      catch ( const std::bad_alloc &_exception ) {
+
+        logFatal() << "bad_alloc:" << _exception.what();
+      }
+      catch ( const std::exception &_exception ) { // NOSONAR fallback for every exeption.
+
+        logFatal() << _exception.what();
+      }
+      m_file.open( m_filename, std::ios::app );
+      if ( !m_file.is_open() ) {
+
+        logError() << "Unable to open csv file:" << m_filename;
+        return false;
+      }
+      m_lastFlush = std::chrono::steady_clock::now();
+      return true;
+    }
+
+    /**
+     * @brief Write one line into the buffer.
+     * @tparam Function   Function definition.
+     * @param _fields   Function, which appends the line to the current row.
+     */
+    template <typename Function>
+    void writeLine( Function _fields ) noexcept {
+
+      if ( !open() ) {
+
+        return;
+      }
+      try {
+
+        m_row.clear();
+        _fields();
+      }
+      catch ( const std::bad_alloc &_exception ) {
+
+        logFatal() << "bad_alloc:" << _exception.what();
+        return;
+      }
+      catch ( const std::exception &_exception ) { // NOSONAR fallback for every exeption.
+
+        logFatal() << _exception.what();
+        return;
+      }
+      m_file.write( m_row.data(), static_cast<std::streamsize>( m_row.size() ) );
+    }
+
+    /**
+     * @brief Write one row of a range into the buffer.
+     * @tparam T   Type.
+     * @param _first   First value.
+     * @param _last   Last value.
+     */
+    template <typename T>
+    void writeRange( T _first,
+                     T _last ) noexcept {
+
+      writeLine( [ this, &_first, &_last ]() { m_formatter.appendRange( m_row, _first, _last ); } );
+    }
+
+    /**
+     * @brief Flush if the flush interval is elapsed.
+     */
+    inline void maybeFlush() noexcept {
+
+      if ( m_flushInterval.count() > 0 && std::chrono::steady_clock::now() - m_lastFlush >= m_flushInterval ) {
+
+        flush();
+      }
+    }
   };
 }
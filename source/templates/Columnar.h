@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2020 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+/* c header */
+#include <cstdint> // std::uint8_t, std::uint32_t, std::int8_t, std::int16_t, std::int32_t, std::int64_t
+
+/* stl header */
+#include <array>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+/**
+ * @brief vx (VX APPS) columnar namespace.
+ * The columnar file format is a compact binary alternative to csv files.
+ *
+ * Layout, all numbers are stored in native byte order:
+ * - Header: magic, flags (std::uint8_t), column count (std::uint32_t), per column the type (std::uint8_t) and the name (std::uint32_t length and characters).
+ * - Blocks until the end of the file: row count (std::uint32_t), per column:
+ *   - Numbers: minimum and maximum of the block, if the statistics flag is set, followed by the values.
+ *   - Text: dictionary count (std::uint32_t), every entry (std::uint32_t length and characters), followed by one std::uint32_t dictionary index per row.
+ */
+namespace vx::columnar {
+
+  /**
+   * @brief The column type enum.
+   */
+  enum class Type : std::uint8_t {
+
+    Bool,   /**< Boolean. */
+    Int8,   /**< std::int8_t. */
+    UInt8,  /**< std::uint8_t. */
+    Int16,  /**< std::int16_t. */
+    UInt16, /**< std::uint16_t. */
+    Int32,  /**< std::int32_t. */
+    UInt32, /**< std::uint32_t. */
+    Int64,  /**< std::int64_t. */
+    UInt64, /**< std::uint64_t. */
+    Float,  /**< float. */
+    Double, /**< double. */
+    Text    /**< Dictionary encoded text. */
+  };
+
+  /** @brief Magic bytes at the start of a columnar file. */
+  constexpr std::array magic { 'V', 'X', 'C', 'O', 'L', '\0', '\0', '\1' };
+
+  /** @brief Flag for blocks with minimum and maximum of the number columns. */
+  constexpr std::uint8_t statisticsFlag = 0x01;
+
+  /** @brief Is the type stored as dictionary encoded text? */
+  template <typename T>
+  constexpr bool isText = std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view>;
+
+  /**
+   * @brief Return the column type of a type.
+   * @tparam T   Type.
+   * @return The column type.
+   */
+  template <typename T>
+  [[nodiscard]] constexpr Type typeOf() noexcept {
+
+    if constexpr ( isText<T> ) {
+
+      return Type::Text;
+    }
+    else if constexpr ( std::is_same_v<T, bool> ) {
+
+      return Type::Bool;
+    }
+    else if constexpr ( std::is_same_v<T, float> ) {
+
+      return Type::Float;
+    }
+    else if constexpr ( std::is_same_v<T, double> ) {
+
+      return Type::Double;
+    }
+    else {
+
+      static_assert( std::is_integral_v<T> && sizeof( T ) <= sizeof( std::int64_t ), "Unsupported column type." );
+      constexpr std::array types = std::is_signed_v<T> ? std::array { Type::Int8, Type::Int16, Type::Int32, Type::Int64 } : std::array { Type::UInt8, Type::UInt16, Type::UInt32, Type::UInt64 };
+      if constexpr ( sizeof( T ) == sizeof( std::int8_t ) ) {
+
+        return types[ 0 ];
+      }
+      else if constexpr ( sizeof( T ) == sizeof( std::int16_t ) ) {
+
+        return types[ 1 ];
+      }
+      else if constexpr ( sizeof( T ) == sizeof( std::int32_t ) ) {
+
+        return types[ 2 ];
+      }
+      else {
+
+        return types[ 3 ];
+      }
+    }
+  }
+}
@@ -0,0 +1,488 @@
+/*
+ * Copyright (c) 2020 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+/* c header */
+#include <cstddef> // std::ptrdiff_t, std::size_t
+#include <cstdint> // std::uint8_t, std::uint32_t
+
+/* stl header */
+#include <algorithm>
+#include <array>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <ios>
+#if __cplusplus >= 202002L
+  #include <iterator>
+#endif
+#include <limits>
+#include <new> // std::bad_alloc
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/* local header */
+#include "Columnar.h"
+#include "Logger.h"
+
+/**
+ * @brief vx (VX APPS) namespace.
+ */
+namespace vx {
+
+  /**
+   * @brief A class to write typed rows into a columnar file.
+   * The rows are collected in blocks, each block is written out column by column.
+   * Number columns are written with fixed width, text columns are dictionary encoded per block.
+   * The file can be read by ColumnarReader, which also converts it into a csv file.
+   * @author Florian Becker <fb\@vxapps.com> (VX APPS)
+   * @tparam Ts   Column types - integral types, float, double, bool, std::string or std::string_view.
+   */
+  template <typename... Ts>
+  class ColumnarWriter {
+
+  public:
+    /** @brief Default number of rows per block. */
+    static constexpr std::size_t defaultBlockRows = 64 * 1024;
+
+    /** @brief Number of columns. */
+    static constexpr std::size_t columnCount = sizeof...( Ts );
+
+    /**
+     * @brief Default constructor for ColumnarWriter.
+     * @param _filename   Filename for the columnar file, an existing file is replaced.
+     * @param _names   Column names.
+     */
+    explicit ColumnarWriter( std::string_view _filename,
+                             const std::array<std::string_view, columnCount> &_names = {} )
+      : m_filename( _filename ),
+        m_names( _names ) {}
+
+    /**
+     * @brief Delete copy constructor.
+     */
+    ColumnarWriter( const ColumnarWriter & ) = delete;
+
+    /**
+     * @brief Delete move constructor.
+     */
+    ColumnarWriter( ColumnarWriter && ) = delete;
+
+    /**
+     * @brief Delete copy assign.
+     * @return Nothing.
+     */
+    ColumnarWriter &operator=( const ColumnarWriter & ) = delete;
+
+    /**
+     * @brief Delete move assign.
+     * @return Nothing.
+     */
+    ColumnarWriter &operator=( ColumnarWriter && ) = delete;
+
+    /**
+     * @brief Default destructor for ColumnarWriter, which writes out the last block and closes the file.
+     */
+    ~ColumnarWriter() noexcept { close(); }
+
+    /**
+     * @brief Is the columnar file open?
+     * @return True, if open - otherwise false.
+     */
+    [[nodiscard]] inline bool isOpen() const noexcept { return m_file.is_open(); }
+
+    /**
+     * @brief Return the number of rows per block.
+     * @return The number of rows per block.
+     */
+    [[nodiscard]] inline std::size_t blockRows() const noexcept { return m_blockRows; }
+
+    /**
+     * @brief Set the number of rows per block.
+     * @param _blockRows   The number of rows per block - at least 1, at most the 32 bit row count of a block.
+     */
+    inline void setBlockRows( std::size_t _blockRows ) noexcept { m_blockRows = std::clamp( _blockRows, std::size_t { 1 }, std::size_t { std::numeric_limits<std::uint32_t>::max() } ); }
+
+    /**
+     * @brief Are minimum and maximum of the number columns written per block?
+     * @return True, if the statistics are written - otherwise false.
+     */
+    [[nodiscard]] inline bool statistics() const noexcept { return m_statistics; }
+
+    /**
+     * @brief Write minimum and maximum of the number columns per block - ignored after the first row, because the header
+     * of the file is written then.
+     * @param _statistics   True, to write the statistics.
+     */
+    inline void setStatistics( bool _statistics ) noexcept {
+
+      if ( !m_file.is_open() ) {
+
+        m_statistics = _statistics;
+      }
+    }
+
+    /**
+     * @brief Write out the values as one row.
+     * @tparam Us   Types, which are converted into the column types.
+     * @param _values   Values.
+     */
+    template <typename... Us>
+    void writeRow( const Us &..._values ) noexcept {
+
+      static_assert( sizeof...( Us ) == columnCount, "Every column needs a value." );
+      if ( !open() ) {
+
+        return;
+      }
+      try {
+
+        appendRow( std::index_sequence_for<Ts...> {}, _values... );
+      }
+      catch ( const std::bad_alloc &_exception ) {
+
+        logFatal() << "bad_alloc:" << _exception.what();
+        return;
+      }
+      catch ( const std::exception &_exception ) { // NOSONAR fallback for every exeption.
+
+        logFatal() << _exception.what();
+        return;
+      }
+      if ( ++m_rows >= m_blockRows ) {
+
+        flush();
+      }
+    }
+
+    /**
+     * @brief Write out the tuple as one row.
+     * @tparam Us   Types, which are converted into the column types.
+     * @param _values   Tuple of values.
+     */
+    template <typename... Us>
+    void writeRow( const std::tuple<Us...> &_values ) noexcept {
+
+      std::apply( [ this ]( const auto &..._value ) { writeRow( _value... ); }, _values );
+    }
+
+    /**
+     * @brief Write out a batch of rows.
+     * @tparam T   Type.
+     * @param _first   First row, every row is a tuple of values.
+     * @param _last   Last row.
+     */
+#if __cplusplus >= 202002L
+  #if defined __clang__ && __clang_major__ > 12
+    template <std::forward_iterator T>
+  #else
+    template <typename T>
+  #endif
+#else
+    template <typename T>
+#endif
+    void addRows( T _first,
+                  T _last ) noexcept {
+
+      for ( ; _first != _last; ++_first ) {
+
+        writeRow( *_first );
+      }
+    }
+
+    /**
+     * @brief Write out the collected rows as block.
+     */
+    void flush() noexcept {
+
+      if ( m_rows == 0 || !m_file.is_open() ) {
+
+        return;
+      }
+      writeNumber( static_cast<std::uint32_t>( m_rows ) );
+      try {
+
+        std::apply( [ this ]( auto &..._column ) { ( writeColumn( _column ), ... ); }, m_columns );
+      }
+      catch ( const std::bad_alloc &_exception ) {
+
+        logFatal() << "bad_alloc:" << _exception.what();
+      }
+      catch ( const std::exception &_exception ) { // NOSONAR fallback for every exeption.
+
+        logFatal() << _exception.what();
+      }
+      m_rows = 0;
+      m_file.flush();
+    }
+
+    /**
+     * @brief Write out the last block and close the columnar file.
+     */
+    void close() noexcept {
+
+      flush();
+      if ( m_file.is_open() ) {
+
+        m_file.close();
+      }
+    }
+
+  private:
+    /**
+     * @brief Hash for text, which finds std::string keys by std::string_view.
+     */
+    struct TextHash {
+
+      /** @brief Enable heterogeneous lookup. */
+      using is_transparent = void;
+
+      /**
+       * @brief Hash the text.
+       * @param _text   Text.
+       * @return Hash of the text.
+       */
+      std::size_t operator()( std::string_view _text ) const noexcept { return std::hash<std::string_view> {}( _text ); }
+    };
+
+    /**
+     * @brief Values of one column in the current block.
+     * @tparam T   Column type.
+     */
+    template <typename T>
+    struct Column {
+
+      /** @brief Stored type of a value - text is stored as dictionary index. */
+      using Value = std::conditional_t<columnar::isText<T>, std::uint32_t, std::conditional_t<std::is_same_v<T, bool>, std::uint8_t, T>>;
+
+      /** @brief Values of the block. */
+      std::vector<Value> values {};
+
+      /** @brief Dictionary of the text in the block. */
+      std::unordered_map<std::string, std::uint32_t, TextHash, std::equal_to<>> dictionary {};
+    };
+
+    /**
+     * @brief Columnar filename.
+     */
+    std::string m_filename {};
+
+    /**
+     * @brief Column names.
+     */
+    std::array<std::string_view, columnCount> m_names {};
+
+    /**
+     * @brief Member for the number of rows per block.
+     */
+    std::size_t m_blockRows = defaultBlockRows;
+
+    /**
+     * @brief Member if the statistics are written - fixed, while the file is open.
+     */
+    bool m_statistics = true;
+
+    /**
+     * @brief Member for the number of rows in the current block.
+     */
+    std::size_t m_rows = 0;
+
+    /**
+     * @brief Member for the columns of the current block.
+     */
+    std::tuple<Column<Ts>...> m_columns {};
+
+    /**
+     * @brief Member for the columnar file.
+     */
+    std::ofstream m_file {};
+
+    /**
+     * @brief Open the columnar file and write the header, if it is not open.
+     * @return True, if the file is open - otherwise false.
+     */
+    bool open() noexcept {
+
+      if ( m_file.is_open() ) {
+
+        return true;
+      }
+      m_file.open( m_filename, std::ios::out | std::ios::binary | std::ios::trunc );
+      if ( !m_file.is_open() ) {
+
+        logError() << "Unable to open columnar file:" << m_filename;
+        return false;
+      }
+      m_file.write( columnar::magic.data(), static_cast<std::streamsize>( columnar::magic.size() ) );
+      writeNumber( m_statistics ? columnar::statisticsFlag : std::uint8_t { 0 } );
+      writeNumber( static_cast<std::uint32_t>( columnCount ) );
+      constexpr std::array types { columnar::typeOf<Ts>()... };
+      for ( std::size_t column = 0; column < columnCount; ++column ) {
+
+        writeNumber( static_cast<std::uint8_t>( types.at( column ) ) );
+        writeText( m_names.at( column ) );
+      }
+      return true;
+    }
+
+    /**
+     * @brief Append the values of one row to the columns.
+     * @tparam Is   Column indexes.
+     * @tparam Us   Types.
+     * @param _values   Values.
+     */
+    template <std::size_t... Is, typename... Us>
+    void appendRow( std::index_sequence<Is...>,
+                    const Us &..._values ) {
+
+      const std::array<std::size_t, columnCount> sizes { std::get<Is>( m_columns ).values.size()... };
+      const std::array<std::size_t, columnCount> dictionarySizes { std::get<Is>( m_columns ).dictionary.size()... };
+      try {
+
+        ( appendValue( std::get<Is>( m_columns ), _values ), ... );
+      }
+      catch ( ... ) {
+
+        /* Columns of different lengths would corrupt the block, so the row is removed again. */
+        ( truncate( std::get<Is>( m_columns ), sizes[ Is ], dictionarySizes[ Is ] ), ... );
+        throw;
+      }
+    }
+
+    /**
+     * @brief Remove the values and dictionary entries of a column, which are appended after a size.
+     * @tparam T   Column type.
+     * @param _column   Column.
+     * @param _size   Number of values to keep.
+     * @param _dictionarySize   Number of dictionary entries to keep.
+     */
+    template <typename T>
+    static void truncate( Column<T> &_column,
+                          std::size_t _size,
+                          std::size_t _dictionarySize ) noexcept {
+
+      _column.values.erase( std::begin( _column.values ) + static_cast<std::ptrdiff_t>( _size ), std::end( _column.values ) );
+      if constexpr ( columnar::isText<T> ) {
+
+        for ( auto entry = std::begin( _column.dictionary ); entry != std::end( _column.dictionary ); ) {
+
+          entry = entry->second >= _dictionarySize ? _column.dictionary.erase( entry ) : std::next( entry );
+        }
+      }
+    }
+
+    /**
+     * @brief Append one value to a column.
+     * @tparam T   Column type.
+     * @tparam U   Value type.
+     * @param _column   Column.
+     * @param _value   Value.
+     */
+    template <typename T, typename U>
+    void appendValue( Column<T> &_column,
+                      const U &_value ) {
+
+      if constexpr ( columnar::isText<T> ) {
+
+        const std::string_view text = _value;
+        auto entry = _column.dictionary.find( text );
+        if ( entry == std::end( _column.dictionary ) ) {
+
+          entry = _column.dictionary.emplace( text, static_cast<std::uint32_t>( _column.dictionary.size() ) ).first;
+        }
+        _column.values.push_back( entry->second );
+      }
+      else {
+
+        _column.values.push_back( static_cast<typename Column<T>::Value>( static_cast<T>( _value ) ) );
+      }
+    }
+
+    /**
+     * @brief Write out one column of the current block and clear it.
+     * @tparam T   Column type.
+     * @param _column   Column.
+     * @note This function may throw an exception by std::vector.
+     */
+    template <typename T>
+    void writeColumn( Column<T> &_column ) {
+
+      if constexpr ( columnar::isText<T> ) {
+
+        std::vector<std::string_view> entries( _column.dictionary.size() );
+        for ( const auto &[ text, index ] : _column.dictionary ) {
+
+          entries[ index ] = text;
+        }
+        writeNumber( static_cast<std::uint32_t>( entries.size() ) );
+        for ( const std::string_view entry : entries ) {
+
+          writeText( entry );
+        }
+        _column.dictionary.clear();
+      }
+      else if ( m_statistics ) {
+
+        const auto [ min, max ] = std::minmax_element( std::cbegin( _column.values ), std::cend( _column.values ) );
+        writeNumber( *min );
+        writeNumber( *max );
+      }
+      m_file.write( reinterpret_cast<const char *>( _column.values.data() ), static_cast<std::streamsize>( _column.values.size() * sizeof( typename Column<T>::Value ) ) ); // NOSONAR binary output of fixed width values.
+      _column.values.clear();
+    }
+
+    /**
+     * @brief Write out a number in native byte order.
+     * @tparam T   Type.
+     * @param _value   Number.
+     */
+    template <typename T>
+    void writeNumber( T _value ) noexcept {
+
+      m_file.write( reinterpret_cast<const char *>( &_value ), sizeof( T ) ); // NOSONAR binary output of fixed width values.
+    }
+
+    /**
+     * @brief Write out text with its length.
+     * @param _text   Text.
+     */
+    void writeText( std::string_view _text ) noexcept {
+
+      writeNumber( static_cast<std::uint32_t>( _text.size() ) );
+      m_file.write( _text.data(), static_cast<std::streamsize>( _text.size() ) );
+    }
+  };
+}
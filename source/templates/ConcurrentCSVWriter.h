@@ -0,0 +1,568 @@
+/*
+ * Copyright (c) 2020 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+/* c header */
+#include <cstddef> // std::size_t
+
+/* stl header */
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <ios>
+#if __cplusplus >= 202002L
+  #include <iterator>
+#endif
+#include <mutex>
+#include <new> // std::bad_alloc
+#include <string>
+#include <string_view>
+#ifdef HAVE_JTHREAD
+  #include <thread>
+#else
+  #ifdef __clang__
+    #pragma clang diagnostic push
+    #pragma clang diagnostic ignored "-Weverything"
+  #endif
+  #include <jthread.hpp>
+  #ifdef __clang__
+    #pragma clang diagnostic pop
+  #endif
+#endif
+#include <tuple>
+#include <vector>
+
+/* local header */
+#include "CSVFormatter.h"
+#include "Logger.h"
+
+/**
+ * @brief vx (VX APPS) namespace.
+ */
+namespace vx {
+
+  /**
+   * @brief A class to write a csv file from many threads.
+   * Every thread writes through its own Producer, which collects complete rows in a block.
+   * Full blocks are handed off to a background thread, which writes them out in the order they were handed off.
+   * So the rows are never interleaved and the rows of one producer keep their order.
+   * If more than the maximal pending blocks are waiting, the producers wait for the background thread.
+   * @author Florian Becker <fb\@vxapps.com> (VX APPS)
+   */
+  class ConcurrentCSVWriter {
+
+  public:
+    /** @brief Default block size in bytes. */
+    static constexpr std::size_t defaultBlockSize = 64 * 1024;
+
+    /** @brief Default maximal number of blocks waiting to be written. */
+    static constexpr std::size_t defaultMaxPendingBlocks = 64;
+
+    /**
+     * @brief Rows of one thread, which are handed off to the writer block by block.
+     * A producer must not be shared between threads.
+     * @author Florian Becker <fb\@vxapps.com> (VX APPS)
+     */
+    class Producer {
+
+    public:
+      /**
+       * @brief Default constructor for Producer.
+       * @param _writer   Writer, which writes out the rows.
+       */
+      explicit Producer( ConcurrentCSVWriter &_writer )
+        : m_writer( &_writer ),
+          m_formatter( _writer.m_delimiter, _writer.m_linePrefix, _writer.m_lineSuffix ),
+          m_blockSize( _writer.m_blockSize ),
+          m_flushInterval( _writer.m_flushInterval ),
+          m_lastHandOff( std::chrono::steady_clock::now() ) {}
+
+      /**
+       * @brief Delete copy constructor.
+       */
+      Producer( const Producer & ) = delete;
+
+      /**
+       * @brief Default move constructor.
+       */
+      Producer( Producer && ) noexcept = default;
+
+      /**
+       * @brief Delete copy assign.
+       * @return Nothing.
+       */
+      Producer &operator=( const Producer & ) = delete;
+
+      /**
+       * @brief Delete move assign.
+       * @return Nothing.
+       */
+      Producer &operator=( Producer && ) = delete;
+
+      /**
+       * @brief Default destructor for Producer, which hands off the remaining rows.
+       */
+      ~Producer() noexcept { flush(); }
+
+      /**
+       * @brief Write out the values as one row.
+       * @tparam Ts   Types.
+       * @param _values   Values.
+       */
+      template <typename... Ts>
+      void writeRow( const Ts &..._values ) noexcept {
+
+        appendLine( [ this, &_values... ]() { m_formatter.appendRow( m_block, _values... ); } );
+      }
+
+      /**
+       * @brief Write out the tuple as one row.
+       * @tparam Ts   Types.
+       * @param _values   Tuple of values.
+       */
+      template <typename... Ts>
+      void writeRow( const std::tuple<Ts...> &_values ) noexcept {
+
+        std::apply( [ this ]( const auto &..._value ) { writeRow( _value... ); }, _values );
+      }
+
+      /**
+       * @brief Write out the values.
+       * @tparam T   Type.
+       * @param _first   First value.
+       * @param _last   Last value.
+       */
+#if __cplusplus >= 202002L
+  #if defined __clang__ && __clang_major__ > 12
+      template <std::forward_iterator T>
+  #else
+      template <typename T>
+  #endif
+#else
+      template <typename T>
+#endif
+      void addRowData( T _first,
+                       T _last ) noexcept {
+
+        appendLine( [ this, &_first, &_last ]() { m_formatter.appendRange( m_block, _first, _last ); } );
+      }
+
+      /**
+       * @brief Hand off the collected rows to the writer.
+       */
+      inline void flush() noexcept {
+
+        if ( m_writer && !m_block.empty() ) {
+
+          m_writer->handOff( m_block );
+        }
+        m_lastHandOff = std::chrono::steady_clock::now();
+      }
+
+    private:
+      /**
+       * @brief Member for the writer.
+       */
+      ConcurrentCSVWriter *m_writer = nullptr;
+
+      /**
+       * @brief Member for formatting of the rows.
+       */
+      CSVFormatter m_formatter;
+
+      /**
+       * @brief Member for block size.
+       */
+      std::size_t m_blockSize = defaultBlockSize;
+
+      /**
+       * @brief Member for flush interval.
+       */
+      std::chrono::milliseconds m_flushInterval { 0 };
+
+      /**
+       * @brief Member for timestamp of the last hand off.
+       */
+      std::chrono::steady_clock::time_point m_lastHandOff {};
+
+      /**
+       * @brief Member for the collected rows.
+       */
+      std::string m_block {};
+
+      /**
+       * @brief Append one line to the block and hand off the block, if it is full or the flush interval is elapsed.
+       * @tparam Function   Function definition.
+       * @param _line   Function, which appends the line to the block.
+       */
+      template <typename Function>
+      void appendLine( Function _line ) noexcept {
+
+        const std::size_t size = m_block.size();
+        try {
+
+          _line();
+        }
+        catch ( const std::bad_alloc &_exception ) {
+
+          /* Never hand off a partial row. */
+          m_block.resize( size );
+          logFatal() << "bad_alloc:" << _exception.what();
+          return;
+        }
+        catch ( const std::exception &_exception ) { // NOSONAR fallback for every exeption.
+
+          m_block.resize( size );
+          logFatal() << _exception.what();
+          return;
+        }
+        if ( m_block.size() >= m_blockSize || ( m_flushInterval.count() > 0 && std::chrono::steady_clock::now() - m_lastHandOff >= m_flushInterval ) ) {
+
+          flush();
+        }
+      }
+    };
+
+    /**
+     * @brief Default constructor for ConcurrentCSVWriter, which opens the file and starts the background thread.
+     * @param _filename   Filename for the csv file.
+     * @param _delimiter   Delimiter of values.
+     * @param _linePrefix   Prefix for every line.
+     * @param _lineSuffix   Suffix for every line.
+     */
+    explicit ConcurrentCSVWriter( std::string_view _filename,
+                                  std::string_view _delimiter = ",",
+                                  std::string_view _linePrefix = {},
+                                  std::string_view _lineSuffix = {} )
+      : m_delimiter( _delimiter ),
+        m_linePrefix( _linePrefix ),
+        m_lineSuffix( _lineSuffix ) {
+
+      m_file.open( std::string( _filename ), std::ios::app );
+      if ( !m_file.is_open() ) {
+
+        logError() << "Unable to open csv file:" << _filename;
+        m_stop = true;
+        return;
+      }
+      m_thread = std::jthread( [ this ]() { run(); } );
+    }
+
+    /**
+     * @brief Delete copy constructor.
+     */
+    ConcurrentCSVWriter( const ConcurrentCSVWriter & ) = delete;
+
+    /**
+     * @brief Delete move constructor.
+     */
+    ConcurrentCSVWriter( ConcurrentCSVWriter && ) = delete;
+
+    /**
+     * @brief Delete copy assign.
+     * @return Nothing.
+     */
+    ConcurrentCSVWriter &operator=( const ConcurrentCSVWriter & ) = delete;
+
+    /**
+     * @brief Delete move assign.
+     * @return Nothing.
+     */
+    ConcurrentCSVWriter &operator=( ConcurrentCSVWriter && ) = delete;
+
+    /**
+     * @brief Default destructor for ConcurrentCSVWriter, which writes out the pending blocks and closes the file.
+     * All producers need to be destroyed before.
+     */
+    ~ConcurrentCSVWriter() noexcept { close(); }
+
+    /**
+     * @brief Is the csv file open?
+     * @return True, if open - otherwise false.
+     */
+    [[nodiscard]] inline bool isOpen() const noexcept { return m_file.is_open(); }
+
+    /**
+     * @brief Create a producer for the calling thread.
+     * @return Producer, which writes into this writer.
+     */
+    [[nodiscard]] inline Producer producer() { return Producer( *this ); }
+
+    /**
+     * @brief Return the block size.
+     * @return The block size in bytes.
+     */
+    [[nodiscard]] inline std::size_t blockSize() const noexcept { return m_blockSize; }
+
+    /**
+     * @brief Set the block size, a producer hands off its rows, if this size is reached.
+     * Only used for producers created afterwards.
+     * @param _blockSize   The block size in bytes - 0 hands off every row.
+     */
+    inline void setBlockSize( std::size_t _blockSize ) noexcept { m_blockSize = _blockSize; }
+
+    /**
+     * @brief Return the maximal number of pending blocks.
+     * @return The maximal number of pending blocks.
+     */
+    [[nodiscard]] inline std::size_t maxPendingBlocks() const noexcept { return m_maxPendingBlocks; }
+
+    /**
+     * @brief Set the maximal number of pending blocks, before producers need to wait.
+     * Only to be set before the first producer is created.
+     * @param _maxPendingBlocks   The maximal number of pending blocks - at least 1.
+     */
+    inline void setMaxPendingBlocks( std::size_t _maxPendingBlocks ) noexcept { m_maxPendingBlocks = std::max( _maxPendingBlocks, std::size_t { 1 } ); }
+
+    /**
+     * @brief Return the flush interval.
+     * @return The flush interval - 0 is disabled.
+     */
+    [[nodiscard]] inline std::chrono::milliseconds flushInterval() const noexcept { return m_flushInterval; }
+
+    /**
+     * @brief Set the flush interval, a producer hands off its rows with the next row after the interval is elapsed.
+     * Only used for producers created afterwards.
+     * @param _flushInterval   The flush interval - 0 disables flushing by time.
+     */
+    inline void setFlushInterval( std::chrono::milliseconds _flushInterval ) noexcept { m_flushInterval = _flushInterval; }
+
+    /**
+     * @brief Return the number of blocks waiting to be written.
+     * @return The number of pending blocks.
+     */
+    [[nodiscard]] std::size_t pendingBlocks() const noexcept {
+
+      const std::lock_guard<std::mutex> lock( m_mutex );
+      return m_pending.size();
+    }
+
+    /**
+     * @brief Wait until all handed off blocks are written out.
+     * Rows, which are not handed off by their producer, are not written.
+     */
+    void flush() noexcept {
+
+      std::unique_lock<std::mutex> lock( m_mutex );
+      m_written.wait( lock, [ this ]() { return m_pending.empty() && !m_writing; } );
+    }
+
+    /**
+     * @brief Write out the pending blocks, stop the background thread and close the csv file.
+     */
+    void close() noexcept {
+
+      {
+        const std::lock_guard<std::mutex> lock( m_mutex );
+        m_stop = true;
+      }
+      m_pendingChanged.notify_one();
+      if ( m_thread.joinable() ) {
+
+        m_thread.join();
+      }
+      if ( m_file.is_open() ) {
+
+        m_file.close();
+      }
+    }
+
+  private:
+    /**
+     * @brief Delimiter for values.
+     */
+    std::string_view m_delimiter {};
+
+    /**
+     * @brief Prefix for every line.
+     */
+    std::string_view m_linePrefix {};
+
+    /**
+     * @brief Suffix for every line.
+     */
+    std::string_view m_lineSuffix {};
+
+    /**
+     * @brief Member for block size.
+     */
+    std::size_t m_blockSize = defaultBlockSize;
+
+    /**
+     * @brief Member for the maximal number of pending blocks.
+     */
+    std::size_t m_maxPendingBlocks = defaultMaxPendingBlocks;
+
+    /**
+     * @brief Member for flush interval.
+     */
+    std::chrono::milliseconds m_flushInterval { 0 };
+
+    /**
+     * @brief Member for the csv file, only used by the background thread.
+     */
+    std::ofstream m_file {};
+
+    /**
+     * @brief Member for mutex of the pending blocks.
+     */
+    mutable std::mutex m_mutex {};
+
+    /**
+     * @brief Member for notification of new pending blocks.
+     */
+    std::condition_variable m_pendingChanged {};
+
+    /**
+     * @brief Member for notification of written blocks.
+     */
+    std::condition_variable m_written {};
+
+    /**
+     * @brief Member for the blocks waiting to be written.
+     */
+    std::deque<std::string> m_pending {};
+
+    /**
+     * @brief Member for written blocks, which are reused by the producers.
+     */
+    std::vector<std::string> m_spare {};
+
+    /**
+     * @brief Member if a block is written right now.
+     */
+    bool m_writing = false;
+
+    /**
+     * @brief Member if the background thread should stop.
+     */
+    bool m_stop = false;
+
+    /**
+     * @brief Member for the background thread.
+     */
+    std::jthread m_thread {};
+
+    /**
+     * @brief Queue the block to be written and replace it by an empty block.
+     * Waits, if the maximal number of pending blocks is reached.
+     * @param _block   Block to hand off.
+     */
+    void handOff( std::string &_block ) noexcept {
+
+      std::unique_lock<std::mutex> lock( m_mutex );
+      m_written.wait( lock, [ this ]() { return m_pending.size() < m_maxPendingBlocks || m_stop; } );
+      if ( m_stop ) {
+
+        logError() << "Csv file is closed, rows are dropped.";
+        _block.clear();
+        return;
+      }
+      try {
+
+        m_pending.push_back( std::move( _block ) );
+        if ( m_spare.empty() ) {
+
+          _block = {};
+        }
+        else {
+
+          _block = std::move( m_spare.back() );
+          m_spare.pop_back();
+        }
+      }
+      catch ( const std::bad_alloc &_exception ) {
+
+        logFatal() << "bad_alloc:" << _exception.what();
+      }
+      catch ( const std::exception &_exception ) { // NOSONAR fallback for every exeption.
+
+        logFatal() << _exception.what();
+      }
+      lock.unlock();
+      m_pendingChanged.notify_one();
+    }
+
+    /**
+     * @brief Write out the pending blocks until the writer is stopped.
+     */
+    void run() noexcept {
+
+      std::unique_lock<std::mutex> lock( m_mutex );
+      while ( true ) {
+
+        m_pendingChanged.wait( lock, [ this ]() { return !m_pending.empty() || m_stop; } );
+        if ( m_pending.empty() ) {
+
+          break;
+        }
+        std::string block = std::move( m_pending.front() );
+        m_pending.pop_front();
+        m_writing = true;
+        lock.unlock();
+        m_written.notify_all();
+
+        m_file.write( block.data(), static_cast<std::streamsize>( block.size() ) );
+        block.clear();
+
+        lock.lock();
+        if ( m_pending.empty() ) {
+
+          /* Idle, so the rows reach the file in time. */
+          lock.unlock();
+          m_file.flush();
+          lock.lock();
+        }
+        m_writing = false;
+        try {
+
+          if ( m_spare.size() < m_maxPendingBlocks ) {
+
+            m_spare.push_back( std::move( block ) );
+          }
+        }
+        catch ( const std::bad_alloc &_exception ) {
+
+          logFatal() << "bad_alloc:" << _exception.what();
+        }
+        catch ( const std::exception &_exception ) { // NOSONAR fallback for every exeption.
+
+          logFatal() << _exception.what();
+        }
+        m_written.notify_all();
+      }
+      m_written.notify_all();
+    }
+  };
+}
@@ -0,0 +1,527 @@
+/*
+ * Copyright (c) 2020 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* c header */
+#include <cstddef> // std::size_t
+#include <cstdint> // std::int32_t, std::int64_t, std::uint32_t, std::uint64_t
+
+/* stl header */
+#include <algorithm>
+#include <limits>
+
+/* system header */
+#if defined __x86_64__ || defined _M_X64
+  #include <immintrin.h>
+#endif
+
+/* local header */
+#include "FloatingPoint.h"
+#include "Simd.h"
+
+#ifdef HAVE_SPAN
+namespace vx::floating_point {
+
+  namespace {
+
+    /**
+     * @brief The comparison of a batch.
+     */
+    enum class Compare {
+
+      Equal,   /**< Values are equal. */
+      Less,    /**< First value is less. */
+      Greater, /**< First value is greater. */
+      Between  /**< Value is between a minimum and a maximum. */
+    };
+
+    /**
+     * @brief Compare the values from _first on with the scalar functions.
+     * @tparam Op   Comparison.
+     * @tparam Mode   Absolute or relative to input or combined or in units in the last place.
+     * @tparam T   Type.
+     * @param _left   The first values.
+     * @param _right   The second values, unused for Compare::Between.
+     * @param _min   Lower limit of Compare::Between.
+     * @param _max   Upper limit of Compare::Between.
+     * @param _orEqual   Accept equal values.
+     * @param _first   Index of the first value.
+     * @param _size   Number of values.
+     * @param _words   Words of the result, which are cleared.
+     */
+    template <Compare Op, Equal Mode, typename T>
+    void scalar( const T *_left,
+                 const T *_right,
+                 T _min,
+                 T _max,
+                 bool _orEqual,
+                 std::size_t _first,
+                 std::size_t _size,
+                 std::uint64_t *_words ) noexcept {
+
+      for ( std::size_t index = _first; index < _size; ++index ) {
+
+        bool result = false;
+        if constexpr ( Op == Compare::Equal ) {
+
+          result = equal<Mode>( _left[ index ], _right[ index ] );
+        }
+        else if constexpr ( Op == Compare::Less ) {
+
+          result = less<Mode>( _left[ index ], _right[ index ], _orEqual );
+        }
+        else if constexpr ( Op == Compare::Greater ) {
+
+          result = greater<Mode>( _left[ index ], _right[ index ], _orEqual );
+        }
+        else {
+
+          result = between<Mode>( _left[ index ], _min, _max, _orEqual );
+        }
+        _words[ index / BitMask::wordBits ] |= static_cast<std::uint64_t>( result ) << ( index % BitMask::wordBits );
+      }
+    }
+
+#ifdef VX_BATCH_SSE2
+    /**
+     * @brief SSE2 instructions for float.
+     */
+    struct Sse2Float {
+
+      /** @brief Value type. */
+      using Value = float;
+
+      /** @brief Register type. */
+      using Vector = __m128;
+
+      /** @brief Values per register. */
+      static constexpr std::size_t lanes = 4;
+
+      /** @brief Is Equal::Ulp supported? */
+      static constexpr bool hasUlp = true;
+
+      static Vector load( const Value *_values ) noexcept { return _mm_loadu_ps( _values ); }
+      static Vector set( Value _value ) noexcept { return _mm_set1_ps( _value ); }
+      static Vector sub( Vector _left, Vector _right ) noexcept { return _mm_sub_ps( _left, _right ); }
+      static Vector mul( Vector _left, Vector _right ) noexcept { return _mm_mul_ps( _left, _right ); }
+      static Vector max( Vector _left, Vector _right ) noexcept { return _mm_max_ps( _left, _right ); }
+      static Vector abs( Vector _value ) noexcept { return _mm_andnot_ps( _mm_set1_ps( -0.0F ), _value ); }
+      static Vector less( Vector _left, Vector _right ) noexcept { return _mm_cmplt_ps( _left, _right ); }
+      static Vector lessEqual( Vector _left, Vector _right ) noexcept { return _mm_cmple_ps( _left, _right ); }
+      static std::uint32_t bits( Vector _mask ) noexcept { return static_cast<std::uint32_t>( _mm_movemask_ps( _mask ) ); }
+
+      /* Same mapping and distance as ulps(), compared unsigned by flipping the sign bit. */
+      static __m128i ordered( Vector _value ) noexcept {
+
+        const __m128i bits = _mm_castps_si128( _value );
+        const __m128i negative = _mm_srai_epi32( bits, 31 );
+        return _mm_sub_epi32( _mm_xor_si128( bits, _mm_andnot_si128( _mm_set1_epi32( std::numeric_limits<std::int32_t>::min() ), negative ) ), negative );
+      }
+      static Vector ulp( Vector _left, Vector _right ) noexcept {
+
+        const __m128i sign = _mm_set1_epi32( std::numeric_limits<std::int32_t>::min() );
+        const __m128i distance = _mm_xor_si128( _mm_add_epi32( _mm_sub_epi32( ordered( _left ), ordered( _right ) ), _mm_set1_epi32( maxUlps ) ), sign );
+        const __m128i outside = _mm_cmpgt_epi32( distance, _mm_xor_si128( _mm_set1_epi32( 2 * maxUlps ), sign ) );
+        return _mm_andnot_ps( _mm_or_ps( _mm_castsi128_ps( outside ), _mm_cmpunord_ps( _left, _right ) ), _mm_castsi128_ps( _mm_set1_epi32( -1 ) ) );
+      }
+    };
+
+    /**
+     * @brief SSE2 instructions for double.
+     */
+    struct Sse2Double {
+
+      /** @brief Value type. */
+      using Value = double;
+
+      /** @brief Register type. */
+      using Vector = __m128d;
+
+      /** @brief Values per register. */
+      static constexpr std::size_t lanes = 2;
+
+      /** @brief Is Equal::Ulp supported? SSE2 has no 64 bit integer comparison. */
+      static constexpr bool hasUlp = false;
+
+      static Vector load( const Value *_values ) noexcept { return _mm_loadu_pd( _values ); }
+      static Vector set( Value _value ) noexcept { return _mm_set1_pd( _value ); }
+      static Vector sub( Vector _left, Vector _right ) noexcept { return _mm_sub_pd( _left, _right ); }
+      static Vector mul( Vector _left, Vector _right ) noexcept { return _mm_mul_pd( _left, _right ); }
+      static Vector max( Vector _left, Vector _right ) noexcept { return _mm_max_pd( _left, _right ); }
+      static Vector abs( Vector _value ) noexcept { return _mm_andnot_pd( _mm_set1_pd( -0.0 ), _value ); }
+      static Vector less( Vector _left, Vector _right ) noexcept { return _mm_cmplt_pd( _left, _right ); }
+      static Vector lessEqual( Vector _left, Vector _right ) noexcept { return _mm_cmple_pd( _left, _right ); }
+      static std::uint32_t bits( Vector _mask ) noexcept { return static_cast<std::uint32_t>( _mm_movemask_pd( _mask ) ); }
+      static void store( Value *_values, Vector _value ) noexcept { _mm_storeu_pd( _values, _value ); }
+      static Vector add( Vector _left, Vector _right ) noexcept { return _mm_add_pd( _left, _right ); }
+      static Vector div( Vector _left, Vector _right ) noexcept { return _mm_div_pd( _left, _right ); }
+      static Vector greater( Vector _left, Vector _right ) noexcept { return _mm_cmpgt_pd( _left, _right ); }
+      static Vector greaterEqual( Vector _left, Vector _right ) noexcept { return _mm_cmpge_pd( _left, _right ); }
+      static Vector bitAnd( Vector _left, Vector _right ) noexcept { return _mm_and_pd( _left, _right ); }
+      static Vector select( Vector _mask, Vector _true, Vector _false ) noexcept { return _mm_or_pd( _mm_and_pd( _mask, _true ), _mm_andnot_pd( _mask, _false ) ); }
+    };
+
+    /**
+     * @brief SIMD kernels with SSE2 instructions.
+     */
+    namespace sse2 {
+
+  #define VX_TARGET
+  #include "FloatingPoint_simd.h"
+  #undef VX_TARGET
+    }
+#endif
+
+#ifdef VX_BATCH_AVX2
+    /**
+     * @brief AVX2 instructions for float.
+     */
+    struct Avx2Float {
+
+      /** @brief Value type. */
+      using Value = float;
+
+      /** @brief Register type. */
+      using Vector = __m256;
+
+      /** @brief Values per register. */
+      static constexpr std::size_t lanes = 8;
+
+      /** @brief Is Equal::Ulp supported? */
+      static constexpr bool hasUlp = true;
+
+      VX_TARGET_AVX2 static Vector load( const Value *_values ) noexcept { return _mm256_loadu_ps( _values ); }
+      VX_TARGET_AVX2 static Vector set( Value _value ) noexcept { return _mm256_set1_ps( _value ); }
+      VX_TARGET_AVX2 static Vector sub( Vector _left, Vector _right ) noexcept { return _mm256_sub_ps( _left, _right ); }
+      VX_TARGET_AVX2 static Vector mul( Vector _left, Vector _right ) noexcept { return _mm256_mul_ps( _left, _right ); }
+      VX_TARGET_AVX2 static Vector max( Vector _left, Vector _right ) noexcept { return _mm256_max_ps( _left, _right ); }
+      VX_TARGET_AVX2 static Vector abs( Vector _value ) noexcept { return _mm256_andnot_ps( _mm256_set1_ps( -0.0F ), _value ); }
+      VX_TARGET_AVX2 static Vector less( Vector _left, Vector _right ) noexcept { return _mm256_cmp_ps( _left, _right, _CMP_LT_OQ ); }
+      VX_TARGET_AVX2 static Vector lessEqual( Vector _left, Vector _right ) noexcept { return _mm256_cmp_ps( _left, _right, _CMP_LE_OQ ); }
+      VX_TARGET_AVX2 static std::uint32_t bits( Vector _mask ) noexcept { return static_cast<std::uint32_t>( _mm256_movemask_ps( _mask ) ); }
+
+      /* Same mapping and distance as ulps(), compared unsigned by flipping the sign bit. */
+      VX_TARGET_AVX2 static __m256i ordered( Vector _value ) noexcept {
+
+        const __m256i bits = _mm256_castps_si256( _value );
+        const __m256i negative = _mm256_srai_epi32( bits, 31 );
+        return _mm256_sub_epi32( _mm256_xor_si256( bits, _mm256_andnot_si256( _mm256_set1_epi32( std::numeric_limits<std::int32_t>::min() ), negative ) ), negative );
+      }
+      VX_TARGET_AVX2 static Vector ulp( Vector _left, Vector _right ) noexcept {
+
+        const __m256i sign = _mm256_set1_epi32( std::numeric_limits<std::int32_t>::min() );
+        const __m256i distance = _mm256_xor_si256( _mm256_add_epi32( _mm256_sub_epi32( ordered( _left ), ordered( _right ) ), _mm256_set1_epi32( maxUlps ) ), sign );
+        const __m256i outside = _mm256_cmpgt_epi32( distance, _mm256_xor_si256( _mm256_set1_epi32( 2 * maxUlps ), sign ) );
+        return _mm256_andnot_ps( _mm256_or_ps( _mm256_castsi256_ps( outside ), _mm256_cmp_ps( _left, _right, _CMP_UNORD_Q ) ), _mm256_castsi256_ps( _mm256_set1_epi32( -1 ) ) );
+      }
+    };
+
+    /**
+     * @brief AVX2 instructions for double.
+     */
+    struct Avx2Double {
+
+      /** @brief Value type. */
+      using Value = double;
+
+      /** @brief Register type. */
+      using Vector = __m256d;
+
+      /** @brief Values per register. */
+      static constexpr std::size_t lanes = 4;
+
+      /** @brief Is Equal::Ulp supported? */
+      static constexpr bool hasUlp = true;
+
+      VX_TARGET_AVX2 static Vector load( const Value *_values ) noexcept { return _mm256_loadu_pd( _values ); }
+      VX_TARGET_AVX2 static Vector set( Value _value ) noexcept { return _mm256_set1_pd( _value ); }
+      VX_TARGET_AVX2 static Vector sub( Vector _left, Vector _right ) noexcept { return _mm256_sub_pd( _left, _right ); }
+      VX_TARGET_AVX2 static Vector mul( Vector _left, Vector _right ) noexcept { return _mm256_mul_pd( _left, _right ); }
+      VX_TARGET_AVX2 static Vector max( Vector _left, Vector _right ) noexcept { return _mm256_max_pd( _left, _right ); }
+      VX_TARGET_AVX2 static Vector abs( Vector _value ) noexcept { return _mm256_andnot_pd( _mm256_set1_pd( -0.0 ), _value ); }
+      VX_TARGET_AVX2 static Vector less( Vector _left, Vector _right ) noexcept { return _mm256_cmp_pd( _left, _right, _CMP_LT_OQ ); }
+      VX_TARGET_AVX2 static Vector lessEqual( Vector _left, Vector _right ) noexcept { return _mm256_cmp_pd( _left, _right, _CMP_LE_OQ ); }
+      VX_TARGET_AVX2 static std::uint32_t bits( Vector _mask ) noexcept { return static_cast<std::uint32_t>( _mm256_movemask_pd( _mask ) ); }
+      VX_TARGET_AVX2 static void store( Value *_values, Vector _value ) noexcept { _mm256_storeu_pd( _values, _value ); }
+      VX_TARGET_AVX2 static Vector add( Vector _left, Vector _right ) noexcept { return _mm256_add_pd( _left, _right ); }
+      VX_TARGET_AVX2 static Vector div( Vector _left, Vector _right ) noexcept { return _mm256_div_pd( _left, _right ); }
+      VX_TARGET_AVX2 static Vector greater( Vector _left, Vector _right ) noexcept { return _mm256_cmp_pd( _left, _right, _CMP_GT_OQ ); }
+      VX_TARGET_AVX2 static Vector greaterEqual( Vector _left, Vector _right ) noexcept { return _mm256_cmp_pd( _left, _right, _CMP_GE_OQ ); }
+      VX_TARGET_AVX2 static Vector bitAnd( Vector _left, Vector _right ) noexcept { return _mm256_and_pd( _left, _right ); }
+      VX_TARGET_AVX2 static Vector select( Vector _mask, Vector _true, Vector _false ) noexcept { return _mm256_blendv_pd( _false, _true, _mask ); }
+
+      /* Same mapping and distance as ulps(), compared unsigned by flipping the sign bit. */
+      VX_TARGET_AVX2 static __m256i ordered( Vector _value ) noexcept {
+
+        const __m256i bits = _mm256_castpd_si256( _value );
+        const __m256i negative = _mm256_cmpgt_epi64( _mm256_setzero_si256(), bits );
+        return _mm256_sub_epi64( _mm256_xor_si256( bits, _mm256_andnot_si256( _mm256_set1_epi64x( std::numeric_limits<std::int64_t>::min() ), negative ) ), negative );
+      }
+      VX_TARGET_AVX2 static Vector ulp( Vector _left, Vector _right ) noexcept {
+
+        const __m256i sign = _mm256_set1_epi64x( std::numeric_limits<std::int64_t>::min() );
+        const __m256i distance = _mm256_xor_si256( _mm256_add_epi64( _mm256_sub_epi64( ordered( _left ), ordered( _right ) ), _mm256_set1_epi64x( maxUlps ) ), sign );
+        const __m256i outside = _mm256_cmpgt_epi64( distance, _mm256_xor_si256( _mm256_set1_epi64x( 2 * maxUlps ), sign ) );
+        return _mm256_andnot_pd( _mm256_or_pd( _mm256_castsi256_pd( outside ), _mm256_cmp_pd( _left, _right, _CMP_UNORD_Q ) ), _mm256_castsi256_pd( _mm256_set1_epi64x( -1 ) ) );
+      }
+    };
+
+    /**
+     * @brief SIMD kernels with AVX2 instructions.
+     */
+    namespace avx2 {
+
+  #define VX_TARGET VX_TARGET_AVX2
+  #include "FloatingPoint_simd.h"
+  #undef VX_TARGET
+    }
+#endif
+
+    /**
+     * @brief Instruction sets of a type.
+     * @tparam T   Type.
+     */
+    template <typename T>
+    struct Instructions;
+
+    /**
+     * @brief Instruction sets of float.
+     */
+    template <>
+    struct Instructions<float> {
+
+#ifdef VX_BATCH_SSE2
+      /** @brief SSE2 instructions. */
+      using Sse2 = Sse2Float;
+#endif
+#ifdef VX_BATCH_AVX2
+      /** @brief AVX2 instructions. */
+      using Avx2 = Avx2Float;
+#endif
+    };
+
+    /**
+     * @brief Instruction sets of double.
+     */
+    template <>
+    struct Instructions<double> {
+
+#ifdef VX_BATCH_SSE2
+      /** @brief SSE2 instructions. */
+      using Sse2 = Sse2Double;
+#endif
+#ifdef VX_BATCH_AVX2
+      /** @brief AVX2 instructions. */
+      using Avx2 = Avx2Double;
+#endif
+    };
+
+    /**
+     * @brief Compare every value with the best available kernel.
+     * @tparam Op   Comparison.
+     * @tparam Mode   Absolute or relative to input or combined or in units in the last place.
+     * @tparam T   Type.
+     * @param _left   The first values.
+     * @param _right   The second values, unused for Compare::Between.
+     * @param _min   Lower limit of Compare::Between.
+     * @param _max   Upper limit of Compare::Between.
+     * @param _orEqual   Accept equal values.
+     * @param _size   Number of values.
+     * @param _result   Bit i is set, if value i fulfills the comparison.
+     * @note This function may throw an exception by std::vector.
+     */
+    template <Compare Op, Equal Mode, typename T>
+    void run( const T *_left,
+              const T *_right,
+              T _min,
+              T _max,
+              bool _orEqual,
+              std::size_t _size,
+              BitMask &_result ) {
+
+      _result.reset( _size );
+      std::uint64_t *words = _result.words();
+      std::size_t first = 0;
+      switch ( batchSimd() ) {
+
+        case Simd::AVX2:
+#ifdef VX_BATCH_AVX2
+          first = avx2::kernel<typename Instructions<T>::Avx2, Op, Mode>( _left, _right, _min, _max, _orEqual, _size, words );
+          break;
+#endif
+        case Simd::SSE2:
+#ifdef VX_BATCH_SSE2
+          first = sse2::kernel<typename Instructions<T>::Sse2, Op, Mode>( _left, _right, _min, _max, _orEqual, _size, words );
+          break;
+#endif
+        case Simd::Scalar:
+          break;
+      }
+      scalar<Op, Mode>( _left, _right, _min, _max, _orEqual, first, _size, words );
+    }
+  }
+
+  void round( std::span<double> _values,
+              std::size_t _precision ) noexcept {
+
+    std::size_t first = 0;
+    /* Larger factors are not exact, the kernels would not match the scalar function. */
+    if ( _precision < powersOfTen.size() ) {
+
+      switch ( batchSimd() ) {
+
+        case Simd::AVX2:
+#ifdef VX_BATCH_AVX2
+          first = avx2::roundKernel<Instructions<double>::Avx2>( _values.data(), powersOfTen[ _precision ], _values.size() );
+          break;
+#endif
+        case Simd::SSE2:
+#ifdef VX_BATCH_SSE2
+          first = sse2::roundKernel<Instructions<double>::Sse2>( _values.data(), powersOfTen[ _precision ], _values.size() );
+          break;
+#endif
+        case Simd::Scalar:
+          break;
+      }
+    }
+    for ( double &value : _values.subspan( first ) ) {
+
+      value = round( value, _precision );
+    }
+  }
+
+  template <Equal Mode>
+  void equal( std::span<const float> _left,
+              std::span<const float> _right,
+              BitMask &_result ) {
+
+    run<Compare::Equal, Mode>( _left.data(), _right.data(), 0.0F, 0.0F, false, std::min( _left.size(), _right.size() ), _result );
+  }
+
+  template <Equal Mode>
+  void equal( std::span<const double> _left,
+              std::span<const double> _right,
+              BitMask &_result ) {
+
+    run<Compare::Equal, Mode>( _left.data(), _right.data(), 0.0, 0.0, false, std::min( _left.size(), _right.size() ), _result );
+  }
+
+  template <Equal Mode>
+  void less( std::span<const float> _left,
+             std::span<const float> _right,
+             BitMask &_result,
+             bool _orEqual ) {
+
+    run<Compare::Less, Mode>( _left.data(), _right.data(), 0.0F, 0.0F, _orEqual, std::min( _left.size(), _right.size() ), _result );
+  }
+
+  template <Equal Mode>
+  void less( std::span<const double> _left,
+             std::span<const double> _right,
+             BitMask &_result,
+             bool _orEqual ) {
+
+    run<Compare::Less, Mode>( _left.data(), _right.data(), 0.0, 0.0, _orEqual, std::min( _left.size(), _right.size() ), _result );
+  }
+
+  template <Equal Mode>
+  void greater( std::span<const float> _left,
+                std::span<const float> _right,
+                BitMask &_result,
+                bool _orEqual ) {
+
+    run<Compare::Greater, Mode>( _left.data(), _right.data(), 0.0F, 0.0F, _orEqual, std::min( _left.size(), _right.size() ), _result );
+  }
+
+  template <Equal Mode>
+  void greater( std::span<const double> _left,
+                std::span<const double> _right,
+                BitMask &_result,
+                bool _orEqual ) {
+
+    run<Compare::Greater, Mode>( _left.data(), _right.data(), 0.0, 0.0, _orEqual, std::min( _left.size(), _right.size() ), _result );
+  }
+
+  template <Equal Mode>
+  void between( std::span<const float> _values,
+                float _min,
+                float _max,
+                BitMask &_result,
+                bool _orEqual ) {
+
+    run<Compare::Between, Mode>( _values.data(), _values.data(), _min, _max, _orEqual, _values.size(), _result );
+  }
+
+  template <Equal Mode>
+  void between( std::span<const double> _values,
+                double _min,
+                double _max,
+                BitMask &_result,
+                bool _orEqual ) {
+
+    run<Compare::Between, Mode>( _values.data(), _values.data(), _min, _max, _orEqual, _values.size(), _result );
+  }
+
+  template void equal<Equal::Absolute>( std::span<const float>, std::span<const float>, BitMask & );
+  template void equal<Equal::Relative>( std::span<const float>, std::span<const float>, BitMask & );
+  template void equal<Equal::Combined>( std::span<const float>, std::span<const float>, BitMask & );
+  template void equal<Equal::Ulp>( std::span<const float>, std::span<const float>, BitMask & );
+  template void equal<Equal::Absolute>( std::span<const double>, std::span<const double>, BitMask & );
+  template void equal<Equal::Relative>( std::span<const double>, std::span<const double>, BitMask & );
+  template void equal<Equal::Combined>( std::span<const double>, std::span<const double>, BitMask & );
+  template void equal<Equal::Ulp>( std::span<const double>, std::span<const double>, BitMask & );
+
+  template void less<Equal::Absolute>( std::span<const float>, std::span<const float>, BitMask &, bool );
+  template void less<Equal::Relative>( std::span<const float>, std::span<const float>, BitMask &, bool );
+  template void less<Equal::Combined>( std::span<const float>, std::span<const float>, BitMask &, bool );
+  template void less<Equal::Ulp>( std::span<const float>, std::span<const float>, BitMask &, bool );
+  template void less<Equal::Absolute>( std::span<const double>, std::span<const double>, BitMask &, bool );
+  template void less<Equal::Relative>( std::span<const double>, std::span<const double>, BitMask &, bool );
+  template void less<Equal::Combined>( std::span<const double>, std::span<const double>, BitMask &, bool );
+  template void less<Equal::Ulp>( std::span<const double>, std::span<const double>, BitMask &, bool );
+
+  template void greater<Equal::Absolute>( std::span<const float>, std::span<const float>, BitMask &, bool );
+  template void greater<Equal::Relative>( std::span<const float>, std::span<const float>, BitMask &, bool );
+  template void greater<Equal::Combined>( std::span<const float>, std::span<const float>, BitMask &, bool );
+  template void greater<Equal::Ulp>( std::span<const float>, std::span<const float>, BitMask &, bool );
+  template void greater<Equal::Absolute>( std::span<const double>, std::span<const double>, BitMask &, bool );
+  template void greater<Equal::Relative>( std::span<const double>, std::span<const double>, BitMask &, bool );
+  template void greater<Equal::Combined>( std::span<const double>, std::span<const double>, BitMask &, bool );
+  template void greater<Equal::Ulp>( std::span<const double>, std::span<const double>, BitMask &, bool );
+
+  template void between<Equal::Absolute>( std::span<const float>, float, float, BitMask &, bool );
+  template void between<Equal::Relative>( std::span<const float>, float, float, BitMask &, bool );
+  template void between<Equal::Combined>( std::span<const float>, float, float, BitMask &, bool );
+  template void between<Equal::Ulp>( std::span<const float>, float, float, BitMask &, bool );
+  template void between<Equal::Absolute>( std::span<const double>, double, double, BitMask &, bool );
+  template void between<Equal::Relative>( std::span<const double>, double, double, BitMask &, bool );
+  template void between<Equal::Combined>( std::span<const double>, double, double, BitMask &, bool );
+  template void between<Equal::Ulp>( std::span<const double>, double, double, BitMask &, bool );
+}
+#endif
@@ -31,14 +31,29 @@
 #pragma once
 
 /* c header */
-#include <cmath>   // std::abs, std::floor, std::modf, std::pow
+#include <cmath>   // std::abs
 #include <cstddef> // std::size_t
+#include <cstdint> // std::int32_t, std::int64_t, std::uint32_t, std::uint64_t
+#include <cstring> // std::memcpy
 
 /* stl header */
 #include <algorithm>
+#include <array>
+#if __cplusplus >= 202002L
+  #include <bit>
+#endif
 #include <limits>
+#ifdef HAVE_SPAN
+  #include <span>
+#endif
+#include <type_traits>
 #include <utility>
 
+#ifdef HAVE_SPAN
+/* local header */
+  #include "BitMask.h"
+#endif
+
 /**
  * @brief vx (VX APPS) floating_point namespace.
  */
@@ -51,15 +66,166 @@ namespace vx::floating_point {
 
     Absolute, /**< Absolute value. */
     Relative, /**< Relative value. */
-    Combined  /**< Absolute and relative value. */
+    Combined, /**< Absolute and relative value. */
+    Ulp       /**< Units in the last place. */
   };
 
+  /** @brief Maximum distance in units in the last place for Equal::Ulp. */
+  constexpr std::uint32_t maxUlps = 4;
+
+  /**
+   * @brief Return the distance of _left and _right in units in the last place.
+   * The distance of 0.0 and -0.0 is zero, the distance to NaN is meaningless.
+   * @tparam T   Type - float or double.
+   * @param _left   The first value.
+   * @param _right   The second value.
+   * @return The number of representable values between _left and _right.
+   */
+  template <typename T>
+#if __cplusplus >= 202002L
+  requires std::is_floating_point_v<T> && ( sizeof( T ) == sizeof( std::uint32_t ) || sizeof( T ) == sizeof( std::uint64_t ) )
+#endif
+  [[nodiscard]] constexpr std::uint64_t ulps( T _left,
+                                              T _right ) noexcept {
+
+    using Signed = std::conditional_t<sizeof( T ) == sizeof( std::int32_t ), std::int32_t, std::int64_t>;
+    using Unsigned = std::make_unsigned_t<Signed>;
+
+    /* Map the sign and magnitude bits to a monotonic two's complement value. */
+    const auto ordered = []( T _value ) {
+#if __cplusplus >= 202002L
+      const auto bits = std::bit_cast<Signed>( _value );
+#else
+      Signed bits = 0;
+      std::memcpy( &bits, &_value, sizeof( bits ) );
+#endif
+      return bits < 0 ? std::numeric_limits<Signed>::min() - bits : bits;
+    };
+    const Signed left = ordered( _left );
+    const Signed right = ordered( _right );
+    return left > right ? static_cast<Unsigned>( left ) - static_cast<Unsigned>( right ) : static_cast<Unsigned>( right ) - static_cast<Unsigned>( left );
+  }
+
   /**
    * @brief Is _left and _right equal?
+   * The mode is resolved at compile time and the comparison is branchless.
+   * @tparam Mode   Absolute or relative to input or combined or in units in the last place.
    * @tparam T   Type.
    * @param _left   The first value.
    * @param _right   The second value.
-   * @param _equal   Absolute or relative to input or combined.
+   * @return True, if _left and _right are equal - otherwise false.
+   */
+  template <Equal Mode, typename T>
+#if __cplusplus >= 202002L
+  requires std::is_floating_point_v<T> || std::is_integral_v<T>
+#endif
+  [[nodiscard]] constexpr bool equal( T _left,
+                                      T _right ) noexcept {
+
+    if constexpr ( std::is_integral_v<T> ) {
+
+      /* The epsilon of integral types is zero in every mode. */
+      return _left == _right;
+    }
+    else if constexpr ( Mode == Equal::Ulp && ( sizeof( T ) == sizeof( std::uint32_t ) || sizeof( T ) == sizeof( std::uint64_t ) ) ) {
+
+      return ( _left == _left ) & ( _right == _right ) & ( ulps( _left, _right ) <= maxUlps );
+    }
+    else {
+
+      T limit = std::numeric_limits<T>::epsilon();
+      if constexpr ( Mode == Equal::Relative ) {
+
+        limit *= std::max<T>( std::abs( _left ), std::abs( _right ) );
+      }
+      else if constexpr ( Mode == Equal::Combined ) {
+
+        limit *= std::max<T>( 1, std::max<T>( std::abs( _left ), std::abs( _right ) ) );
+      }
+      else if constexpr ( Mode == Equal::Ulp ) {
+
+        /* Approximation for types without a matching integer type. */
+        limit *= maxUlps * std::max<T>( std::abs( _left ), std::abs( _right ) );
+      }
+      return std::abs( _left - _right ) <= limit;
+    }
+  }
+
+  /**
+   * @brief Is _left less than _right or _orEqual?
+   * The mode is resolved at compile time and the comparison is branchless.
+   * @tparam Mode   Absolute or relative to input or combined or in units in the last place.
+   * @tparam T   Type.
+   * @param _left   The first value.
+   * @param _right   The second value.
+   * @param _orEqual   Check if _left and _right are equal - default false.
+   * @return True, if _left is less than _right or _left and _right are equal and
+   * _orEqual is set to true - otherwise false.
+   */
+  template <Equal Mode, typename T>
+#if __cplusplus >= 202002L
+  requires std::is_floating_point_v<T> || std::is_integral_v<T>
+#endif
+  [[nodiscard]] constexpr bool less( T _left,
+                                     T _right,
+                                     bool _orEqual = false ) noexcept {
+
+    const bool same = equal<Mode>( _left, _right );
+    return ( same & _orEqual ) | ( !same & ( _left < _right ) );
+  }
+
+  /**
+   * @brief Is _left greater than _right or _orEqual?
+   * The mode is resolved at compile time and the comparison is branchless.
+   * @tparam Mode   Absolute or relative to input or combined or in units in the last place.
+   * @tparam T   Type.
+   * @param _left   The first value.
+   * @param _right   The second value.
+   * @param _orEqual   Check if _left and _right are equal - default false.
+   * @return True, if _left is greater than _right or _left and _right are equal and
+   * _orEqual is set to true - otherwise false.
+   */
+  template <Equal Mode, typename T>
+#if __cplusplus >= 202002L
+  requires std::is_floating_point_v<T> || std::is_integral_v<T>
+#endif
+  [[nodiscard]] constexpr bool greater( T _left,
+                                        T _right,
+                                        bool _orEqual = false ) noexcept {
+
+    const bool same = equal<Mode>( _left, _right );
+    return ( same & _orEqual ) | ( !same & ( _left > _right ) );
+  }
+
+  /**
+   * @brief Is _value between _min and _max or _orEqual.
+   * The mode is resolved at compile time and the comparison is branchless.
+   * @tparam Mode   Absolute or relative to input or combined or in units in the last place.
+   * @tparam T   Type.
+   * @param _value   Value to test.
+   * @param _min   Is _value greater?
+   * @param _max   Is _value less?
+   * @param _orEqual  Is _value == _min or _value == _max
+   * @return True, if _value is between _min and _max _orEqual - otherwise false.
+   */
+  template <Equal Mode, typename T>
+#if __cplusplus >= 202002L
+  requires std::is_floating_point_v<T> || std::is_integral_v<T>
+#endif
+  [[nodiscard]] constexpr bool between( T _value,
+                                        T _min,
+                                        T _max,
+                                        bool _orEqual = false ) noexcept {
+
+    return greater<Mode>( _value, _min, _orEqual ) & less<Mode>( _value, _max, _orEqual );
+  }
+
+  /**
+   * @brief Is _left and _right equal?
+   * @tparam T   Type.
+   * @param _left   The first value.
+   * @param _right   The second value.
+   * @param _equal   Absolute or relative to input or combined or in units in the last place.
    * @return True, if _left and _right are equal - otherwise false.
    */
   template <typename T>
@@ -70,17 +236,18 @@ namespace vx::floating_point {
                                       T _right,
                                       Equal _equal = Equal::Absolute ) noexcept {
 
-    /* Absolute */
-    auto factor = static_cast<T>( 1 );
-    if ( _equal == Equal::Relative ) {
-
-      factor = std::max<T>( std::abs( _left ), std::abs( _right ) );
-    }
-    else if ( _equal == Equal::Combined ) {
+    switch ( _equal ) {
 
-      factor = std::max<T>( factor, std::max<T>( std::abs( _left ), std::abs( _right ) ) );
+      case Equal::Relative:
+        return equal<Equal::Relative>( _left, _right );
+      case Equal::Combined:
+        return equal<Equal::Combined>( _left, _right );
+      case Equal::Ulp:
+        return equal<Equal::Ulp>( _left, _right );
+      case Equal::Absolute:
+        break;
     }
-    return std::abs( _left - _right ) <= std::numeric_limits<T>::epsilon() * factor;
+    return equal<Equal::Absolute>( _left, _right );
   }
 
   /**
@@ -89,7 +256,7 @@ namespace vx::floating_point {
    * @param _left   The first value.
    * @param _right   The second value.
    * @param _orEqual   Check if _left and _right are equal - default false.
-   * @param _equal   Absolute or relative to input or combined.
+   * @param _equal   Absolute or relative to input or combined or in units in the last place.
    * @return True, if _left is less than _right or _left and _right are equal and
    * _orEqual is set to true - otherwise false.
    */
@@ -115,7 +282,7 @@ namespace vx::floating_point {
    * @param _left   The first value.
    * @param _right   The second value.
    * @param _orEqual   Check if _left and _right are equal - default false.
-   * @param _equal   Absolute or relative to input or combined.
+   * @param _equal   Absolute or relative to input or combined or in units in the last place.
    * @return True, if _left is greater than _right or _left and _right are equal and
    * _orEqual is set to true - otherwise false.
    */
@@ -142,7 +309,7 @@ namespace vx::floating_point {
    * @param _min   Is _value greater?
    * @param _max   Is _value less?
    * @param _orEqual  Is _value == _min or _value == _max
-   * @param _equal   Absolute or relative to input or combined.
+   * @param _equal   Absolute or relative to input or combined or in units in the last place.
    * @return True, if _value is between _min and _max _orEqual - otherwise false.
    */
   template <typename T>
@@ -164,8 +331,65 @@ namespace vx::floating_point {
   /** @brief Base for rounding. */
   constexpr double roundBase = 0.5;
 
+  /** @brief Powers of ten, which are exact as double - up to 10^22. */
+  constexpr std::array<double, 23> powersOfTen = []() {
+    std::array<double, 23> powers {};
+    double power = 1;
+    for ( double &entry : powers ) {
+
+      entry = power;
+      power *= precisionBase;
+    }
+    return powers;
+  }();
+
+  /**
+   * @brief Return ten to the power of _exponent without std::pow.
+   * @param _exponent   Exponent.
+   * @return The power of ten - exact up to 10^22.
+   */
+  [[nodiscard]] constexpr double powerOfTen( std::size_t _exponent ) noexcept {
+
+    if ( _exponent < powersOfTen.size() ) {
+
+      return powersOfTen[ _exponent ];
+    }
+    double power = powersOfTen.back();
+    for ( std::size_t exponent = powersOfTen.size() - 1; exponent < _exponent; ++exponent ) {
+
+      power *= precisionBase;
+    }
+    return power;
+  }
+
+  /**
+   * @brief Return the smallest value, from which on every value of the type has no decimal places.
+   * @tparam T   Type.
+   * @return Two to the power of the mantissa digits.
+   */
+  template <typename T>
+  [[nodiscard]] constexpr T integralLimit() noexcept { return static_cast<T>( std::uint64_t { 1 } << ( std::numeric_limits<T>::digits - 1 ) ); }
+
+  /**
+   * @brief Return the largest integer not greater than _value without std::floor.
+   * @tparam T   Type.
+   * @param _value   Value with an absolute value less than integralLimit().
+   * @return The largest integer not greater than _value.
+   */
+  template <typename T>
+#if __cplusplus >= 202002L
+  requires std::is_floating_point_v<T>
+#endif
+  [[nodiscard]] constexpr T floor( T _value ) noexcept {
+
+    const auto truncated = static_cast<std::int64_t>( _value );
+    return static_cast<T>( truncated - static_cast<std::int64_t>( static_cast<T>( truncated ) > _value ) );
+  }
+
   /**
    * @brief Round a double _value by _precision. Rounded by default to two decimal places.
+   * The value is scaled by a power of ten from a table and rounded half up without a second rounding of the scaled value.
+   * Values with more decimal places than the type can hold, infinite values and NaN are returned unchanged.
    * @tparam T   Type.
    * @param _value   Value to round.
    * @param _precision   Decimal places to round.
@@ -178,8 +402,22 @@ namespace vx::floating_point {
   [[nodiscard]] constexpr T round( T _value,
                                    std::size_t _precision = 2 ) noexcept {
 
-    const auto factor = _precision != 0 ? std::pow( precisionBase, _precision ) : 1;
-    return std::floor( _value * factor + roundBase ) / factor;
+    if constexpr ( std::is_integral_v<T> ) {
+
+      return _value;
+    }
+    else {
+
+      using Float = std::common_type_t<T, double>;
+      const auto factor = static_cast<Float>( powerOfTen( _precision ) );
+      const Float scaled = static_cast<Float>( _value ) * factor;
+      if ( !( scaled < integralLimit<Float>() && scaled > -integralLimit<Float>() ) ) {
+
+        return _value;
+      }
+      const Float lower = floor( scaled );
+      return static_cast<T>( ( lower + ( scaled - lower >= static_cast<Float>( roundBase ) ? 1 : 0 ) ) / factor );
+    }
   }
 
   /**
@@ -192,10 +430,152 @@ namespace vx::floating_point {
 #if __cplusplus >= 202002L
   requires std::is_floating_point_v<T> || std::is_integral_v<T>
 #endif
-  [[nodiscard]] std::pair<T, T> split( T _value ) noexcept {
+  [[nodiscard]] constexpr std::pair<T, T> split( T _value ) noexcept {
+
+    if constexpr ( std::is_integral_v<T> ) {
+
+      return std::make_pair( _value, static_cast<T>( 0 ) );
+    }
+    else {
+
+      if ( !( ( _value < 0 ? -_value : _value ) < integralLimit<T>() ) ) {
 
-    T integral = 0.0;
-    const auto fraction = std::modf( _value, &integral );
-    return std::make_pair( integral, fraction );
+        /* Infinite values have no decimal places, NaN stays NaN. */
+        return std::make_pair( _value, _value == _value ? static_cast<T>( 0 ) : _value );
+      }
+      const T integral = _value < 0 ? -floor( -_value ) : floor( _value );
+      return std::make_pair( integral, _value - integral );
+    }
   }
+
+#ifdef HAVE_SPAN
+  /**
+   * @brief Is _left[i] and _right[i] equal?
+   * The batch functions run SSE2 or AVX2 kernels selected by batchSimd() and give the same results as the scalar functions.
+   * @tparam Mode   Absolute or relative to input or combined or in units in the last place.
+   * @param _left   The first values.
+   * @param _right   The second values.
+   * @param _result   Bit i is set, if _left[i] and _right[i] are equal.
+   * @note This function may throw an exception by std::vector.
+   */
+  template <Equal Mode = Equal::Absolute>
+  void equal( std::span<const float> _left,
+              std::span<const float> _right,
+              BitMask &_result );
+
+  /**
+   * @brief Is _left[i] and _right[i] equal?
+   * @tparam Mode   Absolute or relative to input or combined or in units in the last place.
+   * @param _left   The first values.
+   * @param _right   The second values.
+   * @param _result   Bit i is set, if _left[i] and _right[i] are equal.
+   * @note This function may throw an exception by std::vector.
+   */
+  template <Equal Mode = Equal::Absolute>
+  void equal( std::span<const double> _left,
+              std::span<const double> _right,
+              BitMask &_result );
+
+  /**
+   * @brief Is _left[i] less than _right[i] or _orEqual?
+   * @tparam Mode   Absolute or relative to input or combined or in units in the last place.
+   * @param _left   The first values.
+   * @param _right   The second values.
+   * @param _result   Bit i is set, if _left[i] is less than _right[i] or both are equal and _orEqual is set to true.
+   * @param _orEqual   Check if _left[i] and _right[i] are equal - default false.
+   * @note This function may throw an exception by std::vector.
+   */
+  template <Equal Mode = Equal::Absolute>
+  void less( std::span<const float> _left,
+             std::span<const float> _right,
+             BitMask &_result,
+             bool _orEqual = false );
+
+  /**
+   * @brief Is _left[i] less than _right[i] or _orEqual?
+   * @tparam Mode   Absolute or relative to input or combined or in units in the last place.
+   * @param _left   The first values.
+   * @param _right   The second values.
+   * @param _result   Bit i is set, if _left[i] is less than _right[i] or both are equal and _orEqual is set to true.
+   * @param _orEqual   Check if _left[i] and _right[i] are equal - default false.
+   * @note This function may throw an exception by std::vector.
+   */
+  template <Equal Mode = Equal::Absolute>
+  void less( std::span<const double> _left,
+             std::span<const double> _right,
+             BitMask &_result,
+             bool _orEqual = false );
+
+  /**
+   * @brief Is _left[i] greater than _right[i] or _orEqual?
+   * @tparam Mode   Absolute or relative to input or combined or in units in the last place.
+   * @param _left   The first values.
+   * @param _right   The second values.
+   * @param _result   Bit i is set, if _left[i] is greater than _right[i] or both are equal and _orEqual is set to true.
+   * @param _orEqual   Check if _left[i] and _right[i] are equal - default false.
+   * @note This function may throw an exception by std::vector.
+   */
+  template <Equal Mode = Equal::Absolute>
+  void greater( std::span<const float> _left,
+                std::span<const float> _right,
+                BitMask &_result,
+                bool _orEqual = false );
+
+  /**
+   * @brief Is _left[i] greater than _right[i] or _orEqual?
+   * @tparam Mode   Absolute or relative to input or combined or in units in the last place.
+   * @param _left   The first values.
+   * @param _right   The second values.
+   * @param _result   Bit i is set, if _left[i] is greater than _right[i] or both are equal and _orEqual is set to true.
+   * @param _orEqual   Check if _left[i] and _right[i] are equal - default false.
+   * @note This function may throw an exception by std::vector.
+   */
+  template <Equal Mode = Equal::Absolute>
+  void greater( std::span<const double> _left,
+                std::span<const double> _right,
+                BitMask &_result,
+                bool _orEqual = false );
+
+  /**
+   * @brief Is _values[i] between _min and _max or _orEqual?
+   * @tparam Mode   Absolute or relative to input or combined or in units in the last place.
+   * @param _values   Values to test.
+   * @param _min   Is _values[i] greater?
+   * @param _max   Is _values[i] less?
+   * @param _result   Bit i is set, if _values[i] is between _min and _max _orEqual.
+   * @param _orEqual  Is _values[i] == _min or _values[i] == _max
+   * @note This function may throw an exception by std::vector.
+   */
+  template <Equal Mode = Equal::Absolute>
+  void between( std::span<const float> _values,
+                float _min,
+                float _max,
+                BitMask &_result,
+                bool _orEqual = false );
+
+  /**
+   * @brief Is _values[i] between _min and _max or _orEqual?
+   * @tparam Mode   Absolute or relative to input or combined or in units in the last place.
+   * @param _values   Values to test.
+   * @param _min   Is _values[i] greater?
+   * @param _max   Is _values[i] less?
+   * @param _result   Bit i is set, if _values[i] is between _min and _max _orEqual.
+   * @param _orEqual  Is _values[i] == _min or _values[i] == _max
+   * @note This function may throw an exception by std::vector.
+   */
+  template <Equal Mode = Equal::Absolute>
+  void between( std::span<const double> _values,
+                double _min,
+                double _max,
+                BitMask &_result,
+                bool _orEqual = false );
+
+  /**
+   * @brief Round every value in place by _precision like round() does, with SSE2 or AVX2 kernels.
+   * @param _values   Values to round.
+   * @param _precision   Decimal places to round.
+   */
+  void round( std::span<double> _values,
+              std::size_t _precision = 2 ) noexcept;
+#endif
 }
@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2020 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * SIMD kernels of the floating_point batch functions, included by FloatingPoint.cpp once per instruction set into its own namespace.
+ * VX_TARGET holds the function attributes of the instruction set.
+ * Isa is the instruction set with the same functions for every register type.
+ */
+
+/**
+ * @brief Check which lanes are equal branchless.
+ * @tparam Isa   Instruction set.
+ * @tparam Mode   Absolute or relative to input or combined or in units in the last place.
+ * @param _left   The first values.
+ * @param _right   The second values.
+ * @return Mask of the equal lanes.
+ */
+template <typename Isa, Equal Mode>
+VX_TARGET typename Isa::Vector same( typename Isa::Vector _left,
+                                     typename Isa::Vector _right ) noexcept {
+
+  if constexpr ( Mode == Equal::Ulp ) {
+
+    return Isa::ulp( _left, _right );
+  }
+  else {
+
+    auto limit = Isa::set( std::numeric_limits<typename Isa::Value>::epsilon() );
+    if constexpr ( Mode == Equal::Relative ) {
+
+      limit = Isa::mul( limit, Isa::max( Isa::abs( _left ), Isa::abs( _right ) ) );
+    }
+    else if constexpr ( Mode == Equal::Combined ) {
+
+      limit = Isa::mul( limit, Isa::max( Isa::set( 1 ), Isa::max( Isa::abs( _left ), Isa::abs( _right ) ) ) );
+    }
+    return Isa::lessEqual( Isa::abs( Isa::sub( _left, _right ) ), limit );
+  }
+}
+
+/**
+ * @brief Check if the lanes are less or _orEqual branchless.
+ * @tparam Isa   Instruction set.
+ * @tparam Mode   Absolute or relative to input or combined or in units in the last place.
+ * @param _left   The first values.
+ * @param _right   The second values.
+ * @param _orEqual   All bits set, if equal lanes are accepted - otherwise zero.
+ * @return Bit i is set, if lane i is less or equal and accepted.
+ */
+template <typename Isa, Equal Mode>
+VX_TARGET std::uint32_t lessBits( typename Isa::Vector _left,
+                                  typename Isa::Vector _right,
+                                  std::uint32_t _orEqual ) noexcept {
+
+  const std::uint32_t equal = Isa::bits( same<Isa, Mode>( _left, _right ) );
+  return ( equal & _orEqual ) | ( ~equal & Isa::bits( Isa::less( _left, _right ) ) );
+}
+
+/**
+ * @brief Compare the values, as long as a register is filled.
+ * @tparam Isa   Instruction set.
+ * @tparam Op   Comparison.
+ * @tparam Mode   Absolute or relative to input or combined or in units in the last place.
+ * @param _left   The first values.
+ * @param _right   The second values, unused for Compare::Between.
+ * @param _min   Lower limit of Compare::Between.
+ * @param _max   Upper limit of Compare::Between.
+ * @param _orEqual   Accept equal values.
+ * @param _size   Number of values.
+ * @param _words   Words of the result, which are cleared.
+ * @return Number of compared values.
+ */
+template <typename Isa, Compare Op, Equal Mode>
+VX_TARGET std::size_t kernel( const typename Isa::Value *_left,
+                              const typename Isa::Value *_right,
+                              typename Isa::Value _min,
+                              typename Isa::Value _max,
+                              bool _orEqual,
+                              std::size_t _size,
+                              std::uint64_t *_words ) noexcept {
+
+  if constexpr ( Mode == Equal::Ulp && !Isa::hasUlp ) {
+
+    return 0;
+  }
+  else {
+
+    const auto min = Isa::set( _min );
+    const auto max = Isa::set( _max );
+    const std::uint32_t orEqual = _orEqual ? ~0U : 0U;
+    constexpr std::uint32_t lanesMask = ( 1U << Isa::lanes ) - 1;
+    const std::size_t size = _size - _size % Isa::lanes;
+    for ( std::size_t index = 0; index < size; index += Isa::lanes ) {
+
+      const auto left = Isa::load( _left + index );
+      std::uint32_t bits = 0;
+      if constexpr ( Op == Compare::Equal ) {
+
+        bits = Isa::bits( same<Isa, Mode>( left, Isa::load( _right + index ) ) );
+      }
+      else if constexpr ( Op == Compare::Less ) {
+
+        bits = lessBits<Isa, Mode>( left, Isa::load( _right + index ), orEqual );
+      }
+      else if constexpr ( Op == Compare::Greater ) {
+
+        bits = lessBits<Isa, Mode>( Isa::load( _right + index ), left, orEqual );
+      }
+      else {
+
+        bits = lessBits<Isa, Mode>( min, left, orEqual ) & lessBits<Isa, Mode>( left, max, orEqual );
+      }
+      _words[ index / BitMask::wordBits ] |= static_cast<std::uint64_t>( bits & lanesMask ) << ( index % BitMask::wordBits );
+    }
+    return size;
+  }
+}
+
+/**
+ * @brief Round the values in place, as long as a register is filled - same operations as round().
+ * @tparam Isa   Instruction set.
+ * @param _values   Values to round.
+ * @param _factor   Exact power of ten.
+ * @param _size   Number of values.
+ * @return Number of rounded values.
+ */
+template <typename Isa>
+VX_TARGET std::size_t roundKernel( typename Isa::Value *_values,
+                                   typename Isa::Value _factor,
+                                   std::size_t _size ) noexcept {
+
+  using Value = typename Isa::Value;
+  const auto factor = Isa::set( _factor );
+  const auto limit = Isa::set( integralLimit<Value>() );
+  const auto negativeLimit = Isa::set( -integralLimit<Value>() );
+  const auto zero = Isa::set( 0 );
+  const auto one = Isa::set( 1 );
+  const auto half = Isa::set( static_cast<Value>( roundBase ) );
+  const std::size_t size = _size - _size % Isa::lanes;
+  for ( std::size_t index = 0; index < size; index += Isa::lanes ) {
+
+    const auto value = Isa::load( _values + index );
+    const auto scaled = Isa::mul( value, factor );
+    const auto magic = Isa::select( Isa::less( scaled, zero ), negativeLimit, limit );
+    auto lower = Isa::sub( Isa::add( scaled, magic ), magic );
+    lower = Isa::sub( lower, Isa::bitAnd( Isa::greater( lower, scaled ), one ) );
+    const auto rounded = Isa::add( lower, Isa::bitAnd( Isa::greaterEqual( Isa::sub( scaled, lower ), half ), one ) );
+    /* Out of range, infinite and NaN lanes keep their value. */
+    Isa::store( _values + index, Isa::select( Isa::less( Isa::abs( scaled ), limit ), Isa::div( rounded, factor ), value ) );
+  }
+  return size;
+}
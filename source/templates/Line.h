@@ -35,10 +35,13 @@
 #include <cstdint> // std::int32_t
 
 /* stl header */
+#include <algorithm>
+#include <utility> // std::pair
 #include <variant>
 
 /* local header */
 #include "Point.h"
+#include "Rect.h"
 #include "TypeCheck.h"
 
 /**
@@ -46,8 +49,20 @@
  */
 namespace vx {
 
+  /**
+   * @brief The kind of intersection of two lines.
+   */
+  enum class LineIntersection {
+
+    None,   /**< Lines do not intersect. */
+    Point,  /**< Lines intersect in a single point. */
+    Overlap /**< Lines are collinear and share a line. */
+  };
+
   /**
    * @brief Template for line.
+   * The geometric queries treat the line as segment between both points and are calculated with double.
+   * Integer coordinates are exact up to an absolute value of 2^26.
    * @author Florian Becker <fb\@vxapps.com> (VX APPS)
    * @tparam T   Type.
    */
@@ -162,6 +177,159 @@ namespace vx {
      */
     [[nodiscard]] constexpr T width() const noexcept { return static_cast<T>( std::sqrt( std::sqrt( m_point2.x() - m_point1.x() ) + std::sqrt( m_point2.y() - m_point1.y() ) ) ); }
 
+    /**
+     * @brief Length of this line.
+     * @return The euclidean distance of both points.
+     */
+    [[nodiscard]] inline double length() const noexcept {
+
+      const double dx = static_cast<double>( m_point2.x() ) - static_cast<double>( m_point1.x() );
+      const double dy = static_cast<double>( m_point2.y() ) - static_cast<double>( m_point1.y() );
+      return std::sqrt( dx * dx + dy * dy );
+    }
+
+    /**
+     * @brief Squared distance of a point to this line.
+     * @param _point   Point.
+     * @return The squared distance to the nearest point of this line.
+     */
+    [[nodiscard]] constexpr double squaredDistance( Point<T> _point ) const noexcept {
+
+      const double dx = static_cast<double>( m_point2.x() ) - static_cast<double>( m_point1.x() );
+      const double dy = static_cast<double>( m_point2.y() ) - static_cast<double>( m_point1.y() );
+      const double px = static_cast<double>( _point.x() ) - static_cast<double>( m_point1.x() );
+      const double py = static_cast<double>( _point.y() ) - static_cast<double>( m_point1.y() );
+      const double lengthSquared = dx * dx + dy * dy;
+
+      /* A null line is its first point. */
+      const double position = std::clamp( ( px * dx + py * dy ) / ( lengthSquared > 0 ? lengthSquared : 1 ), 0.0, 1.0 );
+      const double ex = px - position * dx;
+      const double ey = py - position * dy;
+      return ex * ex + ey * ey;
+    }
+
+    /**
+     * @brief Distance of a point to this line.
+     * @param _point   Point.
+     * @return The distance to the nearest point of this line.
+     */
+    [[nodiscard]] inline double distance( Point<T> _point ) const noexcept { return std::sqrt( squaredDistance( _point ) ); }
+
+    /**
+     * @brief Check if this line intersects or touches the line.
+     * Branchless by the orientation of the end points and the bounding boxes.
+     * @param _line   Line to check with.
+     * @return True, if the lines share at least one point - otherwise false.
+     */
+    [[nodiscard]] constexpr bool intersects( const Line<T> &_line ) const noexcept {
+
+      const double ax1 = m_point1.x();
+      const double ay1 = m_point1.y();
+      const double ax2 = m_point2.x();
+      const double ay2 = m_point2.y();
+      const double bx1 = _line.m_point1.x();
+      const double by1 = _line.m_point1.y();
+      const double bx2 = _line.m_point2.x();
+      const double by2 = _line.m_point2.y();
+      const int straddleA = orientation( ax1, ay1, ax2, ay2, bx1, by1 ) * orientation( ax1, ay1, ax2, ay2, bx2, by2 );
+      const int straddleB = orientation( bx1, by1, bx2, by2, ax1, ay1 ) * orientation( bx1, by1, bx2, by2, ax2, ay2 );
+
+      /* Collinear lines have only zero orientations, so the bounding boxes decide. */
+      const bool boxes = ( std::min( ax1, ax2 ) <= std::max( bx1, bx2 ) ) & ( std::min( bx1, bx2 ) <= std::max( ax1, ax2 ) ) & ( std::min( ay1, ay2 ) <= std::max( by1, by2 ) ) & ( std::min( by1, by2 ) <= std::max( ay1, ay2 ) );
+      return ( straddleA <= 0 ) & ( straddleB <= 0 ) & boxes;
+    }
+
+    /**
+     * @brief Calculate the intersection with the line.
+     * @param _line   Line to check with.
+     * @param _result   The shared line - both points are equal for LineIntersection::Point. Unchanged for LineIntersection::None.
+     * @return The kind of the intersection.
+     */
+    [[nodiscard]] constexpr LineIntersection intersection( const Line<T> &_line,
+                                                           Line<double> &_result ) const noexcept {
+
+      if ( !intersects( _line ) ) {
+
+        return LineIntersection::None;
+      }
+      const double x = m_point1.x();
+      const double y = m_point1.y();
+      const double rx = static_cast<double>( m_point2.x() ) - x;
+      const double ry = static_cast<double>( m_point2.y() ) - y;
+      const double sx = static_cast<double>( _line.m_point2.x() ) - static_cast<double>( _line.m_point1.x() );
+      const double sy = static_cast<double>( _line.m_point2.y() ) - static_cast<double>( _line.m_point1.y() );
+      const double qx = static_cast<double>( _line.m_point1.x() ) - x;
+      const double qy = static_cast<double>( _line.m_point1.y() ) - y;
+      const double denominator = rx * sy - ry * sx;
+      if ( denominator != 0 ) {
+
+        const double position = std::clamp( ( qx * sy - qy * sx ) / denominator, 0.0, 1.0 );
+        _result = Line<double>( x + position * rx, y + position * ry, x + position * rx, y + position * ry );
+        return LineIntersection::Point;
+      }
+
+      /* Parallel lines, which intersect, are collinear or one of them is null. */
+      const double lengthSquared = rx * rx + ry * ry;
+      if ( lengthSquared == 0 ) {
+
+        _result = Line<double>( x, y, x, y );
+        return LineIntersection::Point;
+      }
+      if ( sx == 0 && sy == 0 ) {
+
+        _result = Line<double>( x + qx, y + qy, x + qx, y + qy );
+        return LineIntersection::Point;
+      }
+      const double first = ( qx * rx + qy * ry ) / lengthSquared;
+      const double second = first + ( sx * rx + sy * ry ) / lengthSquared;
+      const double start = std::max( 0.0, std::min( first, second ) );
+      const double end = std::min( 1.0, std::max( first, second ) );
+      _result = Line<double>( x + start * rx, y + start * ry, x + end * rx, y + end * ry );
+      return start < end ? LineIntersection::Overlap : LineIntersection::Point;
+    }
+
+    /**
+     * @brief Clip this line by the rect with the algorithm of Liang and Barsky.
+     * The rect is normalized like Rect<T>::contains() and includes its border.
+     * @param _rectangle   Rectangle to clip with.
+     * @param _result   The part of this line inside of the rect. Unchanged, if there is no such part.
+     * @return True, if a part of this line is inside of the rect - otherwise false.
+     */
+    [[nodiscard]] constexpr bool clip( Rect<T> _rectangle,
+                                       Line<double> &_result ) const noexcept {
+
+      if ( _rectangle.null() ) {
+
+        return false;
+      }
+      const bool flipX = _rectangle.right() - _rectangle.left() + 1 < 0;
+      const bool flipY = _rectangle.bottom() - _rectangle.top() + 1 < 0;
+      const T left = flipX ? _rectangle.right() : _rectangle.left();
+      const T right = flipX ? _rectangle.left() : _rectangle.right();
+      const T top = flipY ? _rectangle.bottom() : _rectangle.top();
+      const T bottom = flipY ? _rectangle.top() : _rectangle.bottom();
+
+      /* Zero width or height - the rect contains no point. */
+      if ( left > right || top > bottom ) {
+
+        return false;
+      }
+      const double x = m_point1.x();
+      const double y = m_point1.y();
+      const double dx = static_cast<double>( m_point2.x() ) - x;
+      const double dy = static_cast<double>( m_point2.y() ) - y;
+      const auto [ enterX, leaveX ] = slab( x, dx, left, right );
+      const auto [ enterY, leaveY ] = slab( y, dy, top, bottom );
+      const double enter = std::max( { 0.0, enterX, enterY } );
+      const double leave = std::min( { 1.0, leaveX, leaveY } );
+      if ( enter > leave ) {
+
+        return false;
+      }
+      _result = Line<double>( x + enter * dx, y + enter * dy, x + leave * dx, y + leave * dy );
+      return true;
+    }
+
   private:
     /**
      * @brief Member for point1.
@@ -172,6 +340,49 @@ namespace vx {
      * @brief Member for point2.
      */
     Point<T> m_point2 {};
+
+    /**
+     * @brief Orientation of a point to the line through two points.
+     * @param _x1   X of first point.
+     * @param _y1   Y of first point.
+     * @param _x2   X of second point.
+     * @param _y2   Y of second point.
+     * @param _x   X of the point.
+     * @param _y   Y of the point.
+     * @return 1 for counterclockwise, -1 for clockwise and 0 for collinear.
+     */
+    [[nodiscard]] static constexpr int orientation( double _x1,
+                                                    double _y1,
+                                                    double _x2,
+                                                    double _y2,
+                                                    double _x,
+                                                    double _y ) noexcept {
+
+      const double cross = ( _x2 - _x1 ) * ( _y - _y1 ) - ( _y2 - _y1 ) * ( _x - _x1 );
+      return static_cast<int>( cross > 0 ) - static_cast<int>( cross < 0 );
+    }
+
+    /**
+     * @brief Range of the line position inside of a slab - branchless for the batch functions.
+     * @param _start   Start coordinate.
+     * @param _delta   Distance of the coordinates.
+     * @param _min   Lower limit of the slab.
+     * @param _max   Upper limit of the slab.
+     * @return The position entering and leaving the slab - an empty range, if a parallel line is outside.
+     */
+    [[nodiscard]] static constexpr std::pair<double, double> slab( double _start,
+                                                                  double _delta,
+                                                                  double _min,
+                                                                  double _max ) noexcept {
+
+      const bool parallel = _delta == 0;
+      const bool inside = ( _start >= _min ) & ( _start <= _max );
+      const double divisor = parallel ? 1 : _delta;
+      const double first = ( _min - _start ) / divisor;
+      const double second = ( _max - _start ) / divisor;
+      return { parallel ? ( inside ? 0.0 : 2.0 ) : std::min( first, second ),
+               parallel ? ( inside ? 1.0 : -1.0 ) : std::max( first, second ) };
+    }
   };
 
   /**
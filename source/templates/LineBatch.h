@@ -0,0 +1,291 @@
+/*
+ * Copyright (c) 2020 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+/* c header */
+#include <cmath>   // std::sqrt
+#include <cstddef> // std::size_t
+#include <cstdint> // std::int32_t
+
+/* stl header */
+#include <algorithm>
+#include <numeric>
+#include <utility> // std::pair
+#include <variant>
+#include <vector>
+
+/* local header */
+#include "AlignedAllocator.h"
+#include "BitMask.h"
+#include "Line.h"
+#include "Point.h"
+#include "Rect.h"
+#include "TypeCheck.h"
+
+/**
+ * @brief vx (VX APPS) namespace.
+ */
+namespace vx {
+
+  /**
+   * @brief Template for lines stored as structure of arrays.
+   * The coordinates are stored in separate aligned arrays and the checks are branchless, so the bulk operations are vectorized by the compiler.
+   * Every check gives the same result as the scalar function of Line<T>.
+   * @author Florian Becker <fb\@vxapps.com> (VX APPS)
+   * @tparam T   Type.
+   */
+  template <typename T>
+  class LineBatch : private TypeCheck<isVariantMember<T, std::variant<std::int32_t, float, double>>::value> {
+
+  public:
+    /**
+     * @brief Return the number of lines.
+     * @return The number of lines.
+     */
+    [[nodiscard]] inline std::size_t size() const noexcept { return m_x1.size(); }
+
+    /**
+     * @brief Check if the batch is empty.
+     * @return True, if the batch is empty - otherwise false.
+     */
+    [[nodiscard]] inline bool empty() const noexcept { return m_x1.empty(); }
+
+    /**
+     * @brief Reserve memory for lines.
+     * @param _size   Number of lines.
+     * @note This function may throw an exception by std::vector.
+     */
+    inline void reserve( std::size_t _size ) {
+
+      m_x1.reserve( _size );
+      m_y1.reserve( _size );
+      m_x2.reserve( _size );
+      m_y2.reserve( _size );
+    }
+
+    /**
+     * @brief Remove every line.
+     */
+    inline void clear() noexcept {
+
+      m_x1.clear();
+      m_y1.clear();
+      m_x2.clear();
+      m_y2.clear();
+    }
+
+    /**
+     * @brief Add a line.
+     * @param _line   Line to add.
+     * @note This function may throw an exception by std::vector.
+     */
+    inline void push_back( const Line<T> &_line ) {
+
+      m_x1.push_back( _line.x1() );
+      m_y1.push_back( _line.y1() );
+      m_x2.push_back( _line.x2() );
+      m_y2.push_back( _line.y2() );
+    }
+
+    /**
+     * @brief Return a line.
+     * @param _index   Index of the line.
+     * @return The line.
+     */
+    [[nodiscard]] inline Line<T> operator[]( std::size_t _index ) const noexcept { return { m_x1[ _index ], m_y1[ _index ], m_x2[ _index ], m_y2[ _index ] }; }
+
+    /**
+     * @brief Return the x coordinates of point1.
+     * @return The x coordinates of point1.
+     */
+    [[nodiscard]] inline const T *x1s() const noexcept { return m_x1.data(); }
+
+    /**
+     * @brief Return the y coordinates of point1.
+     * @return The y coordinates of point1.
+     */
+    [[nodiscard]] inline const T *y1s() const noexcept { return m_y1.data(); }
+
+    /**
+     * @brief Return the x coordinates of point2.
+     * @return The x coordinates of point2.
+     */
+    [[nodiscard]] inline const T *x2s() const noexcept { return m_x2.data(); }
+
+    /**
+     * @brief Return the y coordinates of point2.
+     * @return The y coordinates of point2.
+     */
+    [[nodiscard]] inline const T *y2s() const noexcept { return m_y2.data(); }
+
+    /**
+     * @brief Move every line.
+     * @param _offset   Offset to add.
+     */
+    void translate( Point<T> _offset ) noexcept {
+
+      const T offsetX = _offset.x();
+      const T offsetY = _offset.y();
+      T *x1 = m_x1.data();
+      T *y1 = m_y1.data();
+      T *x2 = m_x2.data();
+      T *y2 = m_y2.data();
+      for ( std::size_t index = 0; index < m_x1.size(); ++index ) {
+
+        x1[ index ] += offsetX;
+        y1[ index ] += offsetY;
+        x2[ index ] += offsetX;
+        y2[ index ] += offsetY;
+      }
+    }
+
+    /**
+     * @brief Check which lines intersect or touch the line.
+     * @param _line   Line to check with.
+     * @param _result   Bit i is set, if line i intersects the line.
+     * @note This function may throw an exception by std::vector.
+     */
+    void intersects( const Line<T> &_line,
+                     BitMask &_result ) const {
+
+      const T *x1 = m_x1.data();
+      const T *y1 = m_y1.data();
+      const T *x2 = m_x2.data();
+      const T *y2 = m_y2.data();
+      _result.assign( m_x1.size(), [ x1, y1, x2, y2, &_line ]( std::size_t _index ) {
+        return Line<T>( x1[ _index ], y1[ _index ], x2[ _index ], y2[ _index ] ).intersects( _line );
+      } );
+    }
+
+    /**
+     * @brief Check which lines have a part inside of the rect, like Line<T>::clip().
+     * @param _rectangle   Rectangle to check with.
+     * @param _result   Bit i is set, if line i has a part inside of the rect.
+     * @note This function may throw an exception by std::vector.
+     */
+    void intersects( Rect<T> _rectangle,
+                     BitMask &_result ) const {
+
+      const T *x1 = m_x1.data();
+      const T *y1 = m_y1.data();
+      const T *x2 = m_x2.data();
+      const T *y2 = m_y2.data();
+      _result.assign( m_x1.size(), [ x1, y1, x2, y2, _rectangle ]( std::size_t _index ) {
+        Line<double> clipped {};
+        return Line<T>( x1[ _index ], y1[ _index ], x2[ _index ], y2[ _index ] ).clip( _rectangle, clipped );
+      } );
+    }
+
+    /**
+     * @brief Calculate the distance of the point to every line.
+     * @param _point   Point.
+     * @param _result   Distance i is the distance to line i.
+     * @note This function may throw an exception by std::vector.
+     */
+    void distance( Point<T> _point,
+                   std::vector<double> &_result ) const {
+
+      _result.resize( m_x1.size() );
+      const T *x1 = m_x1.data();
+      const T *y1 = m_y1.data();
+      const T *x2 = m_x2.data();
+      const T *y2 = m_y2.data();
+      double *distance = _result.data();
+      for ( std::size_t index = 0; index < m_x1.size(); ++index ) {
+
+        distance[ index ] = std::sqrt( Line<T>( x1[ index ], y1[ index ], x2[ index ], y2[ index ] ).squaredDistance( _point ) );
+      }
+    }
+
+    /**
+     * @brief Find every pair of intersecting lines with a sweep over the x coordinates.
+     * The lines are sorted by their left end, so only lines with overlapping x ranges are checked exactly.
+     * @param _result   Pairs of the indexes of intersecting lines, the smaller index first.
+     * @note This function may throw an exception by std::vector.
+     */
+    void intersections( std::vector<std::pair<std::size_t, std::size_t>> &_result ) const {
+
+      _result.clear();
+      const T *x1 = m_x1.data();
+      const T *y1 = m_y1.data();
+      const T *x2 = m_x2.data();
+      const T *y2 = m_y2.data();
+      std::vector<std::size_t> order( m_x1.size() );
+      std::iota( std::begin( order ), std::end( order ), 0 );
+      std::sort( std::begin( order ), std::end( order ), [ x1, x2 ]( std::size_t _left, std::size_t _right ) {
+        return std::min( x1[ _left ], x2[ _left ] ) < std::min( x1[ _right ], x2[ _right ] );
+      } );
+
+      /* Lines, which reach the current sweep position. */
+      std::vector<std::size_t> active {};
+      for ( const std::size_t index : order ) {
+
+        const T left = std::min( x1[ index ], x2[ index ] );
+        const T top = std::min( y1[ index ], y2[ index ] );
+        const T bottom = std::max( y1[ index ], y2[ index ] );
+        active.erase( std::remove_if( std::begin( active ), std::end( active ), [ x1, x2, left ]( std::size_t _active ) {
+                        return std::max( x1[ _active ], x2[ _active ] ) < left;
+                      } ),
+                      std::end( active ) );
+        const Line<T> line( x1[ index ], y1[ index ], x2[ index ], y2[ index ] );
+        for ( const std::size_t other : active ) {
+
+          if ( std::min( y1[ other ], y2[ other ] ) <= bottom && top <= std::max( y1[ other ], y2[ other ] ) && line.intersects( Line<T>( x1[ other ], y1[ other ], x2[ other ], y2[ other ] ) ) ) {
+
+            _result.emplace_back( std::min( index, other ), std::max( index, other ) );
+          }
+        }
+        active.push_back( index );
+      }
+    }
+
+  private:
+    /**
+     * @brief Member for the x coordinates of point1.
+     */
+    std::vector<T, AlignedAllocator<T>> m_x1 {};
+
+    /**
+     * @brief Member for the y coordinates of point1.
+     */
+    std::vector<T, AlignedAllocator<T>> m_y1 {};
+
+    /**
+     * @brief Member for the x coordinates of point2.
+     */
+    std::vector<T, AlignedAllocator<T>> m_x2 {};
+
+    /**
+     * @brief Member for the y coordinates of point2.
+     */
+    std::vector<T, AlignedAllocator<T>> m_y2 {};
+  };
+}
@@ -0,0 +1,390 @@
+/*
+ * Copyright (c) 2020 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+/* c header */
+#include <cstddef> // std::size_t
+#include <cstdint> // std::int32_t
+
+/* stl header */
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <variant>
+#include <vector>
+
+/* local header */
+#include "Point.h"
+#include "Rect.h"
+#include "RectBatch.h"
+#include "Spatial.h"
+#include "TypeCheck.h"
+
+/**
+ * @brief vx (VX APPS) namespace.
+ */
+namespace vx {
+
+  /**
+   * @brief Template for a static R-tree, which is bulk loaded by sort-tile-recursive packing.
+   * The nodes are stored level by level in one array, so the tree is compact and fast to query, but it has to be loaded again after changes.
+   * Use RTree for data, which is inserted and removed one by one.
+   * @author Florian Becker <fb\@vxapps.com> (VX APPS)
+   * @tparam T   Type.
+   */
+  template <typename T>
+  class PackedRTree : private TypeCheck<isVariantMember<T, std::variant<std::int32_t, float, double>>::value> {
+
+  public:
+    /** @brief Default number of entries per node. */
+    static constexpr std::size_t defaultNodeSize = 16;
+
+    /**
+     * @brief Default constructor for PackedRTree.
+     * @param _nodeSize   Number of entries per node - at least two.
+     */
+    explicit PackedRTree( std::size_t _nodeSize = defaultNodeSize ) noexcept
+      : m_nodeSize( std::max( _nodeSize, static_cast<std::size_t>( 2 ) ) ) {}
+
+    /**
+     * @brief Return the number of indexed rects.
+     * @return The number of indexed rects.
+     */
+    [[nodiscard]] inline std::size_t size() const noexcept { return m_items.size(); }
+
+    /**
+     * @brief Check if the tree is empty.
+     * @return True, if the tree is empty - otherwise false.
+     */
+    [[nodiscard]] inline bool empty() const noexcept { return m_items.empty(); }
+
+    /**
+     * @brief Remove every rect.
+     */
+    inline void clear() noexcept {
+
+      m_items.clear();
+      m_nodes.clear();
+      m_leafNodes = 0;
+    }
+
+    /**
+     * @brief Load rects and replace the current content.
+     * The id of a rect is its index. Null rects are skipped, as they never intersect.
+     * @param _rects   Rects to index.
+     * @note This function may throw an exception by std::vector.
+     */
+    void load( const std::vector<Rect<T>> &_rects ) {
+
+      std::vector<spatial::Entry<T>> entries {};
+      entries.reserve( _rects.size() );
+      for ( std::size_t index = 0; index < _rects.size(); ++index ) {
+
+        if ( !_rects[ index ].null() ) {
+
+          entries.push_back( { spatial::box( _rects[ index ] ), index } );
+        }
+      }
+      build( std::move( entries ) );
+    }
+
+    /**
+     * @brief Load rects and replace the current content.
+     * The id of a rect is its index. Null rects are skipped, as they never intersect.
+     * @param _rects   Rects to index.
+     * @note This function may throw an exception by std::vector.
+     */
+    void load( const RectBatch<T> &_rects ) {
+
+      std::vector<spatial::Entry<T>> entries {};
+      entries.reserve( _rects.size() );
+      for ( std::size_t index = 0; index < _rects.size(); ++index ) {
+
+        const Rect<T> rectangle = _rects[ index ];
+        if ( !rectangle.null() ) {
+
+          entries.push_back( { spatial::box( rectangle ), index } );
+        }
+      }
+      build( std::move( entries ) );
+    }
+
+    /**
+     * @brief Return the bounding rect of every indexed rect.
+     * @return The bounding rect - a null rect for an empty tree.
+     */
+    [[nodiscard]] Rect<T> boundingRect() const noexcept {
+
+      if ( m_nodes.empty() ) {
+
+        return { Point<T>( 0, 0 ), Point<T>( -1, -1 ) };
+      }
+      const spatial::Box<T> &box = m_nodes.back().box;
+      return { Point<T>( box.left, box.top ), Point<T>( box.right, box.bottom ) };
+    }
+
+    /**
+     * @brief Call a function for every rect, which intersects the region.
+     * @param _region   Region to search.
+     * @param _function   Function called with the id of every rect found.
+     * @note This function may throw an exception by std::vector.
+     */
+    template <typename Function>
+    void visit( Rect<T> _region,
+                Function _function ) const {
+
+      if ( !_region.null() ) {
+
+        search( spatial::box( _region ), _function );
+      }
+    }
+
+    /**
+     * @brief Return every rect, which intersects the region.
+     * @param _region   Region to search.
+     * @param _result   Ids of the rects found - cleared first.
+     * @note This function may throw an exception by std::vector.
+     */
+    void intersecting( Rect<T> _region,
+                       std::vector<std::size_t> &_result ) const {
+
+      _result.clear();
+      visit( _region, [ &_result ]( std::size_t _id ) { _result.push_back( _id ); } );
+    }
+
+    /**
+     * @brief Return every rect, which contains the point, including its border.
+     * @param _point   Point to search.
+     * @param _result   Ids of the rects found - cleared first.
+     * @note This function may throw an exception by std::vector.
+     */
+    void containing( Point<T> _point,
+                     std::vector<std::size_t> &_result ) const {
+
+      _result.clear();
+      search( spatial::box( _point ), [ &_result ]( std::size_t _id ) { _result.push_back( _id ); } );
+    }
+
+    /**
+     * @brief Return the rects nearest to the point.
+     * The distance is measured to the border of a rect and is zero for rects containing the point.
+     * @param _point   Point to search.
+     * @param _count   Maximum number of rects.
+     * @param _result   Ids of the rects found, ordered by distance - cleared first.
+     * @note This function may throw an exception by std::vector.
+     */
+    void nearest( Point<T> _point,
+                  std::size_t _count,
+                  std::vector<std::size_t> &_result ) const {
+
+      _result.clear();
+      if ( m_nodes.empty() || _count == 0 ) {
+
+        return;
+      }
+
+      std::priority_queue<Candidate, std::vector<Candidate>, std::greater<>> queue {};
+      queue.push( { 0.0, m_nodes.size() - 1, false } );
+      while ( !queue.empty() && _result.size() < _count ) {
+
+        const Candidate candidate = queue.top();
+        queue.pop();
+        if ( candidate.item ) {
+
+          _result.push_back( m_items[ candidate.index ].index );
+          continue;
+        }
+
+        const Node &node = m_nodes[ candidate.index ];
+        const bool leaf = candidate.index < m_leafNodes;
+        for ( std::size_t child = node.begin; child < node.end; ++child ) {
+
+          const spatial::Box<T> &box = leaf ? m_items[ child ].box : m_nodes[ child ].box;
+          queue.push( { spatial::distance( box, _point ), child, leaf } );
+        }
+      }
+    }
+
+  private:
+    /**
+     * @brief Node of the tree.
+     */
+    struct Node {
+
+      /** @brief Box around every child. */
+      spatial::Box<T> box {};
+
+      /** @brief First child - an item for leaf nodes, otherwise a node. */
+      std::size_t begin = 0;
+
+      /** @brief Behind the last child. */
+      std::size_t end = 0;
+    };
+
+    /**
+     * @brief Candidate of the nearest search.
+     */
+    struct Candidate {
+
+      /** @brief Squared distance to the point. */
+      double distance = 0.0;
+
+      /** @brief Index of the item or node. */
+      std::size_t index = 0;
+
+      /** @brief Is the candidate an item? */
+      bool item = false;
+
+      /**
+       * @brief Compare the distance with another candidate.
+       * @param _candidate   Other candidate.
+       * @return True, if the distance is greater - otherwise false.
+       */
+      [[nodiscard]] constexpr bool operator>( const Candidate &_candidate ) const noexcept { return distance > _candidate.distance; }
+    };
+
+    /**
+     * @brief Build the tree.
+     * @param _entries   Entries to index.
+     * @note This function may throw an exception by std::vector.
+     */
+    void build( std::vector<spatial::Entry<T>> &&_entries ) {
+
+      clear();
+      m_items = std::move( _entries );
+      if ( m_items.empty() ) {
+
+        return;
+      }
+
+      std::size_t total = 0;
+      std::size_t count = m_items.size();
+      do {
+
+        count = ( count + m_nodeSize - 1 ) / m_nodeSize;
+        total += count;
+      } while ( count > 1 );
+      m_nodes.reserve( total );
+
+      spatial::sortTiles( std::begin( m_items ), std::end( m_items ), m_nodeSize );
+      for ( std::size_t begin = 0; begin < m_items.size(); begin += m_nodeSize ) {
+
+        const std::size_t end = std::min( begin + m_nodeSize, m_items.size() );
+        spatial::Box<T> box = m_items[ begin ].box;
+        for ( std::size_t index = begin + 1; index < end; ++index ) {
+
+          box = spatial::united( box, m_items[ index ].box );
+        }
+        m_nodes.push_back( { box, begin, end } );
+      }
+      m_leafNodes = m_nodes.size();
+
+      std::size_t levelBegin = 0;
+      std::size_t levelEnd = m_nodes.size();
+      while ( levelEnd - levelBegin > 1 ) {
+
+        const auto first = std::begin( m_nodes ) + static_cast<std::ptrdiff_t>( levelBegin );
+        const auto last = std::begin( m_nodes ) + static_cast<std::ptrdiff_t>( levelEnd );
+        spatial::sortTiles( first, last, m_nodeSize );
+        for ( std::size_t begin = levelBegin; begin < levelEnd; begin += m_nodeSize ) {
+
+          const std::size_t end = std::min( begin + m_nodeSize, levelEnd );
+          spatial::Box<T> box = m_nodes[ begin ].box;
+          for ( std::size_t index = begin + 1; index < end; ++index ) {
+
+            box = spatial::united( box, m_nodes[ index ].box );
+          }
+          m_nodes.push_back( { box, begin, end } );
+        }
+        levelBegin = levelEnd;
+        levelEnd = m_nodes.size();
+      }
+    }
+
+    /**
+     * @brief Call a function for every item, which intersects the box.
+     * @param _box   Box to search.
+     * @param _function   Function called with the id of every item found.
+     * @note This function may throw an exception by std::vector.
+     */
+    template <typename Function>
+    void search( const spatial::Box<T> &_box,
+                 Function &&_function ) const {
+
+      if ( m_nodes.empty() || !spatial::intersects( m_nodes.back().box, _box ) ) {
+
+        return;
+      }
+
+      std::vector<std::size_t> stack { m_nodes.size() - 1 };
+      while ( !stack.empty() ) {
+
+        const Node &node = m_nodes[ stack.back() ];
+        const bool leaf = stack.back() < m_leafNodes;
+        stack.pop_back();
+        for ( std::size_t child = node.begin; child < node.end; ++child ) {
+
+          if ( leaf ) {
+
+            if ( spatial::intersects( m_items[ child ].box, _box ) ) {
+
+              _function( m_items[ child ].index );
+            }
+          }
+          else if ( spatial::intersects( m_nodes[ child ].box, _box ) ) {
+
+            stack.push_back( child );
+          }
+        }
+      }
+    }
+
+    /**
+     * @brief Member for the number of entries per node.
+     */
+    std::size_t m_nodeSize = defaultNodeSize;
+
+    /**
+     * @brief Member for the indexed rects in tile order.
+     */
+    std::vector<spatial::Entry<T>> m_items {};
+
+    /**
+     * @brief Member for the nodes - the leaf nodes first and the root last.
+     */
+    std::vector<Node> m_nodes {};
+
+    /**
+     * @brief Member for the number of leaf nodes.
+     */
+    std::size_t m_leafNodes = 0;
+  };
+}
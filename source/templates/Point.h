@@ -74,7 +74,7 @@ namespace vx {
      * @brief Check if the point is null.
      * @return True, if the point is null - otherwise false.
      */
-    [[nodiscard]] constexpr bool null() const noexcept { return floating_point::equal( m_x, static_cast<T>( 0 ) ) && floating_point::equal( m_y, static_cast<T>( 0 ) ); }
+    [[nodiscard]] constexpr bool null() const noexcept { return floating_point::equal<floating_point::Equal::Absolute>( m_x, static_cast<T>( 0 ) ) && floating_point::equal<floating_point::Equal::Absolute>( m_y, static_cast<T>( 0 ) ); }
 
     /**
      * @brief Return x coordinate of point.
@@ -135,7 +135,7 @@ namespace vx {
      * @param _point   Point to compare with.
      * @return True, if the compared point is equal current point - otherwise false.
      */
-    [[nodiscard]] constexpr bool operator==( Point<T> _point ) const noexcept { return floating_point::equal( m_x, _point.m_x ) && floating_point::equal( m_y, _point.m_y ); }
+    [[nodiscard]] constexpr bool operator==( Point<T> _point ) const noexcept { return floating_point::equal<floating_point::Equal::Absolute>( m_x, _point.m_x ) && floating_point::equal<floating_point::Equal::Absolute>( m_y, _point.m_y ); }
 
   private:
     /**
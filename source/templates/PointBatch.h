@@ -0,0 +1,227 @@
+/*
+ * Copyright (c) 2011 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+/* c header */
+#include <cstddef> // std::size_t
+#include <cstdint> // std::int32_t
+
+/* stl header */
+#include <algorithm>
+#include <variant>
+#include <vector>
+
+/* local header */
+#include "AlignedAllocator.h"
+#include "BitMask.h"
+#include "Point.h"
+#include "Rect.h"
+#include "TypeCheck.h"
+
+/**
+ * @brief vx (VX APPS) namespace.
+ */
+namespace vx {
+
+  /**
+   * @brief Template for points stored as structure of arrays.
+   * The x and y coordinates are stored in separate aligned arrays, so the bulk operations are vectorized by the compiler.
+   * @author Florian Becker <fb\@vxapps.com> (VX APPS)
+   * @tparam T   Type.
+   */
+  template <typename T>
+  class PointBatch : private TypeCheck<isVariantMember<T, std::variant<std::int32_t, float, double>>::value> {
+
+  public:
+    /**
+     * @brief Return the number of points.
+     * @return The number of points.
+     */
+    [[nodiscard]] inline std::size_t size() const noexcept { return m_x.size(); }
+
+    /**
+     * @brief Check if the batch is empty.
+     * @return True, if the batch is empty - otherwise false.
+     */
+    [[nodiscard]] inline bool empty() const noexcept { return m_x.empty(); }
+
+    /**
+     * @brief Reserve memory for points.
+     * @param _size   Number of points.
+     * @note This function may throw an exception by std::vector.
+     */
+    inline void reserve( std::size_t _size ) {
+
+      m_x.reserve( _size );
+      m_y.reserve( _size );
+    }
+
+    /**
+     * @brief Remove every point.
+     */
+    inline void clear() noexcept {
+
+      m_x.clear();
+      m_y.clear();
+    }
+
+    /**
+     * @brief Add a point.
+     * @param _point   Point to add.
+     * @note This function may throw an exception by std::vector.
+     */
+    inline void push_back( Point<T> _point ) {
+
+      m_x.push_back( _point.x() );
+      m_y.push_back( _point.y() );
+    }
+
+    /**
+     * @brief Return a point.
+     * @param _index   Index of the point.
+     * @return The point.
+     */
+    [[nodiscard]] inline Point<T> operator[]( std::size_t _index ) const noexcept { return { m_x[ _index ], m_y[ _index ] }; }
+
+    /**
+     * @brief Return the x coordinates.
+     * @return The x coordinates.
+     */
+    [[nodiscard]] inline T *xs() noexcept { return m_x.data(); }
+
+    /**
+     * @brief Return the x coordinates.
+     * @return The x coordinates.
+     */
+    [[nodiscard]] inline const T *xs() const noexcept { return m_x.data(); }
+
+    /**
+     * @brief Return the y coordinates.
+     * @return The y coordinates.
+     */
+    [[nodiscard]] inline T *ys() noexcept { return m_y.data(); }
+
+    /**
+     * @brief Return the y coordinates.
+     * @return The y coordinates.
+     */
+    [[nodiscard]] inline const T *ys() const noexcept { return m_y.data(); }
+
+    /**
+     * @brief Move every point.
+     * @param _offset   Offset to add.
+     */
+    void translate( Point<T> _offset ) noexcept {
+
+      const T offsetX = _offset.x();
+      const T offsetY = _offset.y();
+      T *x = m_x.data();
+      T *y = m_y.data();
+      for ( std::size_t index = 0; index < m_x.size(); ++index ) {
+
+        x[ index ] += offsetX;
+        y[ index ] += offsetY;
+      }
+    }
+
+    /**
+     * @brief Scale every point.
+     * @param _factorX   Factor for the x coordinates.
+     * @param _factorY   Factor for the y coordinates.
+     */
+    void scale( T _factorX,
+                T _factorY ) noexcept {
+
+      T *x = m_x.data();
+      T *y = m_y.data();
+      for ( std::size_t index = 0; index < m_x.size(); ++index ) {
+
+        x[ index ] *= _factorX;
+        y[ index ] *= _factorY;
+      }
+    }
+
+    /**
+     * @brief Return the bounding rect of every point.
+     * @return The bounding rect - a null rect for an empty batch.
+     */
+    [[nodiscard]] Rect<T> boundingRect() const noexcept {
+
+      if ( m_x.empty() ) {
+
+        return { Point<T>( 0, 0 ), Point<T>( -1, -1 ) };
+      }
+      const auto [ left, right ] = std::minmax_element( std::cbegin( m_x ), std::cend( m_x ) );
+      const auto [ top, bottom ] = std::minmax_element( std::cbegin( m_y ), std::cend( m_y ) );
+      return { Point<T>( *left, *top ), Point<T>( *right, *bottom ) };
+    }
+
+    /**
+     * @brief Check which points are inside of the rect, including its border.
+     * @param _rectangle   Rectangle to check with.
+     * @param _result   Bit i is set, if point i is inside of the rect.
+     * @note This function may throw an exception by std::vector.
+     */
+    void containedBy( Rect<T> _rectangle,
+                      BitMask &_result ) const {
+
+      if ( _rectangle.null() ) {
+
+        _result.reset( m_x.size() );
+        return;
+      }
+
+      /* Normalized like Rect<T>::contains() */
+      const bool flipX = _rectangle.right() - _rectangle.left() + 1 < 0;
+      const bool flipY = _rectangle.bottom() - _rectangle.top() + 1 < 0;
+      const T left = flipX ? _rectangle.right() : _rectangle.left();
+      const T right = flipX ? _rectangle.left() : _rectangle.right();
+      const T top = flipY ? _rectangle.bottom() : _rectangle.top();
+      const T bottom = flipY ? _rectangle.top() : _rectangle.bottom();
+      const T *x = m_x.data();
+      const T *y = m_y.data();
+      _result.assign( m_x.size(), [ x, y, left, right, top, bottom ]( std::size_t _index ) {
+        return ( x[ _index ] >= left ) & ( x[ _index ] <= right ) & ( y[ _index ] >= top ) & ( y[ _index ] <= bottom );
+      } );
+    }
+
+  private:
+    /**
+     * @brief Member for the x coordinates.
+     */
+    std::vector<T, AlignedAllocator<T>> m_x {};
+
+    /**
+     * @brief Member for the y coordinates.
+     */
+    std::vector<T, AlignedAllocator<T>> m_y {};
+  };
+}
@@ -0,0 +1,647 @@
+/*
+ * Copyright (c) 2020 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+/* c header */
+#include <cstddef> // std::size_t
+#include <cstdint> // std::int32_t
+
+/* stl header */
+#include <algorithm>
+#include <functional>
+#include <optional>
+#include <queue>
+#include <variant>
+#include <vector>
+
+/* local header */
+#include "Point.h"
+#include "Rect.h"
+#include "Spatial.h"
+#include "TypeCheck.h"
+
+/**
+ * @brief vx (VX APPS) namespace.
+ */
+namespace vx {
+
+  /**
+   * @brief Template for a dynamic R-tree.
+   * Rects are inserted and removed one by one. Overflowing nodes are split like in the R*-tree, underflowing nodes are dissolved and their rects inserted again.
+   * Use PackedRTree for data, which is loaded at once and not changed afterwards.
+   * @author Florian Becker <fb\@vxapps.com> (VX APPS)
+   * @tparam T   Type.
+   */
+  template <typename T>
+  class RTree : private TypeCheck<isVariantMember<T, std::variant<std::int32_t, float, double>>::value> {
+
+  public:
+    /** @brief Default maximum number of entries per node. */
+    static constexpr std::size_t defaultNodeSize = 16;
+
+    /**
+     * @brief Default constructor for RTree.
+     * @param _nodeSize   Maximum number of entries per node - at least four.
+     */
+    explicit RTree( std::size_t _nodeSize = defaultNodeSize ) noexcept
+      : m_maxEntries( std::max( _nodeSize, static_cast<std::size_t>( 4 ) ) ),
+        m_minEntries( std::max( m_maxEntries * 2 / 5, static_cast<std::size_t>( 2 ) ) ) {}
+
+    /**
+     * @brief Return the number of indexed rects.
+     * @return The number of indexed rects.
+     */
+    [[nodiscard]] inline std::size_t size() const noexcept { return m_size; }
+
+    /**
+     * @brief Check if the tree is empty.
+     * @return True, if the tree is empty - otherwise false.
+     */
+    [[nodiscard]] inline bool empty() const noexcept { return m_size == 0; }
+
+    /**
+     * @brief Remove every rect.
+     */
+    inline void clear() noexcept {
+
+      m_nodes.clear();
+      m_free.clear();
+      m_root = 0;
+      m_size = 0;
+    }
+
+    /**
+     * @brief Insert a rect.
+     * Null rects are skipped, as they never intersect.
+     * @param _rectangle   Rect to insert.
+     * @param _id   Id of the rect.
+     * @note This function may throw an exception by std::vector.
+     */
+    void insert( Rect<T> _rectangle,
+                 std::size_t _id ) {
+
+      if ( _rectangle.null() ) {
+
+        return;
+      }
+      insert( { spatial::box( _rectangle ), _id } );
+      ++m_size;
+    }
+
+    /**
+     * @brief Remove a rect.
+     * @param _rectangle   Rect as inserted.
+     * @param _id   Id of the rect.
+     * @return True, if the rect was found - otherwise false.
+     * @note This function may throw an exception by std::vector.
+     */
+    bool remove( Rect<T> _rectangle,
+                 std::size_t _id ) {
+
+      if ( _rectangle.null() || m_nodes.empty() ) {
+
+        return false;
+      }
+
+      std::vector<spatial::Entry<T>> orphans {};
+      if ( !remove( m_root, { spatial::box( _rectangle ), _id }, orphans ) ) {
+
+        return false;
+      }
+      --m_size;
+
+      while ( !m_nodes[ m_root ].leaf && m_nodes[ m_root ].entries.size() == 1 ) {
+
+        const std::size_t root = m_root;
+        m_root = m_nodes[ root ].entries.front().index;
+        release( root );
+      }
+      if ( m_nodes[ m_root ].entries.empty() ) {
+
+        m_nodes[ m_root ].leaf = true;
+      }
+      for ( const spatial::Entry<T> &entry : orphans ) {
+
+        insert( entry );
+      }
+      return true;
+    }
+
+    /**
+     * @brief Return the bounding rect of every indexed rect.
+     * @return The bounding rect - a null rect for an empty tree.
+     */
+    [[nodiscard]] Rect<T> boundingRect() const noexcept {
+
+      if ( m_size == 0 ) {
+
+        return { Point<T>( 0, 0 ), Point<T>( -1, -1 ) };
+      }
+      const spatial::Box<T> box = bounds( m_root );
+      return { Point<T>( box.left, box.top ), Point<T>( box.right, box.bottom ) };
+    }
+
+    /**
+     * @brief Call a function for every rect, which intersects the region.
+     * @param _region   Region to search.
+     * @param _function   Function called with the id of every rect found.
+     * @note This function may throw an exception by std::vector.
+     */
+    template <typename Function>
+    void visit( Rect<T> _region,
+                Function _function ) const {
+
+      if ( !_region.null() ) {
+
+        search( spatial::box( _region ), _function );
+      }
+    }
+
+    /**
+     * @brief Return every rect, which intersects the region.
+     * @param _region   Region to search.
+     * @param _result   Ids of the rects found - cleared first.
+     * @note This function may throw an exception by std::vector.
+     */
+    void intersecting( Rect<T> _region,
+                       std::vector<std::size_t> &_result ) const {
+
+      _result.clear();
+      visit( _region, [ &_result ]( std::size_t _id ) { _result.push_back( _id ); } );
+    }
+
+    /**
+     * @brief Return every rect, which contains the point, including its border.
+     * @param _point   Point to search.
+     * @param _result   Ids of the rects found - cleared first.
+     * @note This function may throw an exception by std::vector.
+     */
+    void containing( Point<T> _point,
+                     std::vector<std::size_t> &_result ) const {
+
+      _result.clear();
+      search( spatial::box( _point ), [ &_result ]( std::size_t _id ) { _result.push_back( _id ); } );
+    }
+
+    /**
+     * @brief Return the rects nearest to the point.
+     * The distance is measured to the border of a rect and is zero for rects containing the point.
+     * @param _point   Point to search.
+     * @param _count   Maximum number of rects.
+     * @param _result   Ids of the rects found, ordered by distance - cleared first.
+     * @note This function may throw an exception by std::vector.
+     */
+    void nearest( Point<T> _point,
+                  std::size_t _count,
+                  std::vector<std::size_t> &_result ) const {
+
+      _result.clear();
+      if ( m_size == 0 || _count == 0 ) {
+
+        return;
+      }
+
+      std::priority_queue<Candidate, std::vector<Candidate>, std::greater<>> queue {};
+      queue.push( { 0.0, m_root, false } );
+      while ( !queue.empty() && _result.size() < _count ) {
+
+        const Candidate candidate = queue.top();
+        queue.pop();
+        if ( candidate.item ) {
+
+          _result.push_back( candidate.index );
+          continue;
+        }
+
+        const Node &node = m_nodes[ candidate.index ];
+        for ( const spatial::Entry<T> &entry : node.entries ) {
+
+          queue.push( { spatial::distance( entry.box, _point ), entry.index, node.leaf } );
+        }
+      }
+    }
+
+  private:
+    /**
+     * @brief Node of the tree.
+     */
+    struct Node {
+
+      /** @brief Is the node a leaf, whose entries are rects? */
+      bool leaf = true;
+
+      /** @brief Rects of a leaf, otherwise child nodes. */
+      std::vector<spatial::Entry<T>> entries {};
+    };
+
+    /**
+     * @brief Candidate of the nearest search.
+     */
+    struct Candidate {
+
+      /** @brief Squared distance to the point. */
+      double distance = 0.0;
+
+      /** @brief Id of the rect or index of the node. */
+      std::size_t index = 0;
+
+      /** @brief Is the candidate a rect? */
+      bool item = false;
+
+      /**
+       * @brief Compare the distance with another candidate.
+       * @param _candidate   Other candidate.
+       * @return True, if the distance is greater - otherwise false.
+       */
+      [[nodiscard]] constexpr bool operator>( const Candidate &_candidate ) const noexcept { return distance > _candidate.distance; }
+    };
+
+    /**
+     * @brief Insert an entry and split the root, if it overflows.
+     * @param _entry   Entry of the rect.
+     * @note This function may throw an exception by std::vector.
+     */
+    void insert( const spatial::Entry<T> &_entry ) {
+
+      if ( m_nodes.empty() ) {
+
+        m_root = allocate( true );
+      }
+
+      const std::optional<spatial::Entry<T>> sibling = insert( m_root, _entry );
+      if ( sibling ) {
+
+        const std::size_t root = allocate( false );
+        m_nodes[ root ].entries.push_back( { bounds( m_root ), m_root } );
+        m_nodes[ root ].entries.push_back( *sibling );
+        m_root = root;
+      }
+    }
+
+    /**
+     * @brief Insert an entry into the subtree.
+     * @param _node   Root of the subtree.
+     * @param _entry   Entry of the rect.
+     * @return The entry of the new sibling, if the node was split.
+     * @note This function may throw an exception by std::vector.
+     */
+    std::optional<spatial::Entry<T>> insert( std::size_t _node,
+                                             const spatial::Entry<T> &_entry ) {
+
+      if ( m_nodes[ _node ].leaf ) {
+
+        m_nodes[ _node ].entries.push_back( _entry );
+      }
+      else {
+
+        const std::size_t best = choose( _node, _entry.box );
+        const std::size_t child = m_nodes[ _node ].entries[ best ].index;
+        const std::optional<spatial::Entry<T>> sibling = insert( child, _entry );
+
+        /* The nodes may have been reallocated. */
+        std::vector<spatial::Entry<T>> &entries = m_nodes[ _node ].entries;
+        if ( sibling ) {
+
+          entries[ best ].box = bounds( child );
+          entries.push_back( *sibling );
+        }
+        else {
+
+          entries[ best ].box = spatial::united( entries[ best ].box, _entry.box );
+        }
+      }
+
+      if ( m_nodes[ _node ].entries.size() > m_maxEntries ) {
+
+        return split( _node );
+      }
+      return std::nullopt;
+    }
+
+    /**
+     * @brief Choose the child, which needs the least enlargement for the box.
+     * @param _node   Parent node.
+     * @param _box   Box to insert.
+     * @return The index of the entry.
+     */
+    [[nodiscard]] std::size_t choose( std::size_t _node,
+                                      const spatial::Box<T> &_box ) const noexcept {
+
+      const std::vector<spatial::Entry<T>> &entries = m_nodes[ _node ].entries;
+      std::size_t best = 0;
+      double bestEnlargement = 0.0;
+      double bestArea = 0.0;
+      for ( std::size_t index = 0; index < entries.size(); ++index ) {
+
+        const double area = spatial::area( entries[ index ].box );
+        const double enlargement = spatial::area( spatial::united( entries[ index ].box, _box ) ) - area;
+        if ( index == 0 || enlargement < bestEnlargement || ( enlargement == bestEnlargement && area < bestArea ) ) {
+
+          best = index;
+          bestEnlargement = enlargement;
+          bestArea = area;
+        }
+      }
+      return best;
+    }
+
+    /**
+     * @brief Split an overflowing node.
+     * The split axis has the least margin sum, the split index the least overlap and then the least area.
+     * @param _node   Node to split.
+     * @return The entry of the new sibling.
+     * @note This function may throw an exception by std::vector.
+     */
+    spatial::Entry<T> split( std::size_t _node ) {
+
+      std::vector<spatial::Entry<T>> entries = std::move( m_nodes[ _node ].entries );
+      const std::size_t count = entries.size();
+      std::vector<spatial::Box<T>> prefix( count );
+      std::vector<spatial::Box<T>> suffix( count );
+      const auto distribute = [ & ]() {
+        prefix[ 0 ] = entries[ 0 ].box;
+        for ( std::size_t index = 1; index < count; ++index ) {
+
+          prefix[ index ] = spatial::united( prefix[ index - 1 ], entries[ index ].box );
+        }
+        suffix[ count - 1 ] = entries[ count - 1 ].box;
+        for ( std::size_t index = count - 1; index > 0; --index ) {
+
+          suffix[ index - 1 ] = spatial::united( suffix[ index ], entries[ index - 1 ].box );
+        }
+      };
+      const auto byX = []( const spatial::Entry<T> &_first, const spatial::Entry<T> &_second ) { return _first.box.left < _second.box.left || ( _first.box.left == _second.box.left && _first.box.right < _second.box.right ); };
+      const auto byY = []( const spatial::Entry<T> &_first, const spatial::Entry<T> &_second ) { return _first.box.top < _second.box.top || ( _first.box.top == _second.box.top && _first.box.bottom < _second.box.bottom ); };
+      const auto marginSum = [ & ]() {
+        distribute();
+        double sum = 0.0;
+        for ( std::size_t index = m_minEntries; index <= count - m_minEntries; ++index ) {
+
+          sum += spatial::margin( prefix[ index - 1 ] ) + spatial::margin( suffix[ index ] );
+        }
+        return sum;
+      };
+
+      std::sort( std::begin( entries ), std::end( entries ), byX );
+      const double marginX = marginSum();
+      std::sort( std::begin( entries ), std::end( entries ), byY );
+      if ( marginX < marginSum() ) {
+
+        std::sort( std::begin( entries ), std::end( entries ), byX );
+        distribute();
+      }
+
+      std::size_t splitIndex = m_minEntries;
+      double bestOverlap = 0.0;
+      double bestArea = 0.0;
+      for ( std::size_t index = m_minEntries; index <= count - m_minEntries; ++index ) {
+
+        const double overlap = this->overlap( prefix[ index - 1 ], suffix[ index ] );
+        const double area = spatial::area( prefix[ index - 1 ] ) + spatial::area( suffix[ index ] );
+        if ( index == m_minEntries || overlap < bestOverlap || ( overlap == bestOverlap && area < bestArea ) ) {
+
+          splitIndex = index;
+          bestOverlap = overlap;
+          bestArea = area;
+        }
+      }
+
+      const bool leaf = m_nodes[ _node ].leaf;
+      const std::size_t sibling = allocate( leaf );
+      m_nodes[ sibling ].entries.assign( std::begin( entries ) + static_cast<std::ptrdiff_t>( splitIndex ), std::end( entries ) );
+      entries.resize( splitIndex );
+      m_nodes[ _node ].entries = std::move( entries );
+      return { suffix[ splitIndex ], sibling };
+    }
+
+    /**
+     * @brief Remove an entry from the subtree.
+     * @param _node   Root of the subtree.
+     * @param _entry   Entry of the rect.
+     * @param _orphans   Rects of dissolved nodes, which have to be inserted again.
+     * @return True, if the entry was found - otherwise false.
+     * @note This function may throw an exception by std::vector.
+     */
+    bool remove( std::size_t _node,
+                 const spatial::Entry<T> &_entry,
+                 std::vector<spatial::Entry<T>> &_orphans ) {
+
+      std::vector<spatial::Entry<T>> &entries = m_nodes[ _node ].entries;
+      if ( m_nodes[ _node ].leaf ) {
+
+        const auto found = std::find_if( std::begin( entries ), std::end( entries ), [ &_entry ]( const spatial::Entry<T> &_candidate ) {
+          return _candidate.index == _entry.index && spatial::contains( _candidate.box, _entry.box ) && spatial::contains( _entry.box, _candidate.box );
+        } );
+        if ( found == std::end( entries ) ) {
+
+          return false;
+        }
+        entries.erase( found );
+        return true;
+      }
+
+      for ( std::size_t index = 0; index < entries.size(); ++index ) {
+
+        const std::size_t child = entries[ index ].index;
+        if ( !spatial::contains( entries[ index ].box, _entry.box ) || !remove( child, _entry, _orphans ) ) {
+
+          continue;
+        }
+
+        if ( m_nodes[ child ].entries.size() < m_minEntries ) {
+
+          collect( child, _orphans );
+          entries.erase( std::begin( entries ) + static_cast<std::ptrdiff_t>( index ) );
+        }
+        else {
+
+          entries[ index ].box = bounds( child );
+        }
+        return true;
+      }
+      return false;
+    }
+
+    /**
+     * @brief Collect every rect of the subtree and release its nodes.
+     * @param _node   Root of the subtree.
+     * @param _orphans   Collected rects.
+     * @note This function may throw an exception by std::vector.
+     */
+    void collect( std::size_t _node,
+                  std::vector<spatial::Entry<T>> &_orphans ) {
+
+      if ( m_nodes[ _node ].leaf ) {
+
+        _orphans.insert( std::end( _orphans ), std::cbegin( m_nodes[ _node ].entries ), std::cend( m_nodes[ _node ].entries ) );
+      }
+      else {
+
+        for ( const spatial::Entry<T> &entry : m_nodes[ _node ].entries ) {
+
+          collect( entry.index, _orphans );
+        }
+      }
+      release( _node );
+    }
+
+    /**
+     * @brief Return a new or a released node.
+     * @param _leaf   Is the node a leaf?
+     * @return The index of the node.
+     * @note This function may throw an exception by std::vector.
+     */
+    std::size_t allocate( bool _leaf ) {
+
+      if ( !m_free.empty() ) {
+
+        const std::size_t node = m_free.back();
+        m_free.pop_back();
+        m_nodes[ node ].leaf = _leaf;
+        return node;
+      }
+
+      m_nodes.emplace_back();
+      m_nodes.back().leaf = _leaf;
+      m_nodes.back().entries.reserve( m_maxEntries + 1 );
+      return m_nodes.size() - 1;
+    }
+
+    /**
+     * @brief Release a node for reuse.
+     * @param _node   Node to release.
+     * @note This function may throw an exception by std::vector.
+     */
+    void release( std::size_t _node ) {
+
+      m_nodes[ _node ].entries.clear();
+      m_free.push_back( _node );
+    }
+
+    /**
+     * @brief Return the box around every entry of a node.
+     * @param _node   Node.
+     * @return The box.
+     */
+    [[nodiscard]] spatial::Box<T> bounds( std::size_t _node ) const noexcept {
+
+      const std::vector<spatial::Entry<T>> &entries = m_nodes[ _node ].entries;
+      spatial::Box<T> box = entries.front().box;
+      for ( const spatial::Entry<T> &entry : entries ) {
+
+        box = spatial::united( box, entry.box );
+      }
+      return box;
+    }
+
+    /**
+     * @brief Return the overlapping area of two boxes.
+     * @param _first   First box.
+     * @param _second   Second box.
+     * @return The overlapping area - zero, if the boxes do not overlap.
+     */
+    [[nodiscard]] static constexpr double overlap( const spatial::Box<T> &_first,
+                                                   const spatial::Box<T> &_second ) noexcept {
+
+      const double width = static_cast<double>( std::min( _first.right, _second.right ) ) - std::max( _first.left, _second.left );
+      const double height = static_cast<double>( std::min( _first.bottom, _second.bottom ) ) - std::max( _first.top, _second.top );
+      return width > 0.0 && height > 0.0 ? width * height : 0.0;
+    }
+
+    /**
+     * @brief Call a function for every rect, which intersects the box.
+     * @param _box   Box to search.
+     * @param _function   Function called with the id of every rect found.
+     * @note This function may throw an exception by std::vector.
+     */
+    template <typename Function>
+    void search( const spatial::Box<T> &_box,
+                 Function &&_function ) const {
+
+      if ( m_size == 0 ) {
+
+        return;
+      }
+
+      std::vector<std::size_t> stack { m_root };
+      while ( !stack.empty() ) {
+
+        const Node &node = m_nodes[ stack.back() ];
+        stack.pop_back();
+        for ( const spatial::Entry<T> &entry : node.entries ) {
+
+          if ( !spatial::intersects( entry.box, _box ) ) {
+
+            continue;
+          }
+          if ( node.leaf ) {
+
+            _function( entry.index );
+          }
+          else {
+
+            stack.push_back( entry.index );
+          }
+        }
+      }
+    }
+
+    /**
+     * @brief Member for the maximum number of entries per node.
+     */
+    std::size_t m_maxEntries = defaultNodeSize;
+
+    /**
+     * @brief Member for the minimum number of entries per node.
+     */
+    std::size_t m_minEntries = 2;
+
+    /**
+     * @brief Member for the nodes.
+     */
+    std::vector<Node> m_nodes {};
+
+    /**
+     * @brief Member for the released nodes.
+     */
+    std::vector<std::size_t> m_free {};
+
+    /**
+     * @brief Member for the root node.
+     */
+    std::size_t m_root = 0;
+
+    /**
+     * @brief Member for the number of indexed rects.
+     */
+    std::size_t m_size = 0;
+  };
+}
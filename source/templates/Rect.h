@@ -104,19 +104,19 @@ namespace vx {
      * @brief Check if the rect is null.
      * @return True, if the rect is null - otherwise false.
      */
-    [[nodiscard]] constexpr bool null() const noexcept { return floating_point::equal( m_x2, m_x1 - 1 ) && floating_point::equal( m_y2, m_y1 - 1 ); }
+    [[nodiscard]] constexpr bool null() const noexcept { return floating_point::equal<floating_point::Equal::Absolute>( m_x2, m_x1 - 1 ) && floating_point::equal<floating_point::Equal::Absolute>( m_y2, m_y1 - 1 ); }
 
     /**
      * @brief Check if the rect is empty.
      * @return True, if the rect is empty - otherwise false.
      */
-    [[nodiscard]] constexpr bool empty() const noexcept { return floating_point::greater( m_x1, m_x2 ) || floating_point::greater( m_y1, m_y2 ); }
+    [[nodiscard]] constexpr bool empty() const noexcept { return floating_point::greater<floating_point::Equal::Absolute>( m_x1, m_x2 ) || floating_point::greater<floating_point::Equal::Absolute>( m_y1, m_y2 ); }
 
     /**
      * @brief Check if the rect is valid.
      * @return True, if the rect is valid - otherwise false.
      */
-    [[nodiscard]] constexpr bool valid() const noexcept { return floating_point::less( m_x1, m_x2, true ) && floating_point::less( m_y1, m_y2, true ); }
+    [[nodiscard]] constexpr bool valid() const noexcept { return floating_point::less<floating_point::Equal::Absolute>( m_x1, m_x2, true ) && floating_point::less<floating_point::Equal::Absolute>( m_y1, m_y2, true ); }
 
     /**
      * @brief Return left coordinate.
@@ -263,7 +263,7 @@ namespace vx {
      * @param _rect   Rect to compare with.
      * @return True, if the compared rect is equal current rect - otherwise false.
      */
-    [[nodiscard]] constexpr bool operator==( Rect<T> _rect ) const noexcept { return floating_point::equal( m_x1, _rect.m_x1 ) && floating_point::equal( m_y1, _rect.m_y1 ) && floating_point::equal( m_x2, _rect.m_x2 ) && floating_point::equal( m_y2, _rect.m_y2 ); }
+    [[nodiscard]] constexpr bool operator==( Rect<T> _rect ) const noexcept { return floating_point::equal<floating_point::Equal::Absolute>( m_x1, _rect.m_x1 ) && floating_point::equal<floating_point::Equal::Absolute>( m_y1, _rect.m_y1 ) && floating_point::equal<floating_point::Equal::Absolute>( m_x2, _rect.m_x2 ) && floating_point::equal<floating_point::Equal::Absolute>( m_y2, _rect.m_y2 ); }
 
   private:
     /**
@@ -0,0 +1,520 @@
+/*
+ * Copyright (c) 2011 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* c header */
+#include <cstddef> // std::size_t
+#include <cstdint> // std::int32_t, std::uint32_t, std::uint64_t
+
+/* stl header */
+#include <algorithm>
+#include <limits>
+
+/* system header */
+#if defined __x86_64__ || defined _M_X64
+  #include <immintrin.h>
+#endif
+
+/* local header */
+#include "RectBatch.h"
+
+namespace vx {
+
+  namespace {
+
+    /**
+     * @brief Normalized coordinates of a rect.
+     * @tparam T   Type.
+     */
+    template <typename T>
+    struct Normalized {
+
+      /** @brief Left coordinate. */
+      T left;
+
+      /** @brief Top coordinate. */
+      T top;
+
+      /** @brief Right coordinate. */
+      T right;
+
+      /** @brief Bottom coordinate. */
+      T bottom;
+
+      /** @brief Is the rect null? */
+      bool null;
+    };
+
+    /**
+     * @brief Normalize the coordinates of a rect like Rect<T> does.
+     * @tparam T   Type.
+     * @param _x1   X coordinate of point1.
+     * @param _y1   Y coordinate of point1.
+     * @param _x2   X coordinate of point2.
+     * @param _y2   Y coordinate of point2.
+     * @return The normalized rect.
+     */
+    template <typename T>
+    constexpr Normalized<T> normalize( T _x1,
+                                       T _y1,
+                                       T _x2,
+                                       T _y2 ) noexcept {
+
+      const bool flipX = _x2 - _x1 + 1 < 0;
+      const bool flipY = _y2 - _y1 + 1 < 0;
+      return { flipX ? _x2 : _x1, flipY ? _y2 : _y1, flipX ? _x1 : _x2, flipY ? _y1 : _y2, floating_point::equal<floating_point::Equal::Absolute>( _x2, _x1 - 1 ) && floating_point::equal<floating_point::Equal::Absolute>( _y2, _y1 - 1 ) };
+    }
+
+    /**
+     * @brief Check the relation of two normalized rects like the scalar functions of Rect<T>.
+     * @tparam Relation   Relation to check.
+     * @tparam T   Type.
+     * @param _first   First rect.
+     * @param _second   Second rect.
+     * @return True, if the relation is fulfilled - otherwise false.
+     */
+    template <RectRelation Relation, typename T>
+    constexpr bool check( const Normalized<T> &_first,
+                          const Normalized<T> &_second ) noexcept {
+
+      if ( _first.null || _second.null ) {
+
+        return false;
+      }
+      if constexpr ( Relation == RectRelation::Intersects ) {
+
+        return !( _first.left > _second.right || _second.left > _first.right || _first.top > _second.bottom || _second.top > _first.bottom );
+      }
+      else if constexpr ( Relation == RectRelation::Contains ) {
+
+        return !( _second.left < _first.left || _second.right > _first.right || _second.top < _first.top || _second.bottom > _first.bottom );
+      }
+      else {
+
+        return !( _first.left < _second.left || _first.right > _second.right || _first.top < _second.top || _first.bottom > _second.bottom );
+      }
+    }
+
+    /**
+     * @brief Coordinates of a batch.
+     * @tparam T   Type.
+     */
+    template <typename T>
+    struct Coordinates {
+
+      /** @brief X coordinates of point1. */
+      const T *x1;
+
+      /** @brief Y coordinates of point1. */
+      const T *y1;
+
+      /** @brief X coordinates of point2. */
+      const T *x2;
+
+      /** @brief Y coordinates of point2. */
+      const T *y2;
+
+      /**
+       * @brief Return the normalized rect at an index.
+       * @param _index   Index of the rect.
+       * @return The normalized rect.
+       */
+      [[nodiscard]] constexpr Normalized<T> operator[]( std::size_t _index ) const noexcept { return normalize( x1[ _index ], y1[ _index ], x2[ _index ], y2[ _index ] ); }
+    };
+
+    /**
+     * @brief Check the rects from an index on without SIMD instructions.
+     * @tparam Relation   Relation to check.
+     * @tparam T   Type.
+     * @param _batch   Coordinates of the batch.
+     * @param _other   Coordinates of the other batch, nullptr to use the rect.
+     * @param _rectangle   Normalized rect to check with.
+     * @param _first   First index.
+     * @param _size   Number of rects.
+     * @param _words   Words of the result, which are cleared.
+     */
+    template <RectRelation Relation, typename T>
+    void scalar( const Coordinates<T> &_batch,
+                 const Coordinates<T> *_other,
+                 const Normalized<T> &_rectangle,
+                 std::size_t _first,
+                 std::size_t _size,
+                 std::uint64_t *_words ) noexcept {
+
+      for ( std::size_t index = _first; index < _size; ++index ) {
+
+        const bool result = check<Relation>( _batch[ index ], _other ? ( *_other )[ index ] : _rectangle );
+        _words[ index / BitMask::wordBits ] |= static_cast<std::uint64_t>( result ) << ( index % BitMask::wordBits );
+      }
+    }
+
+#ifdef VX_BATCH_SSE2
+    /**
+     * @brief SSE2 instructions for std::int32_t.
+     */
+    struct Sse2Int32 {
+
+      /** @brief Value type. */
+      using Value = std::int32_t;
+
+      /** @brief Register type. */
+      using Vector = __m128i;
+
+      /** @brief Values per register. */
+      static constexpr std::size_t lanes = 4;
+
+      static Vector load( const Value *_values ) noexcept { return _mm_loadu_si128( reinterpret_cast<const __m128i *>( _values ) ); } // NOSONAR unaligned load of the coordinates.
+      static Vector set( Value _value ) noexcept { return _mm_set1_epi32( _value ); }
+      static Vector add( Vector _left, Vector _right ) noexcept { return _mm_add_epi32( _left, _right ); }
+      static Vector sub( Vector _left, Vector _right ) noexcept { return _mm_sub_epi32( _left, _right ); }
+      static Vector less( Vector _left, Vector _right ) noexcept { return _mm_cmplt_epi32( _left, _right ); }
+      static Vector greater( Vector _left, Vector _right ) noexcept { return _mm_cmpgt_epi32( _left, _right ); }
+      static Vector equal( Vector _left, Vector _right ) noexcept { return _mm_cmpeq_epi32( _left, _right ); }
+      static Vector bitAnd( Vector _left, Vector _right ) noexcept { return _mm_and_si128( _left, _right ); }
+      static Vector bitOr( Vector _left, Vector _right ) noexcept { return _mm_or_si128( _left, _right ); }
+      static Vector select( Vector _mask, Vector _true, Vector _false ) noexcept { return _mm_or_si128( _mm_and_si128( _mask, _true ), _mm_andnot_si128( _mask, _false ) ); }
+      static std::uint32_t bits( Vector _mask ) noexcept { return static_cast<std::uint32_t>( _mm_movemask_ps( _mm_castsi128_ps( _mask ) ) ); }
+    };
+
+    /**
+     * @brief SSE2 instructions for float.
+     */
+    struct Sse2Float {
+
+      /** @brief Value type. */
+      using Value = float;
+
+      /** @brief Register type. */
+      using Vector = __m128;
+
+      /** @brief Values per register. */
+      static constexpr std::size_t lanes = 4;
+
+      static Vector load( const Value *_values ) noexcept { return _mm_loadu_ps( _values ); }
+      static Vector set( Value _value ) noexcept { return _mm_set1_ps( _value ); }
+      static Vector add( Vector _left, Vector _right ) noexcept { return _mm_add_ps( _left, _right ); }
+      static Vector sub( Vector _left, Vector _right ) noexcept { return _mm_sub_ps( _left, _right ); }
+      static Vector less( Vector _left, Vector _right ) noexcept { return _mm_cmplt_ps( _left, _right ); }
+      static Vector greater( Vector _left, Vector _right ) noexcept { return _mm_cmpgt_ps( _left, _right ); }
+      static Vector equal( Vector _left, Vector _right ) noexcept { return _mm_cmple_ps( _mm_andnot_ps( _mm_set1_ps( -0.0F ), _mm_sub_ps( _left, _right ) ), _mm_set1_ps( std::numeric_limits<Value>::epsilon() ) ); }
+      static Vector bitAnd( Vector _left, Vector _right ) noexcept { return _mm_and_ps( _left, _right ); }
+      static Vector bitOr( Vector _left, Vector _right ) noexcept { return _mm_or_ps( _left, _right ); }
+      static Vector select( Vector _mask, Vector _true, Vector _false ) noexcept { return _mm_or_ps( _mm_and_ps( _mask, _true ), _mm_andnot_ps( _mask, _false ) ); }
+      static std::uint32_t bits( Vector _mask ) noexcept { return static_cast<std::uint32_t>( _mm_movemask_ps( _mask ) ); }
+    };
+
+    /**
+     * @brief SSE2 instructions for double.
+     */
+    struct Sse2Double {
+
+      /** @brief Value type. */
+      using Value = double;
+
+      /** @brief Register type. */
+      using Vector = __m128d;
+
+      /** @brief Values per register. */
+      static constexpr std::size_t lanes = 2;
+
+      static Vector load( const Value *_values ) noexcept { return _mm_loadu_pd( _values ); }
+      static Vector set( Value _value ) noexcept { return _mm_set1_pd( _value ); }
+      static Vector add( Vector _left, Vector _right ) noexcept { return _mm_add_pd( _left, _right ); }
+      static Vector sub( Vector _left, Vector _right ) noexcept { return _mm_sub_pd( _left, _right ); }
+      static Vector less( Vector _left, Vector _right ) noexcept { return _mm_cmplt_pd( _left, _right ); }
+      static Vector greater( Vector _left, Vector _right ) noexcept { return _mm_cmpgt_pd( _left, _right ); }
+      static Vector equal( Vector _left, Vector _right ) noexcept { return _mm_cmple_pd( _mm_andnot_pd( _mm_set1_pd( -0.0 ), _mm_sub_pd( _left, _right ) ), _mm_set1_pd( std::numeric_limits<Value>::epsilon() ) ); }
+      static Vector bitAnd( Vector _left, Vector _right ) noexcept { return _mm_and_pd( _left, _right ); }
+      static Vector bitOr( Vector _left, Vector _right ) noexcept { return _mm_or_pd( _left, _right ); }
+      static Vector select( Vector _mask, Vector _true, Vector _false ) noexcept { return _mm_or_pd( _mm_and_pd( _mask, _true ), _mm_andnot_pd( _mask, _false ) ); }
+      static std::uint32_t bits( Vector _mask ) noexcept { return static_cast<std::uint32_t>( _mm_movemask_pd( _mask ) ); }
+    };
+
+    /**
+     * @brief SIMD kernels with SSE2 instructions.
+     */
+    namespace sse2 {
+
+  #define VX_TARGET
+  #include "RectBatch_simd.h"
+  #undef VX_TARGET
+    }
+#endif
+
+#ifdef VX_BATCH_AVX2
+    /**
+     * @brief AVX2 instructions for std::int32_t.
+     */
+    struct Avx2Int32 {
+
+      /** @brief Value type. */
+      using Value = std::int32_t;
+
+      /** @brief Register type. */
+      using Vector = __m256i;
+
+      /** @brief Values per register. */
+      static constexpr std::size_t lanes = 8;
+
+      VX_TARGET_AVX2 static Vector load( const Value *_values ) noexcept { return _mm256_loadu_si256( reinterpret_cast<const __m256i *>( _values ) ); } // NOSONAR unaligned load of the coordinates.
+      VX_TARGET_AVX2 static Vector set( Value _value ) noexcept { return _mm256_set1_epi32( _value ); }
+      VX_TARGET_AVX2 static Vector add( Vector _left, Vector _right ) noexcept { return _mm256_add_epi32( _left, _right ); }
+      VX_TARGET_AVX2 static Vector sub( Vector _left, Vector _right ) noexcept { return _mm256_sub_epi32( _left, _right ); }
+      VX_TARGET_AVX2 static Vector less( Vector _left, Vector _right ) noexcept { return _mm256_cmpgt_epi32( _right, _left ); }
+      VX_TARGET_AVX2 static Vector greater( Vector _left, Vector _right ) noexcept { return _mm256_cmpgt_epi32( _left, _right ); }
+      VX_TARGET_AVX2 static Vector equal( Vector _left, Vector _right ) noexcept { return _mm256_cmpeq_epi32( _left, _right ); }
+      VX_TARGET_AVX2 static Vector bitAnd( Vector _left, Vector _right ) noexcept { return _mm256_and_si256( _left, _right ); }
+      VX_TARGET_AVX2 static Vector bitOr( Vector _left, Vector _right ) noexcept { return _mm256_or_si256( _left, _right ); }
+      VX_TARGET_AVX2 static Vector select( Vector _mask, Vector _true, Vector _false ) noexcept { return _mm256_blendv_epi8( _false, _true, _mask ); }
+      VX_TARGET_AVX2 static std::uint32_t bits( Vector _mask ) noexcept { return static_cast<std::uint32_t>( _mm256_movemask_ps( _mm256_castsi256_ps( _mask ) ) ); }
+    };
+
+    /**
+     * @brief AVX2 instructions for float.
+     */
+    struct Avx2Float {
+
+      /** @brief Value type. */
+      using Value = float;
+
+      /** @brief Register type. */
+      using Vector = __m256;
+
+      /** @brief Values per register. */
+      static constexpr std::size_t lanes = 8;
+
+      VX_TARGET_AVX2 static Vector load( const Value *_values ) noexcept { return _mm256_loadu_ps( _values ); }
+      VX_TARGET_AVX2 static Vector set( Value _value ) noexcept { return _mm256_set1_ps( _value ); }
+      VX_TARGET_AVX2 static Vector add( Vector _left, Vector _right ) noexcept { return _mm256_add_ps( _left, _right ); }
+      VX_TARGET_AVX2 static Vector sub( Vector _left, Vector _right ) noexcept { return _mm256_sub_ps( _left, _right ); }
+      VX_TARGET_AVX2 static Vector less( Vector _left, Vector _right ) noexcept { return _mm256_cmp_ps( _left, _right, _CMP_LT_OQ ); }
+      VX_TARGET_AVX2 static Vector greater( Vector _left, Vector _right ) noexcept { return _mm256_cmp_ps( _left, _right, _CMP_GT_OQ ); }
+      VX_TARGET_AVX2 static Vector equal( Vector _left, Vector _right ) noexcept { return _mm256_cmp_ps( _mm256_andnot_ps( _mm256_set1_ps( -0.0F ), _mm256_sub_ps( _left, _right ) ), _mm256_set1_ps( std::numeric_limits<Value>::epsilon() ), _CMP_LE_OQ ); }
+      VX_TARGET_AVX2 static Vector bitAnd( Vector _left, Vector _right ) noexcept { return _mm256_and_ps( _left, _right ); }
+      VX_TARGET_AVX2 static Vector bitOr( Vector _left, Vector _right ) noexcept { return _mm256_or_ps( _left, _right ); }
+      VX_TARGET_AVX2 static Vector select( Vector _mask, Vector _true, Vector _false ) noexcept { return _mm256_blendv_ps( _false, _true, _mask ); }
+      VX_TARGET_AVX2 static std::uint32_t bits( Vector _mask ) noexcept { return static_cast<std::uint32_t>( _mm256_movemask_ps( _mask ) ); }
+    };
+
+    /**
+     * @brief AVX2 instructions for double.
+     */
+    struct Avx2Double {
+
+      /** @brief Value type. */
+      using Value = double;
+
+      /** @brief Register type. */
+      using Vector = __m256d;
+
+      /** @brief Values per register. */
+      static constexpr std::size_t lanes = 4;
+
+      VX_TARGET_AVX2 static Vector load( const Value *_values ) noexcept { return _mm256_loadu_pd( _values ); }
+      VX_TARGET_AVX2 static Vector set( Value _value ) noexcept { return _mm256_set1_pd( _value ); }
+      VX_TARGET_AVX2 static Vector add( Vector _left, Vector _right ) noexcept { return _mm256_add_pd( _left, _right ); }
+      VX_TARGET_AVX2 static Vector sub( Vector _left, Vector _right ) noexcept { return _mm256_sub_pd( _left, _right ); }
+      VX_TARGET_AVX2 static Vector less( Vector _left, Vector _right ) noexcept { return _mm256_cmp_pd( _left, _right, _CMP_LT_OQ ); }
+      VX_TARGET_AVX2 static Vector greater( Vector _left, Vector _right ) noexcept { return _mm256_cmp_pd( _left, _right, _CMP_GT_OQ ); }
+      VX_TARGET_AVX2 static Vector equal( Vector _left, Vector _right ) noexcept { return _mm256_cmp_pd( _mm256_andnot_pd( _mm256_set1_pd( -0.0 ), _mm256_sub_pd( _left, _right ) ), _mm256_set1_pd( std::numeric_limits<Value>::epsilon() ), _CMP_LE_OQ ); }
+      VX_TARGET_AVX2 static Vector bitAnd( Vector _left, Vector _right ) noexcept { return _mm256_and_pd( _left, _right ); }
+      VX_TARGET_AVX2 static Vector bitOr( Vector _left, Vector _right ) noexcept { return _mm256_or_pd( _left, _right ); }
+      VX_TARGET_AVX2 static Vector select( Vector _mask, Vector _true, Vector _false ) noexcept { return _mm256_blendv_pd( _false, _true, _mask ); }
+      VX_TARGET_AVX2 static std::uint32_t bits( Vector _mask ) noexcept { return static_cast<std::uint32_t>( _mm256_movemask_pd( _mask ) ); }
+    };
+
+    /**
+     * @brief SIMD kernels with AVX2 instructions.
+     */
+    namespace avx2 {
+
+  #define VX_TARGET VX_TARGET_AVX2
+  #include "RectBatch_simd.h"
+  #undef VX_TARGET
+    }
+#endif
+
+    /**
+     * @brief Instruction sets for a type.
+     * @tparam T   Type.
+     */
+    template <typename T>
+    struct Instructions;
+
+    /**
+     * @brief Instruction sets for std::int32_t.
+     */
+    template <>
+    struct Instructions<std::int32_t> {
+#ifdef VX_BATCH_SSE2
+      /** @brief SSE2 instructions. */
+      using Sse2 = Sse2Int32;
+#endif
+#ifdef VX_BATCH_AVX2
+      /** @brief AVX2 instructions. */
+      using Avx2 = Avx2Int32;
+#endif
+    };
+
+    /**
+     * @brief Instruction sets for float.
+     */
+    template <>
+    struct Instructions<float> {
+#ifdef VX_BATCH_SSE2
+      /** @brief SSE2 instructions. */
+      using Sse2 = Sse2Float;
+#endif
+#ifdef VX_BATCH_AVX2
+      /** @brief AVX2 instructions. */
+      using Avx2 = Avx2Float;
+#endif
+    };
+
+    /**
+     * @brief Instruction sets for double.
+     */
+    template <>
+    struct Instructions<double> {
+#ifdef VX_BATCH_SSE2
+      /** @brief SSE2 instructions. */
+      using Sse2 = Sse2Double;
+#endif
+#ifdef VX_BATCH_AVX2
+      /** @brief AVX2 instructions. */
+      using Avx2 = Avx2Double;
+#endif
+    };
+
+    /**
+     * @brief Check every rect with the best available kernel.
+     * @tparam Relation   Relation to check.
+     * @tparam T   Type.
+     * @param _batch   Coordinates of the batch.
+     * @param _other   Coordinates of the other batch, nullptr to use the rect.
+     * @param _rectangle   Normalized rect to check with.
+     * @param _size   Number of rects.
+     * @param _words   Words of the result, which are cleared.
+     */
+    template <RectRelation Relation, typename T>
+    void run( const Coordinates<T> &_batch,
+              const Coordinates<T> *_other,
+              const Normalized<T> &_rectangle,
+              std::size_t _size,
+              std::uint64_t *_words ) noexcept {
+
+      std::size_t first = 0;
+      switch ( batchSimd() ) {
+
+        case Simd::AVX2:
+#ifdef VX_BATCH_AVX2
+          first = avx2::kernel<typename Instructions<T>::Avx2, Relation>( _batch, _other, _rectangle, _size, _words );
+          break;
+#endif
+        case Simd::SSE2:
+#ifdef VX_BATCH_SSE2
+          first = sse2::kernel<typename Instructions<T>::Sse2, Relation>( _batch, _other, _rectangle, _size, _words );
+          break;
+#endif
+        case Simd::Scalar:
+          break;
+      }
+      scalar<Relation>( _batch, _other, _rectangle, first, _size, _words );
+    }
+
+    /**
+     * @brief Check every rect with the best available kernel.
+     * @tparam T   Type.
+     * @param _relation   Relation to check.
+     * @param _batch   Coordinates of the batch.
+     * @param _other   Coordinates of the other batch, nullptr to use the rect.
+     * @param _rectangle   Normalized rect to check with.
+     * @param _size   Number of rects.
+     * @param _words   Words of the result, which are cleared.
+     */
+    template <typename T>
+    void run( RectRelation _relation,
+              const Coordinates<T> &_batch,
+              const Coordinates<T> *_other,
+              const Normalized<T> &_rectangle,
+              std::size_t _size,
+              std::uint64_t *_words ) noexcept {
+
+      switch ( _relation ) {
+
+        case RectRelation::Intersects:
+          run<RectRelation::Intersects>( _batch, _other, _rectangle, _size, _words );
+          break;
+        case RectRelation::Contains:
+          run<RectRelation::Contains>( _batch, _other, _rectangle, _size, _words );
+          break;
+        case RectRelation::ContainedBy:
+          run<RectRelation::ContainedBy>( _batch, _other, _rectangle, _size, _words );
+          break;
+      }
+    }
+  }
+
+  template <typename T>
+  void RectBatch<T>::test( Rect<T> _rectangle,
+                           BitMask &_result,
+                           RectRelation _relation ) const {
+
+    _result.reset( m_x1.size() );
+    const Normalized<T> rectangle = normalize( _rectangle.left(), _rectangle.top(), _rectangle.right(), _rectangle.bottom() );
+    if ( rectangle.null ) {
+
+      return;
+    }
+    run<T>( _relation, Coordinates<T> { m_x1.data(), m_y1.data(), m_x2.data(), m_y2.data() }, nullptr, rectangle, m_x1.size(), _result.words() );
+  }
+
+  template void RectBatch<std::int32_t>::test( Rect<std::int32_t>, BitMask &, RectRelation ) const;
+
+  template void RectBatch<float>::test( Rect<float>, BitMask &, RectRelation ) const;
+
+  template void RectBatch<double>::test( Rect<double>, BitMask &, RectRelation ) const;
+
+  template <typename T>
+  void RectBatch<T>::test( const RectBatch<T> &_other,
+                           BitMask &_result,
+                           RectRelation _relation ) const {
+
+    const std::size_t size = std::min( m_x1.size(), _other.m_x1.size() );
+    _result.reset( size );
+    const Coordinates<T> other { _other.m_x1.data(), _other.m_y1.data(), _other.m_x2.data(), _other.m_y2.data() };
+    run<T>( _relation, Coordinates<T> { m_x1.data(), m_y1.data(), m_x2.data(), m_y2.data() }, &other, {}, size, _result.words() );
+  }
+
+  template void RectBatch<std::int32_t>::test( const RectBatch<std::int32_t> &, BitMask &, RectRelation ) const;
+
+  template void RectBatch<float>::test( const RectBatch<float> &, BitMask &, RectRelation ) const;
+
+  template void RectBatch<double>::test( const RectBatch<double> &, BitMask &, RectRelation ) const;
+}
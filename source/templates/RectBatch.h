@@ -0,0 +1,391 @@
+/*
+ * Copyright (c) 2011 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+/* c header */
+#include <cstddef> // std::size_t
+#include <cstdint> // std::int32_t
+
+/* stl header */
+#include <algorithm>
+#include <limits>
+#include <variant>
+#include <vector>
+
+/* local header */
+#include "AlignedAllocator.h"
+#include "BitMask.h"
+#include "FloatingPoint.h"
+#include "Point.h"
+#include "Rect.h"
+#include "Simd.h"
+#include "TypeCheck.h"
+
+/**
+ * @brief vx (VX APPS) namespace.
+ */
+namespace vx {
+
+  /**
+   * @brief The relation of two rects checked by a batch.
+   */
+  enum class RectRelation {
+
+    Intersects, /**< First rect intersects the second rect. */
+    Contains,   /**< First rect contains the second rect. */
+    ContainedBy /**< First rect is contained by the second rect. */
+  };
+
+  /**
+   * @brief Template for rects stored as structure of arrays.
+   * The coordinates are stored in separate aligned arrays, so the bulk operations are vectorized by the compiler.
+   * The checks are branchless with SSE2 or AVX2 kernels and give the same results as the scalar functions of Rect<T>.
+   * @author Florian Becker <fb\@vxapps.com> (VX APPS)
+   * @tparam T   Type.
+   */
+  template <typename T>
+  class RectBatch : private TypeCheck<isVariantMember<T, std::variant<std::int32_t, float, double>>::value> {
+
+  public:
+    /**
+     * @brief Return the number of rects.
+     * @return The number of rects.
+     */
+    [[nodiscard]] inline std::size_t size() const noexcept { return m_x1.size(); }
+
+    /**
+     * @brief Check if the batch is empty.
+     * @return True, if the batch is empty - otherwise false.
+     */
+    [[nodiscard]] inline bool empty() const noexcept { return m_x1.empty(); }
+
+    /**
+     * @brief Reserve memory for rects.
+     * @param _size   Number of rects.
+     * @note This function may throw an exception by std::vector.
+     */
+    inline void reserve( std::size_t _size ) {
+
+      m_x1.reserve( _size );
+      m_y1.reserve( _size );
+      m_x2.reserve( _size );
+      m_y2.reserve( _size );
+    }
+
+    /**
+     * @brief Remove every rect.
+     */
+    inline void clear() noexcept {
+
+      m_x1.clear();
+      m_y1.clear();
+      m_x2.clear();
+      m_y2.clear();
+    }
+
+    /**
+     * @brief Add a rect.
+     * @param _rectangle   Rect to add.
+     * @note This function may throw an exception by std::vector.
+     */
+    inline void push_back( Rect<T> _rectangle ) {
+
+      m_x1.push_back( _rectangle.left() );
+      m_y1.push_back( _rectangle.top() );
+      m_x2.push_back( _rectangle.right() );
+      m_y2.push_back( _rectangle.bottom() );
+    }
+
+    /**
+     * @brief Return a rect.
+     * @param _index   Index of the rect.
+     * @return The rect.
+     */
+    [[nodiscard]] inline Rect<T> operator[]( std::size_t _index ) const noexcept { return { Point<T>( m_x1[ _index ], m_y1[ _index ] ), Point<T>( m_x2[ _index ], m_y2[ _index ] ) }; }
+
+    /**
+     * @brief Return the left coordinates.
+     * @return The left coordinates.
+     */
+    [[nodiscard]] inline const T *lefts() const noexcept { return m_x1.data(); }
+
+    /**
+     * @brief Return the top coordinates.
+     * @return The top coordinates.
+     */
+    [[nodiscard]] inline const T *tops() const noexcept { return m_y1.data(); }
+
+    /**
+     * @brief Return the right coordinates.
+     * @return The right coordinates.
+     */
+    [[nodiscard]] inline const T *rights() const noexcept { return m_x2.data(); }
+
+    /**
+     * @brief Return the bottom coordinates.
+     * @return The bottom coordinates.
+     */
+    [[nodiscard]] inline const T *bottoms() const noexcept { return m_y2.data(); }
+
+    /**
+     * @brief Move every rect.
+     * @param _offset   Offset to add.
+     */
+    void translate( Point<T> _offset ) noexcept {
+
+      const T offsetX = _offset.x();
+      const T offsetY = _offset.y();
+      T *x1 = m_x1.data();
+      T *y1 = m_y1.data();
+      T *x2 = m_x2.data();
+      T *y2 = m_y2.data();
+      for ( std::size_t index = 0; index < m_x1.size(); ++index ) {
+
+        x1[ index ] += offsetX;
+        y1[ index ] += offsetY;
+        x2[ index ] += offsetX;
+        y2[ index ] += offsetY;
+      }
+    }
+
+    /**
+     * @brief Scale the coordinates of every rect.
+     * @param _factorX   Factor for the x coordinates.
+     * @param _factorY   Factor for the y coordinates.
+     */
+    void scale( T _factorX,
+                T _factorY ) noexcept {
+
+      T *x1 = m_x1.data();
+      T *y1 = m_y1.data();
+      T *x2 = m_x2.data();
+      T *y2 = m_y2.data();
+      for ( std::size_t index = 0; index < m_x1.size(); ++index ) {
+
+        x1[ index ] *= _factorX;
+        y1[ index ] *= _factorY;
+        x2[ index ] *= _factorX;
+        y2[ index ] *= _factorY;
+      }
+    }
+
+    /**
+     * @brief Unite every rect, null rects are skipped like by Rect<T>::united().
+     * @return The united rect - a null rect, if there is no rect, which is not null.
+     */
+    [[nodiscard]] Rect<T> united() const noexcept {
+
+      T left = std::numeric_limits<T>::max();
+      T top = std::numeric_limits<T>::max();
+      T right = std::numeric_limits<T>::lowest();
+      T bottom = std::numeric_limits<T>::lowest();
+      const T *x1 = m_x1.data();
+      const T *y1 = m_y1.data();
+      const T *x2 = m_x2.data();
+      const T *y2 = m_y2.data();
+      bool any = false;
+      for ( std::size_t index = 0; index < m_x1.size(); ++index ) {
+
+        const bool null = isNull( x1[ index ], y1[ index ], x2[ index ], y2[ index ] );
+        const bool flipX = x2[ index ] - x1[ index ] + 1 < 0;
+        const bool flipY = y2[ index ] - y1[ index ] + 1 < 0;
+        left = std::min( left, null ? left : ( flipX ? x2[ index ] : x1[ index ] ) );
+        right = std::max( right, null ? right : ( flipX ? x1[ index ] : x2[ index ] ) );
+        top = std::min( top, null ? top : ( flipY ? y2[ index ] : y1[ index ] ) );
+        bottom = std::max( bottom, null ? bottom : ( flipY ? y1[ index ] : y2[ index ] ) );
+        any |= !null;
+      }
+      if ( !any ) {
+
+        return { Point<T>( 0, 0 ), Point<T>( -1, -1 ) };
+      }
+      return { Point<T>( left, top ), Point<T>( right, bottom ) };
+    }
+
+    /**
+     * @brief Check which rects intersect the rect.
+     * @param _rectangle   Rectangle to check with.
+     * @param _result   Bit i is set, if rect i intersects the rect.
+     * @note This function may throw an exception by std::vector.
+     */
+    inline void intersects( Rect<T> _rectangle,
+                            BitMask &_result ) const { test( _rectangle, _result, RectRelation::Intersects ); }
+
+    /**
+     * @brief Check which rects contain the rect.
+     * @param _rectangle   Rectangle to check with.
+     * @param _result   Bit i is set, if rect i contains the rect.
+     * @note This function may throw an exception by std::vector.
+     */
+    inline void contains( Rect<T> _rectangle,
+                          BitMask &_result ) const { test( _rectangle, _result, RectRelation::Contains ); }
+
+    /**
+     * @brief Check which rects are contained by the rect.
+     * @param _rectangle   Rectangle to check with.
+     * @param _result   Bit i is set, if the rect contains rect i.
+     * @note This function may throw an exception by std::vector.
+     */
+    inline void containedBy( Rect<T> _rectangle,
+                             BitMask &_result ) const { test( _rectangle, _result, RectRelation::ContainedBy ); }
+
+    /**
+     * @brief Check which rects intersect the rect at the same index of the other batch.
+     * @param _other   Other batch - only the rects of both batches are checked.
+     * @param _result   Bit i is set, if rect i intersects rect i of the other batch.
+     * @note This function may throw an exception by std::vector.
+     */
+    inline void intersects( const RectBatch<T> &_other,
+                            BitMask &_result ) const { test( _other, _result, RectRelation::Intersects ); }
+
+    /**
+     * @brief Check which rects contain the rect at the same index of the other batch.
+     * @param _other   Other batch - only the rects of both batches are checked.
+     * @param _result   Bit i is set, if rect i contains rect i of the other batch.
+     * @note This function may throw an exception by std::vector.
+     */
+    inline void contains( const RectBatch<T> &_other,
+                          BitMask &_result ) const { test( _other, _result, RectRelation::Contains ); }
+
+    /**
+     * @brief Check which rects are contained by the rect at the same index of the other batch.
+     * @param _other   Other batch - only the rects of both batches are checked.
+     * @param _result   Bit i is set, if rect i of the other batch contains rect i.
+     * @note This function may throw an exception by std::vector.
+     */
+    inline void containedBy( const RectBatch<T> &_other,
+                             BitMask &_result ) const { test( _other, _result, RectRelation::ContainedBy ); }
+
+  private:
+    /**
+     * @brief Member for the x coordinates of point1.
+     */
+    std::vector<T, AlignedAllocator<T>> m_x1 {};
+
+    /**
+     * @brief Member for the y coordinates of point1.
+     */
+    std::vector<T, AlignedAllocator<T>> m_y1 {};
+
+    /**
+     * @brief Member for the x coordinates of point2.
+     */
+    std::vector<T, AlignedAllocator<T>> m_x2 {};
+
+    /**
+     * @brief Member for the y coordinates of point2.
+     */
+    std::vector<T, AlignedAllocator<T>> m_y2 {};
+
+    /**
+     * @brief Check if the coordinates are a null rect like Rect<T>::null().
+     * @param _x1   X coordinate of point1.
+     * @param _y1   Y coordinate of point1.
+     * @param _x2   X coordinate of point2.
+     * @param _y2   Y coordinate of point2.
+     * @return True, if the rect is null - otherwise false.
+     */
+    [[nodiscard]] static constexpr bool isNull( T _x1,
+                                                T _y1,
+                                                T _x2,
+                                                T _y2 ) noexcept { return floating_point::equal<floating_point::Equal::Absolute>( _x2, _x1 - 1 ) & floating_point::equal<floating_point::Equal::Absolute>( _y2, _y1 - 1 ); }
+
+    /**
+     * @brief Check every rect with the rect, both normalized like the scalar functions of Rect<T>.
+     * @param _rectangle   Rectangle to check with.
+     * @param _result   Result of the check for every rect - null rects are never set.
+     * @param _relation   Relation to check.
+     * @note This function may throw an exception by std::vector.
+     */
+    void test( Rect<T> _rectangle,
+               BitMask &_result,
+               RectRelation _relation ) const;
+
+    /**
+     * @brief Check every rect with the rect at the same index of the other batch.
+     * @param _other   Other batch.
+     * @param _result   Result of the check for every pair - null rects are never set.
+     * @param _relation   Relation to check.
+     * @note This function may throw an exception by std::vector.
+     */
+    void test( const RectBatch<T> &_other,
+               BitMask &_result,
+               RectRelation _relation ) const;
+  };
+
+  /**
+   * @brief Check every rect with the rect.
+   * @param _rectangle   Rectangle to check with.
+   * @param _result   Result of the check for every rect.
+   * @param _relation   Relation to check.
+   */
+  extern template void RectBatch<std::int32_t>::test( Rect<std::int32_t> _rectangle, BitMask &_result, RectRelation _relation ) const;
+
+  /**
+   * @brief Check every rect with the rect.
+   * @param _rectangle   Rectangle to check with.
+   * @param _result   Result of the check for every rect.
+   * @param _relation   Relation to check.
+   */
+  extern template void RectBatch<float>::test( Rect<float> _rectangle, BitMask &_result, RectRelation _relation ) const;
+
+  /**
+   * @brief Check every rect with the rect.
+   * @param _rectangle   Rectangle to check with.
+   * @param _result   Result of the check for every rect.
+   * @param _relation   Relation to check.
+   */
+  extern template void RectBatch<double>::test( Rect<double> _rectangle, BitMask &_result, RectRelation _relation ) const;
+
+  /**
+   * @brief Check every rect with the rect at the same index of the other batch.
+   * @param _other   Other batch.
+   * @param _result   Result of the check for every pair.
+   * @param _relation   Relation to check.
+   */
+  extern template void RectBatch<std::int32_t>::test( const RectBatch<std::int32_t> &_other, BitMask &_result, RectRelation _relation ) const;
+
+  /**
+   * @brief Check every rect with the rect at the same index of the other batch.
+   * @param _other   Other batch.
+   * @param _result   Result of the check for every pair.
+   * @param _relation   Relation to check.
+   */
+  extern template void RectBatch<float>::test( const RectBatch<float> &_other, BitMask &_result, RectRelation _relation ) const;
+
+  /**
+   * @brief Check every rect with the rect at the same index of the other batch.
+   * @param _other   Other batch.
+   * @param _result   Result of the check for every pair.
+   * @param _relation   Relation to check.
+   */
+  extern template void RectBatch<double>::test( const RectBatch<double> &_other, BitMask &_result, RectRelation _relation ) const;
+}
@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2011 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * SIMD kernels of RectBatch, included by RectBatch.cpp once per instruction set into its own namespace.
+ * VX_TARGET holds the function attributes of the instruction set.
+ * Isa is the instruction set with the same functions for every register type.
+ */
+
+/**
+ * @brief Normalized coordinates of rects in registers.
+ * @tparam Isa   Instruction set.
+ */
+template <typename Isa>
+struct Lanes {
+
+  /** @brief Left coordinates. */
+  typename Isa::Vector left;
+
+  /** @brief Top coordinates. */
+  typename Isa::Vector top;
+
+  /** @brief Right coordinates. */
+  typename Isa::Vector right;
+
+  /** @brief Bottom coordinates. */
+  typename Isa::Vector bottom;
+
+  /** @brief Mask of null rects. */
+  typename Isa::Vector null;
+};
+
+/**
+ * @brief Load and normalize the rects like Rect<T> does.
+ * @tparam Isa   Instruction set.
+ * @param _batch   Coordinates of the batch.
+ * @param _index   Index of the first rect.
+ * @return The normalized rects.
+ */
+template <typename Isa>
+VX_TARGET Lanes<Isa> load( const Coordinates<typename Isa::Value> &_batch,
+                           std::size_t _index ) noexcept {
+
+  const auto x1 = Isa::load( _batch.x1 + _index );
+  const auto y1 = Isa::load( _batch.y1 + _index );
+  const auto x2 = Isa::load( _batch.x2 + _index );
+  const auto y2 = Isa::load( _batch.y2 + _index );
+  const auto one = Isa::set( 1 );
+  const auto zero = Isa::set( 0 );
+  const auto flipX = Isa::less( Isa::add( Isa::sub( x2, x1 ), one ), zero );
+  const auto flipY = Isa::less( Isa::add( Isa::sub( y2, y1 ), one ), zero );
+  const auto null = Isa::bitAnd( Isa::equal( x2, Isa::sub( x1, one ) ), Isa::equal( y2, Isa::sub( y1, one ) ) );
+  return { Isa::select( flipX, x2, x1 ), Isa::select( flipY, y2, y1 ), Isa::select( flipX, x1, x2 ), Isa::select( flipY, y1, y2 ), null };
+}
+
+/**
+ * @brief Check the relation of the rects branchless.
+ * @tparam Isa   Instruction set.
+ * @tparam Relation   Relation to check.
+ * @param _first   First rects.
+ * @param _second   Second rects.
+ * @return Bit i is set, if the relation of lane i is fulfilled.
+ */
+template <typename Isa, RectRelation Relation>
+VX_TARGET std::uint32_t check( const Lanes<Isa> &_first,
+                               const Lanes<Isa> &_second ) noexcept {
+
+  typename Isa::Vector outside {};
+  if constexpr ( Relation == RectRelation::Intersects ) {
+
+    outside = Isa::bitOr( Isa::bitOr( Isa::greater( _first.left, _second.right ), Isa::greater( _second.left, _first.right ) ),
+                          Isa::bitOr( Isa::greater( _first.top, _second.bottom ), Isa::greater( _second.top, _first.bottom ) ) );
+  }
+  else if constexpr ( Relation == RectRelation::Contains ) {
+
+    outside = Isa::bitOr( Isa::bitOr( Isa::less( _second.left, _first.left ), Isa::greater( _second.right, _first.right ) ),
+                          Isa::bitOr( Isa::less( _second.top, _first.top ), Isa::greater( _second.bottom, _first.bottom ) ) );
+  }
+  else {
+
+    outside = Isa::bitOr( Isa::bitOr( Isa::less( _first.left, _second.left ), Isa::greater( _first.right, _second.right ) ),
+                          Isa::bitOr( Isa::less( _first.top, _second.top ), Isa::greater( _first.bottom, _second.bottom ) ) );
+  }
+  constexpr std::uint32_t lanesMask = ( 1U << Isa::lanes ) - 1;
+  return ~Isa::bits( Isa::bitOr( outside, Isa::bitOr( _first.null, _second.null ) ) ) & lanesMask;
+}
+
+/**
+ * @brief Check the rects, as long as a register is filled.
+ * @tparam Isa   Instruction set.
+ * @tparam Relation   Relation to check.
+ * @param _batch   Coordinates of the batch.
+ * @param _other   Coordinates of the other batch, nullptr to use the rect.
+ * @param _rectangle   Normalized rect to check with.
+ * @param _size   Number of rects.
+ * @param _words   Words of the result, which are cleared.
+ * @return Number of checked rects.
+ */
+template <typename Isa, RectRelation Relation>
+VX_TARGET std::size_t kernel( const Coordinates<typename Isa::Value> &_batch,
+                              const Coordinates<typename Isa::Value> *_other,
+                              const Normalized<typename Isa::Value> &_rectangle,
+                              std::size_t _size,
+                              std::uint64_t *_words ) noexcept {
+
+  const Lanes<Isa> rectangle { Isa::set( _rectangle.left ), Isa::set( _rectangle.top ), Isa::set( _rectangle.right ), Isa::set( _rectangle.bottom ), Isa::set( 0 ) };
+  const std::size_t size = _size - _size % Isa::lanes;
+  for ( std::size_t index = 0; index < size; index += Isa::lanes ) {
+
+    const std::uint32_t bits = check<Isa, Relation>( load<Isa>( _batch, index ), _other ? load<Isa>( *_other, index ) : rectangle );
+    _words[ index / BitMask::wordBits ] |= static_cast<std::uint64_t>( bits ) << ( index % BitMask::wordBits );
+  }
+  return size;
+}
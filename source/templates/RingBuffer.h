@@ -0,0 +1,242 @@
+/*
+ * Copyright (c) 2020 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+/* c header */
+#include <cstddef> // std::byte, std::size_t
+
+/* stl header */
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstring> // std::memcpy
+#include <memory>
+
+/**
+ * @brief vx (VX APPS) namespace.
+ */
+namespace vx {
+
+  /**
+   * @brief Lock-free byte ring buffer for a single producer and a single consumer thread.
+   * The capacity is a power of two, so positions only grow and wrap by a mask. The producer and the consumer may access
+   * the free and the filled space in place by regions, e.g. to read from a device without a copy.
+   * @author Florian Becker <fb\@vxapps.com> (VX APPS)
+   */
+  class RingBuffer {
+
+  public:
+    /**
+     * @brief Contiguous part of the buffer.
+     */
+    struct Region {
+
+      /** @brief Begin of the part. */
+      std::byte *data = nullptr;
+
+      /** @brief Size of the part. */
+      std::size_t size = 0;
+    };
+
+    /**
+     * @brief Default constructor for RingBuffer.
+     * @param _capacity   Capacity, rounded up to a power of two.
+     * @note This function may throw an exception by new.
+     */
+    explicit RingBuffer( std::size_t _capacity )
+      : m_capacity( std::bit_ceil( std::max<std::size_t>( _capacity, 1 ) ) ),
+        m_data( std::make_unique<std::byte[]>( m_capacity ) ) {}
+
+    /**
+     * @brief Delete copy constructor.
+     */
+    RingBuffer( const RingBuffer & ) = delete;
+
+    /**
+     * @brief Delete move constructor.
+     */
+    RingBuffer( RingBuffer && ) = delete;
+
+    /**
+     * @brief Delete copy assign.
+     * @return Nothing.
+     */
+    RingBuffer &operator=( const RingBuffer & ) = delete;
+
+    /**
+     * @brief Delete move assign.
+     * @return Nothing.
+     */
+    RingBuffer &operator=( RingBuffer && ) = delete;
+
+    /**
+     * @brief Default destructor for RingBuffer.
+     */
+    ~RingBuffer() = default;
+
+    /**
+     * @brief Return the capacity.
+     * @return The capacity.
+     */
+    [[nodiscard]] inline std::size_t capacity() const noexcept { return m_capacity; }
+
+    /**
+     * @brief Return the number of filled bytes - exact only for the producer or the consumer thread.
+     * @return The number of filled bytes.
+     */
+    [[nodiscard]] inline std::size_t size() const noexcept { return m_tail.load( std::memory_order_acquire ) - m_head.load( std::memory_order_acquire ); }
+
+    /**
+     * @brief Is the buffer empty?
+     * @return True, if the buffer is empty - otherwise false.
+     */
+    [[nodiscard]] inline bool empty() const noexcept { return size() == 0; }
+
+    /**
+     * @brief Return the free space in place - producer only.
+     * @return Up to two regions, the second one is empty if the free space does not wrap.
+     */
+    [[nodiscard]] std::array<Region, 2> writeRegions() noexcept {
+
+      const std::size_t tail = m_tail.load( std::memory_order_relaxed );
+      const std::size_t free = m_capacity - ( tail - m_head.load( std::memory_order_acquire ) );
+      return regions( tail, free );
+    }
+
+    /**
+     * @brief Publish bytes written to the write regions - producer only.
+     * @param _size   Number of bytes, which must fit into the write regions.
+     */
+    inline void commit( std::size_t _size ) noexcept { m_tail.store( m_tail.load( std::memory_order_relaxed ) + _size, std::memory_order_release ); }
+
+    /**
+     * @brief Return the filled space in place - consumer only.
+     * @return Up to two regions, the second one is empty if the filled space does not wrap.
+     */
+    [[nodiscard]] std::array<Region, 2> readRegions() noexcept {
+
+      const std::size_t head = m_head.load( std::memory_order_relaxed );
+      const std::size_t filled = m_tail.load( std::memory_order_acquire ) - head;
+      return regions( head, filled );
+    }
+
+    /**
+     * @brief Release bytes of the read regions - consumer only.
+     * @param _size   Number of bytes, which must fit into the read regions.
+     */
+    inline void consume( std::size_t _size ) noexcept { m_head.store( m_head.load( std::memory_order_relaxed ) + _size, std::memory_order_release ); }
+
+    /**
+     * @brief Copy bytes into the buffer - producer only.
+     * @param _data   Data.
+     * @param _size   Size of the data.
+     * @return Number of bytes copied, less than _size if the buffer is full.
+     */
+    std::size_t write( const std::byte *_data,
+                       std::size_t _size ) noexcept {
+
+      std::size_t written = 0;
+      for ( const Region &region : writeRegions() ) {
+
+        const std::size_t size = std::min( region.size, _size - written );
+        if ( size > 0 ) {
+
+          std::memcpy( region.data, _data + written, size );
+          written += size;
+        }
+      }
+      commit( written );
+      return written;
+    }
+
+    /**
+     * @brief Copy bytes out of the buffer - consumer only.
+     * @param _data   Target.
+     * @param _size   Size of the target.
+     * @return Number of bytes copied, less than _size if the buffer is empty.
+     */
+    std::size_t read( std::byte *_data,
+                      std::size_t _size ) noexcept {
+
+      std::size_t read = 0;
+      for ( const Region &region : readRegions() ) {
+
+        const std::size_t size = std::min( region.size, _size - read );
+        if ( size > 0 ) {
+
+          std::memcpy( _data + read, region.data, size );
+          read += size;
+        }
+      }
+      consume( read );
+      return read;
+    }
+
+  private:
+    /** @brief Size of a cache line to separate the positions of producer and consumer. */
+    static constexpr std::size_t cacheLineSize = 64;
+
+    /**
+     * @brief Split a range of positions into contiguous regions.
+     * @param _position   Position of the begin.
+     * @param _size   Size of the range.
+     * @return Up to two regions.
+     */
+    [[nodiscard]] std::array<Region, 2> regions( std::size_t _position,
+                                                 std::size_t _size ) const noexcept {
+
+      const std::size_t offset = _position & ( m_capacity - 1 );
+      const std::size_t first = std::min( _size, m_capacity - offset );
+      return { Region { m_data.get() + offset, first }, Region { m_data.get(), _size - first } };
+    }
+
+    /**
+     * @brief Member for the capacity.
+     */
+    std::size_t m_capacity = 0;
+
+    /**
+     * @brief Member for the data.
+     */
+    std::unique_ptr<std::byte[]> m_data {};
+
+    /**
+     * @brief Member for the read position of the consumer.
+     */
+    alignas( cacheLineSize ) std::atomic_size_t m_head { 0 };
+
+    /**
+     * @brief Member for the write position of the producer.
+     */
+    alignas( cacheLineSize ) std::atomic_size_t m_tail { 0 };
+  };
+}
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2020 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* stl header */
+#include <algorithm>
+#include <atomic>
+
+/* local header */
+#include "Simd.h"
+
+namespace vx {
+
+  namespace {
+
+    /**
+     * @brief Return the best SIMD instruction set supported by the CPU.
+     * @return The SIMD instruction set.
+     */
+    Simd supportedSimd() noexcept {
+
+#if defined VX_BATCH_AVX2 && ( defined __GNUC__ || defined __clang__ )
+      return __builtin_cpu_supports( "avx2" ) ? Simd::AVX2 : Simd::SSE2;
+#elif defined VX_BATCH_AVX2
+      return Simd::AVX2;
+#elif defined VX_BATCH_SSE2
+      return Simd::SSE2;
+#else
+      return Simd::Scalar;
+#endif
+    }
+
+    /** @brief SIMD instruction set used by the batch functions. */
+    std::atomic<Simd> currentSimd = supportedSimd(); // NOSONAR can be changed by setBatchSimd().
+  }
+
+  Simd batchSimd() noexcept {
+
+    return currentSimd.load( std::memory_order_relaxed );
+  }
+
+  void setBatchSimd( Simd _simd ) noexcept {
+
+    currentSimd.store( std::min( _simd, supportedSimd() ), std::memory_order_relaxed );
+  }
+}
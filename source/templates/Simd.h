@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2020 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#if defined __x86_64__ || defined _M_X64
+  /** @brief SSE2 kernels are available. */
+  #define VX_BATCH_SSE2
+  #if defined __GNUC__ || defined __clang__
+    /** @brief AVX2 kernels are available. */
+    #define VX_BATCH_AVX2
+    /** @brief Compile a function for AVX2, it is only called if the CPU supports it. */
+    #define VX_TARGET_AVX2 __attribute__( ( target( "avx2" ) ) )
+  #elif defined __AVX2__
+    #define VX_BATCH_AVX2
+    #define VX_TARGET_AVX2
+  #endif
+#endif
+
+/**
+ * @brief vx (VX APPS) namespace.
+ */
+namespace vx {
+
+  /**
+   * @brief The SIMD instruction set used by the batch functions.
+   */
+  enum class Simd {
+
+    Scalar, /**< No SIMD instructions. */
+    SSE2,   /**< SSE2 instructions with 128 bit registers. */
+    AVX2    /**< AVX2 instructions with 256 bit registers. */
+  };
+
+  /**
+   * @brief Return the SIMD instruction set used by the batch functions.
+   * @return The SIMD instruction set - the best one supported by the CPU by default.
+   */
+  [[nodiscard]] Simd batchSimd() noexcept;
+
+  /**
+   * @brief Set the SIMD instruction set used by the batch functions, e.g. to compare the results.
+   * @param _simd   The SIMD instruction set - limited to the best one supported by the CPU.
+   */
+  void setBatchSimd( Simd _simd ) noexcept;
+}
@@ -73,13 +73,13 @@ namespace vx {
      * @brief Is this size null?
      * @return True, width and height is null - otherwise false.
      */
-    [[nodiscard]] constexpr bool null() const noexcept { return floating_point::equal( m_width, static_cast<T>( 0 ) ) && floating_point::equal( m_height, static_cast<T>( 0 ) ); }
+    [[nodiscard]] constexpr bool null() const noexcept { return floating_point::equal<floating_point::Equal::Absolute>( m_width, static_cast<T>( 0 ) ) && floating_point::equal<floating_point::Equal::Absolute>( m_height, static_cast<T>( 0 ) ); }
 
     /**
      * @brief Is this size empty?
      * @return True, width and height is one - otherwise false.
      */
-    [[nodiscard]] constexpr bool empty() const noexcept { return floating_point::less( m_width, static_cast<T>( 1 ) ) || floating_point::less( m_height, static_cast<T>( 1 ) ); }
+    [[nodiscard]] constexpr bool empty() const noexcept { return floating_point::less<floating_point::Equal::Absolute>( m_width, static_cast<T>( 1 ) ) || floating_point::less<floating_point::Equal::Absolute>( m_height, static_cast<T>( 1 ) ); }
 
     /**
      * @brief Return width.
@@ -134,7 +134,7 @@ namespace vx {
      * @param _size   Size to compare with.
      * @return True, if the compared size is equal current size - otherwise false.
      */
-    [[nodiscard]] constexpr bool operator==( Size<T> _size ) const noexcept { return floating_point::equal( m_width, _size.m_width ) && floating_point::equal( m_height, _size.m_height ); }
+    [[nodiscard]] constexpr bool operator==( Size<T> _size ) const noexcept { return floating_point::equal<floating_point::Equal::Absolute>( m_width, _size.m_width ) && floating_point::equal<floating_point::Equal::Absolute>( m_height, _size.m_height ); }
 
   private:
     /**
@@ -0,0 +1,226 @@
+/*
+ * Copyright (c) 2020 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+/* c header */
+#include <cstddef> // std::size_t
+
+/* stl header */
+#include <algorithm>
+#include <utility>
+
+/* local header */
+#include "Point.h"
+#include "Rect.h"
+
+/**
+ * @brief vx (VX APPS) spatial namespace.
+ * Shared helpers of the spatial indexes PackedRTree, RTree and UniformGrid.
+ * Every index stores normalized boxes with inclusive coordinates, so the results match Rect<T>::intersects().
+ */
+namespace vx::spatial {
+
+  /**
+   * @brief Normalized box with inclusive coordinates.
+   * Like in Rect<T>, a rect thinner than one unit keeps its right border left of its left border.
+   * @tparam T   Type.
+   */
+  template <typename T>
+  struct Box {
+
+    /** @brief Left coordinate. */
+    T left = 0;
+
+    /** @brief Top coordinate. */
+    T top = 0;
+
+    /** @brief Right coordinate. */
+    T right = 0;
+
+    /** @brief Bottom coordinate. */
+    T bottom = 0;
+  };
+
+  /**
+   * @brief Indexed box.
+   * @tparam T   Type.
+   */
+  template <typename T>
+  struct Entry {
+
+    /** @brief Box of the entry. */
+    Box<T> box {};
+
+    /** @brief Id of the rect or index of the child node. */
+    std::size_t index = 0;
+  };
+
+  /**
+   * @brief Return the normalized box of a rect.
+   * Rects with a negative width or height are flipped like in Rect<T>::intersects().
+   * @param _rectangle   Rectangle to normalize.
+   * @return The normalized box.
+   */
+  template <typename T>
+  [[nodiscard]] constexpr Box<T> box( Rect<T> _rectangle ) noexcept {
+
+    const bool flipX = _rectangle.right() - _rectangle.left() + 1 < 0;
+    const bool flipY = _rectangle.bottom() - _rectangle.top() + 1 < 0;
+    return { flipX ? _rectangle.right() : _rectangle.left(),
+             flipY ? _rectangle.bottom() : _rectangle.top(),
+             flipX ? _rectangle.left() : _rectangle.right(),
+             flipY ? _rectangle.top() : _rectangle.bottom() };
+  }
+
+  /**
+   * @brief Return the box of a point.
+   * @param _point   Point.
+   * @return The box with the point as only coordinate.
+   */
+  template <typename T>
+  [[nodiscard]] constexpr Box<T> box( Point<T> _point ) noexcept { return { _point.x(), _point.y(), _point.x(), _point.y() }; }
+
+  /**
+   * @brief Check if two boxes intersect, including their border.
+   * @param _first   First box.
+   * @param _second   Second box.
+   * @return True, if the boxes intersect - otherwise false.
+   */
+  template <typename T>
+  [[nodiscard]] constexpr bool intersects( const Box<T> &_first,
+                                           const Box<T> &_second ) noexcept {
+
+    return _first.left <= _second.right && _second.left <= _first.right && _first.top <= _second.bottom && _second.top <= _first.bottom;
+  }
+
+  /**
+   * @brief Check if the first box contains the second box, including their border.
+   * @param _first   First box.
+   * @param _second   Second box.
+   * @return True, if the first box contains the second box - otherwise false.
+   */
+  template <typename T>
+  [[nodiscard]] constexpr bool contains( const Box<T> &_first,
+                                         const Box<T> &_second ) noexcept {
+
+    return _first.left <= _second.left && _second.right <= _first.right && _first.top <= _second.top && _second.bottom <= _first.bottom;
+  }
+
+  /**
+   * @brief Return the box around two boxes.
+   * @param _first   First box.
+   * @param _second   Second box.
+   * @return The united box.
+   */
+  template <typename T>
+  [[nodiscard]] constexpr Box<T> united( const Box<T> &_first,
+                                         const Box<T> &_second ) noexcept {
+
+    return { std::min( _first.left, _second.left ), std::min( _first.top, _second.top ), std::max( _first.right, _second.right ), std::max( _first.bottom, _second.bottom ) };
+  }
+
+  /**
+   * @brief Return the area of a box.
+   * @param _box   Box.
+   * @return The area.
+   */
+  template <typename T>
+  [[nodiscard]] constexpr double area( const Box<T> &_box ) noexcept { return ( static_cast<double>( _box.right ) - _box.left ) * ( static_cast<double>( _box.bottom ) - _box.top ); }
+
+  /**
+   * @brief Return the half perimeter of a box.
+   * @param _box   Box.
+   * @return The half perimeter.
+   */
+  template <typename T>
+  [[nodiscard]] constexpr double margin( const Box<T> &_box ) noexcept { return ( static_cast<double>( _box.right ) - _box.left ) + ( static_cast<double>( _box.bottom ) - _box.top ); }
+
+  /**
+   * @brief Return the doubled center x coordinate of a box.
+   * @param _box   Box.
+   * @return The doubled center x coordinate.
+   */
+  template <typename T>
+  [[nodiscard]] constexpr double centerX( const Box<T> &_box ) noexcept { return static_cast<double>( _box.left ) + _box.right; }
+
+  /**
+   * @brief Return the doubled center y coordinate of a box.
+   * @param _box   Box.
+   * @return The doubled center y coordinate.
+   */
+  template <typename T>
+  [[nodiscard]] constexpr double centerY( const Box<T> &_box ) noexcept { return static_cast<double>( _box.top ) + _box.bottom; }
+
+  /**
+   * @brief Return the squared distance between a point and a box.
+   * @param _box   Box.
+   * @param _point   Point.
+   * @return The squared distance - zero, if the point is inside of the box.
+   */
+  template <typename T>
+  [[nodiscard]] constexpr double distance( const Box<T> &_box,
+                                           Point<T> _point ) noexcept {
+
+    const double x = _point.x();
+    const double y = _point.y();
+    const double deltaX = std::max( { static_cast<double>( _box.left ) - x, 0.0, x - _box.right } );
+    const double deltaY = std::max( { static_cast<double>( _box.top ) - y, 0.0, y - _box.bottom } );
+    return deltaX * deltaX + deltaY * deltaY;
+  }
+
+  /**
+   * @brief Sort entries by sort-tile-recursive packing.
+   * The entries are sorted by x into vertical slices and every slice by y, so consecutive groups of _nodeSize entries form compact nodes.
+   * @param _begin   First entry.
+   * @param _end   Behind the last entry.
+   * @param _nodeSize   Number of entries per node.
+   */
+  template <typename Iterator>
+  void sortTiles( Iterator _begin,
+                  Iterator _end,
+                  std::size_t _nodeSize ) {
+
+    const auto count = static_cast<std::size_t>( _end - _begin );
+    const std::size_t nodes = ( count + _nodeSize - 1 ) / _nodeSize;
+    auto slices = static_cast<std::size_t>( 1 );
+    while ( slices * slices < nodes ) {
+
+      ++slices;
+    }
+    const std::size_t sliceSize = ( ( nodes + slices - 1 ) / slices ) * _nodeSize;
+    std::sort( _begin, _end, []( const auto &_first, const auto &_second ) { return centerX( _first.box ) < centerX( _second.box ); } );
+    for ( std::size_t start = 0; start < count; start += sliceSize ) {
+
+      const std::size_t end = std::min( start + sliceSize, count );
+      std::sort( _begin + static_cast<std::ptrdiff_t>( start ), _begin + static_cast<std::ptrdiff_t>( end ), []( const auto &_first, const auto &_second ) { return centerY( _first.box ) < centerY( _second.box ); } );
+    }
+  }
+}
@@ -0,0 +1,445 @@
+/*
+ * Copyright (c) 2020 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+/* c header */
+#include <cstddef> // std::size_t, std::ptrdiff_t
+#include <cstdint> // std::int32_t
+
+/* stl header */
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+/* local header */
+#include "Point.h"
+#include "Rect.h"
+#include "Spatial.h"
+#include "TypeCheck.h"
+
+/**
+ * @brief vx (VX APPS) namespace.
+ */
+namespace vx {
+
+  /**
+   * @brief Template for a uniform grid of cells over an area.
+   * A rect is stored in every cell it overlaps, rects outside of the area in the cells at the border.
+   * The grid is the fastest index for rects of similar size, which are spread evenly over the area.
+   * @author Florian Becker <fb\@vxapps.com> (VX APPS)
+   * @tparam T   Type.
+   */
+  template <typename T>
+  class UniformGrid : private TypeCheck<isVariantMember<T, std::variant<std::int32_t, float, double>>::value> {
+
+  public:
+    /**
+     * @brief Default constructor for UniformGrid.
+     * @param _area   Area covered by the cells.
+     * @param _columns   Number of columns - at least one.
+     * @param _rows   Number of rows - at least one.
+     * @note This function may throw an exception by std::vector.
+     */
+    UniformGrid( Rect<T> _area,
+                 std::size_t _columns,
+                 std::size_t _rows )
+      : m_area( spatial::box( _area ) ),
+        m_columns( std::max( _columns, static_cast<std::size_t>( 1 ) ) ),
+        m_rows( std::max( _rows, static_cast<std::size_t>( 1 ) ) ),
+        m_cells( m_columns * m_rows ) {
+
+      const double width = static_cast<double>( m_area.right ) - m_area.left;
+      const double height = static_cast<double>( m_area.bottom ) - m_area.top;
+      m_cellWidth = width > 0.0 ? width / static_cast<double>( m_columns ) : 1.0;
+      m_cellHeight = height > 0.0 ? height / static_cast<double>( m_rows ) : 1.0;
+    }
+
+    /**
+     * @brief Return the number of indexed rects.
+     * @return The number of indexed rects.
+     */
+    [[nodiscard]] inline std::size_t size() const noexcept { return m_size; }
+
+    /**
+     * @brief Check if the grid is empty.
+     * @return True, if the grid is empty - otherwise false.
+     */
+    [[nodiscard]] inline bool empty() const noexcept { return m_size == 0; }
+
+    /**
+     * @brief Return the number of columns.
+     * @return The number of columns.
+     */
+    [[nodiscard]] inline std::size_t columns() const noexcept { return m_columns; }
+
+    /**
+     * @brief Return the number of rows.
+     * @return The number of rows.
+     */
+    [[nodiscard]] inline std::size_t rows() const noexcept { return m_rows; }
+
+    /**
+     * @brief Remove every rect.
+     */
+    inline void clear() noexcept {
+
+      for ( std::vector<spatial::Entry<T>> &cell : m_cells ) {
+
+        cell.clear();
+      }
+      m_size = 0;
+    }
+
+    /**
+     * @brief Insert a rect.
+     * Null rects are skipped, as they never intersect.
+     * @param _rectangle   Rect to insert.
+     * @param _id   Id of the rect.
+     * @note This function may throw an exception by std::vector.
+     */
+    void insert( Rect<T> _rectangle,
+                 std::size_t _id ) {
+
+      if ( _rectangle.null() ) {
+
+        return;
+      }
+
+      const spatial::Entry<T> entry { spatial::box( _rectangle ), _id };
+      const auto [ left, top, right, bottom ] = cells( entry.box );
+      for ( std::size_t y = top; y <= bottom; ++y ) {
+
+        for ( std::size_t x = left; x <= right; ++x ) {
+
+          m_cells[ y * m_columns + x ].push_back( entry );
+        }
+      }
+      ++m_size;
+    }
+
+    /**
+     * @brief Remove a rect.
+     * @param _rectangle   Rect as inserted.
+     * @param _id   Id of the rect.
+     * @return True, if the rect was found - otherwise false.
+     */
+    bool remove( Rect<T> _rectangle,
+                 std::size_t _id ) noexcept {
+
+      if ( _rectangle.null() ) {
+
+        return false;
+      }
+
+      const spatial::Box<T> box = spatial::box( _rectangle );
+      bool found = false;
+      const auto [ left, top, right, bottom ] = cells( box );
+      for ( std::size_t y = top; y <= bottom; ++y ) {
+
+        for ( std::size_t x = left; x <= right; ++x ) {
+
+          std::vector<spatial::Entry<T>> &cell = m_cells[ y * m_columns + x ];
+          const auto entry = std::find_if( std::begin( cell ), std::end( cell ), [ &box, _id ]( const spatial::Entry<T> &_entry ) {
+            return _entry.index == _id && spatial::contains( _entry.box, box ) && spatial::contains( box, _entry.box );
+          } );
+          if ( entry == std::end( cell ) ) {
+
+            continue;
+          }
+          *entry = cell.back();
+          cell.pop_back();
+          found = true;
+        }
+      }
+      if ( found ) {
+
+        --m_size;
+      }
+      return found;
+    }
+
+    /**
+     * @brief Call a function for every rect, which intersects the region.
+     * Every rect is reported once, in the first cell it shares with the region.
+     * @param _region   Region to search.
+     * @param _function   Function called with the id of every rect found.
+     */
+    template <typename Function>
+    void visit( Rect<T> _region,
+                Function _function ) const {
+
+      if ( _region.null() || m_size == 0 ) {
+
+        return;
+      }
+
+      const spatial::Box<T> region = spatial::box( _region );
+      const auto [ left, top, right, bottom ] = cells( region );
+      for ( std::size_t y = top; y <= bottom; ++y ) {
+
+        for ( std::size_t x = left; x <= right; ++x ) {
+
+          for ( const spatial::Entry<T> &entry : m_cells[ y * m_columns + x ] ) {
+
+            if ( !spatial::intersects( entry.box, region ) ) {
+
+              continue;
+            }
+            const auto [ entryLeft, entryTop, entryRight, entryBottom ] = cells( entry.box );
+            if ( std::max( entryLeft, left ) == x && std::max( entryTop, top ) == y ) {
+
+              _function( entry.index );
+            }
+          }
+        }
+      }
+    }
+
+    /**
+     * @brief Return every rect, which intersects the region.
+     * @param _region   Region to search.
+     * @param _result   Ids of the rects found - cleared first.
+     * @note This function may throw an exception by std::vector.
+     */
+    void intersecting( Rect<T> _region,
+                       std::vector<std::size_t> &_result ) const {
+
+      _result.clear();
+      visit( _region, [ &_result ]( std::size_t _id ) { _result.push_back( _id ); } );
+    }
+
+    /**
+     * @brief Return every rect, which contains the point, including its border.
+     * @param _point   Point to search.
+     * @param _result   Ids of the rects found - cleared first.
+     * @note This function may throw an exception by std::vector.
+     */
+    void containing( Point<T> _point,
+                     std::vector<std::size_t> &_result ) const {
+
+      _result.clear();
+      const spatial::Box<T> point = spatial::box( _point );
+      for ( const spatial::Entry<T> &entry : m_cells[ row( _point.y() ) * m_columns + column( _point.x() ) ] ) {
+
+        if ( spatial::intersects( entry.box, point ) ) {
+
+          _result.push_back( entry.index );
+        }
+      }
+    }
+
+    /**
+     * @brief Return the rects nearest to the point.
+     * The cells are searched in growing rings around the point, until no rect outside of the searched cells can be nearer.
+     * The distance is measured to the border of a rect and is zero for rects containing the point.
+     * @param _point   Point to search.
+     * @param _count   Maximum number of rects.
+     * @param _result   Ids of the rects found, ordered by distance - cleared first.
+     * @note This function may throw an exception by std::vector.
+     */
+    void nearest( Point<T> _point,
+                  std::size_t _count,
+                  std::vector<std::size_t> &_result ) const {
+
+      _result.clear();
+      if ( m_size == 0 || _count == 0 ) {
+
+        return;
+      }
+
+      const auto centerX = static_cast<std::ptrdiff_t>( column( _point.x() ) );
+      const auto centerY = static_cast<std::ptrdiff_t>( row( _point.y() ) );
+      const auto columns = static_cast<std::ptrdiff_t>( m_columns );
+      const auto rows = static_cast<std::ptrdiff_t>( m_rows );
+      const auto compare = []( const std::pair<double, std::size_t> &_first, const std::pair<double, std::size_t> &_second ) { return _first.first < _second.first; };
+      std::vector<std::pair<double, std::size_t>> candidates {};
+
+      /* Every rect is reported once, in its cell nearest to the center cell. */
+      const auto visitCell = [ &, this ]( std::ptrdiff_t _x, std::ptrdiff_t _y ) {
+        if ( _x < 0 || _y < 0 || _x >= columns || _y >= rows ) {
+
+          return;
+        }
+        for ( const spatial::Entry<T> &entry : m_cells[ static_cast<std::size_t>( _y * columns + _x ) ] ) {
+
+          const auto [ left, top, right, bottom ] = cells( entry.box );
+          const auto nearestX = std::clamp( centerX, static_cast<std::ptrdiff_t>( left ), static_cast<std::ptrdiff_t>( right ) );
+          const auto nearestY = std::clamp( centerY, static_cast<std::ptrdiff_t>( top ), static_cast<std::ptrdiff_t>( bottom ) );
+          if ( nearestX != _x || nearestY != _y ) {
+
+            continue;
+          }
+          candidates.emplace_back( spatial::distance( entry.box, _point ), entry.index );
+          std::push_heap( std::begin( candidates ), std::end( candidates ), compare );
+          if ( candidates.size() > _count ) {
+
+            std::pop_heap( std::begin( candidates ), std::end( candidates ), compare );
+            candidates.pop_back();
+          }
+        }
+      };
+
+      const double x = _point.x();
+      const double y = _point.y();
+      for ( std::ptrdiff_t ring = 0;; ++ring ) {
+
+        for ( std::ptrdiff_t cellX = centerX - ring; cellX <= centerX + ring; ++cellX ) {
+
+          visitCell( cellX, centerY - ring );
+          if ( ring > 0 ) {
+
+            visitCell( cellX, centerY + ring );
+          }
+        }
+        for ( std::ptrdiff_t cellY = centerY - ring + 1; cellY < centerY + ring; ++cellY ) {
+
+          visitCell( centerX - ring, cellY );
+          visitCell( centerX + ring, cellY );
+        }
+
+        /* Distance to the nearest cell outside of the searched block. */
+        constexpr double unbounded = std::numeric_limits<double>::infinity();
+        double bound = unbounded;
+        if ( centerX - ring > 0 ) {
+
+          bound = std::min( bound, std::max( x - ( static_cast<double>( m_area.left ) + static_cast<double>( centerX - ring ) * m_cellWidth ), 0.0 ) );
+        }
+        if ( centerX + ring < columns - 1 ) {
+
+          bound = std::min( bound, std::max( static_cast<double>( m_area.left ) + static_cast<double>( centerX + ring + 1 ) * m_cellWidth - x, 0.0 ) );
+        }
+        if ( centerY - ring > 0 ) {
+
+          bound = std::min( bound, std::max( y - ( static_cast<double>( m_area.top ) + static_cast<double>( centerY - ring ) * m_cellHeight ), 0.0 ) );
+        }
+        if ( centerY + ring < rows - 1 ) {
+
+          bound = std::min( bound, std::max( static_cast<double>( m_area.top ) + static_cast<double>( centerY + ring + 1 ) * m_cellHeight - y, 0.0 ) );
+        }
+        if ( bound == unbounded || ( candidates.size() == _count && candidates.front().first <= bound * bound ) ) {
+
+          break;
+        }
+      }
+
+      std::sort_heap( std::begin( candidates ), std::end( candidates ), compare );
+      _result.reserve( candidates.size() );
+      for ( const auto &[ distance, id ] : candidates ) {
+
+        _result.push_back( id );
+      }
+    }
+
+  private:
+    /**
+     * @brief Return the cells covered by a box.
+     * A box with less than one pixel width or height may have its right left of its left border, so the cells are ordered.
+     * @param _box   Box.
+     * @return The left column, top row, right column and bottom row.
+     */
+    [[nodiscard]] std::array<std::size_t, 4> cells( const spatial::Box<T> &_box ) const noexcept {
+
+      const std::size_t left = column( _box.left );
+      const std::size_t right = column( _box.right );
+      const std::size_t top = row( _box.top );
+      const std::size_t bottom = row( _box.bottom );
+      return { std::min( left, right ), std::min( top, bottom ), std::max( left, right ), std::max( top, bottom ) };
+    }
+
+    /**
+     * @brief Return the column of a x coordinate.
+     * @param _x   X coordinate.
+     * @return The column - clamped to the grid.
+     */
+    [[nodiscard]] std::size_t column( T _x ) const noexcept {
+
+      const double cell = ( static_cast<double>( _x ) - m_area.left ) / m_cellWidth;
+      if ( !( cell > 0.0 ) ) {
+
+        return 0;
+      }
+      return cell < static_cast<double>( m_columns ) ? static_cast<std::size_t>( cell ) : m_columns - 1;
+    }
+
+    /**
+     * @brief Return the row of a y coordinate.
+     * @param _y   Y coordinate.
+     * @return The row - clamped to the grid.
+     */
+    [[nodiscard]] std::size_t row( T _y ) const noexcept {
+
+      const double cell = ( static_cast<double>( _y ) - m_area.top ) / m_cellHeight;
+      if ( !( cell > 0.0 ) ) {
+
+        return 0;
+      }
+      return cell < static_cast<double>( m_rows ) ? static_cast<std::size_t>( cell ) : m_rows - 1;
+    }
+
+    /**
+     * @brief Member for the area covered by the cells.
+     */
+    spatial::Box<T> m_area {};
+
+    /**
+     * @brief Member for the number of columns.
+     */
+    std::size_t m_columns = 1;
+
+    /**
+     * @brief Member for the number of rows.
+     */
+    std::size_t m_rows = 1;
+
+    /**
+     * @brief Member for the width of a cell.
+     */
+    double m_cellWidth = 1.0;
+
+    /**
+     * @brief Member for the height of a cell.
+     */
+    double m_cellHeight = 1.0;
+
+    /**
+     * @brief Member for the rects of every cell, row by row.
+     */
+    std::vector<std::vector<spatial::Entry<T>>> m_cells {};
+
+    /**
+     * @brief Member for the number of indexed rects.
+     */
+    std::size_t m_size = 0;
+  };
+}
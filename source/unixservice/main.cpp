@@ -30,146 +30,77 @@
 
 /* c header */
 #include <cstdint>
-#include <cstdlib> // std::exit, EXIT_SUCCESS, EXIT_FAILURE
+#include <cstdlib> // std::exit, std::getenv, EXIT_SUCCESS, EXIT_FAILURE
 
 /* system header */
-#include <sys/stat.h>
 #include <sys/syslog.h>
-#include <unistd.h>
 
 /* stl header */
-#include <filesystem>
-#include <fstream>
-#include <ios>
 #include <sstream>
 #include <string>
 
+/* local header */
+#include "PidFile.h"
+#include "Service.h"
+
 constexpr auto DAEMON_NAME = "Demo";
 
 /* For security purposes, we don't allow any arguments to be passed into the daemon */
 std::int32_t main() {
 
   // DAEMONIZE START
-  /* Fork the current process */
-  /* The parent process continues with a process ID greater than 0 */
-  if ( const pid_t pid = ::fork() > 0 ) {
-
-    std::exit( EXIT_SUCCESS );
-  }
-  /* A process ID lower than 0 indicates a failure in either process */
-  else if ( pid < 0 ) {
+  /* Started by a service manager (Type=notify), the service stays in the foreground. */
+  if ( std::getenv( "NOTIFY_SOCKET" ) == nullptr && !vx::service::daemonize() ) {
 
     std::exit( EXIT_FAILURE );
   }
-  /* The parent process has now terminated, and the forked child process will continue */
-  /* (the pid of the child process was 0) */
 
-  /* Since the child process is a daemon, the umask needs to be set so files and logs can be written */
-  ::umask( S_IRWXO );
-
-  /* Open system logs for the child process */
+  /* Open system logs for the daemon */
   ::openlog( DAEMON_NAME, LOG_NOWAIT | LOG_PID, LOG_USER );
   ::syslog( LOG_NOTICE, "Successfully started %s", DAEMON_NAME );
 
-  /* Generate a session ID for the child process */
-  /* Ensure a valid SID for the child process */
-  if ( ::setsid() < 0 ) {
-
-    /* Log failure and exit */
-    ::syslog( LOG_ERR, "Could not generate session ID for child process" );
-
-    /* If a new session ID could not be generated, we must terminate the child process */
-    /* or it will be orphaned */
-    std::exit( EXIT_FAILURE );
-  }
-
-  /* Change the current working directory to a directory guaranteed to exist */
-  if ( ( ::chdir( "/" ) ) < 0 ) {
-
-    /* Log failure and exit */
-    ::syslog( LOG_ERR, "Could not change working directory to /" );
-
-    /* If our guaranteed directory does not exist, terminate the child process to ensure */
-    /* the daemon has not been hijacked */
-    std::exit( EXIT_FAILURE );
-  }
-
-  /* A daemon cannot use the terminal, so close standard file descriptors for security reasons */
-  for ( auto pos = static_cast<int>( sysconf( _SC_OPEN_MAX ) ); pos >= 0; pos-- ) {
-
-    ::close( pos );
-  }
-  /* Alternative, sometimes it is needed not to close all file descriptors */
-  // ::close( STDIN_FILENO ); // NOSONAR possible alternative solution.
-  // ::close( STDOUT_FILENO ); // NOSONAR possible alternative solution.
-  // ::close( STDERR_FILENO ); // NOSONAR possible alternative solution.
-
-  /* Ensure only one copy */
+  /* Ensure only one copy - locked until the daemon exits, even after a crash */
   std::ostringstream ostream {};
   ostream << "/var/run/" << DAEMON_NAME << ".pid";
   const std::string pidfile = ostream.str();
 
-  std::ofstream file {};
-  const std::ios_base::iostate state = file.exceptions();
-  file.exceptions( std::ofstream::failbit | std::ofstream::badbit );
-  try {
+  std::int32_t result = EXIT_FAILURE;
+  {
+    const vx::service::PidFile pidFile( pidfile );
+    if ( !pidFile.isLocked() ) {
 
-    file.open( pidfile, std::ofstream::out | std::ofstream::in );
-  }
-  catch ( const std::ofstream::failure &_exception ) {
+      if ( pidFile.owner() > 0 ) {
 
-    /* Couldn't open pid lock file */
-    ::syslog( LOG_INFO, "Could not open or create PID lock file %s: %s, exiting", pidfile.c_str(), _exception.what() );
-    std::exit( EXIT_FAILURE );
-  }
-  file.exceptions( state );
+        ::syslog( LOG_INFO, "Service already running as PID %d, exiting", pidFile.owner() );
+      }
+      else {
 
-  /* Read pid from file, if there is any, find if the process is running - EXIT */
-  std::ostringstream buffer {};
-  buffer << file.rdbuf();
-  const std::string currentPid = buffer.str();
+        ::syslog( LOG_INFO, "Could not lock PID file %s, exiting", pidfile.c_str() );
+      }
+      ::closelog();
+      std::exit( EXIT_FAILURE );
+    }
+    // DAEMONIZE END
 
-  /* Get and format PID */
-  const std::string str = std::to_string( getpid() );
-  if ( !currentPid.empty() && currentPid != str ) {
+    // SERVICE START
+    /* The runtime blocks the signals, so it is created before any thread. */
+    vx::service::Runtime runtime {};
+    runtime.setReloadFunction( []() { ::syslog( LOG_NOTICE, "Reloading %s", DAEMON_NAME ); } );
+    runtime.setShutdownFunction( []() { ::syslog( LOG_NOTICE, "Shutting down %s", DAEMON_NAME ); } );
 
-    /* Couldn't open lock file */
-    ::syslog( LOG_INFO, "Service already running as PID %s, exiting", currentPid.c_str() );
-    std::exit( EXIT_FAILURE );
-  }
+    /* Daemon-specific initialization should go here, descriptors are watched by runtime.add() */
 
-  /* write pid to lockfile */
-  file << str;
-  try {
-
-    file.close();
-  }
-  catch ( const std::ofstream::failure &_exception ) {
-
-    ::syslog( LOG_INFO, "Could not close PID lock file %s, exiting with: %s", pidfile.c_str(), _exception.what() );
-    std::exit( EXIT_FAILURE );
-  }
-  // DAEMONIZE END
-
-  // SERVICE START
-  /* Daemon-specific initialization should go here */
-
-  // SERVICE END
+    /* Runs until SIGTERM or SIGINT, SIGHUP reloads */
+    result = runtime.run();
+    // SERVICE END
+  } /* Removes the PID file and releases the lock */
 
   // CLEANUP START
   /* Close system logs for the child process */
   ::syslog( LOG_NOTICE, "Stopping %s", DAEMON_NAME );
   ::closelog();
-
-  /* Remove content of file */
-  if ( std::error_code errorCode {}; !std::filesystem::remove( pidfile, errorCode ) || errorCode ) {
-
-    ::syslog( LOG_INFO, "Could not remove PID lock file %s, exiting with: %s, Code: %i", pidfile.c_str(), errorCode.message().c_str(), errorCode.value() );
-    std::exit( EXIT_FAILURE );
-  }
-
   // CLEANUP END
 
   /* Terminate the child process when the daemon completes */
-  std::exit( EXIT_SUCCESS );
+  std::exit( result );
 }
@@ -0,0 +1,293 @@
+/*
+ * Copyright (c) 2023 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* c header */
+#include <cstddef> // std::size_t
+#include <cstdint> // std::int32_t, std::int64_t, std::uint8_t, std::uint32_t
+#include <cstdio> // std::remove
+
+/* stl header */
+#include <fstream>
+#include <ios>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+/* gtest header */
+#include <gtest/gtest.h>
+
+/* modern.cpp.core */
+#include <ColumnarReader.h>
+#include <ColumnarWriter.h>
+
+using ::testing::InitGoogleTest;
+using ::testing::Test;
+
+#ifdef __clang__
+  #pragma clang diagnostic push
+  #pragma clang diagnostic ignored "-Wglobal-constructors"
+#endif
+namespace vx {
+
+  namespace {
+
+    /**
+     * @brief Read the whole file and remove it.
+     * @param _filename   Filename to read.
+     * @return The content of the file.
+     */
+    std::string dump( const std::string &_filename ) {
+
+      std::ifstream input( _filename, std::ios::in | std::ios::binary );
+      std::string result { std::istreambuf_iterator<char>( input ), std::istreambuf_iterator<char>() };
+      input.close();
+      std::remove( _filename.c_str() );
+      return result;
+    }
+
+    /**
+     * @brief Text, which fails to convert.
+     */
+    struct Failing {
+
+      /**
+       * @brief Convert into text.
+       * @return Nothing, it throws.
+       */
+      operator std::string_view() const { throw std::runtime_error( "conversion failed" ); }
+    };
+
+#ifdef _WIN32
+    /** @brief Line ending of text files. */
+    constexpr std::string_view newline = "\r\n";
+#else
+    /** @brief Line ending of text files. */
+    constexpr std::string_view newline = "\n";
+#endif
+  }
+
+  TEST( Columnar, RoundTrip ) {
+
+    using namespace std::literals;
+
+    {
+      ColumnarWriter<std::int32_t, double, std::string, bool> writer( "test.vxc", { "id", "value", "city", "valid" } );
+      writer.setBlockRows( 3 );
+      EXPECT_EQ( writer.blockRows(), 3 );
+      writer.writeRow( 1, 1.5, "Berlin"sv, true );
+      writer.writeRow( -4, 2.25, "Hamburg", false );
+      writer.writeRow( std::make_tuple( 7, -0.5, "Berlin"s, true ) );
+      writer.writeRow( 9, 8.0, "Köln"sv, false );
+      EXPECT_TRUE( writer.isOpen() );
+    }
+
+    ColumnarReader reader( "test.vxc" );
+    ASSERT_TRUE( reader.isOpen() );
+    EXPECT_TRUE( reader.hasStatistics() );
+    EXPECT_EQ( reader.columnCount(), 4 );
+    EXPECT_EQ( reader.columnType( 0 ), columnar::Type::Int32 );
+    EXPECT_EQ( reader.columnType( 1 ), columnar::Type::Double );
+    EXPECT_EQ( reader.columnType( 2 ), columnar::Type::Text );
+    EXPECT_EQ( reader.columnType( 3 ), columnar::Type::Bool );
+    EXPECT_FALSE( reader.columnType( 4 ).has_value() );
+    EXPECT_EQ( reader.columnName( 2 ), "city" );
+    EXPECT_TRUE( reader.columnName( 4 ).empty() );
+    EXPECT_EQ( reader.blockCount(), 2 );
+    EXPECT_EQ( reader.blockRows( 0 ), 3 );
+    EXPECT_EQ( reader.blockRows( 1 ), 1 );
+    EXPECT_EQ( reader.blockRows( 2 ), 0 );
+    EXPECT_EQ( reader.rowCount(), 4 );
+
+    std::vector<std::int32_t> ids {};
+    EXPECT_TRUE( reader.column( 0, 0, ids ) );
+    EXPECT_EQ( ids, ( std::vector { 1, -4, 7 } ) );
+    std::vector<double> values {};
+    EXPECT_TRUE( reader.column( 1, 1, values ) );
+    EXPECT_EQ( values, ( std::vector { 8.0 } ) );
+    std::vector<std::string_view> cities {};
+    EXPECT_TRUE( reader.column( 0, 2, cities ) );
+    EXPECT_EQ( cities, ( std::vector { "Berlin"sv, "Hamburg"sv, "Berlin"sv } ) );
+    std::vector<bool> valid {};
+    EXPECT_TRUE( reader.column( 0, 3, valid ) );
+    EXPECT_EQ( valid, ( std::vector { true, false, true } ) );
+
+    /* Wrong type or index. */
+    std::vector<std::int64_t> wrong {};
+    EXPECT_FALSE( reader.column( 0, 0, wrong ) );
+    EXPECT_FALSE( reader.column( 2, 0, ids ) );
+    EXPECT_TRUE( ids.empty() );
+
+    std::int32_t min = 0;
+    std::int32_t max = 0;
+    EXPECT_TRUE( reader.minMax( 0, 0, min, max ) );
+    EXPECT_EQ( min, -4 );
+    EXPECT_EQ( max, 7 );
+    double minValue = 0;
+    double maxValue = 0;
+    EXPECT_TRUE( reader.minMax( 0, 1, minValue, maxValue ) );
+    EXPECT_DOUBLE_EQ( minValue, -0.5 );
+    EXPECT_DOUBLE_EQ( maxValue, 2.25 );
+    std::ignore = dump( "test.vxc" );
+  }
+
+  TEST( Columnar, ToCSV ) {
+
+    using namespace std::literals;
+
+    {
+      ColumnarWriter<std::uint8_t, float, std::string_view> writer( "test_csv.vxc" );
+      writer.setStatistics( false );
+      writer.writeRow( 200, 0.1f, "Smith, John"sv );
+      writer.writeRow( 3, 2.0f, "plain"sv );
+    }
+    ColumnarReader reader( "test_csv.vxc" );
+    EXPECT_TRUE( reader.isOpen() );
+    EXPECT_FALSE( reader.hasStatistics() );
+    float min = 0;
+    float max = 0;
+    EXPECT_FALSE( reader.minMax( 0, 1, min, max ) );
+
+    EXPECT_TRUE( reader.toCSV( "test_columnar.csv", ";" ) );
+    EXPECT_EQ( dump( "test_columnar.csv" ), "200;0.1;Smith, John"s + std::string( newline ) + "3;2;plain" + std::string( newline ) );
+    std::ignore = dump( "test_csv.vxc" );
+  }
+
+  TEST( Columnar, Statistics ) {
+
+    /* The header is written with the first row, so the setting is fixed from then on. */
+    {
+      ColumnarWriter<std::int32_t, double> writer( "test_statistics.vxc" );
+      writer.setBlockRows( 2 );
+      writer.writeRow( 1, 1.5 );
+      writer.setStatistics( false );
+      EXPECT_TRUE( writer.statistics() );
+      writer.writeRow( 2, 2.5 );
+      writer.writeRow( 3, 3.5 );
+    }
+    {
+      ColumnarReader reader( "test_statistics.vxc" );
+      ASSERT_TRUE( reader.isOpen() );
+      EXPECT_TRUE( reader.hasStatistics() );
+      EXPECT_EQ( reader.blockCount(), 2 );
+      std::vector<double> values {};
+      EXPECT_TRUE( reader.column( 1, 1, values ) );
+      EXPECT_EQ( values, ( std::vector { 3.5 } ) );
+      std::int32_t min = 0;
+      std::int32_t max = 0;
+      EXPECT_TRUE( reader.minMax( 1, 0, min, max ) );
+      EXPECT_EQ( min, 3 );
+    }
+    std::ignore = dump( "test_statistics.vxc" );
+
+    {
+      ColumnarWriter<std::int32_t, double> writer( "test_statistics.vxc" );
+      writer.setStatistics( false );
+      writer.writeRow( 1, 1.5 );
+      writer.setStatistics( true );
+      EXPECT_FALSE( writer.statistics() );
+      writer.writeRow( 2, 2.5 );
+    }
+    {
+      ColumnarReader reader( "test_statistics.vxc" );
+      ASSERT_TRUE( reader.isOpen() );
+      EXPECT_FALSE( reader.hasStatistics() );
+      std::vector<std::int32_t> ids {};
+      EXPECT_TRUE( reader.column( 0, 0, ids ) );
+      EXPECT_EQ( ids, ( std::vector { 1, 2 } ) );
+    }
+    std::ignore = dump( "test_statistics.vxc" );
+  }
+
+  TEST( Columnar, FailedRow ) {
+
+    using namespace std::literals;
+
+    {
+      ColumnarWriter<std::int32_t, std::string_view, std::string_view> writer( "test_failed.vxc" );
+      writer.setBlockRows( std::numeric_limits<std::size_t>::max() );
+      EXPECT_EQ( writer.blockRows(), std::numeric_limits<std::uint32_t>::max() );
+
+      /* The first columns are appended already, when the last one fails. */
+      writer.writeRow( 1, "one"sv, "first"sv );
+      writer.writeRow( 2, "two"sv, Failing {} );
+      writer.writeRow( 3, "three"sv, "last"sv );
+    }
+    ColumnarReader reader( "test_failed.vxc" );
+    ASSERT_TRUE( reader.isOpen() );
+    EXPECT_EQ( reader.rowCount(), 2 );
+    std::vector<std::int32_t> ids {};
+    EXPECT_TRUE( reader.column( 0, 0, ids ) );
+    EXPECT_EQ( ids, ( std::vector { 1, 3 } ) );
+    std::vector<std::string_view> texts {};
+    EXPECT_TRUE( reader.column( 0, 1, texts ) );
+    EXPECT_EQ( texts, ( std::vector { "one"sv, "three"sv } ) );
+    EXPECT_TRUE( reader.column( 0, 2, texts ) );
+    EXPECT_EQ( texts, ( std::vector { "first"sv, "last"sv } ) );
+    std::ignore = dump( "test_failed.vxc" );
+  }
+
+  TEST( Columnar, Invalid ) {
+
+    const ColumnarReader missing( "missing.vxc" );
+    EXPECT_FALSE( missing.isOpen() );
+
+    {
+      ColumnarWriter<std::int64_t> writer( "test_invalid.vxc" );
+      writer.writeRow( 42 );
+    }
+
+    /* Cut off the last value. */
+    std::string content = dump( "test_invalid.vxc" );
+    content.pop_back();
+    std::ofstream output( "test_invalid.vxc", std::ios::out | std::ios::binary );
+    output << content;
+    output.close();
+
+    const ColumnarReader truncated( "test_invalid.vxc" );
+    EXPECT_FALSE( truncated.isOpen() );
+    EXPECT_EQ( truncated.columnCount(), 0 );
+    EXPECT_FALSE( truncated.toCSV( "test_invalid.csv" ) );
+    std::ignore = dump( "test_invalid.vxc" );
+  }
+}
+#ifdef __clang__
+  #pragma clang diagnostic pop
+#endif
+
+std::int32_t main( std::int32_t argc,
+                   char **argv ) {
+
+  InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
@@ -33,6 +33,7 @@
 #include <cstdio> // std::remove
 
 /* stl header */
+#include <charconv>
 #include <fstream>
 #include <ios>
 #include <iosfwd>
@@ -40,13 +41,17 @@
 #include <iterator>
 #include <string>
 #include <string_view>
+#include <thread>
+#include <tuple>
 #include <vector>
 
 /* gtest header */
 #include <gtest/gtest.h>
 
 /* modern.cpp.core */
+#include <CSVReader.h>
 #include <CSVWriter.h>
+#include <ConcurrentCSVWriter.h>
 
 using ::testing::InitGoogleTest;
 using ::testing::Test;
@@ -57,45 +62,320 @@ using ::testing::Test;
 #endif
 namespace vx {
 
+  namespace {
+
+    /**
+     * @brief Read the whole file and remove it.
+     * @param _filename   Filename to read.
+     * @return The content of the file.
+     */
+    std::string dump( const std::string &_filename ) {
+
+      std::vector<char> dump {};
+      std::ifstream input( _filename, std::ios::in | std::ios::binary );
+      if ( !input.is_open() ) {
+
+        std::cout << "Cannot open file for import." << std::endl;
+      }
+      if ( !input.eof() && !input.fail() ) {
+
+        input.seekg( 0, std::ios_base::end );
+        const std::streampos size = input.tellg();
+        dump.resize( static_cast<std::size_t>( size ) );
+
+        input.seekg( 0, std::ios_base::beg );
+        input.read( dump.data(), size );
+      }
+      try {
+
+        input.close();
+      }
+      catch ( const std::ofstream::failure &_exception ) {
+
+        std::cout << _exception.what() << std::endl;
+      }
+      std::remove( _filename.c_str() );
+
+      return { std::cbegin( dump ), std::cend( dump ) };
+    }
+
+#ifdef _WIN32
+    /** @brief Line ending of text files. */
+    constexpr std::string_view newline = "\r\n";
+#else
+    /** @brief Line ending of text files. */
+    constexpr std::string_view newline = "\n";
+#endif
+  }
+
   TEST( CSV, Simple ) {
 
     using namespace std::literals;
 
     const std::vector data = { "Hans"sv, "1.23"sv, "Manchester"sv };
-    const CSVWriter writer( "test.csv" );
+    CSVWriter writer( "test.csv" );
     writer.addRowData( std::cbegin( data ), std::cend( data ) );
+    writer.close();
 
-    std::vector<char> dump {};
-    std::ifstream input( "test.csv", std::ios::in | std::ios::binary );
-    if ( !input.is_open() ) {
+    EXPECT_EQ( dump( "test.csv" ), "Hans,1.23,Manchester"s + std::string( newline ) );
+  }
 
-      std::cout << "Cannot open file for import." << std::endl;
-    }
-    if ( !input.eof() && !input.fail() ) {
+  TEST( CSV, Buffered ) {
+
+    using namespace std::literals;
+
+    const std::vector data = { 1, 2, 3 };
+    {
+      CSVWriter writer( "test_buffered.csv", ";" );
+      EXPECT_FALSE( writer.isOpen() );
+      writer.addRowData( std::cbegin( data ), std::cend( data ) );
+      EXPECT_TRUE( writer.isOpen() );
+
+      /* Nothing is written out before the buffer is full or flushed. */
+      std::ifstream input( "test_buffered.csv", std::ios::in | std::ios::binary | std::ios::ate );
+      EXPECT_EQ( input.tellg(), 0 );
 
+      writer.flush();
       input.seekg( 0, std::ios_base::end );
-      const std::streampos size = input.tellg();
-      dump.resize( static_cast<std::size_t>( size ) );
+      EXPECT_EQ( input.tellg(), static_cast<std::streamoff>( 5 + newline.size() ) );
+      input.close();
 
-      input.seekg( 0, std::ios_base::beg );
-      input.read( dump.data(), size );
+      const std::vector<std::vector<int>> rows = { { 4, 5 }, { 6 } };
+      writer.addRows( std::cbegin( rows ), std::cend( rows ) );
     }
-    try {
+    const std::string expected = "1;2;3"s + std::string( newline ) + "4;5" + std::string( newline ) + "6" + std::string( newline );
+    EXPECT_EQ( dump( "test_buffered.csv" ), expected );
+  }
 
-      input.close();
+  TEST( CSV, Unbuffered ) {
+
+    using namespace std::literals;
+
+    const std::vector data = { "Hans"sv, "Manchester"sv };
+    CSVWriter writer( "test_unbuffered.csv" );
+    writer.setBufferSize( 0 );
+    writer.addRowData( std::cbegin( data ), std::cend( data ) );
+
+    /* Written out without flush. */
+    std::ifstream input( "test_unbuffered.csv", std::ios::in | std::ios::binary | std::ios::ate );
+    EXPECT_EQ( input.tellg(), static_cast<std::streamoff>( 15 + newline.size() ) );
+    input.close();
+    writer.close();
+
+    EXPECT_EQ( dump( "test_unbuffered.csv" ), "Hans,Manchester"s + std::string( newline ) );
+  }
+
+  TEST( CSV, WriteRow ) {
+
+    using namespace std::literals;
+
+    CSVWriter writer( "test_row.csv" );
+    writer.writeRow( "Hans"sv, 42, 1.25, true, 'x' );
+    writer.writeRow( std::make_tuple( "Smith, John"s, -7, "He said \"hi\""sv ) );
+    writer.writeRow( "two\nlines", 0.1f );
+    writer.close();
+
+    const std::string expected = "Hans,42,1.25,true,x"s + std::string( newline ) + R"("Smith, John",-7,"He said ""hi""")" + std::string( newline ) + "\"two" + std::string( newline ) + "lines\",0.1" + std::string( newline );
+    EXPECT_EQ( dump( "test_row.csv" ), expected );
+  }
+
+  TEST( CSV, Quoting ) {
+
+    using namespace std::literals;
+
+    const std::vector data = { "a;b"sv, "plain, with comma"sv, "\"quoted\""sv };
+    CSVWriter writer( "test_quoting.csv", ";" );
+    writer.addRowData( std::cbegin( data ), std::cend( data ) );
+    writer.close();
+
+    EXPECT_EQ( dump( "test_quoting.csv" ), R"("a;b";plain, with comma;"""quoted""")"s + std::string( newline ) );
+  }
+
+  TEST( CSV, Reader ) {
+
+    using namespace std::literals;
+
+    {
+      CSVWriter writer( "test_reader.csv" );
+      writer.writeRow( "Hans"sv, 42, 1.25 );
+      writer.writeRow( "Smith, John"sv, "He said \"hi\""sv, "two\nlines"sv );
+      writer.writeRow( ""sv, ""sv );
     }
-    catch ( const std::ofstream::failure &_exception ) {
+    CSVReader reader( "test_reader.csv" );
+    EXPECT_TRUE( reader.isOpen() );
 
-      std::cout << _exception.what() << std::endl;
+    std::vector<std::string_view> fields {};
+    EXPECT_TRUE( reader.readRow( fields ) );
+    EXPECT_EQ( fields, ( std::vector { "Hans"sv, "42"sv, "1.25"sv } ) );
+    EXPECT_TRUE( reader.readRow( fields ) );
+    EXPECT_EQ( fields.size(), 3 );
+    EXPECT_EQ( fields[ 0 ], "Smith, John" );
+    EXPECT_EQ( fields[ 1 ], R"(He said ""hi"")" );
+    EXPECT_EQ( CSVReader::unescape( fields[ 1 ] ), R"(He said "hi")" );
+    EXPECT_EQ( CSVReader::unescape( fields[ 2 ] ), "two"s + std::string( newline ) + "lines" );
+    EXPECT_TRUE( reader.readRow( fields ) );
+    EXPECT_EQ( fields, ( std::vector { ""sv, ""sv } ) );
+    EXPECT_FALSE( reader.readRow( fields ) );
+    EXPECT_TRUE( fields.empty() );
+
+    reader.rewind();
+    EXPECT_TRUE( reader.readRow( fields ) );
+    EXPECT_EQ( fields[ 0 ], "Hans" );
+    reader.close();
+    EXPECT_FALSE( reader.isOpen() );
+    std::ignore = dump( "test_reader.csv" );
+
+    const CSVReader missing( "missing.csv" );
+    EXPECT_FALSE( missing.isOpen() );
+  }
+
+  TEST( CSV, ParseRow ) {
+
+    using namespace std::literals;
+
+    std::string_view input = "a;\"b;c\"\r\n;\n\"x\"\"y\";z";
+    std::vector<std::string_view> fields {};
+    EXPECT_TRUE( CSVReader::parseRow( input, fields, ';' ) );
+    EXPECT_EQ( fields, ( std::vector { "a"sv, "b;c"sv } ) );
+    EXPECT_TRUE( CSVReader::parseRow( input, fields, ';' ) );
+    EXPECT_EQ( fields, ( std::vector { ""sv, ""sv } ) );
+    EXPECT_TRUE( CSVReader::parseRow( input, fields, ';' ) );
+    EXPECT_EQ( fields, ( std::vector { "x\"\"y"sv, "z"sv } ) );
+    EXPECT_FALSE( CSVReader::parseRow( input, fields, ';' ) );
+  }
+
+  TEST( CSV, ReaderChunks ) {
+
+    using namespace std::literals;
+
+    constexpr std::size_t rows = 1000;
+    {
+      CSVWriter writer( "test_chunks.csv" );
+      for ( std::size_t row = 0; row < rows; ++row ) {
+
+        writer.writeRow( row, "multi\nline"sv, "plain"sv );
+      }
     }
-    std::remove( "test.csv" );
+    const CSVReader reader( "test_chunks.csv" );
+    const std::vector chunks = reader.chunks( 4 );
+    EXPECT_EQ( chunks.size(), 4 );
 
-    std::string converted( std::cbegin( dump ), std::cend( dump ) );
-#ifdef _WIN32
-    EXPECT_EQ( converted, "Hans,1.23,Manchester\r\n" );
-#else
-    EXPECT_EQ( converted, "Hans,1.23,Manchester\n" );
-#endif
+    std::string joined {};
+    for ( const auto &chunk : chunks ) {
+
+      joined += chunk;
+    }
+    EXPECT_EQ( joined, reader.data() );
+
+    std::vector<std::size_t> counts( chunks.size() );
+    std::vector<std::thread> threads {};
+    for ( std::size_t index = 0; index < chunks.size(); ++index ) {
+
+      threads.emplace_back( [ &chunks, &counts, index ]() {
+
+        std::string_view chunk = chunks[ index ];
+        std::vector<std::string_view> fields {};
+        while ( CSVReader::parseRow( chunk, fields ) ) {
+
+          EXPECT_EQ( fields.size(), 3 );
+          EXPECT_EQ( fields[ 2 ], "plain" );
+          ++counts[ index ];
+        }
+      } );
+    }
+    std::size_t total = 0;
+    for ( std::size_t index = 0; index < threads.size(); ++index ) {
+
+      threads[ index ].join();
+      total += counts[ index ];
+    }
+    EXPECT_EQ( total, rows );
+    EXPECT_TRUE( reader.chunks( 0 ).empty() );
+    EXPECT_EQ( reader.chunks( rows * 10 ).size(), rows );
+    std::ignore = dump( "test_chunks.csv" );
+  }
+  TEST( CSV, Concurrent ) {
+
+    using namespace std::literals;
+
+    constexpr std::size_t threadCount = 8;
+    constexpr std::size_t rows = 2000;
+    {
+      ConcurrentCSVWriter writer( "test_concurrent.csv" );
+      EXPECT_TRUE( writer.isOpen() );
+      writer.setBlockSize( 256 );
+      writer.setMaxPendingBlocks( 2 );
+      std::vector<std::thread> threads {};
+      for ( std::size_t thread = 0; thread < threadCount; ++thread ) {
+
+        threads.emplace_back( [ &writer, thread ]() {
+
+          ConcurrentCSVWriter::Producer producer = writer.producer();
+          for ( std::size_t row = 0; row < rows; ++row ) {
+
+            producer.writeRow( thread, row, "text, with comma"sv );
+            EXPECT_LE( writer.pendingBlocks(), 2 );
+          }
+        } );
+      }
+      for ( auto &thread : threads ) {
+
+        thread.join();
+      }
+      writer.flush();
+      EXPECT_EQ( writer.pendingBlocks(), 0 );
+    }
+
+    CSVReader reader( "test_concurrent.csv" );
+    std::vector<std::size_t> next( threadCount );
+    std::vector<std::string_view> fields {};
+    std::size_t total = 0;
+    while ( reader.readRow( fields ) ) {
+
+      /* Every row is complete and the rows of a thread are in order. */
+      EXPECT_EQ( fields.size(), 3 );
+      std::size_t thread = 0;
+      std::size_t row = 0;
+      std::ignore = std::from_chars( fields[ 0 ].data(), fields[ 0 ].data() + fields[ 0 ].size(), thread );
+      std::ignore = std::from_chars( fields[ 1 ].data(), fields[ 1 ].data() + fields[ 1 ].size(), row );
+      EXPECT_LT( thread, threadCount );
+      EXPECT_EQ( row, next[ thread ] );
+      next[ thread ] = row + 1;
+      EXPECT_EQ( fields[ 2 ], "text, with comma" );
+      ++total;
+    }
+    EXPECT_EQ( total, threadCount * rows );
+    reader.close();
+    std::ignore = dump( "test_concurrent.csv" );
+  }
+
+  TEST( CSV, ConcurrentFlush ) {
+
+    using namespace std::literals;
+
+    ConcurrentCSVWriter writer( "test_concurrent_flush.csv", ";" );
+    {
+      ConcurrentCSVWriter::Producer producer = writer.producer();
+      producer.writeRow( 1, "a;b"sv );
+
+      /* Rows stay in the producer until they are handed off. */
+      writer.flush();
+      std::ifstream input( "test_concurrent_flush.csv", std::ios::in | std::ios::binary | std::ios::ate );
+      EXPECT_EQ( input.tellg(), 0 );
+      input.close();
+
+      producer.flush();
+      writer.flush();
+      input.open( "test_concurrent_flush.csv", std::ios::in | std::ios::binary | std::ios::ate );
+      EXPECT_EQ( input.tellg(), static_cast<std::streamoff>( 7 + newline.size() ) );
+      input.close();
+
+      const std::vector data = { 2, 3 };
+      producer.addRowData( std::cbegin( data ), std::cend( data ) );
+    }
+    writer.close();
+    EXPECT_FALSE( writer.isOpen() );
+    EXPECT_EQ( dump( "test_concurrent_flush.csv" ), "1;\"a;b\""s + std::string( newline ) + "2;3" + std::string( newline ) );
   }
 }
 #ifdef __clang__
@@ -123,6 +123,24 @@ namespace vx {
     const std::tuple<int, char, const char *> tuple2 { 1, 'a', "def" };
     EXPECT_EQ( demangle::extreme( typeid( tuple2 ).name() ), "std::tuple<int, char, const char *>" );
   }
+
+  TEST( DemangleCached, ComplexTypes ) {
+
+    EXPECT_EQ( demangle::cached( typeid( std::vector<int> ) ), "std::vector<int>" );
+    EXPECT_EQ( demangle::cached<std::vector<int>>(), "std::vector<int>" );
+    EXPECT_EQ( demangle::cached<std::set<int>>(), "std::set<int>" );
+    EXPECT_EQ( ( demangle::cached<std::tuple<int, const char *, const char *>>() ), "std::tuple<int, const char *, const char *>" );
+
+    /* Interned, the same storage is returned every time */
+    EXPECT_EQ( demangle::cached( typeid( std::list<int> ) ).data(), demangle::cached<std::list<int>>().data() );
+  }
+
+  TEST( DemangleTypeName, SimpleTypes ) {
+
+    static_assert( demangle::typeName<int>() == "int" );
+    EXPECT_EQ( demangle::typeName<int>(), "int" );
+    EXPECT_EQ( demangle::typeName<double>(), "double" );
+  }
 }
 #ifdef __clang__
   #pragma clang diagnostic pop
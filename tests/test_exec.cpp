@@ -0,0 +1,453 @@
+/*
+ * Copyright (c) 2022 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* c header */
+#include <csignal> // SIGKILL
+#include <cstddef> // std::size_t
+#include <cstdint> // std::int32_t
+
+/* system header */
+#ifndef _MSC_VER
+  #include <unistd.h> // close, pipe, read, write
+#endif
+
+/* stl header */
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+/* gtest header */
+#include <gtest/gtest.h>
+
+/* modern.cpp.core */
+#include <Exec.h>
+
+using ::testing::InitGoogleTest;
+using ::testing::Test;
+
+#ifdef __clang__
+  #pragma clang diagnostic push
+  #pragma clang diagnostic ignored "-Wglobal-constructors"
+#endif
+namespace vx {
+
+  TEST( Exec, Run ) {
+
+    exec::Result result = exec::run( "echo hello" );
+    EXPECT_EQ( result.output, "hello\n" );
+    EXPECT_EQ( result.exitCode, 0 );
+#ifndef _MSC_VER
+    EXPECT_EQ( result.signal, 0 );
+    EXPECT_GT( result.duration.count(), 0 );
+    EXPECT_GT( result.maxResidentSize, 0 );
+
+    result = exec::run( "echo mixed 1>&2; exit 3" );
+    EXPECT_EQ( result.output, "" );
+    EXPECT_EQ( result.error, "mixed\n" );
+    EXPECT_EQ( result.exitCode, 3 );
+
+    EXPECT_EQ( exec::run( "( echo mixed 1>&2 ) 2>&1" ).output, "mixed\n" );
+
+    /* Arguments are passed without a shell. */
+    result = exec::run( { "printf", "%s|", "a b", "$HOME", "*" } );
+    EXPECT_EQ( result.output, "a b|$HOME|*|" );
+    EXPECT_EQ( result.exitCode, 0 );
+
+    result = exec::run( { "sh", "-c", "kill -15 $$" } );
+    EXPECT_EQ( result.exitCode, 128 + 15 );
+    EXPECT_EQ( result.signal, 15 );
+
+    EXPECT_EQ( exec::run( std::vector<std::string> { "/nonexistent/program" } ).exitCode, -1 );
+#endif
+  }
+
+#ifndef _MSC_VER
+  TEST( Exec, Parallel ) {
+
+    /* Every call has its own result. */
+    constexpr std::int32_t threadCount = 8;
+    constexpr std::int32_t runs = 20;
+    std::vector<std::thread> threads {};
+    std::atomic<std::int32_t> mismatches = 0;
+    for ( std::int32_t thread = 0; thread < threadCount; ++thread ) {
+
+      threads.emplace_back( [ thread, &mismatches ]() {
+        for ( std::int32_t run = 0; run < runs; ++run ) {
+
+          const exec::Result result = exec::run( { "sh", "-c", "echo " + std::to_string( thread ) + "; exit " + std::to_string( thread ) } );
+          if ( result.exitCode != thread || result.output != std::to_string( thread ) + "\n" ) {
+
+            ++mismatches;
+          }
+        }
+      } );
+    }
+    for ( std::thread &thread : threads ) {
+
+      thread.join();
+    }
+    EXPECT_EQ( mismatches, 0 );
+  }
+
+  TEST( Exec, Process ) {
+
+    exec::Process process( { "sh", "-c", "echo out; echo err 1>&2; exit 5" } );
+    EXPECT_EQ( process.id(), -1 );
+    ASSERT_TRUE( process.start() );
+    EXPECT_GT( process.id(), 0 );
+    EXPECT_FALSE( process.start() );
+    EXPECT_EQ( process.wait(), 5 );
+    EXPECT_EQ( process.id(), -1 );
+    EXPECT_EQ( process.output(), "out\n" );
+    EXPECT_EQ( process.error(), "err\n" );
+    EXPECT_EQ( process.result().exitCode, 5 );
+
+    const exec::Result result = process.takeResult();
+    EXPECT_EQ( result.output, "out\n" );
+    EXPECT_GE( result.userTime.count() + result.systemTime.count(), 0 );
+
+    /* Not started */
+    EXPECT_EQ( process.wait(), -1 );
+    exec::Process missing( { "/nonexistent/program" } );
+    EXPECT_FALSE( missing.start() );
+    EXPECT_EQ( missing.wait(), -1 );
+    exec::Process empty( {} );
+    EXPECT_FALSE( empty.start() );
+
+    /* Terminated by a signal */
+    exec::Process killed( { "sh", "-c", "kill -9 $$" } );
+    ASSERT_TRUE( killed.start() );
+    EXPECT_EQ( killed.wait(), 128 + 9 );
+    EXPECT_EQ( killed.result().signal, 9 );
+  }
+
+  TEST( Exec, LargeOutput ) {
+
+    /* Both pipes get more than their capacity, which blocks a child, if only one pipe is read. */
+    constexpr std::size_t size = 3 * 1024 * 1024;
+    exec::Process process( { "sh", "-c", "head -c 3145728 /dev/zero; head -c 3145728 /dev/zero 1>&2" } );
+    ASSERT_TRUE( process.start() );
+    EXPECT_EQ( process.wait(), 0 );
+    EXPECT_EQ( process.output().size(), size );
+    EXPECT_EQ( process.error().size(), size );
+    EXPECT_EQ( process.output().find_first_not_of( '\0' ), std::string::npos );
+  }
+
+  TEST( Exec, Destructor ) {
+
+    /* The child is blocked by a full pipe, the destructor must not hang. */
+    exec::Process process( { "sh", "-c", "head -c 1048576 /dev/zero" } );
+    ASSERT_TRUE( process.start() );
+  }
+
+  TEST( Exec, Pool ) {
+
+    /* Ten commands sleeping 300 ms at once take less than the time of running them one by one. */
+    exec::Pool pool( 10 );
+    for ( std::int32_t index = 0; index < 10; ++index ) {
+
+      EXPECT_EQ( pool.add( { "sh", "-c", "sleep 0.3; echo " + std::to_string( index ) + "; exit " + std::to_string( index ) } ), static_cast<std::size_t>( index ) );
+    }
+    EXPECT_EQ( pool.add( { "/nonexistent/program" } ), 10 );
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<exec::Result> results = pool.run();
+    EXPECT_LT( std::chrono::steady_clock::now() - start, std::chrono::milliseconds( 2500 ) );
+    ASSERT_EQ( results.size(), 11 );
+    for ( std::int32_t index = 0; index < 10; ++index ) {
+
+      EXPECT_EQ( results[ static_cast<std::size_t>( index ) ].exitCode, index );
+      EXPECT_EQ( results[ static_cast<std::size_t>( index ) ].output, std::to_string( index ) + "\n" );
+      EXPECT_FALSE( results[ static_cast<std::size_t>( index ) ].timedOut );
+    }
+    EXPECT_EQ( results[ 10 ].exitCode, -1 );
+
+    /* The pool is empty after run(). */
+    EXPECT_TRUE( pool.run().empty() );
+  }
+
+  TEST( Exec, PoolStreaming ) {
+
+    exec::Pool pool( 2 );
+    std::vector<std::string> events {};
+    pool.setKeepOutput( false );
+    pool.setOutputFunction( [ &events ]( std::size_t _index, exec::Stream _stream, std::string_view _data ) {
+      events.push_back( std::to_string( _index ) + ( _stream == exec::Stream::Output ? " out " : " err " ) + std::string( _data ) );
+    } );
+    pool.setFinishFunction( [ &events, &pool ]( std::size_t _index, const exec::Result &_result ) {
+      events.push_back( std::to_string( _index ) + " exit " + std::to_string( _result.exitCode ) );
+
+      /* Commands can be added by the callbacks. */
+      if ( _index == 0 ) {
+
+        std::ignore = pool.add( { "sh", "-c", "echo next" } );
+      }
+    } );
+    std::ignore = pool.add( { "sh", "-c", "echo first; sleep 0.3; echo second 1>&2" } );
+    const std::vector<exec::Result> results = pool.run();
+    ASSERT_EQ( results.size(), 2 );
+    EXPECT_TRUE( results[ 0 ].output.empty() );
+    const std::vector<std::string> expected { "0 out first\n", "0 err second\n", "0 exit 0", "1 out next\n", "1 exit 0" };
+    EXPECT_EQ( events, expected );
+  }
+
+  TEST( Exec, PoolTimeout ) {
+
+    exec::Pool pool( 2 );
+
+    /* The child of the shell is killed too, otherwise it would keep the pipes open. */
+    std::ignore = pool.add( { "sh", "-c", "sleep 10; echo late" }, std::chrono::milliseconds( 200 ) );
+    std::ignore = pool.add( { "sh", "-c", "echo fast" }, std::chrono::milliseconds( 5000 ) );
+    const auto start = std::chrono::steady_clock::now();
+    const std::vector<exec::Result> results = pool.run();
+    EXPECT_LT( std::chrono::steady_clock::now() - start, std::chrono::milliseconds( 5000 ) );
+    ASSERT_EQ( results.size(), 2 );
+    EXPECT_TRUE( results[ 0 ].timedOut );
+    EXPECT_EQ( results[ 0 ].signal, SIGKILL );
+    EXPECT_TRUE( results[ 0 ].output.empty() );
+    EXPECT_FALSE( results[ 1 ].timedOut );
+    EXPECT_EQ( results[ 1 ].output, "fast\n" );
+  }
+
+  TEST( Exec, PoolClosedPipes ) {
+
+    /* Commands, which close stdout and stderr, but keep running, still get their timeout and do not stall the others. */
+    exec::Pool pool( 4 );
+    std::ignore = pool.add( { "sh", "-c", "exec >&- 2>&-; sleep 3" }, std::chrono::milliseconds( 200 ) );
+    std::ignore = pool.add( { "sh", "-c", "exec >&- 2>&-; sleep 0.2; exit 7" } );
+    std::ignore = pool.add( { "sh", "-c", "exec >&- 2>&-; sleep 3" } );
+    std::ignore = pool.add( { "sh", "-c", "sleep 0.4; echo fast" } );
+    std::vector<std::size_t> finished {};
+    pool.setFinishFunction( [ &pool, &finished ]( std::size_t _index, const exec::Result & ) {
+      finished.push_back( _index );
+      if ( _index == 3 ) {
+
+        pool.cancel( 2 );
+      }
+    } );
+    const auto start = std::chrono::steady_clock::now();
+    const std::vector<exec::Result> results = pool.run();
+    EXPECT_LT( std::chrono::steady_clock::now() - start, std::chrono::milliseconds( 2000 ) );
+    ASSERT_EQ( results.size(), 4 );
+    EXPECT_TRUE( results[ 0 ].timedOut );
+    EXPECT_EQ( results[ 0 ].signal, SIGKILL );
+    EXPECT_FALSE( results[ 1 ].timedOut );
+    EXPECT_EQ( results[ 1 ].exitCode, 7 );
+    EXPECT_EQ( results[ 2 ].signal, SIGKILL );
+    EXPECT_EQ( results[ 3 ].output, "fast\n" );
+    EXPECT_EQ( finished, ( std::vector<std::size_t> { 0, 1, 3, 2 } ) );
+  }
+
+  TEST( Exec, PoolThrowingCallback ) {
+
+    exec::Pool pool( 3 );
+    std::ignore = pool.add( { "sleep", "10" } );
+    std::ignore = pool.add( { "sleep", "10" }, std::chrono::milliseconds( 200 ) );
+    std::ignore = pool.add( { "sh", "-c", "echo fast" } );
+    std::ignore = pool.add( { "sleep", "10" } );
+    pool.setFinishFunction( []( std::size_t, const exec::Result & ) { throw std::runtime_error( "callback failed" ); } );
+
+    /* The running commands are killed, not waited for. */
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT_THROW( std::ignore = pool.run(), std::runtime_error );
+    EXPECT_LT( std::chrono::steady_clock::now() - start, std::chrono::milliseconds( 5000 ) );
+
+    /* Every command is removed, so nothing is run again. */
+    pool.setFinishFunction( {} );
+    EXPECT_TRUE( pool.run().empty() );
+    EXPECT_EQ( pool.add( { "sh", "-c", "echo again" } ), 0 );
+    const std::vector<exec::Result> results = pool.run();
+    ASSERT_EQ( results.size(), 1 );
+    EXPECT_EQ( results[ 0 ].output, "again\n" );
+  }
+
+  TEST( Exec, PoolCancel ) {
+
+    exec::Pool pool( 1 );
+    std::ignore = pool.add( { "sleep", "10" } );
+    std::ignore = pool.add( { "sleep", "10" } );
+    std::thread canceller( [ &pool ]() {
+      std::this_thread::sleep_for( std::chrono::milliseconds( 200 ) );
+      pool.cancel();
+    } );
+    const auto start = std::chrono::steady_clock::now();
+    const std::vector<exec::Result> results = pool.run();
+    canceller.join();
+    EXPECT_LT( std::chrono::steady_clock::now() - start, std::chrono::milliseconds( 5000 ) );
+    ASSERT_EQ( results.size(), 2 );
+    EXPECT_EQ( results[ 0 ].signal, SIGKILL );
+    EXPECT_FALSE( results[ 0 ].timedOut );
+
+    /* Not started */
+    EXPECT_EQ( results[ 1 ].exitCode, -1 );
+
+    /* Cancel a single command by a callback. */
+    std::ignore = pool.add( { "sh", "-c", "echo ready; sleep 10" } );
+    std::ignore = pool.add( { "sh", "-c", "echo other" } );
+    pool.setOutputFunction( [ &pool ]( std::size_t _index, exec::Stream, std::string_view ) {
+      if ( _index == 0 ) {
+
+        pool.cancel( 0 );
+      }
+    } );
+    const std::vector<exec::Result> cancelled = pool.run();
+    ASSERT_EQ( cancelled.size(), 2 );
+    EXPECT_EQ( cancelled[ 0 ].output, "ready\n" );
+    EXPECT_EQ( cancelled[ 0 ].signal, SIGKILL );
+    EXPECT_EQ( cancelled[ 1 ].output, "other\n" );
+  }
+
+  TEST( Exec, Pipeline ) {
+
+    exec::Pipeline pipeline {};
+    std::ignore = pipeline.add( { "printf", "b\\na\\nc\\n" } );
+    std::ignore = pipeline.add( { "sort" } );
+    std::ignore = pipeline.add( { "tr", "a-z", "A-Z" } );
+    const std::vector<exec::Result> results = pipeline.run();
+    ASSERT_EQ( results.size(), 3 );
+    EXPECT_EQ( results[ 0 ].exitCode, 0 );
+    EXPECT_EQ( results[ 1 ].exitCode, 0 );
+    EXPECT_EQ( results[ 2 ].exitCode, 0 );
+    EXPECT_EQ( results[ 2 ].output, "A\nB\nC\n" );
+
+    /* More data than a pipe holds. */
+    exec::Pipeline large {};
+    std::ignore = large.add( { "head", "-c", "3145728", "/dev/zero" } );
+    std::ignore = large.add( { "tr", "\\0", "x" } );
+    std::ignore = large.add( { "wc", "-c" } );
+    const std::vector<exec::Result> counted = large.run();
+    ASSERT_EQ( counted.size(), 3 );
+    EXPECT_EQ( std::stoul( counted[ 2 ].output ), 3145728 );
+
+    /* Stderr and exit code per stage. */
+    exec::Pipeline failing {};
+    std::ignore = failing.add( { "sh", "-c", "echo first >&2; echo data" } );
+    std::ignore = failing.add( { "sh", "-c", "cat; echo second >&2; exit 3" } );
+    const std::vector<exec::Result> failed = failing.run();
+    ASSERT_EQ( failed.size(), 2 );
+    EXPECT_EQ( failed[ 0 ].error, "first\n" );
+    EXPECT_EQ( failed[ 0 ].exitCode, 0 );
+    EXPECT_EQ( failed[ 1 ].error, "second\n" );
+    EXPECT_EQ( failed[ 1 ].output, "data\n" );
+    EXPECT_EQ( failed[ 1 ].exitCode, 3 );
+
+    /* A missing stage does not block the others. */
+    exec::Pipeline missing {};
+    std::ignore = missing.add( { "printf", "data" } );
+    std::ignore = missing.add( { "/not/existing" } );
+    std::ignore = missing.add( { "cat" } );
+    const std::vector<exec::Result> broken = missing.run();
+    ASSERT_EQ( broken.size(), 3 );
+    EXPECT_EQ( broken[ 1 ].exitCode, -1 );
+    EXPECT_EQ( broken[ 2 ].exitCode, 0 );
+    EXPECT_TRUE( broken[ 2 ].output.empty() );
+
+    EXPECT_TRUE( exec::Pipeline {}.run().empty() );
+  }
+
+  TEST( Exec, PipelineDescriptor ) {
+
+    std::array<int, 2> input { -1, -1 };
+    std::array<int, 2> output { -1, -1 };
+    ASSERT_EQ( ::pipe( input.data() ), 0 );
+    ASSERT_EQ( ::pipe( output.data() ), 0 );
+    ASSERT_EQ( ::write( input[ 1 ], "abc", 3 ), 3 );
+    ::close( input[ 1 ] );
+
+    exec::Pipeline pipeline {};
+    pipeline.setInput( input[ 0 ] );
+    pipeline.setOutput( output[ 1 ] );
+    std::ignore = pipeline.add( { "cat" } );
+    std::ignore = pipeline.add( { "tr", "a-z", "A-Z" } );
+    const std::vector<exec::Result> results = pipeline.run();
+    ::close( input[ 0 ] );
+    ::close( output[ 1 ] );
+    ASSERT_EQ( results.size(), 2 );
+    EXPECT_TRUE( results[ 1 ].output.empty() );
+    std::array<char, 16> buffer {};
+    EXPECT_EQ( ::read( output[ 0 ], buffer.data(), buffer.size() ), 3 );
+    EXPECT_EQ( std::string_view( buffer.data(), 3 ), "ABC" );
+    ::close( output[ 0 ] );
+  }
+
+  #ifdef __linux__
+  TEST( Exec, PipelineTap ) {
+
+    exec::Pipeline pipeline {};
+    std::ignore = pipeline.add( { "seq", "1", "200000" } );
+    std::ignore = pipeline.add( { "sort", "-n", "-r" } );
+    std::ignore = pipeline.add( { "head", "-n", "1" } );
+    std::string observed {};
+    std::size_t sorted = 0;
+    std::string last {};
+    pipeline.setTap( 0, [ &observed ]( std::string_view _data ) { observed.append( _data ); } );
+    pipeline.setTap( 1, [ &sorted ]( std::string_view _data ) { sorted += _data.size(); } );
+    pipeline.setTap( 2, [ &last ]( std::string_view _data ) { last.append( _data ); } );
+    const std::vector<exec::Result> results = pipeline.run();
+    ASSERT_EQ( results.size(), 3 );
+    EXPECT_EQ( results[ 2 ].output, "200000\n" );
+    EXPECT_EQ( last, results[ 2 ].output );
+    EXPECT_EQ( observed, exec::run( std::vector<std::string> { "seq", "1", "200000" } ).output );
+    EXPECT_GT( sorted, 0 );
+
+    /* Observed output to a descriptor. */
+    std::array<int, 2> output { -1, -1 };
+    ASSERT_EQ( ::pipe( output.data() ), 0 );
+    exec::Pipeline written {};
+    written.setOutput( output[ 1 ] );
+    std::ignore = written.add( { "printf", "tapped" } );
+    std::string copy {};
+    written.setTap( 0, [ &copy ]( std::string_view _data ) { copy.append( _data ); } );
+    std::ignore = written.run();
+    ::close( output[ 1 ] );
+    std::array<char, 16> buffer {};
+    EXPECT_EQ( ::read( output[ 0 ], buffer.data(), buffer.size() ), 6 );
+    EXPECT_EQ( std::string_view( buffer.data(), 6 ), "tapped" );
+    EXPECT_EQ( copy, "tapped" );
+    ::close( output[ 0 ] );
+  }
+  #endif
+#endif
+}
+#ifdef __clang__
+  #pragma clang diagnostic pop
+#endif
+
+std::int32_t main( std::int32_t argc,
+                   char **argv ) {
+
+  InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
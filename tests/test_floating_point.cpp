@@ -33,13 +33,18 @@
 #include <cstdint> // std::int32_t
 
 /* stl header */
+#include <cmath>
+#include <limits>
+#include <random>
 #include <utility> // std::pair
+#include <vector>
 
 /* gtest header */
 #include <gtest/gtest.h>
 
 /* modern.cpp.core */
 #include <FloatingPoint.h>
+#include <Simd.h>
 
 using ::testing::InitGoogleTest;
 using ::testing::Test;
@@ -50,6 +55,114 @@ using ::testing::Test;
 #endif
 namespace vx {
 
+#ifdef HAVE_SPAN
+  namespace {
+
+    using floating_point::Equal;
+
+    /**
+     * @brief Return random values with equal, nearly equal, signed zero, infinite and NaN neighbours.
+     * @tparam T   Type.
+     * @param _size   Number of values.
+     * @param _seed   Seed of the generator.
+     * @return The values.
+     */
+    template <typename T>
+    std::vector<T> random( std::size_t _size,
+                           unsigned int _seed ) {
+
+      std::mt19937 generator( _seed );
+      std::uniform_real_distribution<T> value( -4, 4 );
+      std::uniform_int_distribution<int> kind( 0, 9 );
+      std::vector<T> values {};
+      for ( std::size_t index = 0; index < _size; ++index ) {
+
+        switch ( kind( generator ) ) {
+
+          case 0:
+            values.push_back( static_cast<T>( index % 3 ) );
+            break;
+          case 1:
+            values.push_back( index % 2 == 0 ? static_cast<T>( 0.0 ) : static_cast<T>( -0.0 ) );
+            break;
+          case 2:
+            values.push_back( std::nextafter( static_cast<T>( index % 3 ), static_cast<T>( 10 ) ) );
+            break;
+          case 3:
+            values.push_back( index % 5 == 0 ? std::numeric_limits<T>::quiet_NaN() : std::numeric_limits<T>::infinity() );
+            break;
+          default:
+            values.push_back( value( generator ) );
+            break;
+        }
+      }
+      return values;
+    }
+
+    /**
+     * @brief Compare the batch functions of every instruction set with the scalar functions.
+     * @tparam Mode   Equal mode.
+     * @tparam T   Type.
+     */
+    template <Equal Mode, typename T>
+    void compare() {
+
+      /* The size is no multiple of the register lanes, so the scalar tail is used too. */
+      const std::vector<T> left = random<T>( 1001, 1 );
+      std::vector<T> right = random<T>( 1001, 2 );
+      for ( std::size_t index = 0; index < right.size(); index += 4 ) {
+
+        right[ index ] = left[ index ];
+      }
+      const auto min = static_cast<T>( -1 );
+      const auto max = static_cast<T>( 1 );
+      const Simd supported = batchSimd();
+      BitMask result {};
+      for ( const Simd simd : { Simd::Scalar, Simd::SSE2, Simd::AVX2 } ) {
+
+        setBatchSimd( simd );
+        floating_point::equal<Mode>( left, right, result );
+        for ( std::size_t index = 0; index < left.size(); ++index ) {
+
+          EXPECT_EQ( result.test( index ), floating_point::equal<Mode>( left[ index ], right[ index ] ) ) << index;
+        }
+        for ( const bool orEqual : { false, true } ) {
+
+          floating_point::less<Mode>( left, right, result, orEqual );
+          for ( std::size_t index = 0; index < left.size(); ++index ) {
+
+            EXPECT_EQ( result.test( index ), floating_point::less<Mode>( left[ index ], right[ index ], orEqual ) ) << index;
+          }
+          floating_point::greater<Mode>( left, right, result, orEqual );
+          for ( std::size_t index = 0; index < left.size(); ++index ) {
+
+            EXPECT_EQ( result.test( index ), floating_point::greater<Mode>( left[ index ], right[ index ], orEqual ) ) << index;
+          }
+          floating_point::between<Mode>( left, min, max, result, orEqual );
+          for ( std::size_t index = 0; index < left.size(); ++index ) {
+
+            EXPECT_EQ( result.test( index ), floating_point::between<Mode>( left[ index ], min, max, orEqual ) ) << index;
+          }
+        }
+      }
+      setBatchSimd( supported );
+    }
+
+    /**
+     * @brief Compare the batch functions of every mode.
+     * @tparam T   Type.
+     */
+    template <typename T>
+    void compareModes() {
+
+      compare<Equal::Absolute, T>();
+      compare<Equal::Relative, T>();
+      compare<Equal::Combined, T>();
+      compare<Equal::Ulp, T>();
+    }
+  }
+#endif
+
   TEST( FloatingPoint, Equal ) {
 
     constexpr double first = 1.23;
@@ -62,6 +175,46 @@ namespace vx {
     EXPECT_FALSE( floating_point::equal( third, fourth ) );
   }
 
+  TEST( FloatingPoint, EqualMode ) {
+
+    constexpr double first = 1000.0;
+    constexpr double second = 1000.0 + 1e-13;
+
+    static_assert( floating_point::equal<floating_point::Equal::Absolute>( 3, 3 ) );
+    static_assert( !floating_point::equal<floating_point::Equal::Relative>( 3, 4 ) );
+    EXPECT_FALSE( floating_point::equal<floating_point::Equal::Absolute>( first, second ) );
+    EXPECT_TRUE( floating_point::equal<floating_point::Equal::Relative>( first, second ) );
+    EXPECT_TRUE( floating_point::equal<floating_point::Equal::Combined>( first, second ) );
+    EXPECT_EQ( floating_point::equal( first, second, floating_point::Equal::Relative ), floating_point::equal<floating_point::Equal::Relative>( first, second ) );
+    EXPECT_TRUE( floating_point::less<floating_point::Equal::Absolute>( first, second ) );
+    EXPECT_FALSE( floating_point::less<floating_point::Equal::Relative>( first, second ) );
+    EXPECT_TRUE( floating_point::less<floating_point::Equal::Relative>( first, second, true ) );
+    EXPECT_TRUE( floating_point::between<floating_point::Equal::Absolute>( 2.0, 1.0, 3.0 ) );
+  }
+
+  TEST( FloatingPoint, Ulp ) {
+
+    constexpr double one = 1.0;
+    const double next = std::nextafter( one, 2.0 );
+
+    EXPECT_EQ( floating_point::ulps( one, next ), 1U );
+    EXPECT_EQ( floating_point::ulps( 0.0, -0.0 ), 0U );
+    EXPECT_EQ( floating_point::ulps( -std::numeric_limits<float>::denorm_min(), std::numeric_limits<float>::denorm_min() ), 2U );
+    EXPECT_TRUE( floating_point::equal<floating_point::Equal::Ulp>( one, next ) );
+    EXPECT_TRUE( floating_point::equal( 0.0F, -0.0F, floating_point::Equal::Ulp ) );
+    EXPECT_FALSE( floating_point::equal<floating_point::Equal::Ulp>( one, one + 5 * ( next - one ) ) );
+    EXPECT_FALSE( floating_point::equal<floating_point::Equal::Ulp>( std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::quiet_NaN() ) );
+    EXPECT_FALSE( floating_point::equal<floating_point::Equal::Ulp>( std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity() ) );
+  }
+
+#ifdef HAVE_SPAN
+  TEST( FloatingPoint, Batch ) {
+
+    compareModes<float>();
+    compareModes<double>();
+  }
+#endif
+
   TEST( FloatingPoint, Less ) {
 
     constexpr double first = 1.23;
@@ -120,7 +273,54 @@ namespace vx {
     EXPECT_EQ( floating_point::round( second, precisionTwo ), 2.23 );
     EXPECT_EQ( floating_point::round( third, precisionFive ), 2.23457 );
     EXPECT_EQ( floating_point::round( fourth, precisionFive ), 2.23357 );
+
+    /* Half up of the scaled value, without rounding the scaled value plus a half again. */
+    EXPECT_EQ( floating_point::round( 400.565, precisionTwo ), 400.57 );
+    EXPECT_EQ( floating_point::round( -2.5, 0 ), -2.0 );
+    EXPECT_EQ( floating_point::round( 0.49999999999999994, 0 ), 0.0 );
+    EXPECT_EQ( floating_point::round( 4503599627370495.5, 0 ), 4503599627370496.0 );
+    EXPECT_EQ( floating_point::round( 1.5F, 0 ), 2.0F );
+    EXPECT_EQ( floating_point::round( 2.345L, precisionTwo ), 2.35L );
+    EXPECT_EQ( floating_point::round( 7, precisionTwo ), 7 );
+    EXPECT_EQ( floating_point::round( 1e300, precisionFive ), 1e300 );
+    EXPECT_EQ( floating_point::round( 1.25, 30 ), 1.25 );
+    EXPECT_EQ( floating_point::round( std::numeric_limits<double>::infinity(), precisionTwo ), std::numeric_limits<double>::infinity() );
+    EXPECT_TRUE( std::isnan( floating_point::round( std::numeric_limits<double>::quiet_NaN(), precisionTwo ) ) );
+
+    static_assert( floating_point::powerOfTen( 22 ) == 1e22 );
+    static_assert( floating_point::round( first, precisionTwo ) == 1.23 );
+    static_assert( floating_point::round( second, precisionFive ) == 2.23457 );
+  }
+
+#ifdef HAVE_SPAN
+  TEST( FloatingPoint, RoundBatch ) {
+
+    /* The size is no multiple of the register lanes, so the scalar tail is used too. */
+    std::vector<double> values = random<double>( 1001, 3 );
+    for ( std::size_t index = 0; index < values.size(); index += 7 ) {
+
+      values[ index ] = ( index % 2 == 0 ? 1 : -1 ) * ( static_cast<double>( index ) + 0.5 ) / 100;
+    }
+    values[ 1 ] = 0.49999999999999994;
+    values[ 2 ] = 1e300;
+    const Simd supported = batchSimd();
+    for ( const std::size_t precision : { 0, 2, 5, 22, 30 } ) {
+
+      for ( const Simd simd : { Simd::Scalar, Simd::SSE2, Simd::AVX2 } ) {
+
+        setBatchSimd( simd );
+        std::vector<double> rounded = values;
+        floating_point::round( rounded, precision );
+        for ( std::size_t index = 0; index < values.size(); ++index ) {
+
+          const double expected = floating_point::round( values[ index ], precision );
+          EXPECT_TRUE( std::isnan( expected ) ? std::isnan( rounded[ index ] ) : rounded[ index ] == expected ) << index;
+        }
+      }
+    }
+    setBatchSimd( supported );
   }
+#endif
 
   TEST( FloatingPoint, Split ) {
 
@@ -144,6 +344,23 @@ namespace vx {
     separated = floating_point::split(fourth );
     EXPECT_EQ( separated.first, 2.0 );
     EXPECT_TRUE( floating_point::equal( separated.second, 0.2335678 ) );
+
+    separated = floating_point::split( -2.75 );
+    EXPECT_EQ( separated.first, -2.0 );
+    EXPECT_EQ( separated.second, -0.75 );
+
+    separated = floating_point::split( -0.5 );
+    EXPECT_EQ( separated.first, 0.0 );
+    EXPECT_EQ( separated.second, -0.5 );
+
+    separated = floating_point::split( std::numeric_limits<double>::infinity() );
+    EXPECT_EQ( separated.first, std::numeric_limits<double>::infinity() );
+    EXPECT_EQ( separated.second, 0.0 );
+    EXPECT_TRUE( std::isnan( floating_point::split( std::numeric_limits<double>::quiet_NaN() ).second ) );
+
+    static_assert( floating_point::split( 3.5 ) == std::make_pair( 3.0, 0.5 ) );
+    static_assert( floating_point::split( 1.5F ) == std::make_pair( 1.0F, 0.5F ) );
+    static_assert( floating_point::split( 9 ) == std::make_pair( 9, 0 ) );
   }
 }
 #ifdef __clang__
@@ -0,0 +1,269 @@
+/*
+ * Copyright (c) 2022 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* c header */
+#include <cstddef> // std::byte, std::size_t
+#include <cstdint> // std::int32_t
+#include <cstdlib> // posix_openpt, grantpt, unlockpt, ptsname
+
+/* system header */
+#ifndef _WIN32
+  #include <fcntl.h> // O_RDWR, O_NOCTTY
+  #include <unistd.h> // close, write
+#endif
+
+/* stl header */
+#include <array>
+#include <chrono>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/* gtest header */
+#include <gtest/gtest.h>
+
+/* modern.cpp.core */
+#include <Framer.h>
+#ifndef _WIN32
+  #include <Serial.h>
+#endif
+
+using ::testing::InitGoogleTest;
+using ::testing::Test;
+
+#ifdef __clang__
+  #pragma clang diagnostic push
+  #pragma clang diagnostic ignored "-Wglobal-constructors"
+#endif
+namespace vx {
+
+  namespace {
+
+    /**
+     * @brief Encode payloads, push the stream in chunks of a size and return the received payloads.
+     */
+    std::vector<std::string> roundTrip( framer::Framer &_framer,
+                                        const std::vector<std::string> &_payloads,
+                                        std::size_t _chunk ) {
+
+      std::string stream {};
+      for ( const std::string &payload : _payloads ) {
+
+        EXPECT_TRUE( _framer.encode( payload, stream ) );
+      }
+      std::vector<std::string> received {};
+      for ( std::size_t offset = 0; offset < stream.size(); offset += _chunk ) {
+
+        /* The chunk is reused like a read buffer. */
+        std::string chunk( std::string_view( stream ).substr( offset, _chunk ) );
+        _framer.push( chunk );
+        _framer.drain( [ &received ]( std::string_view _frame ) { received.emplace_back( _frame ); } );
+        chunk.assign( chunk.size(), 'X' );
+      }
+      return received;
+    }
+
+    /** @brief Payloads with every special byte. */
+    const std::vector<std::string> payloads { "hello", std::string( "\0\xC0\xDB\xDC\xDD\n", 6 ), "", std::string( 300, 'a' ), std::string( 254, 'b' ), std::string( "a\0", 2 ) };
+  }
+
+  TEST( Framer, Crc ) {
+
+    EXPECT_EQ( framer::crc16( "123456789" ), 0x29B1 );
+    EXPECT_EQ( framer::crc32( "123456789" ), 0xCBF43926 );
+    EXPECT_EQ( framer::crc16( "" ), 0xFFFF );
+    EXPECT_EQ( framer::crc32( "" ), 0 );
+  }
+
+  TEST( Framer, Delimiter ) {
+
+    framer::Delimiter lines( "\r\n" );
+    lines.push( "one\r\ntwo\r" );
+    EXPECT_EQ( lines.next(), "one" );
+    EXPECT_EQ( lines.next(), std::nullopt );
+    EXPECT_EQ( lines.buffered(), 4 );
+    lines.push( "\n\r\nthree" );
+    EXPECT_EQ( lines.next(), "two" );
+    EXPECT_EQ( lines.next(), "" );
+    EXPECT_EQ( lines.next(), std::nullopt );
+    lines.push( "\r\n" );
+    EXPECT_EQ( lines.next(), "three" );
+    EXPECT_EQ( lines.buffered(), 0 );
+
+    std::string frame {};
+    EXPECT_FALSE( lines.encode( "a\r\nb", frame ) );
+
+    /* Byte by byte with checksum */
+    framer::Delimiter checked( "|" );
+    checked.setChecksum( framer::Checksum::Crc16 );
+    EXPECT_EQ( roundTrip( checked, { "first", "second" }, 1 ), ( std::vector<std::string> { "first", "second" } ) );
+
+    /* Oversized frames are dropped up to the next delimiter. */
+    framer::Delimiter limited {};
+    limited.setMaxFrameSize( 8 );
+    limited.push( "0123456789" );
+    EXPECT_EQ( limited.next(), std::nullopt );
+    limited.push( "abc\nok\n" );
+    EXPECT_EQ( limited.next(), "ok" );
+    EXPECT_EQ( limited.errors(), 1 );
+  }
+
+  TEST( Framer, LengthPrefix ) {
+
+    for ( const std::size_t prefix : { 1, 2, 4 } ) {
+
+      framer::LengthPrefix length( prefix );
+      std::vector<std::string> expected = payloads;
+      if ( prefix == 1 ) {
+
+        expected.erase( expected.begin() + 3 );
+      }
+      for ( const std::size_t chunk : { 1, 3, 1024 } ) {
+
+        EXPECT_EQ( roundTrip( length, expected, chunk ), expected );
+      }
+    }
+    framer::LengthPrefix small( 1 );
+    std::string frame {};
+    EXPECT_FALSE( small.encode( std::string( 256, 'x' ), frame ) );
+
+    framer::LengthPrefix checked( 2 );
+    checked.setChecksum( framer::Checksum::Crc32 );
+    EXPECT_TRUE( checked.encode( "data", frame ) );
+    EXPECT_EQ( frame.size(), 2 + 4 + 4 );
+    frame[ 3 ] = 'X';
+    checked.push( frame );
+    EXPECT_EQ( checked.next(), std::nullopt );
+    EXPECT_EQ( checked.errors(), 1 );
+  }
+
+  TEST( Framer, Slip ) {
+
+    framer::Slip slip {};
+    for ( const std::size_t chunk : { 1, 7, 1024 } ) {
+
+      std::vector<std::string> expected = payloads;
+      expected.erase( expected.begin() + 2 );
+      EXPECT_EQ( roundTrip( slip, payloads, chunk ), expected );
+    }
+    std::string frame {};
+    EXPECT_TRUE( slip.encode( std::string( "\xC0\xDB", 2 ), frame ) );
+    EXPECT_EQ( frame, std::string( "\xC0\xDB\xDC\xDB\xDD\xC0", 6 ) );
+
+    /* Invalid escape */
+    const std::string invalid( "\xC0\x61\xDB\x61\xC0\x62\xC0", 7 );
+    slip.push( invalid );
+    EXPECT_EQ( slip.next(), "b" );
+    EXPECT_EQ( slip.errors(), 1 );
+  }
+
+  TEST( Framer, Cobs ) {
+
+    framer::Cobs cobs {};
+    cobs.setChecksum( framer::Checksum::Crc16 );
+    for ( const std::size_t chunk : { 1, 5, 1024 } ) {
+
+      EXPECT_EQ( roundTrip( cobs, payloads, chunk ), payloads );
+    }
+
+    framer::Cobs plain {};
+    std::string frame {};
+    EXPECT_TRUE( plain.encode( std::string( "\x11\x22\x00\x33", 4 ), frame ) );
+    EXPECT_EQ( frame, std::string( "\x03\x11\x22\x02\x33\x00", 6 ) );
+    frame.clear();
+    EXPECT_TRUE( plain.encode( std::string( "\x00", 1 ), frame ) );
+    EXPECT_EQ( frame, std::string( "\x01\x01\x00", 3 ) );
+
+    /* Code beyond the frame */
+    const std::string invalid( "\x05\x01\x00\x02\x61\x00", 6 );
+    plain.push( invalid );
+    EXPECT_EQ( plain.next(), "a" );
+    EXPECT_EQ( plain.errors(), 1 );
+
+    /* Corrupted data fails the checksum. */
+    frame.clear();
+    EXPECT_TRUE( cobs.encode( "payload", frame ) );
+    frame[ 2 ] = 'X';
+    cobs.push( frame );
+    EXPECT_EQ( cobs.next(), std::nullopt );
+    EXPECT_GE( cobs.errors(), 1 );
+    cobs.reset();
+    EXPECT_EQ( cobs.errors(), 0 );
+  }
+
+#ifndef _WIN32
+  TEST( Framer, Serial ) {
+
+    const std::int32_t master = ::posix_openpt( O_RDWR | O_NOCTTY );
+    ASSERT_GE( master, 0 );
+    ASSERT_EQ( ::grantpt( master ), 0 );
+    ASSERT_EQ( ::unlockpt( master ), 0 );
+    const Serial serial( ::ptsname( master ) );
+    ASSERT_TRUE( serial.isOpen() );
+
+    framer::Slip slip {};
+    slip.setChecksum( framer::Checksum::Crc32 );
+    /* The checksums contain flow control bytes like XOFF, which the line must pass. */
+    std::string stream {};
+    for ( std::size_t index = 0; index < 100; ++index ) {
+
+      EXPECT_TRUE( slip.encode( "frame " + std::to_string( index ), stream ) );
+    }
+    ASSERT_EQ( ::write( master, stream.data(), stream.size() ), static_cast<ssize_t>( stream.size() ) );
+
+    std::array<std::byte, 64> buffer {};
+    std::vector<std::string> received {};
+    while ( received.size() < 100 && serial.waitReadable( std::chrono::seconds( 5 ) ) ) {
+
+      const std::size_t size = serial.read( buffer.data(), buffer.size() );
+      slip.push( std::string_view( reinterpret_cast<const char *>( buffer.data() ), size ) );
+      slip.drain( [ &received ]( std::string_view _frame ) { received.emplace_back( _frame ); } );
+    }
+    ASSERT_EQ( received.size(), 100 );
+    for ( std::size_t index = 0; index < received.size(); ++index ) {
+
+      EXPECT_EQ( received[ index ], "frame " + std::to_string( index ) );
+    }
+    EXPECT_EQ( slip.errors(), 0 );
+    ::close( master );
+  }
+#endif
+}
+#ifdef __clang__
+  #pragma clang diagnostic pop
+#endif
+
+std::int32_t main( std::int32_t argc,
+                   char **argv ) {
+
+  InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
@@ -29,6 +29,7 @@
  */
 
 /* c header */
+#include <cmath>   // std::sqrt
 #include <cstdint> // std::int32_t
 
 /* stl header */
@@ -41,6 +42,7 @@
 #include <FloatingPoint.h>
 #include <Line.h>
 #include <Point.h>
+#include <Rect.h>
 
 using ::testing::InitGoogleTest;
 using ::testing::Test;
@@ -245,6 +247,125 @@ namespace vx {
     EXPECT_EQ( line.x2(), 5.5 );
     EXPECT_EQ( line.y2(), 5.5 );
   }
+
+  TEST( Line, Length ) {
+
+    EXPECT_EQ( Line( 0, 0, 3, 4 ).length(), 5.0 );
+    EXPECT_EQ( Line( 1.5, 1.5, 1.5, 1.5 ).length(), 0.0 );
+    EXPECT_EQ( Line( -1.0F, 2.0F, -1.0F, -6.0F ).length(), 8.0 );
+  }
+
+  TEST( Line, Distance ) {
+
+    const Line line( 0, 0, 10, 0 );
+    EXPECT_EQ( line.distance( Point( 5, 3 ) ), 3.0 );
+    EXPECT_EQ( line.distance( Point( 5, 0 ) ), 0.0 );
+    EXPECT_EQ( line.distance( Point( -3, 4 ) ), 5.0 );
+    EXPECT_EQ( line.distance( Point( 13, -4 ) ), 5.0 );
+    EXPECT_EQ( line.squaredDistance( Point( 13, -4 ) ), 25.0 );
+
+    /* A null line is its point. */
+    EXPECT_EQ( Line( 1.0, 1.0, 1.0, 1.0 ).distance( Point( 4.0, 5.0 ) ), 5.0 );
+    EXPECT_TRUE( floating_point::equal( Line( 0.0, 0.0, 2.0, 2.0 ).distance( Point( 0.0, 2.0 ) ), std::sqrt( 2.0 ) ) );
+  }
+
+  TEST( Line, Intersects ) {
+
+    const Line line( 0, 0, 10, 10 );
+
+    /* Crossing */
+    EXPECT_TRUE( line.intersects( Line( 0, 10, 10, 0 ) ) );
+
+    /* Touching with an end point */
+    EXPECT_TRUE( line.intersects( Line( 5, 5, 10, 0 ) ) );
+    EXPECT_TRUE( line.intersects( Line( 10, 10, 12, 0 ) ) );
+
+    /* Missing */
+    EXPECT_FALSE( line.intersects( Line( 6, 5, 10, 0 ) ) );
+    EXPECT_FALSE( line.intersects( Line( 0, 1, 10, 11 ) ) );
+
+    /* Collinear */
+    EXPECT_TRUE( line.intersects( Line( 5, 5, 15, 15 ) ) );
+    EXPECT_TRUE( line.intersects( Line( 10, 10, 15, 15 ) ) );
+    EXPECT_FALSE( line.intersects( Line( 11, 11, 15, 15 ) ) );
+
+    /* Null lines */
+    EXPECT_TRUE( line.intersects( Line( 3, 3, 3, 3 ) ) );
+    EXPECT_FALSE( line.intersects( Line( 3, 4, 3, 4 ) ) );
+    EXPECT_TRUE( Line( 3, 3, 3, 3 ).intersects( line ) );
+    EXPECT_FALSE( Line( 11, 11, 11, 11 ).intersects( line ) );
+
+    EXPECT_TRUE( Line( 0.5F, 0.0F, 0.5F, 1.0F ).intersects( Line( 0.0F, 0.5F, 1.0F, 0.5F ) ) );
+  }
+
+  TEST( Line, Intersection ) {
+
+    const Line line( 0, 0, 10, 10 );
+    Line<double> result {};
+
+    EXPECT_EQ( line.intersection( Line( 0, 10, 10, 0 ), result ), LineIntersection::Point );
+    EXPECT_EQ( result.point1(), Point( 5.0, 5.0 ) );
+    EXPECT_EQ( result.point2(), Point( 5.0, 5.0 ) );
+
+    EXPECT_EQ( line.intersection( Line( 0, 10, 4, 10 ), result ), LineIntersection::None );
+    EXPECT_EQ( result.point1(), Point( 5.0, 5.0 ) );
+
+    EXPECT_EQ( line.intersection( Line( 15, 15, 5, 5 ), result ), LineIntersection::Overlap );
+    EXPECT_EQ( result.point1(), Point( 5.0, 5.0 ) );
+    EXPECT_EQ( result.point2(), Point( 10.0, 10.0 ) );
+
+    EXPECT_EQ( line.intersection( Line( 10, 10, 15, 15 ), result ), LineIntersection::Point );
+    EXPECT_EQ( result.point1(), Point( 10.0, 10.0 ) );
+
+    EXPECT_EQ( line.intersection( Line( 2, 2, 2, 2 ), result ), LineIntersection::Point );
+    EXPECT_EQ( result.point1(), Point( 2.0, 2.0 ) );
+
+    EXPECT_EQ( Line( 2, 2, 2, 2 ).intersection( line, result ), LineIntersection::Point );
+    EXPECT_EQ( result.point1(), Point( 2.0, 2.0 ) );
+
+    EXPECT_EQ( Line( 0.0, 0.0, 4.0, 0.0 ).intersection( Line( 1.0, -1.0, 1.0, 3.0 ), result ), LineIntersection::Point );
+    EXPECT_EQ( result.point1(), Point( 1.0, 0.0 ) );
+  }
+
+  TEST( Line, Clip ) {
+
+    const Rect rectangle( Point( 0, 0 ), Point( 10, 10 ) );
+    Line<double> result {};
+
+    EXPECT_TRUE( Line( -5, 5, 15, 5 ).clip( rectangle, result ) );
+    EXPECT_EQ( result.point1(), Point( 0.0, 5.0 ) );
+    EXPECT_EQ( result.point2(), Point( 10.0, 5.0 ) );
+
+    EXPECT_TRUE( Line( -5, -5, 5, 5 ).clip( rectangle, result ) );
+    EXPECT_EQ( result.point1(), Point( 0.0, 0.0 ) );
+    EXPECT_EQ( result.point2(), Point( 5.0, 5.0 ) );
+
+    /* Inside */
+    EXPECT_TRUE( Line( 2, 3, 4, 5 ).clip( rectangle, result ) );
+    EXPECT_EQ( result.point1(), Point( 2.0, 3.0 ) );
+    EXPECT_EQ( result.point2(), Point( 4.0, 5.0 ) );
+
+    /* Touching the corner */
+    EXPECT_TRUE( Line( 10, 12, 12, 10 ).clip( Rect( Point( 0, 0 ), Point( 11, 11 ) ), result ) );
+    EXPECT_EQ( result.point1(), Point( 11.0, 11.0 ) );
+
+    /* Outside and parallel outside */
+    EXPECT_FALSE( Line( -5, 12, 15, 30 ).clip( rectangle, result ) );
+    EXPECT_FALSE( Line( 11, -5, 11, 15 ).clip( rectangle, result ) );
+    EXPECT_FALSE( Line( 2, 3, 4, 5 ).clip( Rect( Point( 0, 0 ), Point( -1, -1 ) ), result ) );
+
+    /* Zero width or height, the rect contains no point - neither crossing nor parallel lines */
+    EXPECT_FALSE( Line( 0, 2, 4, 2 ).clip( Rect( Point( 2, 0 ), Point( 1, 5 ) ), result ) );
+    EXPECT_FALSE( Line( 4, 2, 0, 2 ).clip( Rect( Point( 2, 0 ), Point( 1, 5 ) ), result ) );
+    EXPECT_FALSE( Line( 2, -1, 2, 6 ).clip( Rect( Point( 2, 0 ), Point( 1, 5 ) ), result ) );
+    EXPECT_FALSE( Line( 2, 0, 2, 4 ).clip( Rect( Point( 0, 2 ), Point( 5, 1 ) ), result ) );
+    EXPECT_FALSE( Line( -1, 2, 6, 2 ).clip( Rect( Point( 0, 2 ), Point( 5, 1 ) ), result ) );
+
+    /* Flipped rect */
+    EXPECT_TRUE( Line( 5.0, -5.0, 5.0, 15.0 ).clip( Rect( Point( 10.0, 10.0 ), Point( 0.0, 0.0 ) ), result ) );
+    EXPECT_EQ( result.point1(), Point( 5.0, 0.0 ) );
+    EXPECT_EQ( result.point2(), Point( 5.0, 10.0 ) );
+  }
 }
 #ifdef __clang__
   #pragma clang diagnostic pop
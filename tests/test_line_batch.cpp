@@ -0,0 +1,214 @@
+/*
+ * Copyright (c) 2022 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* c header */
+#include <cstddef> // std::size_t
+#include <cstdint> // std::int32_t, std::uintptr_t
+
+/* stl header */
+#include <algorithm>
+#include <random>
+#include <utility> // std::pair
+#include <vector>
+
+/* gtest header */
+#include <gtest/gtest.h>
+
+/* modern.cpp.core */
+#include <LineBatch.h>
+
+using ::testing::InitGoogleTest;
+using ::testing::Test;
+
+#ifdef __clang__
+  #pragma clang diagnostic push
+  #pragma clang diagnostic ignored "-Wglobal-constructors"
+#endif
+namespace vx {
+
+  namespace {
+
+    /**
+     * @brief Return random lines with null, horizontal, vertical and collinear lines.
+     * @tparam T   Type.
+     * @param _size   Number of lines.
+     * @return The lines.
+     */
+    template <typename T>
+    LineBatch<T> random( std::size_t _size ) {
+
+      std::mt19937 generator( 7 );
+      std::uniform_int_distribution<std::int32_t> coordinate( -50, 50 );
+      std::uniform_int_distribution<std::int32_t> kind( 0, 9 );
+      LineBatch<T> batch {};
+      batch.reserve( _size );
+      for ( std::size_t index = 0; index < _size; ++index ) {
+
+        const auto x = static_cast<T>( coordinate( generator ) );
+        const auto y = static_cast<T>( coordinate( generator ) );
+        const auto length = static_cast<T>( coordinate( generator ) / 3 );
+        switch ( kind( generator ) ) {
+
+          case 0:
+            batch.push_back( Line<T>( x, y, x, y ) );
+            break;
+          case 1:
+            batch.push_back( Line<T>( x, y, x + length, y ) );
+            break;
+          case 2:
+            batch.push_back( Line<T>( x, y, x, y + length ) );
+            break;
+          case 3:
+            batch.push_back( Line<T>( x, x, x + length, x + length ) );
+            break;
+          default:
+            batch.push_back( Line<T>( x, y, x + length, y - static_cast<T>( coordinate( generator ) / 3 ) ) );
+            break;
+        }
+      }
+      return batch;
+    }
+
+    /**
+     * @brief Compare the batch functions with the scalar functions of Line<T>.
+     * @tparam T   Type.
+     */
+    template <typename T>
+    void compare() {
+
+      /* The size is no multiple of a word, so the tail is checked too. */
+      const LineBatch<T> batch = random<T>( 1003 );
+      BitMask result {};
+      for ( const Line<T> &line : { Line<T>( -20, -20, 20, 20 ), Line<T>( 0, -50, 0, 50 ), Line<T>( 3, 3, 3, 3 ) } ) {
+
+        batch.intersects( line, result );
+        for ( std::size_t index = 0; index < batch.size(); ++index ) {
+
+          EXPECT_EQ( result.test( index ), batch[ index ].intersects( line ) ) << index;
+        }
+      }
+      for ( const Rect<T> &rectangle : { Rect<T>( Point<T>( -10, -10 ), Point<T>( 10, 10 ) ), Rect<T>( Point<T>( 30, 5 ), Point<T>( 0, -5 ) ), Rect<T>( Point<T>( 0, 0 ), Point<T>( -1, -1 ) ), Rect<T>( Point<T>( 2, -10 ), Point<T>( 1, 10 ) ), Rect<T>( Point<T>( -10, 2 ), Point<T>( 10, 1 ) ) } ) {
+
+        batch.intersects( rectangle, result );
+        for ( std::size_t index = 0; index < batch.size(); ++index ) {
+
+          Line<double> clipped {};
+          EXPECT_EQ( result.test( index ), batch[ index ].clip( rectangle, clipped ) ) << index;
+        }
+      }
+
+      /* Zero width, no line has a part inside. */
+      batch.intersects( Rect<T>( Point<T>( 2, -10 ), Point<T>( 1, 10 ) ), result );
+      EXPECT_EQ( result.count(), 0 );
+      std::vector<double> distances {};
+      batch.distance( Point<T>( 7, -3 ), distances );
+      ASSERT_EQ( distances.size(), batch.size() );
+      for ( std::size_t index = 0; index < batch.size(); ++index ) {
+
+        EXPECT_EQ( distances[ index ], batch[ index ].distance( Point<T>( 7, -3 ) ) ) << index;
+      }
+
+      std::vector<std::pair<std::size_t, std::size_t>> pairs {};
+      batch.intersections( pairs );
+      std::vector<std::pair<std::size_t, std::size_t>> expected {};
+      for ( std::size_t first = 0; first < batch.size(); ++first ) {
+
+        for ( std::size_t second = first + 1; second < batch.size(); ++second ) {
+
+          if ( batch[ first ].intersects( batch[ second ] ) ) {
+
+            expected.emplace_back( first, second );
+          }
+        }
+      }
+      std::sort( std::begin( pairs ), std::end( pairs ) );
+      EXPECT_FALSE( expected.empty() );
+      EXPECT_EQ( pairs, expected );
+    }
+  }
+
+  TEST( LineBatch, Simple ) {
+
+    LineBatch<std::int32_t> batch {};
+    EXPECT_TRUE( batch.empty() );
+
+    batch.reserve( 3 );
+    batch.push_back( Line( 0, 0, 10, 10 ) );
+    batch.push_back( Line( 0, 10, 10, 0 ) );
+    batch.push_back( Line( 20, 0, 30, 0 ) );
+    EXPECT_EQ( batch.size(), 3 );
+    EXPECT_EQ( reinterpret_cast<std::uintptr_t>( batch.x1s() ) % defaultAlignment, 0 );
+    EXPECT_EQ( reinterpret_cast<std::uintptr_t>( batch.y2s() ) % defaultAlignment, 0 );
+    EXPECT_EQ( batch[ 1 ].point1(), Point( 0, 10 ) );
+    EXPECT_EQ( batch[ 1 ].point2(), Point( 10, 0 ) );
+
+    BitMask result {};
+    batch.intersects( Line( 5, -5, 5, 5 ), result );
+    EXPECT_EQ( result.count(), 2 );
+    EXPECT_TRUE( result.test( 0 ) );
+    EXPECT_TRUE( result.test( 1 ) );
+
+    batch.intersects( Rect( Point( 25, -1 ), Point( 40, 1 ) ), result );
+    EXPECT_EQ( result.count(), 1 );
+    EXPECT_TRUE( result.test( 2 ) );
+
+    std::vector<double> distances {};
+    batch.distance( Point( 25, 4 ), distances );
+    EXPECT_EQ( distances[ 2 ], 4.0 );
+
+    std::vector<std::pair<std::size_t, std::size_t>> pairs {};
+    batch.intersections( pairs );
+    ASSERT_EQ( pairs.size(), 1 );
+    EXPECT_EQ( pairs[ 0 ], std::make_pair( std::size_t { 0 }, std::size_t { 1 } ) );
+
+    batch.translate( { -20, 1 } );
+    EXPECT_EQ( batch[ 2 ].point1(), Point( 0, 1 ) );
+
+    batch.clear();
+    EXPECT_TRUE( batch.empty() );
+  }
+
+  TEST( LineBatch, Scalar ) {
+
+    compare<std::int32_t>();
+    compare<float>();
+    compare<double>();
+  }
+}
+#ifdef __clang__
+  #pragma clang diagnostic pop
+#endif
+
+std::int32_t main( std::int32_t argc,
+                   char **argv ) {
+
+  InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
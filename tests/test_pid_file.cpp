@@ -0,0 +1,260 @@
+/*
+ * Copyright (c) 2022 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* c header */
+#include <csignal> // SIGKILL
+#include <cstddef> // std::size_t
+#include <cstdint> // std::int32_t
+
+/* system header */
+#include <sys/wait.h> // waitpid
+#include <unistd.h>
+
+/* stl header */
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+/* gtest header */
+#include <gtest/gtest.h>
+
+/* modern.cpp.core */
+#include <PidFile.h>
+
+using ::testing::InitGoogleTest;
+using ::testing::Test;
+
+#ifdef __clang__
+  #pragma clang diagnostic push
+  #pragma clang diagnostic ignored "-Wglobal-constructors"
+#endif
+namespace vx {
+
+  namespace {
+
+    /**
+     * @brief Path of a PID file in the temporary directory.
+     */
+    std::string pidPath() {
+
+      return ( std::filesystem::temp_directory_path() / ( "test_pid_file_" + std::to_string( ::getpid() ) + ".pid" ) ).string();
+    }
+
+    /**
+     * @brief Content of a file.
+     */
+    std::string content( const std::string &_path ) {
+
+      std::ifstream file( _path );
+      std::string result {};
+      std::getline( file, result );
+      return result;
+    }
+
+    /**
+     * @brief Write a PID file like a process without lock.
+     */
+    void writeUnlocked( const std::string &_path,
+                        pid_t _pid ) {
+
+      std::ofstream file( _path, std::ofstream::trunc );
+      file << _pid << '\n';
+    }
+
+    /**
+     * @brief Fork a child, which runs until it is killed.
+     */
+    pid_t forkSleeping() {
+
+      const pid_t child = ::fork();
+      if ( child == 0 ) {
+
+        while ( true ) {
+
+          ::pause();
+        }
+      }
+      return child;
+    }
+
+    /**
+     * @brief Kill and reap a child.
+     */
+    void reap( pid_t _child ) {
+
+      ::kill( _child, SIGKILL );
+      std::int32_t status = 0;
+      ::waitpid( _child, &status, 0 );
+    }
+  }
+
+  TEST( PidFile, Lock ) {
+
+    const std::string path = pidPath();
+    {
+      const service::PidFile pidFile( path );
+      EXPECT_TRUE( pidFile.isLocked() );
+      EXPECT_EQ( pidFile.owner(), 0 );
+      EXPECT_EQ( content( path ), std::to_string( ::getpid() ) );
+
+      /* Second instance, the lock belongs to the open file description */
+      const service::PidFile second( path );
+      EXPECT_FALSE( second.isLocked() );
+      EXPECT_EQ( second.owner(), ::getpid() );
+      EXPECT_EQ( content( path ), std::to_string( ::getpid() ) );
+    }
+    EXPECT_FALSE( std::filesystem::exists( path ) );
+
+    const service::PidFile again( path );
+    EXPECT_TRUE( again.isLocked() );
+  }
+
+  TEST( PidFile, Stale ) {
+
+    const std::string path = pidPath();
+
+    /* Empty PID file */
+    writeUnlocked( path, 0 );
+    {
+      const service::PidFile pidFile( path );
+      EXPECT_TRUE( pidFile.isLocked() );
+      EXPECT_EQ( content( path ), std::to_string( ::getpid() ) );
+    }
+
+    /* PID of a finished process */
+    const pid_t finished = forkSleeping();
+    reap( finished );
+    writeUnlocked( path, finished );
+    {
+      const service::PidFile pidFile( path );
+      EXPECT_TRUE( pidFile.isLocked() );
+      EXPECT_EQ( content( path ), std::to_string( ::getpid() ) );
+    }
+    EXPECT_FALSE( std::filesystem::exists( path ) );
+  }
+
+  TEST( PidFile, RunningWithoutLock ) {
+
+    const std::string path = pidPath();
+    const pid_t running = forkSleeping();
+    writeUnlocked( path, running );
+    {
+      const service::PidFile pidFile( path );
+      EXPECT_FALSE( pidFile.isLocked() );
+      EXPECT_EQ( pidFile.owner(), running );
+    }
+    reap( running );
+    EXPECT_EQ( content( path ), std::to_string( running ) );
+    std::filesystem::remove( path );
+  }
+
+  TEST( PidFile, Crashed ) {
+
+    const std::string path = pidPath();
+    std::array<std::int32_t, 2> ready {};
+    ASSERT_EQ( ::pipe( ready.data() ), 0 );
+    const pid_t child = ::fork();
+    if ( child == 0 ) {
+
+      /* Never released, the process is killed. */
+      const auto *pidFile = new service::PidFile( path ); // NOSONAR leaked on purpose.
+      const char locked = pidFile->isLocked() ? 1 : 0;
+      std::ignore = ::write( ready[ 1 ], &locked, 1 );
+      while ( true ) {
+
+        ::pause();
+      }
+    }
+    char locked = 0;
+    ASSERT_EQ( ::read( ready[ 0 ], &locked, 1 ), 1 );
+    ::close( ready[ 0 ] );
+    ::close( ready[ 1 ] );
+    EXPECT_EQ( locked, 1 );
+    {
+      const service::PidFile pidFile( path );
+      EXPECT_FALSE( pidFile.isLocked() );
+      EXPECT_EQ( pidFile.owner(), child );
+    }
+
+    /* The kernel releases the lock, the PID file stays. */
+    reap( child );
+    ASSERT_TRUE( std::filesystem::exists( path ) );
+    const service::PidFile pidFile( path );
+    EXPECT_TRUE( pidFile.isLocked() );
+    EXPECT_EQ( content( path ), std::to_string( ::getpid() ) );
+  }
+
+  TEST( PidFile, Concurrent ) {
+
+    const std::string path = pidPath();
+    constexpr std::size_t instances = 8;
+    for ( std::int32_t round = 0; round < 50; ++round ) {
+
+      std::vector<std::unique_ptr<service::PidFile>> pidFiles( instances );
+      std::vector<std::thread> threads {};
+      for ( auto &pidFile : pidFiles ) {
+
+        threads.emplace_back( [ &pidFile, &path ]() { pidFile = std::make_unique<service::PidFile>( path ); } );
+      }
+      for ( auto &thread : threads ) {
+
+        thread.join();
+      }
+      std::size_t locked = 0;
+      for ( const auto &pidFile : pidFiles ) {
+
+        locked += pidFile->isLocked() ? 1 : 0;
+      }
+      EXPECT_EQ( locked, 1 );
+    }
+    EXPECT_FALSE( std::filesystem::exists( path ) );
+
+    /* No temporary file is left behind. */
+    for ( const auto &entry : std::filesystem::directory_iterator( std::filesystem::temp_directory_path() ) ) {
+
+      EXPECT_EQ( entry.path().string().find( path ), std::string::npos );
+    }
+  }
+}
+#ifdef __clang__
+  #pragma clang diagnostic pop
+#endif
+
+std::int32_t main( std::int32_t argc,
+                   char **argv ) {
+
+  InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2022 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* c header */
+#include <cstddef> // std::size_t
+#include <cstdint> // std::int32_t, std::uintptr_t
+
+/* stl header */
+#include <vector>
+
+/* gtest header */
+#include <gtest/gtest.h>
+
+/* modern.cpp.core */
+#include <PointBatch.h>
+
+using ::testing::InitGoogleTest;
+using ::testing::Test;
+
+#ifdef __clang__
+  #pragma clang diagnostic push
+  #pragma clang diagnostic ignored "-Wglobal-constructors"
+#endif
+namespace vx {
+
+  TEST( PointBatch, Simple ) {
+
+    PointBatch<std::int32_t> batch {};
+    EXPECT_TRUE( batch.empty() );
+    EXPECT_TRUE( batch.boundingRect().null() );
+
+    batch.reserve( 3 );
+    batch.push_back( { 1, 2 } );
+    batch.push_back( { -3, 5 } );
+    batch.push_back( { 4, -1 } );
+    EXPECT_EQ( batch.size(), 3 );
+    EXPECT_EQ( reinterpret_cast<std::uintptr_t>( batch.xs() ) % defaultAlignment, 0 );
+    EXPECT_EQ( reinterpret_cast<std::uintptr_t>( batch.ys() ) % defaultAlignment, 0 );
+    EXPECT_EQ( batch[ 1 ], Point( -3, 5 ) );
+
+    const Rect bounding = batch.boundingRect();
+    EXPECT_EQ( bounding.left(), -3 );
+    EXPECT_EQ( bounding.top(), -1 );
+    EXPECT_EQ( bounding.right(), 4 );
+    EXPECT_EQ( bounding.bottom(), 5 );
+
+    batch.translate( { 1, 1 } );
+    EXPECT_EQ( batch[ 0 ], Point( 2, 3 ) );
+    batch.scale( 2, -1 );
+    EXPECT_EQ( batch[ 2 ], Point( 10, 0 ) );
+
+    batch.clear();
+    EXPECT_TRUE( batch.empty() );
+  }
+
+  TEST( PointBatch, ContainedBy ) {
+
+    PointBatch<double> batch {};
+    for ( std::size_t index = 0; index < 100; ++index ) {
+
+      batch.push_back( { static_cast<double>( index ), static_cast<double>( index % 10 ) } );
+    }
+
+    BitMask mask {};
+    batch.containedBy( Rect( 10.0, 0.0, 20.0, 5.0 ), mask );
+    EXPECT_EQ( mask.size(), 100 );
+    for ( std::size_t index = 0; index < batch.size(); ++index ) {
+
+      const Point point = batch[ index ];
+      EXPECT_EQ( mask.test( index ), point.x() >= 10 && point.x() <= 29 && point.y() >= 0 && point.y() <= 4 );
+    }
+    EXPECT_EQ( mask.count(), 10 );
+
+    std::vector<std::size_t> indexes {};
+    mask.forEach( [ &indexes ]( std::size_t _index ) { indexes.push_back( _index ); } );
+    EXPECT_EQ( indexes.front(), 10 );
+    EXPECT_EQ( indexes.size(), 10 );
+
+    batch.containedBy( Rect( 0.0, 0.0, 0.0, 0.0 ), mask );
+    EXPECT_EQ( mask.count(), 0 );
+  }
+}
+#ifdef __clang__
+  #pragma clang diagnostic pop
+#endif
+
+std::int32_t main( std::int32_t argc,
+                   char **argv ) {
+
+  InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
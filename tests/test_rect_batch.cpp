@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2022 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* c header */
+#include <cstddef> // std::size_t
+#include <cstdint> // std::int32_t, std::uintptr_t
+
+/* stl header */
+#include <random>
+
+/* gtest header */
+#include <gtest/gtest.h>
+
+/* modern.cpp.core */
+#include <RectBatch.h>
+
+using ::testing::InitGoogleTest;
+using ::testing::Test;
+
+#ifdef __clang__
+  #pragma clang diagnostic push
+  #pragma clang diagnostic ignored "-Wglobal-constructors"
+#endif
+namespace vx {
+
+  namespace {
+
+    /**
+     * @brief Fill a batch with random rects, some of them null or flipped.
+     * @tparam T   Type.
+     * @param _batch   Batch to fill.
+     * @param _size   Number of rects.
+     */
+    template <typename T>
+    void fill( RectBatch<T> &_batch,
+               std::size_t _size ) {
+
+      std::mt19937 generator( 42 );
+      std::uniform_int_distribution<std::int32_t> position( -50, 50 );
+      std::uniform_int_distribution<std::int32_t> extent( -10, 30 );
+      for ( std::size_t index = 0; index < _size; ++index ) {
+
+        const auto left = static_cast<T>( position( generator ) );
+        const auto top = static_cast<T>( position( generator ) );
+        if ( index % 17 == 0 ) {
+
+          _batch.push_back( Rect<T>( left, top, 0, 0 ) );
+          continue;
+        }
+        _batch.push_back( Rect<T>( left, top, static_cast<T>( extent( generator ) ), static_cast<T>( extent( generator ) ) ) );
+      }
+    }
+
+    /**
+     * @brief Compare the batch checks of every instruction set with the scalar checks.
+     * @tparam T   Type.
+     */
+    template <typename T>
+    void compare() {
+
+      /* The size is no multiple of the register lanes, so the scalar tail is used too. */
+      RectBatch<T> batch {};
+      fill( batch, 1003 );
+      RectBatch<T> other {};
+      for ( std::size_t index = 0; index < batch.size(); ++index ) {
+
+        other.push_back( batch[ ( index * 7 ) % batch.size() ] );
+      }
+      const Simd supported = batchSimd();
+      BitMask intersects {};
+      BitMask contains {};
+      BitMask containedBy {};
+      for ( const Simd simd : { Simd::Scalar, Simd::SSE2, Simd::AVX2 } ) {
+
+        setBatchSimd( simd );
+        for ( std::size_t query = 0; query < 20; ++query ) {
+
+          const Rect<T> rectangle = batch[ query ];
+          batch.intersects( rectangle, intersects );
+          batch.contains( rectangle, contains );
+          batch.containedBy( rectangle, containedBy );
+          for ( std::size_t index = 0; index < batch.size(); ++index ) {
+
+            EXPECT_EQ( intersects.test( index ), batch[ index ].intersects( rectangle ) ) << index;
+            EXPECT_EQ( contains.test( index ), batch[ index ].contains( rectangle ) ) << index;
+            EXPECT_EQ( containedBy.test( index ), rectangle.contains( batch[ index ] ) ) << index;
+          }
+        }
+
+        batch.intersects( other, intersects );
+        batch.contains( other, contains );
+        batch.containedBy( other, containedBy );
+        for ( std::size_t index = 0; index < batch.size(); ++index ) {
+
+          EXPECT_EQ( intersects.test( index ), batch[ index ].intersects( other[ index ] ) ) << index;
+          EXPECT_EQ( contains.test( index ), batch[ index ].contains( other[ index ] ) ) << index;
+          EXPECT_EQ( containedBy.test( index ), other[ index ].contains( batch[ index ] ) ) << index;
+        }
+      }
+      setBatchSimd( supported );
+    }
+  }
+
+  TEST( RectBatch, Simple ) {
+
+    RectBatch<std::int32_t> batch {};
+    EXPECT_TRUE( batch.empty() );
+    EXPECT_TRUE( batch.united().null() );
+
+    batch.push_back( { 0, 0, 10, 10 } );
+    batch.push_back( { 20, -5, 5, 5 } );
+    batch.push_back( { 100, 100, 0, 0 } );
+    EXPECT_EQ( batch.size(), 3 );
+    EXPECT_EQ( reinterpret_cast<std::uintptr_t>( batch.lefts() ) % defaultAlignment, 0 );
+    EXPECT_EQ( batch[ 1 ], Rect( 20, -5, 5, 5 ) );
+
+    /* The null rect is skipped. */
+    const Rect united = batch.united();
+    EXPECT_EQ( united.left(), 0 );
+    EXPECT_EQ( united.top(), -5 );
+    EXPECT_EQ( united.right(), 24 );
+    EXPECT_EQ( united.bottom(), 9 );
+
+    batch.translate( { 1, 2 } );
+    EXPECT_EQ( batch[ 0 ], Rect( 1, 2, 10, 10 ) );
+    batch.scale( 2, 2 );
+    EXPECT_EQ( batch[ 0 ], Rect( Point( 2, 4 ), Point( 20, 22 ) ) );
+
+    BitMask mask {};
+    batch.intersects( { 0, 0, 5, 5 }, mask );
+    EXPECT_EQ( mask.size(), 3 );
+    EXPECT_TRUE( mask.test( 0 ) );
+    EXPECT_FALSE( mask.test( 1 ) );
+    EXPECT_FALSE( mask.test( 2 ) );
+
+    batch.clear();
+    EXPECT_TRUE( batch.empty() );
+  }
+
+  TEST( RectBatch, Simd ) {
+
+    const Simd supported = batchSimd();
+    setBatchSimd( Simd::Scalar );
+    EXPECT_EQ( batchSimd(), Simd::Scalar );
+    setBatchSimd( Simd::AVX2 );
+    EXPECT_EQ( batchSimd(), supported );
+  }
+
+  TEST( RectBatch, Scalar ) {
+
+    compare<std::int32_t>();
+    compare<float>();
+    compare<double>();
+  }
+}
+#ifdef __clang__
+  #pragma clang diagnostic pop
+#endif
+
+std::int32_t main( std::int32_t argc,
+                   char **argv ) {
+
+  InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
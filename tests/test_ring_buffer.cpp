@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2022 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* c header */
+#include <cstddef> // std::byte, std::size_t
+#include <cstdint> // std::int32_t, std::uint8_t
+
+/* stl header */
+#include <array>
+#include <thread>
+#include <vector>
+
+/* gtest header */
+#include <gtest/gtest.h>
+
+/* modern.cpp.core */
+#include <RingBuffer.h>
+
+using ::testing::InitGoogleTest;
+using ::testing::Test;
+
+#ifdef __clang__
+  #pragma clang diagnostic push
+  #pragma clang diagnostic ignored "-Wglobal-constructors"
+#endif
+namespace vx {
+
+  TEST( RingBuffer, Capacity ) {
+
+    EXPECT_EQ( RingBuffer( 0 ).capacity(), 1 );
+    EXPECT_EQ( RingBuffer( 8 ).capacity(), 8 );
+    EXPECT_EQ( RingBuffer( 1000 ).capacity(), 1024 );
+  }
+
+  TEST( RingBuffer, ReadWrite ) {
+
+    RingBuffer buffer( 8 );
+    EXPECT_TRUE( buffer.empty() );
+
+    const std::array<std::byte, 6> data { std::byte { 1 }, std::byte { 2 }, std::byte { 3 }, std::byte { 4 }, std::byte { 5 }, std::byte { 6 } };
+    EXPECT_EQ( buffer.write( data.data(), data.size() ), 6 );
+    EXPECT_EQ( buffer.size(), 6 );
+
+    std::array<std::byte, 8> target {};
+    EXPECT_EQ( buffer.read( target.data(), 4 ), 4 );
+    EXPECT_EQ( target[ 0 ], std::byte { 1 } );
+    EXPECT_EQ( target[ 3 ], std::byte { 4 } );
+
+    /* Wrap around, full buffer drops the rest. */
+    EXPECT_EQ( buffer.write( data.data(), data.size() ), 6 );
+    EXPECT_EQ( buffer.write( data.data(), data.size() ), 0 );
+    EXPECT_EQ( buffer.size(), 8 );
+
+    const std::array<RingBuffer::Region, 2> regions = buffer.readRegions();
+    EXPECT_EQ( regions[ 0 ].size, 4 );
+    EXPECT_EQ( regions[ 1 ].size, 4 );
+    EXPECT_EQ( regions[ 0 ].data[ 0 ], std::byte { 5 } );
+    EXPECT_EQ( regions[ 1 ].data[ 0 ], std::byte { 3 } );
+
+    EXPECT_EQ( buffer.read( target.data(), target.size() ), 8 );
+    EXPECT_EQ( target[ 0 ], std::byte { 5 } );
+    EXPECT_EQ( target[ 2 ], std::byte { 1 } );
+    EXPECT_EQ( target[ 7 ], std::byte { 6 } );
+    EXPECT_TRUE( buffer.empty() );
+    EXPECT_EQ( buffer.read( target.data(), target.size() ), 0 );
+
+    /* In place */
+    const std::array<RingBuffer::Region, 2> free = buffer.writeRegions();
+    EXPECT_EQ( free[ 0 ].size + free[ 1 ].size, 8 );
+    free[ 0 ].data[ 0 ] = std::byte { 9 };
+    buffer.commit( 1 );
+    EXPECT_EQ( buffer.readRegions()[ 0 ].data[ 0 ], std::byte { 9 } );
+    buffer.consume( 1 );
+    EXPECT_TRUE( buffer.empty() );
+  }
+
+  TEST( RingBuffer, Threads ) {
+
+    constexpr std::size_t total = 1 << 22;
+    RingBuffer buffer( 4096 );
+    std::thread producer( [ &buffer ]() {
+      std::array<std::byte, 1000> chunk {};
+      std::size_t written = 0;
+      while ( written < total ) {
+
+        const std::size_t size = std::min( chunk.size(), total - written );
+        for ( std::size_t index = 0; index < size; ++index ) {
+
+          chunk[ index ] = static_cast<std::byte>( ( written + index ) % 251 );
+        }
+        std::size_t done = 0;
+        while ( done < size ) {
+
+          done += buffer.write( chunk.data() + done, size - done );
+        }
+        written += size;
+      }
+    } );
+
+    std::vector<std::byte> chunk( 777 );
+    std::size_t read = 0;
+    bool ordered = true;
+    while ( read < total ) {
+
+      const std::size_t size = buffer.read( chunk.data(), chunk.size() );
+      for ( std::size_t index = 0; index < size; ++index ) {
+
+        ordered = ordered && chunk[ index ] == static_cast<std::byte>( ( read + index ) % 251 );
+      }
+      read += size;
+    }
+    producer.join();
+    EXPECT_TRUE( ordered );
+    EXPECT_TRUE( buffer.empty() );
+  }
+}
+#ifdef __clang__
+  #pragma clang diagnostic pop
+#endif
+
+std::int32_t main( std::int32_t argc,
+                   char **argv ) {
+
+  InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
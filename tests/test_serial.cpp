@@ -0,0 +1,345 @@
+/*
+ * Copyright (c) 2022 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* c header */
+#include <cstddef> // std::byte, std::size_t
+#include <cstdint> // std::int32_t
+#include <cstdlib> // posix_openpt, grantpt, unlockpt, ptsname
+
+/* system header */
+#include <fcntl.h> // O_RDWR, O_NOCTTY
+#include <unistd.h> // close, read, write
+
+/* stl header */
+#include <array>
+#include <chrono>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+/* gtest header */
+#include <gtest/gtest.h>
+
+/* modern.cpp.core */
+#include <Serial.h>
+
+using ::testing::InitGoogleTest;
+using ::testing::Test;
+
+#ifdef __clang__
+  #pragma clang diagnostic push
+  #pragma clang diagnostic ignored "-Wglobal-constructors"
+#endif
+namespace vx {
+
+  namespace {
+
+    /**
+     * @brief Pseudo-terminal as serial device - the test writes and reads the master side.
+     */
+    class Terminal {
+
+    public:
+      Terminal() noexcept
+        : m_master( ::posix_openpt( O_RDWR | O_NOCTTY ) ) {
+
+        if ( m_master >= 0 && ::grantpt( m_master ) == 0 && ::unlockpt( m_master ) == 0 ) {
+
+          m_path = ::ptsname( m_master );
+        }
+      }
+
+      Terminal( const Terminal & ) = delete;
+
+      Terminal &operator=( const Terminal & ) = delete;
+
+      ~Terminal() noexcept { close(); }
+
+      [[nodiscard]] inline const std::string &path() const noexcept { return m_path; }
+
+      void write( std::string_view _data ) const noexcept { std::ignore = ::write( m_master, _data.data(), _data.size() ); }
+
+      [[nodiscard]] std::string read( std::size_t _size ) const {
+
+        std::string result {};
+        std::array<char, 256> buffer {};
+        while ( result.size() < _size ) {
+
+          const ssize_t size = ::read( m_master, buffer.data(), buffer.size() );
+          if ( size <= 0 ) {
+
+            break;
+          }
+          result.append( buffer.data(), static_cast<std::size_t>( size ) );
+        }
+        return result;
+      }
+
+      void close() noexcept {
+
+        if ( m_master >= 0 ) {
+
+          ::close( m_master );
+          m_master = -1;
+        }
+      }
+
+    private:
+      std::int32_t m_master = -1;
+
+      std::string m_path {};
+    };
+  }
+
+  TEST( Serial, Open ) {
+
+    const Serial missing( "/not/existing" );
+    EXPECT_FALSE( missing.isOpen() );
+    EXPECT_EQ( missing.descriptor(), -1 );
+
+    const Terminal terminal {};
+    ASSERT_FALSE( terminal.path().empty() );
+    Serial serial( terminal.path() );
+    EXPECT_TRUE( serial.isOpen() );
+    EXPECT_GE( serial.descriptor(), 0 );
+    serial.close();
+    EXPECT_FALSE( serial.isOpen() );
+    EXPECT_EQ( serial.descriptor(), -1 );
+
+    /* Opened, but no terminal - the descriptor is closed again. */
+    const std::int32_t next = ::open( "/dev/null", O_RDONLY );
+    ::close( next );
+    for ( std::int32_t attempt = 0; attempt < 5; ++attempt ) {
+
+      const Serial device( "/dev/null" );
+      EXPECT_FALSE( device.isOpen() );
+      EXPECT_EQ( device.descriptor(), -1 );
+    }
+    const std::int32_t reused = ::open( "/dev/null", O_RDONLY );
+    EXPECT_EQ( reused, next );
+    ::close( reused );
+  }
+
+  TEST( Serial, Baudrate ) {
+
+    const Terminal terminal {};
+    EXPECT_EQ( Serial( terminal.path() ).baudrate(), 9600 );
+    EXPECT_EQ( Serial( terminal.path(), Baudrate::Speed57600 ).baudrate(), 57600 );
+    EXPECT_EQ( Serial( terminal.path(), Baudrate::Speed115200 ).baudrate(), 115200 );
+#ifdef __linux__
+    EXPECT_EQ( Serial( terminal.path(), Baudrate::Speed4000000 ).baudrate(), 4000000 );
+
+    /* Rate without speed constant */
+    const Serial custom( terminal.path(), static_cast<Baudrate>( 250000 ) );
+    EXPECT_TRUE( custom.isOpen() );
+    EXPECT_EQ( custom.baudrate(), 250000 );
+#endif
+
+    /* A terminal has no low latency, which is only a warning. */
+    const Serial low( terminal.path(), Baudrate::Speed921600, Latency::Low );
+    EXPECT_TRUE( low.isOpen() );
+    terminal.write( "fast" );
+    EXPECT_EQ( low.readExactly( 4, std::chrono::seconds( 1 ) ), "fast" );
+  }
+
+  TEST( Serial, ReadWrite ) {
+
+    const Terminal terminal {};
+    const Serial serial( terminal.path() );
+    ASSERT_TRUE( serial.isOpen() );
+    EXPECT_TRUE( serial.read().empty() );
+
+    EXPECT_TRUE( serial.write( "ping" ) );
+    EXPECT_EQ( terminal.read( 4 ), "ping" );
+
+    terminal.write( "pong" );
+    EXPECT_TRUE( serial.waitReadable( std::chrono::seconds( 1 ) ) );
+    EXPECT_EQ( serial.read(), "pong" );
+
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE( serial.waitReadable( std::chrono::milliseconds( 50 ) ) );
+    EXPECT_GE( std::chrono::steady_clock::now() - start, std::chrono::milliseconds( 40 ) );
+
+    terminal.write( "stale" );
+    EXPECT_TRUE( serial.waitReadable( std::chrono::seconds( 1 ) ) );
+    EXPECT_TRUE( serial.flush() );
+    EXPECT_FALSE( serial.waitReadable( std::chrono::milliseconds( 20 ) ) );
+  }
+
+  TEST( Serial, ReadExactly ) {
+
+    const Terminal terminal {};
+    Serial serial( terminal.path() );
+    ASSERT_TRUE( serial.isOpen() );
+
+    std::thread writer( [ &terminal ]() {
+      terminal.write( "ab" );
+      std::this_thread::sleep_for( std::chrono::milliseconds( 50 ) );
+      terminal.write( "cdef" );
+    } );
+    EXPECT_EQ( serial.readExactly( 4, std::chrono::seconds( 5 ) ), "abcd" );
+    writer.join();
+    EXPECT_EQ( serial.readExactly( 2, std::chrono::seconds( 5 ) ), "ef" );
+
+    /* Timeout */
+    terminal.write( "gh" );
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ( serial.readExactly( 4, std::chrono::milliseconds( 100 ) ), "gh" );
+    EXPECT_GE( std::chrono::steady_clock::now() - start, std::chrono::milliseconds( 90 ) );
+
+    /* Inter-byte timeout ends the read before the timeout. */
+    serial.setInterByteTimeout( std::chrono::milliseconds( 20 ) );
+    EXPECT_EQ( serial.interByteTimeout(), std::chrono::milliseconds( 20 ) );
+    terminal.write( "ij" );
+    start = std::chrono::steady_clock::now();
+    EXPECT_EQ( serial.readExactly( 4, std::chrono::seconds( 10 ) ), "ij" );
+    EXPECT_LT( std::chrono::steady_clock::now() - start, std::chrono::seconds( 5 ) );
+  }
+
+  TEST( Serial, Buffer ) {
+
+    const Terminal terminal {};
+    Serial serial( terminal.path() );
+    ASSERT_TRUE( serial.isOpen() );
+
+    std::array<std::byte, 16> buffer {};
+    EXPECT_EQ( serial.read( buffer ), 0 );
+    terminal.write( "abc" );
+    ASSERT_TRUE( serial.waitReadable( std::chrono::seconds( 1 ) ) );
+    EXPECT_EQ( serial.read( buffer ), 3 );
+    EXPECT_EQ( buffer[ 2 ], std::byte { 'c' } );
+
+    /* Gather write */
+    const std::array<std::byte, 2> header { std::byte { 'h' }, std::byte { ':' } };
+    const std::array<std::byte, 3> payload { std::byte { 'x' }, std::byte { 'y' }, std::byte { 'z' } };
+    const std::array<std::span<const std::byte>, 3> buffers { header, std::span<const std::byte> {}, payload };
+    EXPECT_TRUE( serial.write( std::span<const std::span<const std::byte>>( buffers ) ) );
+    EXPECT_EQ( terminal.read( 5 ), "h:xyz" );
+
+    /* More data than the terminal holds needs partial writes. */
+    const std::vector<std::byte> large( 1 << 20, std::byte { 'l' } );
+    std::string received {};
+    std::thread reader( [ &terminal, &received, &large ]() { received = terminal.read( large.size() ); } );
+    EXPECT_TRUE( serial.write( std::span<const std::byte>( large ) ) );
+    reader.join();
+    EXPECT_EQ( received.size(), large.size() );
+
+    /* Receive buffer */
+    EXPECT_EQ( serial.receiveBuffer(), nullptr );
+    EXPECT_EQ( serial.receive(), 0 );
+    serial.setReceiveBuffer( 8 );
+    ASSERT_NE( serial.receiveBuffer(), nullptr );
+    terminal.write( "0123456789" );
+    ASSERT_TRUE( serial.waitReadable( std::chrono::seconds( 1 ) ) );
+    EXPECT_EQ( serial.receive(), 8 );
+    EXPECT_EQ( serial.receive(), 0 );
+    EXPECT_EQ( serial.receiveBuffer()->read( buffer.data(), 6 ), 6 );
+    EXPECT_EQ( serial.receive(), 2 );
+    EXPECT_EQ( serial.receiveBuffer()->read( buffer.data(), buffer.size() ), 4 );
+    EXPECT_EQ( std::string_view( reinterpret_cast<const char *>( buffer.data() ), 4 ), "6789" );
+  }
+
+  TEST( Serial, Poller ) {
+
+    Terminal first {};
+    const Terminal second {};
+    Serial firstSerial( first.path() );
+    Serial secondSerial( second.path() );
+    ASSERT_TRUE( firstSerial.isOpen() );
+    ASSERT_TRUE( secondSerial.isOpen() );
+
+    SerialPoller poller {};
+    std::string firstData {};
+    std::string secondData {};
+    bool hangup = false;
+    EXPECT_TRUE( poller.add( firstSerial, [ &firstData, &hangup ]( Serial &, std::string_view _data ) {
+      firstData.append( _data );
+      hangup = hangup || _data.empty();
+    } ) );
+    EXPECT_TRUE( poller.add( secondSerial, [ &secondData ]( Serial &, std::string_view _data ) { secondData.append( _data ); } ) );
+    EXPECT_EQ( poller.size(), 2 );
+
+    EXPECT_EQ( poller.poll( std::chrono::milliseconds( 10 ) ), 0 );
+    first.write( "one" );
+    second.write( "two" );
+    while ( firstData.size() < 3 || secondData.size() < 3 ) {
+
+      ASSERT_GT( poller.poll( std::chrono::seconds( 5 ) ), 0 );
+    }
+    EXPECT_EQ( firstData, "one" );
+    EXPECT_EQ( secondData, "two" );
+
+    /* Hang up removes the device. */
+    first.close();
+    while ( !hangup ) {
+
+      ASSERT_GT( poller.poll( std::chrono::seconds( 5 ) ), 0 );
+    }
+    EXPECT_EQ( poller.size(), 1 );
+
+    /* Remove inside the read function. */
+    poller.remove( secondSerial );
+    EXPECT_EQ( poller.size(), 0 );
+    EXPECT_TRUE( poller.add( secondSerial, [ &poller, &secondData ]( Serial &_serial, std::string_view _data ) {
+      secondData.append( _data );
+      poller.remove( _serial );
+    } ) );
+    second.write( "three" );
+    EXPECT_EQ( poller.poll( std::chrono::seconds( 5 ) ), 1 );
+    EXPECT_EQ( secondData, "twothree" );
+    EXPECT_EQ( poller.size(), 0 );
+
+    /* Stop from another thread. */
+    EXPECT_TRUE( poller.add( secondSerial, []( Serial &, std::string_view ) {} ) );
+    std::thread stopper( [ &poller ]() {
+      std::this_thread::sleep_for( std::chrono::milliseconds( 50 ) );
+      poller.stop();
+    } );
+    poller.run();
+    stopper.join();
+    EXPECT_EQ( poller.size(), 1 );
+
+    Serial unopened( "/not/existing" );
+    EXPECT_FALSE( poller.add( unopened, []( Serial &, std::string_view ) {} ) );
+  }
+}
+#ifdef __clang__
+  #pragma clang diagnostic pop
+#endif
+
+std::int32_t main( std::int32_t argc,
+                   char **argv ) {
+
+  InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,234 @@
+/*
+ * Copyright (c) 2022 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* c header */
+#include <csignal> // SIGHUP, SIGTERM
+#include <cstddef> // offsetof, std::size_t
+#include <cstdint> // std::int32_t
+#include <cstdlib> // setenv, unsetenv
+#include <cstring> // std::memcpy
+
+/* system header */
+#include <fcntl.h> // fcntl
+#include <sys/epoll.h> // EPOLLIN
+#include <sys/socket.h>
+#include <sys/un.h> // sockaddr_un
+#include <sys/wait.h> // waitpid
+#include <unistd.h>
+
+/* stl header */
+#include <array>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+/* gtest header */
+#include <gtest/gtest.h>
+
+/* modern.cpp.core */
+#include <Service.h>
+
+using ::testing::InitGoogleTest;
+using ::testing::Test;
+
+#ifdef __clang__
+  #pragma clang diagnostic push
+  #pragma clang diagnostic ignored "-Wglobal-constructors"
+#endif
+namespace vx {
+
+  namespace {
+
+    /**
+     * @brief Service manager socket of NOTIFY_SOCKET, which collects the states.
+     */
+    class Manager {
+
+    public:
+      explicit Manager( const std::string &_name )
+        : m_descriptor( ::socket( AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC | SOCK_NONBLOCK, 0 ) ) {
+
+        /* Abstract socket, nothing to clean up. */
+        sockaddr_un address {};
+        address.sun_family = AF_UNIX;
+        const std::string path = "@" + _name + std::to_string( ::getpid() );
+        std::memcpy( address.sun_path + 1, path.data() + 1, path.size() - 1 );
+        std::ignore = ::bind( m_descriptor, reinterpret_cast<const sockaddr *>( &address ), static_cast<socklen_t>( offsetof( sockaddr_un, sun_path ) + path.size() ) );
+        ::setenv( "NOTIFY_SOCKET", path.c_str(), 1 );
+      }
+
+      Manager( const Manager & ) = delete;
+
+      Manager &operator=( const Manager & ) = delete;
+
+      ~Manager() noexcept {
+
+        ::unsetenv( "NOTIFY_SOCKET" );
+        ::close( m_descriptor );
+      }
+
+      [[nodiscard]] std::vector<std::string> states() const {
+
+        std::vector<std::string> result {};
+        std::array<char, 256> buffer {};
+        ssize_t size = 0;
+        while ( ( size = ::recv( m_descriptor, buffer.data(), buffer.size(), 0 ) ) > 0 ) {
+
+          result.emplace_back( buffer.data(), static_cast<std::size_t>( size ) );
+        }
+        return result;
+      }
+
+    private:
+      std::int32_t m_descriptor = -1;
+    };
+  }
+
+  TEST( Service, Notify ) {
+
+    ::unsetenv( "NOTIFY_SOCKET" );
+    EXPECT_FALSE( service::notify( "READY=1" ) );
+
+    const Manager manager( "test_service_notify" );
+    EXPECT_TRUE( service::notify( "READY=1" ) );
+    EXPECT_TRUE( service::notify( "STATUS=Working\nWATCHDOG=1" ) );
+    EXPECT_EQ( manager.states(), ( std::vector<std::string> { "READY=1", "STATUS=Working\nWATCHDOG=1" } ) );
+  }
+
+  TEST( Service, WatchdogInterval ) {
+
+    ::unsetenv( "WATCHDOG_USEC" );
+    ::unsetenv( "WATCHDOG_PID" );
+    EXPECT_EQ( service::watchdogInterval().count(), 0 );
+    ::setenv( "WATCHDOG_USEC", "30000000", 1 );
+    EXPECT_EQ( service::watchdogInterval(), std::chrono::seconds( 30 ) );
+    ::setenv( "WATCHDOG_PID", std::to_string( ::getpid() ).c_str(), 1 );
+    EXPECT_EQ( service::watchdogInterval(), std::chrono::seconds( 30 ) );
+    ::setenv( "WATCHDOG_PID", "1", 1 );
+    EXPECT_EQ( service::watchdogInterval().count(), 0 );
+    ::unsetenv( "WATCHDOG_USEC" );
+    ::unsetenv( "WATCHDOG_PID" );
+  }
+
+  TEST( Service, Runtime ) {
+
+    const Manager manager( "test_service_runtime" );
+    std::array<std::int32_t, 2> pipe { -1, -1 };
+    ASSERT_EQ( ::pipe( pipe.data() ), 0 );
+
+    std::int32_t reloads = 0;
+    std::int32_t shutdowns = 0;
+    std::string received {};
+    {
+      service::Runtime runtime {};
+      ASSERT_TRUE( runtime.isValid() );
+      runtime.setReloadFunction( [ &reloads ]() { ++reloads; } );
+      runtime.setShutdownFunction( [ &shutdowns ]() { ++shutdowns; } );
+      EXPECT_TRUE( runtime.add( pipe[ 0 ], EPOLLIN, [ &runtime, &received, &pipe ]( std::uint32_t ) {
+        std::array<char, 16> buffer {};
+        const ssize_t size = ::read( pipe[ 0 ], buffer.data(), buffer.size() );
+        received.append( buffer.data(), static_cast<std::size_t>( size ) );
+        runtime.remove( pipe[ 0 ] );
+        ::kill( ::getpid(), SIGTERM );
+      } ) );
+
+      /* Pending until run() */
+      ::kill( ::getpid(), SIGHUP );
+      ASSERT_EQ( ::write( pipe[ 1 ], "data", 4 ), 4 );
+      EXPECT_EQ( runtime.run(), EXIT_SUCCESS );
+    }
+    EXPECT_EQ( reloads, 1 );
+    EXPECT_EQ( shutdowns, 1 );
+    EXPECT_EQ( received, "data" );
+
+    const std::vector<std::string> states = manager.states();
+    ASSERT_EQ( states.size(), 4 );
+    EXPECT_EQ( states[ 0 ], "READY=1" );
+    EXPECT_EQ( states[ 1 ].rfind( "RELOADING=1\nMONOTONIC_USEC=", 0 ), 0 );
+    EXPECT_EQ( states[ 2 ], "READY=1" );
+    EXPECT_EQ( states[ 3 ], "STOPPING=1" );
+    ::close( pipe[ 0 ] );
+    ::close( pipe[ 1 ] );
+  }
+
+  TEST( Service, Watchdog ) {
+
+    const Manager manager( "test_service_watchdog" );
+    ::setenv( "WATCHDOG_USEC", "20000", 1 );
+    service::Runtime runtime {};
+    ::unsetenv( "WATCHDOG_USEC" );
+    std::thread stopper( [ &runtime ]() {
+      std::this_thread::sleep_for( std::chrono::milliseconds( 100 ) );
+      runtime.stop();
+    } );
+    EXPECT_EQ( runtime.run(), EXIT_SUCCESS );
+    stopper.join();
+
+    std::size_t watchdogs = 0;
+    for ( const std::string &state : manager.states() ) {
+
+      watchdogs += state == "WATCHDOG=1" ? 1 : 0;
+    }
+    EXPECT_GE( watchdogs, 3 );
+  }
+
+  TEST( Service, CloseDescriptors ) {
+
+    const pid_t child = ::fork();
+    ASSERT_GE( child, 0 );
+    if ( child == 0 ) {
+
+      std::array<std::int32_t, 2> pipe { -1, -1 };
+      std::ignore = ::pipe( pipe.data() );
+      const std::int32_t first = ::fcntl( pipe[ 0 ], F_DUPFD, 100 );
+      const std::int32_t second = ::fcntl( pipe[ 1 ], F_DUPFD, 200 );
+      service::closeDescriptors( 100 );
+      const bool closed = ::fcntl( first, F_GETFD ) < 0 && ::fcntl( second, F_GETFD ) < 0;
+      const bool kept = ::fcntl( pipe[ 0 ], F_GETFD ) >= 0 && ::fcntl( pipe[ 1 ], F_GETFD ) >= 0;
+      ::_exit( first >= 100 && closed && kept ? EXIT_SUCCESS : EXIT_FAILURE );
+    }
+    std::int32_t status = -1;
+    ASSERT_EQ( ::waitpid( child, &status, 0 ), child );
+    EXPECT_TRUE( WIFEXITED( status ) );
+    EXPECT_EQ( WEXITSTATUS( status ), EXIT_SUCCESS );
+  }
+}
+#ifdef __clang__
+  #pragma clang diagnostic pop
+#endif
+
+std::int32_t main( std::int32_t argc,
+                   char **argv ) {
+
+  InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
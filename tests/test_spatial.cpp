@@ -0,0 +1,300 @@
+/*
+ * Copyright (c) 2022 Florian Becker <fb@vxapps.com> (VX APPS).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* c header */
+#include <cstddef> // std::size_t
+#include <cstdint> // std::int32_t
+
+/* stl header */
+#include <algorithm>
+#include <random>
+#include <vector>
+
+/* gtest header */
+#include <gtest/gtest.h>
+
+/* modern.cpp.core */
+#include <PackedRTree.h>
+#include <RTree.h>
+#include <UniformGrid.h>
+
+using ::testing::InitGoogleTest;
+using ::testing::Test;
+
+#ifdef __clang__
+  #pragma clang diagnostic push
+  #pragma clang diagnostic ignored "-Wglobal-constructors"
+#endif
+namespace vx {
+
+  namespace {
+
+    /**
+     * @brief Return random rects, some of them null or flipped.
+     * @tparam T   Type.
+     * @param _size   Number of rects.
+     * @return The rects.
+     */
+    template <typename T>
+    std::vector<Rect<T>> random( std::size_t _size ) {
+
+      std::mt19937 generator( 42 );
+      std::uniform_real_distribution<double> position( -500.0, 500.0 );
+      std::uniform_real_distribution<double> extent( -10.0, 40.0 );
+      std::vector<Rect<T>> rects {};
+      for ( std::size_t index = 0; index < _size; ++index ) {
+
+        const auto left = static_cast<T>( position( generator ) );
+        const auto top = static_cast<T>( position( generator ) );
+        if ( index % 17 == 0 ) {
+
+          rects.push_back( Rect<T>( left, top, 0, 0 ) );
+          continue;
+        }
+        rects.emplace_back( left, top, static_cast<T>( extent( generator ) ), static_cast<T>( extent( generator ) ) );
+      }
+      return rects;
+    }
+
+    /**
+     * @brief Compare the queries of an index with a linear scan.
+     * @tparam T   Type.
+     * @tparam Index   Spatial index.
+     * @param _index   Index to check.
+     * @param _rects   Rects with their index as id.
+     * @param _indexed   Is the rect indexed?
+     */
+    template <typename T, typename Index>
+    void check( const Index &_index,
+                const std::vector<Rect<T>> &_rects,
+                const std::vector<bool> &_indexed ) {
+
+      std::mt19937 generator( 7 );
+      std::uniform_real_distribution<double> position( -600.0, 600.0 );
+      std::uniform_real_distribution<double> extent( -20.0, 150.0 );
+      std::vector<std::size_t> result {};
+      std::vector<std::size_t> expected {};
+      for ( std::size_t query = 0; query < 100; ++query ) {
+
+        const Point<T> point( static_cast<T>( position( generator ) ), static_cast<T>( position( generator ) ) );
+        const Rect<T> region( point.x(), point.y(), static_cast<T>( extent( generator ) ), static_cast<T>( extent( generator ) ) );
+
+        _index.intersecting( region, result );
+        std::sort( std::begin( result ), std::end( result ) );
+        expected.clear();
+        for ( std::size_t id = 0; id < _rects.size(); ++id ) {
+
+          if ( _indexed[ id ] && _rects[ id ].intersects( region ) ) {
+
+            expected.push_back( id );
+          }
+        }
+        EXPECT_EQ( result, expected ) << query;
+
+        _index.containing( point, result );
+        std::sort( std::begin( result ), std::end( result ) );
+        expected.clear();
+        for ( std::size_t id = 0; id < _rects.size(); ++id ) {
+
+          if ( _indexed[ id ] && _rects[ id ].intersects( Rect<T>( point, point ) ) ) {
+
+            expected.push_back( id );
+          }
+        }
+        EXPECT_EQ( result, expected ) << query;
+
+        std::vector<double> distances {};
+        for ( std::size_t id = 0; id < _rects.size(); ++id ) {
+
+          if ( _indexed[ id ] && !_rects[ id ].null() ) {
+
+            distances.push_back( spatial::distance( spatial::box( _rects[ id ] ), point ) );
+          }
+        }
+        std::sort( std::begin( distances ), std::end( distances ) );
+        _index.nearest( point, 10, result );
+        ASSERT_EQ( result.size(), std::min( distances.size(), static_cast<std::size_t>( 10 ) ) );
+        for ( std::size_t rank = 0; rank < result.size(); ++rank ) {
+
+          EXPECT_DOUBLE_EQ( spatial::distance( spatial::box( _rects[ result[ rank ] ] ), point ), distances[ rank ] ) << query << " " << rank;
+        }
+      }
+    }
+
+    /**
+     * @brief Check the packed R-tree.
+     * @tparam T   Type.
+     */
+    template <typename T>
+    void packed() {
+
+      const std::vector<Rect<T>> rects = random<T>( 2000 );
+      std::vector<bool> indexed( rects.size() );
+      for ( std::size_t id = 0; id < rects.size(); ++id ) {
+
+        indexed[ id ] = !rects[ id ].null();
+      }
+
+      PackedRTree<T> tree {};
+      tree.load( rects );
+      EXPECT_EQ( tree.size(), static_cast<std::size_t>( std::count( std::cbegin( indexed ), std::cend( indexed ), true ) ) );
+      check( tree, rects, indexed );
+
+      RectBatch<T> batch {};
+      for ( const Rect<T> &rectangle : rects ) {
+
+        batch.push_back( rectangle );
+      }
+      PackedRTree<T> small( 4 );
+      small.load( batch );
+      check( small, rects, indexed );
+    }
+
+    /**
+     * @brief Check the dynamic R-tree.
+     * @tparam T   Type.
+     */
+    template <typename T>
+    void dynamic() {
+
+      const std::vector<Rect<T>> rects = random<T>( 2000 );
+      std::vector<bool> indexed( rects.size() );
+      RTree<T> tree( 8 );
+      for ( std::size_t id = 0; id < rects.size(); ++id ) {
+
+        tree.insert( rects[ id ], id );
+        indexed[ id ] = !rects[ id ].null();
+      }
+      check( tree, rects, indexed );
+
+      for ( std::size_t id = 0; id < rects.size(); id += 3 ) {
+
+        EXPECT_EQ( tree.remove( rects[ id ], id ), indexed[ id ] ) << id;
+        EXPECT_FALSE( tree.remove( rects[ id ], id ) ) << id;
+        indexed[ id ] = false;
+      }
+      EXPECT_EQ( tree.size(), static_cast<std::size_t>( std::count( std::cbegin( indexed ), std::cend( indexed ), true ) ) );
+      check( tree, rects, indexed );
+
+      for ( std::size_t id = 0; id < rects.size(); ++id ) {
+
+        if ( indexed[ id ] ) {
+
+          EXPECT_TRUE( tree.remove( rects[ id ], id ) ) << id;
+        }
+      }
+      EXPECT_TRUE( tree.empty() );
+      EXPECT_TRUE( tree.boundingRect().null() );
+    }
+
+    /**
+     * @brief Check the uniform grid.
+     * @tparam T   Type.
+     */
+    template <typename T>
+    void grid() {
+
+      const std::vector<Rect<T>> rects = random<T>( 2000 );
+      std::vector<bool> indexed( rects.size() );
+
+      /* Smaller than the rects, so the border cells hold the rects outside. */
+      UniformGrid<T> grid( Rect<T>( -400, -400, 800, 800 ), 16, 12 );
+      for ( std::size_t id = 0; id < rects.size(); ++id ) {
+
+        grid.insert( rects[ id ], id );
+        indexed[ id ] = !rects[ id ].null();
+      }
+      check( grid, rects, indexed );
+
+      for ( std::size_t id = 1; id < rects.size(); id += 2 ) {
+
+        EXPECT_EQ( grid.remove( rects[ id ], id ), indexed[ id ] ) << id;
+        indexed[ id ] = false;
+      }
+      EXPECT_EQ( grid.size(), static_cast<std::size_t>( std::count( std::cbegin( indexed ), std::cend( indexed ), true ) ) );
+      check( grid, rects, indexed );
+
+      grid.clear();
+      EXPECT_TRUE( grid.empty() );
+    }
+  }
+
+  TEST( Spatial, Box ) {
+
+    const spatial::Box<std::int32_t> box = spatial::box( Rect<std::int32_t>( 10, 20, -5, -8 ) );
+    EXPECT_EQ( box.left, 4 );
+    EXPECT_EQ( box.right, 10 );
+    EXPECT_EQ( box.top, 11 );
+    EXPECT_EQ( box.bottom, 20 );
+    EXPECT_TRUE( spatial::intersects( box, spatial::box( Point<std::int32_t>( 4, 20 ) ) ) );
+    EXPECT_FALSE( spatial::intersects( box, spatial::box( Point<std::int32_t>( 3, 20 ) ) ) );
+    EXPECT_DOUBLE_EQ( spatial::distance( box, Point<std::int32_t>( 13, 24 ) ), 25.0 );
+  }
+
+  TEST( Spatial, PackedRTree ) {
+
+    PackedRTree<std::int32_t> tree {};
+    std::vector<std::size_t> result { 1 };
+    tree.intersecting( Rect<std::int32_t>( 0, 0, 10, 10 ), result );
+    EXPECT_TRUE( result.empty() );
+    EXPECT_TRUE( tree.boundingRect().null() );
+
+    tree.load( { Rect<std::int32_t>( 0, 0, 10, 10 ), Rect<std::int32_t>( 20, 20, 5, 5 ) } );
+    EXPECT_EQ( tree.boundingRect(), Rect<std::int32_t>( 0, 0, 25, 25 ) );
+
+    packed<std::int32_t>();
+    packed<float>();
+    packed<double>();
+  }
+
+  TEST( Spatial, RTree ) {
+
+    dynamic<std::int32_t>();
+    dynamic<float>();
+    dynamic<double>();
+  }
+
+  TEST( Spatial, UniformGrid ) {
+
+    grid<std::int32_t>();
+    grid<float>();
+    grid<double>();
+  }
+}
+#ifdef __clang__
+  #pragma clang diagnostic pop
+#endif
+
+std::int32_t main( std::int32_t argc,
+                   char **argv ) {
+
+  InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
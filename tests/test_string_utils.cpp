@@ -29,12 +29,15 @@
  */
 
 /* c header */
-#include <cstdint> // std::int32_t
+#include <clocale> // std::setlocale
+#include <cstdint> // std::int32_t, std::int64_t, std::uint8_t
 
 /* gtest header */
 #include <gtest/gtest.h>
 
 /* stl header */
+#include <array>
+#include <limits>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -162,6 +165,143 @@ namespace vx {
     EXPECT_EQ( result, "54686520616e737765722069732034322e" );
   }
 
+  TEST( StringUtils, Parse ) {
+
+    EXPECT_EQ( string_utils::parse<std::int32_t>( "42" ), 42 );
+    EXPECT_EQ( string_utils::parse<std::int32_t>( "-42" ), -42 );
+    EXPECT_EQ( string_utils::parse<std::uint8_t>( "255" ), 255 );
+    EXPECT_EQ( string_utils::parse<std::uint8_t>( "256" ), std::nullopt );
+    EXPECT_EQ( string_utils::parse<std::int32_t>( "" ), std::nullopt );
+    EXPECT_EQ( string_utils::parse<std::int32_t>( " 42" ), std::nullopt );
+    EXPECT_EQ( string_utils::parse<std::int32_t>( "42." ), std::nullopt );
+    EXPECT_EQ( string_utils::parse<double>( "1.25" ), 1.25 );
+    EXPECT_EQ( string_utils::parse<double>( "-4.2e1" ), -42.0 );
+    EXPECT_EQ( string_utils::parse<double>( "1.25x" ), std::nullopt );
+
+    const std::string source = "1,2,3,42";
+    const std::optional<std::vector<std::int32_t>> numbers = string_utils::parseAll<std::int32_t>( string_utils::tokenize( source, "," ) );
+    const std::vector<std::int32_t> expected = { 1, 2, 3, 42 };
+    EXPECT_EQ( numbers, expected );
+    EXPECT_EQ( string_utils::parseAll<std::int32_t>( string_utils::tokenize( "1,a,3", "," ) ), std::nullopt );
+  }
+
+  TEST( StringUtils, Format ) {
+
+    std::array<char, string_utils::formatSize<std::int64_t>> buffer {};
+    EXPECT_EQ( string_utils::format( buffer, std::numeric_limits<std::int64_t>::min() ), "-9223372036854775808" );
+    EXPECT_EQ( string_utils::format( buffer, 42 ), "42" );
+
+    std::array<char, string_utils::formatSize<double>> floating {};
+    EXPECT_EQ( string_utils::format( floating, 0.1 ), "0.1" );
+    EXPECT_EQ( string_utils::format( floating, -std::numeric_limits<double>::denorm_min() ), "-5e-324" );
+    EXPECT_EQ( string_utils::parse<double>( string_utils::format( floating, 1.0 / 3.0 ) ), 1.0 / 3.0 );
+
+    /* Buffer too small */
+    std::array<char, 2> small {};
+    EXPECT_EQ( string_utils::format( small, 420 ), "" );
+  }
+
+  TEST( StringUtils, FloatingPointFallback ) {
+
+    /* Used by parse() and format() without floating point std::from_chars and std::to_chars */
+    EXPECT_EQ( string_utils::parseFloatingPoint<double>( "1.25" ), 1.25 );
+    EXPECT_EQ( string_utils::parseFloatingPoint<double>( "-4.2e1" ), -42.0 );
+    EXPECT_EQ( string_utils::parseFloatingPoint<double>( "-5e-324" ), -std::numeric_limits<double>::denorm_min() );
+    EXPECT_EQ( string_utils::parseFloatingPoint<float>( "0.1" ), 0.1F );
+    EXPECT_EQ( string_utils::parseFloatingPoint<double>( "" ), std::nullopt );
+    EXPECT_EQ( string_utils::parseFloatingPoint<double>( "-" ), std::nullopt );
+    EXPECT_EQ( string_utils::parseFloatingPoint<double>( "1.25x" ), std::nullopt );
+    EXPECT_EQ( string_utils::parseFloatingPoint<double>( " 1.25" ), std::nullopt );
+    EXPECT_EQ( string_utils::parseFloatingPoint<double>( "+1.25" ), std::nullopt );
+    EXPECT_EQ( string_utils::parseFloatingPoint<double>( "0x10" ), std::nullopt );
+    EXPECT_EQ( string_utils::parseFloatingPoint<double>( "1e400" ), std::nullopt );
+    EXPECT_EQ( string_utils::parseFloatingPoint<double>( "1e-400" ), std::nullopt );
+
+    std::array<char, string_utils::formatSize<double>> buffer {};
+    EXPECT_EQ( string_utils::formatFloatingPoint( buffer.data(), buffer.size(), 0.1 ), "0.1" );
+    EXPECT_EQ( string_utils::formatFloatingPoint( buffer.data(), buffer.size(), 1e20 ), "1e+20" );
+    EXPECT_EQ( string_utils::formatFloatingPoint( buffer.data(), buffer.size(), 1.0 / 3.0 ), "0.3333333333333333" );
+    EXPECT_EQ( string_utils::formatFloatingPoint( buffer.data(), buffer.size(), -std::numeric_limits<double>::denorm_min() ), "-5e-324" );
+    EXPECT_EQ( string_utils::formatFloatingPoint( buffer.data(), buffer.size(), -std::numeric_limits<double>::min() ), "-2.2250738585072014e-308" );
+    EXPECT_EQ( string_utils::formatFloatingPoint( buffer.data(), buffer.size(), std::numeric_limits<double>::infinity() ), "inf" );
+    EXPECT_EQ( string_utils::formatFloatingPoint( buffer.data(), buffer.size(), 0.1F ), "0.1" );
+
+    std::array<char, string_utils::formatSize<long double>> wide {};
+    EXPECT_FALSE( string_utils::formatFloatingPoint( wide.data(), wide.size(), -std::numeric_limits<long double>::min() ).empty() );
+
+    /* Buffer too small */
+    std::array<char, 3> small {};
+    EXPECT_EQ( string_utils::formatFloatingPoint( small.data(), small.size(), 0.125 ), "" );
+
+    /* Independent of the locale of the process */
+    if ( std::setlocale( LC_NUMERIC, "de_DE.UTF-8" ) != nullptr ) {
+
+      EXPECT_EQ( string_utils::formatFloatingPoint( buffer.data(), buffer.size(), 1.5 ), "1.5" );
+      EXPECT_EQ( string_utils::parseFloatingPoint<double>( "1.5" ), 1.5 );
+      std::setlocale( LC_NUMERIC, "C" );
+    }
+  }
+
+  TEST( StringUtils, FindFirstOf ) {
+
+    const std::string_view source = "The answer is 42, really.";
+    EXPECT_EQ( string_utils::findFirstOf( source, ",." ), 16 );
+    EXPECT_EQ( string_utils::findFirstOf( source, ".," ), 16 );
+    EXPECT_EQ( string_utils::findFirstOf( source, ",.", 17 ), 24 );
+    EXPECT_EQ( string_utils::findFirstOf( source, "T" ), 0 );
+    EXPECT_EQ( string_utils::findFirstOf( source, "xqz" ), std::string_view::npos );
+    EXPECT_EQ( string_utils::findFirstOf( source, "" ), std::string_view::npos );
+    EXPECT_EQ( string_utils::findFirstOf( source, "T", source.size() ), std::string_view::npos );
+
+    /* Every position within and after the first word */
+    for ( std::size_t pos = 0; pos < source.size(); ++pos ) {
+
+      EXPECT_EQ( string_utils::findFirstOf( source, source.substr( pos, 1 ), pos ), pos );
+    }
+  }
+
+  TEST( StringUtils, Searcher ) {
+
+    const string_utils::Searcher searcher( "answer" );
+    EXPECT_EQ( searcher.find( "The answer is 42." ), 4 );
+    EXPECT_EQ( searcher.find( "The answer is 42.", 5 ), std::string_view::npos );
+    EXPECT_EQ( searcher.find( "The question is 42." ), std::string_view::npos );
+    EXPECT_EQ( searcher.find( "answe" ), std::string_view::npos );
+    EXPECT_TRUE( searcher.contains( "answer" ) );
+    EXPECT_FALSE( searcher.contains( "" ) );
+
+    const string_utils::Searcher overlapping( "aa" );
+    const std::vector<std::size_t> expected = { 0, 1, 2 };
+    EXPECT_EQ( overlapping.findAll( "aaaa" ), expected );
+
+    const string_utils::Searcher empty( "" );
+    EXPECT_EQ( empty.find( "The answer is 42.", 3 ), 3 );
+
+    /* pineapple in japanese. Painappuro in romanji. */
+    const string_utils::Searcher japanese( "ナップ" );
+    EXPECT_EQ( japanese.find( "パイナップル" ), std::string_view( "パイ" ).size() );
+  }
+
+  TEST( StringUtils, MultiSearcher ) {
+
+    using namespace std::literals;
+
+    const string_utils::MultiSearcher searcher( { "he"sv, "she"sv, "his"sv, "hers"sv, ""sv } );
+    EXPECT_EQ( searcher.size(), 5 );
+    EXPECT_TRUE( searcher.containsAny( "ushers" ) );
+    EXPECT_FALSE( searcher.containsAny( "Your answer is 42." ) );
+    EXPECT_FALSE( searcher.containsAny( "" ) );
+
+    const std::vector<string_utils::Match> expected = { { 1, 1 }, { 2, 0 }, { 2, 3 } };
+    EXPECT_EQ( searcher.findAll( "ushers" ), expected );
+
+    EXPECT_TRUE( string_utils::containsAny( "The answer is 42.", { "question"sv, "42"sv } ) );
+    EXPECT_FALSE( string_utils::containsAny( "The answer is 42.", { "question"sv, "43"sv } ) );
+
+    const std::vector<string_utils::Match> keywords = { { 4, 1 }, { 14, 0 } };
+    EXPECT_EQ( string_utils::findAll( "The answer is 42.", { "42"sv, "answer"sv } ), keywords );
+  }
+
 #if defined __GNUC__ || defined __clang__ // GCC, Clang, ICC
   __attribute__( ( no_sanitize_address ) )
 #elif defined _MSC_VER // MSVC